@@ -100,6 +100,36 @@ namespace rascal {
             the basis used by the sparse method. The gradients of the
             representation of the atomic structures computed with Calculator
             should have already been computed.)");
+    kernel.def(
+        "compute_for_zetas",
+        py::overload_cast<const Calculator &, const StructureManagers &,
+                          const SparsePoints &, const std::vector<size_t> &>(
+            &SparseKernel::template compute_for_zetas<
+                Calculator, StructureManagers, SparsePoints>),
+        py::call_guard<py::gil_scoped_release>(), py::arg("calculator"),
+        py::arg("managers"), py::arg("sparse_points"), py::arg("zetas"),
+        R"(Compute the sparse kernels between a set of atomic structures and a
+            set of SparsePoints for several exponents zeta. The dot products
+            are computed once and shared by all the exponents.)");
+    kernel.def("compute_for_zetas",
+               py::overload_cast<const SparsePoints &,
+                                 const std::vector<size_t> &>(
+                   &SparseKernel::template compute_for_zetas<SparsePoints>),
+               py::call_guard<py::gil_scoped_release>(),
+               py::arg("sparse_points"), py::arg("zetas"),
+               R"(Compute the kernels between a set of SparsePoints and itself
+            for several exponents zeta.)");
+    kernel.def(
+        "compute_derivative_for_zetas",
+        &SparseKernel::template compute_derivative_for_zetas<
+            Calculator, StructureManagers, SparsePoints>,
+        py::call_guard<py::gil_scoped_release>(), py::arg("calculator"),
+        py::arg("managers"), py::arg("sparse_points"),
+        py::arg("compute_neg_stress"), py::arg("zetas"),
+        R"(Compute the gradients of the sparse kernels w.r.t. the atomic
+            positions for several exponents zeta. The contractions of the
+            representation gradients with the SparsePoints are computed once
+            and shared by all the exponents.)");
   }
 
   //! Register a pseudo points class
@@ -112,6 +142,9 @@ namespace rascal {
     sparse_points.def(py::init());
     sparse_points.def("size", &SparsePoints::size);
     sparse_points.def("get_features", &SparsePoints::get_features);
+    sparse_points.def("get_species", &SparsePoints::species_by_points,
+                      R"(Atomic number of the central atom of each sparse
+            point, in the order of the columns of the kernels.)");
     return sparse_points;
   }
 
@@ -194,6 +227,78 @@ namespace rascal {
           return neg_stress_global;
         },
         py::call_guard<py::gil_scoped_release>());
+
+    mod.def(
+        "compute_sparse_kernel_predictions",
+        [](const Calculator & calculator, SparseKernel & kernel,
+           ManagerCollection & managers, SparsePoints & sparse_points,
+           math::Vector_t & weights, bool compute_neg_stress,
+           bool compute_atomic_virials) {
+          auto names = compute_sparse_kernel_predictions(
+              calculator, kernel, managers, sparse_points, weights,
+              compute_neg_stress, compute_atomic_virials);
+          size_t n_centers{0};
+          for (const auto & manager : managers) {
+            n_centers += manager->size();
+          }
+          math::Matrix_t energies_global{managers.size(), 1};
+          math::Matrix_t gradients_global{n_centers, ThreeD};
+          math::Matrix_t neg_stress_global{managers.size(), 6};
+          neg_stress_global.setZero();
+          math::Matrix_t atomic_virials_global{n_centers, 6};
+          atomic_virials_global.setZero();
+          size_t i_manager{0}, i_center{0};
+          for (const auto & manager : managers) {
+            auto && energy{
+                *manager
+                     ->template get_property<Property<double, 0, Manager_t, 1>>(
+                         names[0], true)};
+            auto && gradients{*manager->template get_property<
+                Property<double, 1, Manager_t, 1, ThreeD>>(names[1], true)};
+            energies_global(i_manager, 0) = energy(0);
+            gradients_global.block(i_center, 0, manager->size(), ThreeD) =
+                gradients.view();
+            if (compute_neg_stress) {
+              auto && neg_stress{*manager->template get_property<
+                  Property<double, 0, Manager_t, 6>>(names[2], true)};
+              neg_stress_global.block(i_manager, 0, 1, 6) =
+                  Eigen::Map<const math::Matrix_t>(neg_stress.view().data(), 1,
+                                                   6);
+            }
+            if (compute_atomic_virials) {
+              auto && atomic_virials{*manager->template get_property<
+                  Property<double, 1, Manager_t, 6>>(names[3], true)};
+              atomic_virials_global.block(i_center, 0, manager->size(), 6) =
+                  atomic_virials.view();
+            }
+            i_center += manager->size();
+            i_manager++;
+          }
+          return std::make_tuple(energies_global, gradients_global,
+                                 neg_stress_global, atomic_virials_global);
+        },
+        py::arg("calculator"), py::arg("kernel"), py::arg("managers"),
+        py::arg("sparse_points"), py::arg("weights"),
+        py::arg("compute_neg_stress") = true,
+        py::arg("compute_atomic_virials") = false,
+        py::call_guard<py::gil_scoped_release>());
+  }
+
+  //! Register the compute function of the pair potential
+  template <class StructureManagers>
+  void bind_pair_potential_compute_function(
+      py::class_<PairPotential> & pair_potential) {
+    pair_potential.def(
+        "compute",
+        [](PairPotential & self, StructureManagers & managers,
+           bool compute_neg_stress) {
+          return self.compute(managers, compute_neg_stress);
+        },
+        py::arg("managers"), py::arg("compute_neg_stress") = true,
+        py::call_guard<py::gil_scoped_release>(),
+        R"(Compute the energies, their gradients w.r.t. the atomic positions
+              and the negative stress of the structures with the pairs of
+              their neighbour lists.)");
   }
 
   /**
@@ -220,6 +325,8 @@ namespace rascal {
     // manager
     using Calc1_t = CalculatorSphericalInvariants;
     using SparsePoints_1_t = SparsePointsBlockSparse<Calc1_t>;
+    using Calc2_t = CalculatorThreeBody;
+    using SparsePoints_2_t = SparsePointsBlockSparse<Calc2_t>;
 
     // Bind the interface of this representation manager
     auto kernel = add_kernel<Kernel>(m_kernels, m_internal);
@@ -228,6 +335,8 @@ namespace rascal {
                                  ManagerCollection_1_t>(kernel);
     bind_kernel_compute_function<internal::KernelType::Cosine, Calc1_t,
                                  ManagerCollection_2_t>(kernel);
+    bind_kernel_compute_function<internal::KernelType::Cosine, Calc2_t,
+                                 ManagerCollection_2_t>(kernel);
 
     // bind the sparse kernel and pseudo points class
     auto sparse_kernel = add_kernel<SparseKernel>(m_kernels, m_internal);
@@ -235,14 +344,54 @@ namespace rascal {
     bind_sparse_kernel_compute_function<internal::SparseKernelType::GAP,
                                         Calc1_t, ManagerCollection_2_t,
                                         SparsePoints_1_t>(sparse_kernel);
-    auto sparse_points =
+    bind_sparse_kernel_compute_function<internal::SparseKernelType::GAP,
+                                        Calc2_t, ManagerCollection_2_t,
+                                        SparsePoints_2_t>(sparse_kernel);
+    auto sparse_points_1 =
         add_sparse_points<SparsePoints_1_t>(m_kernels, m_internal);
-    bind_sparse_points_push_back<ManagerCollection_2_t, Calc1_t>(sparse_points);
-    internal::bind_dict_representation(sparse_points);
+    bind_sparse_points_push_back<ManagerCollection_2_t, Calc1_t>(
+        sparse_points_1);
+    internal::bind_dict_representation(sparse_points_1);
+    auto sparse_points_2 =
+        add_sparse_points<SparsePoints_2_t>(m_kernels, m_internal);
+    bind_sparse_points_push_back<ManagerCollection_2_t, Calc2_t>(
+        sparse_points_2);
+    internal::bind_dict_representation(sparse_points_2);
 
     bind_compute_gradients<ManagerCollection_2_t, Calc1_t, SparsePoints_1_t>(
         mod, m_internal);
     bind_compute_numerical_kernel_gradients<
         SparseKernel, Calc1_t, ManagerCollection_2_t, SparsePoints_1_t>(mod);
+    bind_compute_gradients<ManagerCollection_2_t, Calc2_t, SparsePoints_2_t>(
+        mod, m_internal);
+    bind_compute_numerical_kernel_gradients<
+        SparseKernel, Calc2_t, ManagerCollection_2_t, SparsePoints_2_t>(mod);
+
+    // bind the tabulated pair potential used as a baseline
+    auto pair_potential = add_kernel<PairPotential>(mod, m_internal);
+    internal::bind_dict_representation(pair_potential);
+    pair_potential.def("get_cutoff", &PairPotential::get_cutoff);
+    bind_pair_potential_compute_function<ManagerCollection_1_t>(
+        pair_potential);
+    bind_pair_potential_compute_function<ManagerCollection_2_t>(
+        pair_potential);
+
+    // bind the updatable factorisation of the sparse GPR normal equations
+    using math::UpdatableCholesky;
+    py::class_<UpdatableCholesky> cholesky(mod, "UpdatableCholesky");
+    cholesky.def(py::init<const Eigen::Ref<const math::Matrix_t> &>(),
+                 py::arg("A"));
+    cholesky.def("size", &UpdatableCholesky::size);
+    cholesky.def("get_factor", &UpdatableCholesky::get_factor);
+    cholesky.def("add_rows", &UpdatableCholesky::add_rows,
+                 py::call_guard<py::gil_scoped_release>(), py::arg("U"),
+                 R"(Update the factor of A to the one of A + U^T U.)");
+    cholesky.def(
+        "extend", &UpdatableCholesky::extend,
+        py::call_guard<py::gil_scoped_release>(), py::arg("B"), py::arg("C"),
+        R"(Update the factor of A to the one of [[A, B], [B^T, C]].)");
+    cholesky.def("solve", &UpdatableCholesky::solve,
+                 py::call_guard<py::gil_scoped_release>(), py::arg("B"),
+                 R"(Solve A X = B.)");
   }
 }  // namespace rascal
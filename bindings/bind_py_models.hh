@@ -31,9 +31,11 @@
 #include "bind_include.hh"
 #include "bind_py_representation_calculator.hh"
 #include "bind_py_structure_manager.hh"
+#include "rascal/math/cholesky.hh"
 
 #include "rascal/models/kernels.hh"
 #include "rascal/models/numerical_kernel_gradients.hh"
+#include "rascal/models/pair_potential.hh"
 #include "rascal/models/sparse_kernel_predict.hh"
 #include "rascal/models/sparse_kernels.hh"
 #include "rascal/models/sparse_points.hh"
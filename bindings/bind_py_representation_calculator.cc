@@ -64,6 +64,98 @@ namespace rascal {
         py::call_guard<py::gil_scoped_release>());
   }
 
+  /**
+   * Bind the streaming computation of the representation by batches of
+   * centers, see compute_by_batch. The callback receives a read only numpy
+   * view of the feature buffer, which is overwritten by the next batch, and
+   * the indices of the atoms of the rows.
+   */
+  template <class Calculator, typename Manager,
+            template <class> class... Adaptor>
+  void bind_compute_by_batch_function(
+      PyCalculator<Calculator> & representation) {
+    using Manager_t =
+        typename StructureManagerTypeHolder<Manager, Adaptor...>::type;
+    using Keys_t = typename Calculator::template Property_t<Manager_t>::Keys_t;
+    representation.def(
+        "compute_by_batch",
+        [](Calculator & calculator, const AtomicStructure<3> & structure,
+           const std::string & adaptor_inputs_str, const py::list & keys_l,
+           const size_t batch_size, const py::function & callback) {
+          json adaptor_inputs = json::parse(adaptor_inputs_str);
+          Keys_t keys{};
+          for (py::handle key_l : keys_l) {
+            keys.insert(py::cast<std::vector<int>>(key_l));
+          }
+          // the capsule does not own the buffer so numpy does not copy it
+          py::capsule no_owner{&keys, [](void *) {}};
+          compute_by_batch<Manager, Adaptor...>(
+              calculator, structure, adaptor_inputs, keys, batch_size,
+              [&](const Eigen::Ref<const math::Matrix_t> & features,
+                  const std::vector<size_t> & atom_indices) {
+                const py::ssize_t item_size{sizeof(double)};
+                py::array_t<double> features_view{
+                    {static_cast<py::ssize_t>(features.rows()),
+                     static_cast<py::ssize_t>(features.cols())},
+                    {item_size * features.innerStride(),
+                     item_size * features.outerStride()},
+                    features.data(),
+                    no_owner};
+                features_view.attr("setflags")(py::arg("write") = false);
+                py::array_t<size_t> indices{
+                    static_cast<py::ssize_t>(atom_indices.size()),
+                    atom_indices.data()};
+                callback(features_view, indices);
+              });
+        },
+        py::arg("structure"), py::arg("adaptor_inputs"), py::arg("keys"),
+        py::arg("batch_size"), py::arg("callback"),
+        R"(Compute the representation of structure by batches of at most
+        batch_size centers and call callback(features, atom_indices) for each
+        batch. features is a read only view of a buffer that is reused for
+        the next batch so it has to be copied to be kept.)");
+  }
+
+  /**
+   * Bind the vector-Jacobian and Jacobian-vector products of the
+   * representation of one structure w.r.t. the positions of its atoms, see
+   * the backward() and jvp() members of the calculator.
+   */
+  template <class Calculator, typename Manager,
+            template <class> class... Adaptor>
+  void bind_derivative_products(PyCalculator<Calculator> & representation) {
+    using Manager_t =
+        typename StructureManagerTypeHolder<Manager, Adaptor...>::type;
+    representation.def(
+        "backward", &Calculator::template backward<Manager_t>,
+        py::call_guard<py::gil_scoped_release>(), py::arg("manager"),
+        py::arg("features_gradient"),
+        R"(Vector-Jacobian product of the representation of the structure in
+        manager: given the gradient dL/dX of a scalar L w.r.t. its dense
+        feature matrix X, returns the gradient dL/dr of shape (n_centers, 3)
+        w.r.t. the positions of the atoms and the virial of shape (1, 6) in
+        Voigt order. The gradients of the representation are not stored.)");
+    representation.def(
+        "jvp", &Calculator::template jvp<Manager_t>,
+        py::call_guard<py::gil_scoped_release>(), py::arg("manager"),
+        py::arg("displacements"),
+        R"(Jacobian-vector product of the representation of the structure in
+        manager: the change of its dense feature matrix for the displacements
+        of shape (n_centers, 3) of the atoms. The gradients of the
+        representation are not stored.)");
+    representation.def(
+        "backward_jvp", &Calculator::template backward_jvp<Manager_t>,
+        py::call_guard<py::gil_scoped_release>(), py::arg("manager"),
+        py::arg("features_gradient"), py::arg("features_gradient_change"),
+        py::arg("displacements"), py::arg("fd_step") = 1e-5,
+        R"(Change of the gradient dL/dr returned by backward when the atoms
+        are displaced by displacements of shape (n_centers, 3) and dL/dX
+        changes by features_gradient_change, used for Hessian-vector
+        products. The second derivatives of the expansion are centered finite
+        differences of its gradients with the step fd_step (Angstrom), so the
+        result is accurate to about 1e-9 relative with the default step.)");
+  }
+
   namespace py_internal {
     template <typename SM, typename AdaptorTypeHolder_>
     struct bind_compute_function_helper;
@@ -131,15 +223,38 @@ namespace rascal {
     auto rep_spherical_expansion =
         add_representation_calculator<Calc2_t>(mod, m_internal);
     bind_compute_function_helper<ManagerList_1_t>(rep_spherical_expansion);
+    bind_compute_by_batch_function<Calc2_t, StructureManagerCenters,
+                                   AdaptorNeighbourList,
+                                   AdaptorCenterContribution, AdaptorStrict>(
+        rep_spherical_expansion);
+    bind_derivative_products<Calc2_t, StructureManagerCenters,
+                             AdaptorNeighbourList, AdaptorCenterContribution,
+                             AdaptorStrict>(rep_spherical_expansion);
 
     using Calc3_t = CalculatorSphericalInvariants;
     auto rep_soap = add_representation_calculator<Calc3_t>(mod, m_internal);
     bind_compute_function_helper<ManagerList_1_t>(rep_soap);
+    bind_compute_by_batch_function<Calc3_t, StructureManagerCenters,
+                                   AdaptorNeighbourList,
+                                   AdaptorCenterContribution, AdaptorStrict>(
+        rep_soap);
+    bind_derivative_products<Calc3_t, StructureManagerCenters,
+                             AdaptorNeighbourList, AdaptorCenterContribution,
+                             AdaptorStrict>(rep_soap);
 
     using Calc4_t = CalculatorSphericalCovariants;
     auto rep_lambda_soap =
         add_representation_calculator<Calc4_t>(mod, m_internal);
     bind_compute_function_helper<ManagerList_1_t>(rep_lambda_soap);
+    bind_compute_by_batch_function<Calc4_t, StructureManagerCenters,
+                                   AdaptorNeighbourList,
+                                   AdaptorCenterContribution, AdaptorStrict>(
+        rep_lambda_soap);
+
+    using Calc5_t = CalculatorThreeBody;
+    auto rep_three_body =
+        add_representation_calculator<Calc5_t>(mod, m_internal);
+    bind_compute_function_helper<ManagerList_1_t>(rep_three_body);
   }
 
 }  // namespace rascal
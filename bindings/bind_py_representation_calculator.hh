@@ -34,8 +34,10 @@
 #include "rascal/representations/calculator_base.hh"
 #include "rascal/representations/calculator_sorted_coulomb.hh"
 #include "rascal/representations/calculator_spherical_covariants.hh"
+#include "rascal/representations/calculator_three_body.hh"
 #include "rascal/representations/calculator_spherical_expansion.hh"
 #include "rascal/representations/calculator_spherical_invariants.hh"
+#include "rascal/representations/compute_by_batch.hh"
 
 namespace rascal {
   void add_representation_calculators(py::module &, py::module &);
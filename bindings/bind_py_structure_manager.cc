@@ -833,7 +833,14 @@ namespace rascal {
         py::overload_cast<const std::vector<int> &>(
             &ManagerCollection_t::template get_subset<int>),
         R"(Build a new collection containing a subset of the structure managers
-              selected by selected_ids.)");
+              selected by selected_ids. The managers are shared, not copied.)");
+    manager_collection.def(
+        "get_complement",
+        py::overload_cast<const std::vector<int> &>(
+            &ManagerCollection_t::template get_complement<int>),
+        R"(Build a new collection containing the structure managers that are
+              not selected by selected_ids. The managers are shared, not
+              copied.)");
 
     // bind iteration over the managers
     manager_collection.def(
@@ -861,6 +868,35 @@ namespace rascal {
                            (void (ManagerCollection_t::*)(  // NOLINT
                                const std::vector<AtomicStructure<3>> &)) &
                                ManagerCollection_t::add_structures);
+    manager_collection.def(
+        "add_structures",
+        (void (ManagerCollection_t::*)(  // NOLINT
+            const Eigen::Ref<const Eigen::Matrix<double, 3, Eigen::Dynamic>> &,
+            const Eigen::Ref<const Eigen::VectorXi> &,
+            const Eigen::Ref<const Eigen::Matrix<double, 3, Eigen::Dynamic>> &,
+            const Eigen::Ref<const Eigen::Matrix<int, 3, Eigen::Dynamic>> &,
+            const Eigen::Ref<const Eigen::Array<bool, Eigen::Dynamic, 1>> &,
+            const Eigen::Ref<const Eigen::VectorXi> &, const bool,
+            const size_t)) &
+            ManagerCollection_t::add_structures,
+        R"(Add the structures given as flat arrays, the atoms of structure i
+        being the columns offsets[i] to offsets[i+1] of positions [3, n_atoms],
+        atom_types [n_atoms] and center_atoms_mask [n_atoms]. The cells
+        [3, 3*n_structures] hold the lattice vectors of structure i in the
+        columns 3*i to 3*i+2 and pbcs is [3, n_structures].)",
+        py::arg("positions"), py::arg("atom_types"), py::arg("cells"),
+        py::arg("pbcs"), py::arg("center_atoms_mask"), py::arg("offsets"),
+        py::arg("wrap_positions") = true, py::arg("n_threads") = 1,
+        py::call_guard<py::gil_scoped_release>());
+    manager_collection.def(
+        "update_structures", &ManagerCollection_t::update_structures,
+        R"(Update in place the managers with new positions
+        [n_structures, 3*n_atoms] and cells [n_structures, 9] (or a single cell
+        [1, 9]), keeping the atom types, periodicity and center masks of the
+        structures.)",
+        py::arg("positions"), py::arg("cells"),
+        py::arg("wrap_positions") = true, py::arg("n_threads") = 1,
+        py::call_guard<py::gil_scoped_release>());
     /**
      * Binds the `add_structures`. Instead of invoking the targeted function to
      * bind within a lambda function, a pointer-to-member-function is used here.
@@ -890,6 +926,8 @@ namespace rascal {
                                ManagerCollection_t>(manager_collection);
     bind_feature_matrix_getter<CalculatorSphericalCovariants,
                                ManagerCollection_t>(manager_collection);
+    bind_feature_matrix_getter<CalculatorThreeBody, ManagerCollection_t>(
+        manager_collection);
     // bind some special getters
     bind_sparse_feature_matrix_getter<CalculatorSphericalExpansion,
                                       ManagerCollection_t>(manager_collection);
@@ -897,6 +935,8 @@ namespace rascal {
                                       ManagerCollection_t>(manager_collection);
     bind_sparse_feature_matrix_getter<CalculatorSphericalCovariants,
                                       ManagerCollection_t>(manager_collection);
+    bind_sparse_feature_matrix_getter<CalculatorThreeBody,
+                                      ManagerCollection_t>(manager_collection);
   }
 
   /**
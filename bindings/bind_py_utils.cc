@@ -28,6 +28,7 @@
 #include "bind_py_utils.hh"
 
 #include "rascal/utils/sparsify_fps.hh"
+#include "rascal/utils/timer.hh"
 
 namespace rascal {
   void utils_binding(py::module & mod) {
@@ -52,5 +53,15 @@ namespace rascal {
         " space).",
         py::arg("feature_matrix"), py::arg("n_sparse"),
         py::arg("i_first_point"));
+
+    mod.def(
+        "get_timings_report",
+        []() { return internal::Timings::report().dump(); },
+        "Returns the built-in timers and counters aggregated over the threads"
+        " as a json string.");
+
+    mod.def(
+        "reset_timings", []() { internal::Timings::reset(); },
+        "Discards the measurements of the built-in timers and counters.");
   }
 }  // namespace rascal
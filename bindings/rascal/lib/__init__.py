@@ -4,5 +4,7 @@ from ._rascal.models import (
     kernels,
     compute_sparse_kernel_gradients,
     compute_sparse_kernel_neg_stress,
+    compute_sparse_kernel_predictions,
+    UpdatableCholesky,
 )
 from ._rascal.utils import sparsification
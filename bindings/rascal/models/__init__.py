@@ -1,2 +1,9 @@
-from .krr import train_gap_model, KRR, compute_KNM
+from .krr import (
+    train_gap_model,
+    KRR,
+    compute_KNM,
+    GAPHyperparameterScan,
+    IncrementalGAPTrainer,
+)
 from .kernels import Kernel
+from .pair_potential import PairPotential
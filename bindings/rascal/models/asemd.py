@@ -51,13 +51,39 @@ class ASEMLCalculator(Calculator, BaseIO):
 
         self.manager = self.representation.transform(self.manager)
 
-        energy = self.model.predict(self.manager)
+        if self._use_fused_prediction(properties):
+            # energy, forces and stress share most of their intermediates so
+            # they are predicted in a single pass
+            energy, forces, stress = self.model.predict_all(
+                self.manager, compute_stress=("stress" in properties)
+            )
+        else:
+            energy = self.model.predict(self.manager)
+            if "forces" in properties:
+                forces = self.model.predict_forces(self.manager)
+            if "stress" in properties:
+                stress = self.model.predict_stress(self.manager)
         self.results["energy"] = energy
         self.results["free_energy"] = energy
         if "forces" in properties:
-            self.results["forces"] = self.model.predict_forces(self.manager)
+            self.results["forces"] = forces
         if "stress" in properties:
-            self.results["stress"] = self.model.predict_stress(self.manager).flatten()
+            self.results["stress"] = stress.flatten()
+
+    def _use_fused_prediction(self, properties):
+        """The fused prediction is only useful when gradients are requested
+        and is only available for sparse kernels of total energies computed
+        with the gradients of the representation"""
+        if "forces" not in properties and "stress" not in properties:
+            return False
+        if not hasattr(self.model, "predict_all"):
+            return False
+        hypers = getattr(self.representation, "hypers", dict())
+        return (
+            self.model.kernel.kernel_type == "Sparse"
+            and self.model.target_type == "Structure"
+            and hypers.get("compute_gradients", False)
+        )
 
     def _get_init_params(self):
         init_params = dict(model=self.model, representation=self.representation)
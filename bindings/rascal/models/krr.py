@@ -2,16 +2,26 @@
 
 Public classes:
     Kernel  Kernel Ridge Regression model (sparse GPR only).
+    GAPHyperparameterScan   Scan the regularisation and zeta of a GAP model
+    IncrementalGAPTrainer   Update a GAP model when data or sparse points are added
 
 Public functions:
     compute_KNM             Compute GAP kernel of a set of structures
     train_gap_model         Train a GAP model given a kernel matrix and sparse points
 """
-from ..utils import BaseIO
-from ..lib import compute_sparse_kernel_gradients, compute_sparse_kernel_neg_stress
+from ..utils import BaseIO, get_timings
+from ..lib import (
+    compute_sparse_kernel_gradients,
+    compute_sparse_kernel_neg_stress,
+    compute_sparse_kernel_predictions,
+    UpdatableCholesky,
+)
 
 import numpy as np
 import ase
+import copy
+
+from .sparse_points import SparsePoints
 
 
 class KRR(BaseIO):
@@ -39,6 +49,12 @@ class KRR(BaseIO):
     units : dict
         Energy and length units used by the model (default: eV and Å (aka AA),
         same as used in ASE)
+
+    baseline : PairPotential, optional
+        pair potential added to the predictions, e.g. a ZBL repulsion when
+        the model has been trained on the difference with it (Δ-learning).
+        It is evaluated on the neighbour lists of the structures so their
+        cutoff must be at least the one of the baseline.
     """
 
     def __init__(
@@ -49,6 +65,7 @@ class KRR(BaseIO):
         self_contributions,
         description="KRR potential model",
         units=None,
+        baseline=None,
     ):
         # Weights of the krr model
         self.weights = weights
@@ -64,9 +81,14 @@ class KRR(BaseIO):
         if "length" not in units:
             units["length"] = "AA"
         self.units = units
+        self.baseline = baseline
 
     def _get_property_baseline(self, managers):
         """build total baseline contribution for each prediction"""
+        if self.baseline is not None and self.target_type != "Structure":
+            raise NotImplementedError(
+                "pair potential baselines are only implemented for target_type=='Structure'"
+            )
         if self.target_type == "Structure":
             Y0 = np.zeros(len(managers))
             for i_manager, manager in enumerate(managers):
@@ -77,6 +99,8 @@ class KRR(BaseIO):
                 else:
                     for at in manager:
                         Y0[i_manager] += self.self_contributions[at.atom_type]
+            if self.baseline is not None:
+                Y0 += self.baseline.compute(managers, False)[0]
         elif self.target_type == "Atom":
             n_centers = 0
             for manager in managers:
@@ -163,6 +187,8 @@ class KRR(BaseIO):
                 )
             gradients = np.dot(KNM, self.weights).reshape((-1, 3))
 
+        if self.baseline is not None:
+            return self.baseline.compute(managers, False)[1] - gradients
         return -gradients
 
     def predict_stress(self, managers, KNM=None):
@@ -207,11 +233,77 @@ class KRR(BaseIO):
                 )
             neg_stress = np.dot(KNM, self.weights).reshape((len(managers), 6))
 
+        if self.baseline is not None:
+            return self.baseline.compute(managers)[2] - neg_stress
         return -neg_stress
 
+    def predict_all(self, managers, compute_stress=True):
+        """Predict the properties, their negative gradients w.r.t. atomic
+        positions (e.g. forces) and their gradients w.r.t. cell parameters
+        (e.g. stress) in a single pass.
+
+        The intermediate quantities shared by the three predictions, i.e. the
+        linear kernel between the features and the sparse points and the
+        contraction of the weights with the kernel derivatives, are computed
+        only once so this is significantly faster than calling predict,
+        predict_forces and predict_stress one after the other.
+
+        Parameters
+        ----------
+        managers : AtomsList
+            list of atomic structures with already computed features and
+            gradients compatible with representation in kernel
+        compute_stress : bool, optional
+            compute the stress, by default True. The stress is returned
+            using the Voigt order: xx, yy, zz, yz, xz, xy.
+
+        Returns
+        -------
+        tuple(np.array)
+            predictions of shape (n_structures,), forces of shape
+            (n_atoms, 3) and stress of shape (n_structures, 6) (zeros if
+            compute_stress is False)
+        """
+        if self.kernel.kernel_type != "Sparse":
+            raise NotImplementedError(
+                "fused prediction only implemented for kernels with kernel_type=='Sparse'"
+            )
+        if self.target_type != "Structure":
+            raise NotImplementedError(
+                "fused prediction only implemented for target_type=='Structure'"
+            )
+        rep = self.kernel._representation
+        energies, gradients, neg_stress, _ = compute_sparse_kernel_predictions(
+            rep,
+            self.kernel._kernel,
+            managers.managers,
+            self.X_train._sparse_points,
+            self.weights.reshape((1, -1)),
+            compute_stress,
+        )
+        Y0 = self._get_property_baseline(managers)
+        forces, stress = -gradients, -neg_stress
+        if self.baseline is not None:
+            # the energies of the baseline are already in Y0
+            _, baseline_forces, baseline_stress = self.baseline.compute(
+                managers, compute_stress
+            )
+            forces += baseline_forces
+            stress += baseline_stress
+        return Y0 + energies.reshape((-1)), forces, stress
+
     def get_weights(self):
         return self.weights
 
+    def get_timings(self):
+        """Return the built-in timers and counters of the kernels and of the
+        predictions, aggregated over all the calls since the last
+        rascal.utils.reset_timings().
+
+        See rascal.utils.get_timings for the format of the report.
+        """
+        return get_timings(["SparseKernel", "compute_sparse_kernel"])
+
     def _get_init_params(self):
         init_params = dict(
             weights=self.weights,
@@ -220,6 +312,7 @@ class KRR(BaseIO):
             self_contributions=self.self_contributions,
             description=self.description,
             units=self.units.copy(),
+            baseline=self.baseline,
         )
         return init_params
 
@@ -357,6 +450,8 @@ def train_gap_model(
     grad_train=None,
     lambdas=None,
     jitter=1e-8,
+    baseline=None,
+    managers=None,
 ):
     """
     Defines the procedure to train a SOAP-GAP model [1]:
@@ -428,6 +523,12 @@ def train_gap_model(
     jitter : double, optional
         small jitter for the numerical stability of solving the linear system,
         by default 1e-8
+    baseline : PairPotential, optional
+        pair potential subtracted from y_train and grad_train so that the
+        model learns the difference with it (Δ-learning), by default None
+    managers : AtomsList, optional
+        the structures of frames with their neighbour lists, needed to
+        evaluate the baseline
 
     Returns
     -------
@@ -450,6 +551,11 @@ def train_gap_model(
         for sp in frame.get_atomic_numbers():
             Y0[iframe] += self_contributions[sp]
     Y = Y - Y0
+    if baseline is not None:
+        if managers is None:
+            raise ValueError("the managers of the frames are needed for the baseline")
+        baseline_energies, baseline_forces, _ = baseline.compute(managers, False)
+        Y -= baseline_energies.reshape((-1, 1))
     delta = np.std(Y)
     # lambdas[0] is provided per atom hence the '* np.sqrt(Natoms)'
     # the first n_centers rows of KNM are expected to refer to the
@@ -460,6 +566,9 @@ def train_gap_model(
     if grad_train is not None:
         KNM[n_centers:] /= lambdas[1] / delta
         F = grad_train.reshape((-1, 1)).copy()
+        if baseline is not None:
+            # the gradients of the baseline are minus its forces
+            F += baseline_forces.reshape((-1, 1))
         F /= lambdas[1] / delta
         Y = np.vstack([Y, F])
 
@@ -468,10 +577,607 @@ def train_gap_model(
     K = KMM + np.dot(KNM.T, KNM)
     Y = np.dot(KNM.T, Y)
     weights = np.linalg.lstsq(K, Y, rcond=None)[0]
-    model = KRR(weights, kernel, X_sparse, self_contributions)
+    model = KRR(weights, kernel, X_sparse, self_contributions, baseline=baseline)
 
     # avoid memory clogging
     del K, KMM
     K, KMM = [], []
 
     return model
+
+
+class GAPHyperparameterScan:
+    r"""Scan the regularisation and the kernel exponent zeta of a GAP model
+    (see :meth:`train_gap_model`) without recomputing the kernels.
+
+    The linear kernel between the features and the sparse points, and the
+    contraction of the feature gradients with the sparse points, are computed
+    once and shared by all the exponents in zetas. The training problem of
+    :meth:`train_gap_model` is then reduced, for a given zeta and ratio
+    lambdas[1] / lambdas[0], to a diagonal form with a one-time
+    eigendecomposition
+
+    .. math::
+        P^T K_{MM} P = I, \quad P^T K_{MN} \Lambda^{-2} K_{NM} P = s D,
+
+    where :math:`s = (\sigma_{\bm{y}} / lambdas[0])^2`. The weights for any
+    value of lambdas[0] follow in :math:`O(M^2)` as
+
+    .. math::
+        \bm{\alpha} = P (I + s D)^{-1} s P^T K_{MN} \Lambda_0^{-2} \bm{y},
+
+    so that the evaluation of many regularisations, including their k-fold
+    cross-validation errors, costs about as much as a single training.
+
+    Parameters
+    ----------
+    kernel : Kernel
+        SparseKernel of type GAP with target_type 'Structure'
+    frames : list(ase.Atoms)
+        Training structures
+    managers : AtomsList
+        the structures of frames with their features and, when grad_train
+        is given, the gradients of the features
+    X_sparse : SparsePoints
+        basis samples to use in the model's interpolation
+    y_train : np.array
+        reference property
+    self_contributions : dictionary
+        map atomic number to the property baseline, see
+        :meth:`train_gap_model`
+    grad_train : np.array, optional
+        derivatives of y_train w.r.t. to the atomic motion, e.g.
+        minus interatomic forces, by default None
+    zetas : list(int), optional
+        exponents of the kernels to scan, by default the zeta of kernel
+    jitter : double, optional
+        small jitter added to the diagonal of KMM, by default 1e-8. Its
+        eigenvalues below the numerical precision are discarded.
+    baseline : PairPotential, optional
+        pair potential subtracted from y_train and grad_train so that the
+        models learn the difference with it (Δ-learning), by default None
+
+    Notes
+    -----
+    The kernels of all the zetas are kept in memory, i.e.
+    len(zetas) * (n_structures + 3 * n_atoms) * n_sparse doubles when
+    training with gradients.
+    """
+
+    def __init__(
+        self,
+        kernel,
+        frames,
+        managers,
+        X_sparse,
+        y_train,
+        self_contributions,
+        grad_train=None,
+        zetas=None,
+        jitter=1e-8,
+        baseline=None,
+    ):
+        if kernel.kernel_type != "Sparse" or kernel.name != "GAP":
+            raise NotImplementedError(
+                "the scan is only implemented for the sparse GAP kernel"
+            )
+        if kernel.target_type != "Structure":
+            raise NotImplementedError(
+                "the scan is only implemented for target_type=='Structure'"
+            )
+        if zetas is None:
+            zetas = [kernel._kwargs["zeta"]]
+        for zeta in zetas:
+            if not (isinstance(zeta, int) and zeta > 0):
+                raise ValueError("The given zetas have to be positive integers.")
+        self.kernel = kernel
+        self.X_sparse = X_sparse
+        self.self_contributions = self_contributions
+        self.baseline = baseline
+        self.jitter = jitter
+        self.zetas = list(zetas)
+
+        rep = kernel._representation
+        sparse_points = X_sparse._sparse_points
+        KNMs = kernel._kernel.compute_for_zetas(
+            rep, managers.managers, sparse_points, self.zetas
+        )
+        KMMs = kernel._kernel.compute_for_zetas(sparse_points, self.zetas)
+        if grad_train is None:
+            KNM_ders = [None] * len(self.zetas)
+        else:
+            KNM_ders = kernel._kernel.compute_derivative_for_zetas(
+                rep, managers.managers, sparse_points, False, self.zetas
+            )
+        self._kernels = {
+            zeta: (KMM, KNM, KNM_der)
+            for zeta, KMM, KNM, KNM_der in zip(self.zetas, KMMs, KNMs, KNM_ders)
+        }
+
+        self.n_atoms = np.array([len(frame) for frame in frames])
+        Y0 = np.zeros(len(frames))
+        for iframe, frame in enumerate(frames):
+            for sp in frame.get_atomic_numbers():
+                Y0[iframe] += self_contributions[sp]
+        self._y = y_train.reshape((-1)) - Y0
+        if baseline is not None:
+            baseline_energies, baseline_forces, _ = baseline.compute(managers, False)
+            self._y -= baseline_energies.reshape((-1))
+        self._delta = np.std(self._y)
+        if grad_train is None:
+            self._grad = None
+        else:
+            self._grad = grad_train.reshape((-1)).copy()
+            if baseline is not None:
+                # the gradients of the baseline are minus its forces
+                self._grad += baseline_forces.reshape((-1))
+        # first row of the gradients of each structure
+        self._grad_offsets = np.concatenate([[0], np.cumsum(3 * self.n_atoms)])
+
+        # caches of the decompositions of the full training set
+        self._projections = {}
+        self._full_equations = {}
+        self._full_decompositions = {}
+
+    def get_model(self, lambdas, zeta=None):
+        """Train the model of :meth:`train_gap_model` for the regularisation
+        lambdas and the exponent zeta. The first call for a given zeta and
+        ratio lambdas[1] / lambdas[0] decomposes the problem, the subsequent
+        ones cost O(M^2).
+
+        Parameters
+        ----------
+        lambdas : list/tuple
+            regularisation parameters, i.e. lambdas[0] -> property
+            and lambdas[1] -> gradients of the property
+        zeta : int, optional
+            one of the zetas of the scan, by default the first one
+
+        Returns
+        -------
+        KRR
+            the trained model
+        """
+        zeta = self._check_zeta(zeta)
+        ratio = self._get_ratio(lambdas)
+        key = (zeta, ratio)
+        if key not in self._full_decompositions:
+            if zeta not in self._full_equations:
+                self._full_equations[zeta] = self._get_normal_equations(
+                    zeta, np.arange(len(self._y))
+                )
+            self._full_decompositions[key] = self._decompose(
+                zeta, self._full_equations[zeta], ratio
+            )
+        P, eigenvalues, g = self._full_decompositions[key]
+        weights = np.dot(P, self._solve(eigenvalues, g, lambdas[0]))
+
+        kernel_params = self.kernel._get_init_params()
+        kernel_params["zeta"] = zeta
+        kernel = self.kernel.__class__(**kernel_params)
+        return KRR(
+            weights.reshape((-1, 1)),
+            kernel,
+            self.X_sparse,
+            self.self_contributions,
+            baseline=self.baseline,
+        )
+
+    def cross_validation(self, lambdas, zetas=None, n_folds=5, shuffle=True, seed=None):
+        """Compute the k-fold cross-validation errors of the models for each
+        regularisation in lambdas and each exponent in zetas.
+
+        The structures are split like :meth:`AtomsList.get_folds` with the
+        same arguments. The problem is decomposed once per fold, zeta and
+        ratio lambdas[1] / lambdas[0] so scanning lambdas[0] is cheap.
+
+        Parameters
+        ----------
+        lambdas : np.array
+            regularisations to evaluate, of shape (n_lambdas, 2) or
+            (n_lambdas, 1) when training without gradients
+        zetas : list(int), optional
+            exponents to evaluate, by default all the zetas of the scan
+        n_folds : int
+            number of folds
+        shuffle : bool
+            shuffle the structures before splitting them
+        seed : int
+            seed of the shuffling
+
+        Returns
+        -------
+        dict
+            'zetas' and 'lambdas' that have been evaluated, 'energy_rmse'
+            the root mean square error of the property and 'forces_rmse'
+            the one of its gradients (None without gradients), both of shape
+            (n_zetas, n_lambdas)
+        """
+        if not 2 <= n_folds <= len(self._y):
+            raise ValueError(
+                "n_folds={} should be between 2 and the number of structures".format(
+                    n_folds
+                )
+            )
+        lambdas = np.atleast_2d(np.asarray(lambdas, dtype=float))
+        if zetas is None:
+            zetas = self.zetas
+        zetas = [self._check_zeta(zeta) for zeta in zetas]
+        ratios = np.array([self._get_ratio(lambda_) for lambda_ in lambdas])
+        unique_ratios, ratio_ids = np.unique(ratios, return_inverse=True)
+
+        ids = np.arange(len(self._y))
+        if shuffle:
+            np.random.RandomState(seed).shuffle(ids)
+        folds = [np.sort(fold) for fold in np.array_split(ids, n_folds)]
+
+        energy_se = np.zeros((len(zetas), len(lambdas)))
+        forces_se = np.zeros((len(zetas), len(lambdas)))
+        for i_zeta, zeta in enumerate(zetas):
+            _, KNM, KNM_der = self._kernels[zeta]
+            fold_equations = [self._get_normal_equations(zeta, fold) for fold in folds]
+            full_equations = [
+                None if parts[0] is None else sum(parts)
+                for parts in zip(*fold_equations)
+            ]
+            for validation_ids, validation_equations in zip(folds, fold_equations):
+                train_equations = [
+                    None if full is None else full - part
+                    for full, part in zip(full_equations, validation_equations)
+                ]
+                KE_val = KNM[validation_ids]
+                y_val = self._y[validation_ids]
+                if KNM_der is not None:
+                    grad_rows = self._get_grad_rows(validation_ids)
+                    KF_val = KNM_der[grad_rows]
+                    grad_val = self._grad[grad_rows]
+                for i_ratio, ratio in enumerate(unique_ratios):
+                    P, eigenvalues, g = self._decompose(zeta, train_equations, ratio)
+                    # project the validation kernels once for all the lambdas
+                    KE_val_P = np.dot(KE_val, P)
+                    if KNM_der is not None:
+                        KF_val_P = np.dot(KF_val, P)
+                    for i_lambda in np.where(ratio_ids == i_ratio)[0]:
+                        z = self._solve(eigenvalues, g, lambdas[i_lambda, 0])
+                        residuals = y_val - np.dot(KE_val_P, z)
+                        energy_se[i_zeta, i_lambda] += np.sum(residuals ** 2)
+                        if KNM_der is not None:
+                            residuals = grad_val - np.dot(KF_val_P, z)
+                            forces_se[i_zeta, i_lambda] += np.sum(residuals ** 2)
+
+        errors = dict(
+            zetas=zetas,
+            lambdas=lambdas,
+            energy_rmse=np.sqrt(energy_se / len(self._y)),
+            forces_rmse=None,
+        )
+        if self._grad is not None:
+            errors["forces_rmse"] = np.sqrt(forces_se / len(self._grad))
+        return errors
+
+    def _check_zeta(self, zeta):
+        if zeta is None:
+            return self.zetas[0]
+        if zeta not in self._kernels:
+            raise ValueError(
+                "zeta={} is not one of the zetas of the scan {}".format(
+                    zeta, self.zetas
+                )
+            )
+        return zeta
+
+    def _get_ratio(self, lambdas):
+        """ratio of the regularisations of the gradients and of the property"""
+        if self._grad is None:
+            return 0.0
+        return float(lambdas[1]) / float(lambdas[0])
+
+    def _get_grad_rows(self, ids):
+        return np.concatenate(
+            [
+                np.arange(self._grad_offsets[idx], self._grad_offsets[idx + 1])
+                for idx in ids
+            ]
+        )
+
+    def _get_normal_equations(self, zeta, ids):
+        """Contributions of the structures ids to K_MN Λ^-2 K_NM and
+        K_MN Λ^-2 y for the property and for its gradients, with unit
+        regularisations, i.e. lambdas[0] = delta and lambdas[1] = delta."""
+        _, KNM, KNM_der = self._kernels[zeta]
+        inv_n_atoms = 1.0 / self.n_atoms[ids]
+        KE = KNM[ids]
+        BE = np.dot(KE.T, KE * inv_n_atoms[:, None])
+        cE = np.dot(KE.T, self._y[ids] * inv_n_atoms)
+        if KNM_der is None:
+            return BE, cE, None, None
+        grad_rows = self._get_grad_rows(ids)
+        KF = KNM_der[grad_rows]
+        return BE, cE, np.dot(KF.T, KF), np.dot(KF.T, self._grad[grad_rows])
+
+    def _decompose(self, zeta, equations, ratio):
+        """Simultaneous diagonalisation of KMM and of the data term of the
+        normal equations for a given ratio lambdas[1] / lambdas[0]"""
+        if zeta not in self._projections:
+            KMM = self._kernels[zeta][0]
+            s, U = np.linalg.eigh(KMM + self.jitter * np.eye(KMM.shape[0]))
+            keep = s > s[-1] * KMM.shape[0] * np.finfo(float).eps
+            self._projections[zeta] = U[:, keep] / np.sqrt(s[keep])
+        P0 = self._projections[zeta]
+        BE, cE, BF, cF = equations
+        B, c = BE, cE
+        if BF is not None:
+            B = B + BF / ratio ** 2
+            c = c + cF / ratio ** 2
+        eigenvalues, V = np.linalg.eigh(np.dot(P0.T, np.dot(B, P0)))
+        P = np.dot(P0, V)
+        return P, eigenvalues, np.dot(P.T, c)
+
+    def _solve(self, eigenvalues, g, lambda_):
+        """Coefficients of the weights in the basis of the decomposition"""
+        s = (self._delta / lambda_) ** 2
+        return g * s / (1.0 + s * eigenvalues)
+
+
+class IncrementalGAPTrainer:
+    r"""Train the GAP model of :meth:`train_gap_model` incrementally, e.g. in
+    an active learning loop, without recomputing the kernels of the data that
+    has already been added nor factorising the normal equations again.
+
+    The trainer keeps the Cholesky factor of the normal equations
+
+    .. math::
+        K = K_{MM} + K_{MN} \Lambda^{-2} K_{NM} = L L^T
+
+    and the accumulated :math:`K_{MN} \Lambda^{-2} \bm{y}`. Adding k rows of
+    :math:`K_{NM}`, i.e. new structures, is a rank k update of :math:`L` in
+    :math:`O(k M^2)` and adding m sparse points extends :math:`L` in
+    :math:`O(m M^2)` plus the kernels of the m points with the data. The
+    weights of the model are then obtained with two triangular solves in
+    :math:`O(M^2)`.
+
+    Parameters
+    ----------
+    kernel : Kernel
+        SparseKernel of type GAP with target_type 'Structure'
+    X_sparse : SparsePoints
+        initial basis samples of the model. It is copied, and the sparse
+        points of the trainer are copied again only when new ones are added
+        after get_model, so that the models that have already been returned
+        keep their sparse points.
+    self_contributions : dictionary
+        map atomic number to the property baseline, see
+        :meth:`train_gap_model`
+    lambdas : list/tuple
+        regularisation parameters, i.e. lambdas[0] -> property
+        and lambdas[1] -> gradients of the property
+    delta : double, optional
+        scale of the regularisation, i.e. :math:`\sigma_{\bm{y}}` in
+        :meth:`train_gap_model`. It is kept fixed while data is added so
+        that the accumulated normal equations remain valid. By default the
+        standard deviation of the property in the first call to
+        add_structures.
+    jitter : double, optional
+        small jitter added to the diagonal of KMM, by default 1e-8
+    baseline : PairPotential, optional
+        pair potential subtracted from the targets so that the model learns
+        the difference with it (Δ-learning), by default None
+
+    Notes
+    -----
+    The scaled kernels of the data are kept in memory to compute the new
+    columns of the normal equations when sparse points are added, i.e. the
+    same memory as the KNM given to :meth:`train_gap_model`.
+    """
+
+    def __init__(
+        self,
+        kernel,
+        X_sparse,
+        self_contributions,
+        lambdas,
+        delta=None,
+        jitter=1e-8,
+        baseline=None,
+    ):
+        if kernel.kernel_type != "Sparse" or kernel.name != "GAP":
+            raise NotImplementedError(
+                "the incremental training is only implemented for the sparse GAP kernel"
+            )
+        if kernel.target_type != "Structure":
+            raise NotImplementedError(
+                "the incremental training is only implemented for target_type=='Structure'"
+            )
+        self.kernel = kernel
+        self.X_sparse = copy.deepcopy(X_sparse)
+        # whether a model returned by get_model shares self.X_sparse
+        self._X_sparse_is_shared = False
+        self.self_contributions = self_contributions
+        self.lambdas = lambdas
+        self.delta = delta
+        self.jitter = jitter
+        self.baseline = baseline
+
+        KMM = kernel(self.X_sparse)
+        KMM[np.diag_indices_from(KMM)] += jitter
+        self._cholesky = UpdatableCholesky(KMM)
+        self._rhs = np.zeros(KMM.shape[0])
+        # the columns of the normal equations are the sparse points in the
+        # order they have been added, they are mapped to the columns of
+        # X_sparse, sorted by species, with their species and their rank
+        # among the points of the same species
+        self._species = np.asarray(self.X_sparse.get_species(), dtype=int)
+        self._ranks = self._get_ranks(self._species, {})
+        # managers, row scaling, scaled KNM and targets of each batch of data
+        self._batches = []
+
+    def add_structures(self, frames, managers, y_train, grad_train=None):
+        """Add training structures to the model, the cost scales with their
+        number and not with the data that has already been added.
+
+        Parameters
+        ----------
+        frames : list(ase.Atoms)
+            new training structures
+        managers : AtomsList
+            the structures of frames with their features and, when grad_train
+            is given, the gradients of the features
+        y_train : np.array
+            reference property of the new structures
+        grad_train : np.array, optional
+            derivatives of y_train w.r.t. to the atomic motion, e.g.
+            minus interatomic forces, by default None
+        """
+        n_atoms = np.array([len(frame) for frame in frames])
+        Y = y_train.reshape((-1)).astype(float)
+        for iframe, frame in enumerate(frames):
+            for sp in frame.get_atomic_numbers():
+                Y[iframe] -= self.self_contributions[sp]
+        if self.baseline is not None:
+            baseline_energies, baseline_forces, _ = self.baseline.compute(
+                managers, False
+            )
+            Y -= baseline_energies.reshape((-1))
+        if self.delta is None:
+            self.delta = np.std(Y)
+            if self.delta == 0:
+                raise ValueError(
+                    "delta cannot be estimated from a property without variance"
+                )
+
+        # lambdas[0] is provided per atom hence the '* np.sqrt(n_atoms)'
+        scales = [self.delta / (self.lambdas[0] * np.sqrt(n_atoms))]
+        KNM = [self.kernel(managers, self.X_sparse)]
+        targets = [Y]
+        if grad_train is not None:
+            F = grad_train.reshape((-1)).astype(float)
+            if self.baseline is not None:
+                # the gradients of the baseline are minus its forces
+                F += baseline_forces.reshape((-1))
+            scales.append(np.full(F.shape[0], self.delta / self.lambdas[1]))
+            KNM.append(self.kernel(managers, self.X_sparse, grad=(True, False)))
+            targets.append(F)
+        scales = np.concatenate(scales)
+        KNM = np.vstack(KNM)[:, self._get_columns()] * scales[:, None]
+        Y = np.concatenate(targets) * scales
+
+        self._cholesky.add_rows(KNM)
+        self._rhs += np.dot(KNM.T, Y)
+        self._batches.append(
+            dict(
+                managers=managers,
+                with_gradients=grad_train is not None,
+                scales=scales,
+                KNM=KNM,
+                targets=Y,
+            )
+        )
+
+    def add_sparse_points(self, managers, selected_ids):
+        """Add sparse points to the model, see :meth:`SparsePoints.extend`.
+        The cost scales with the number of new points times the size of the
+        model and of the data, the kernels between the data and the current
+        sparse points are not recomputed.
+
+        Parameters
+        ----------
+        managers : AtomsList
+            structures with the features of the new sparse points
+        selected_ids : list(list(int))
+            indices of the new sparse points within their structure
+        """
+        new_points = SparsePoints(self.X_sparse.representation)
+        new_points.extend(managers, selected_ids)
+        if new_points.size() == 0:
+            return
+
+        # the new points are sorted by species, keeping the order of
+        # selection within a species, like in the sparse points
+        selected_rows, selected_species = [], []
+        i_row = 0
+        for manager, ids in zip(managers, selected_ids):
+            species = [center.atom_type for center in manager]
+            selected_rows.extend([i_row + idx for idx in ids])
+            selected_species.extend([species[idx] for idx in ids])
+            i_row += len(species)
+        order = np.argsort(selected_species, kind="stable")
+        selected_rows = np.asarray(selected_rows, dtype=int)[order]
+
+        # kernels between the sparse points
+        atom_kernel_params = self.kernel._get_init_params()
+        atom_kernel_params["target_type"] = "Atom"
+        atom_kernel = self.kernel.__class__(**atom_kernel_params)
+        KMM_new = atom_kernel(managers, self.X_sparse)[selected_rows]
+        B = KMM_new[:, self._get_columns()].T
+        C = self.kernel(new_points)
+        C[np.diag_indices_from(C)] += self.jitter
+
+        # data terms of the new columns
+        rhs = np.zeros(new_points.size())
+        for batch in self._batches:
+            KNM_new = [self.kernel(batch["managers"], new_points)]
+            if batch["with_gradients"]:
+                KNM_new.append(
+                    self.kernel(batch["managers"], new_points, grad=(True, False))
+                )
+            KNM_new = np.vstack(KNM_new) * batch["scales"][:, None]
+            B += np.dot(batch["KNM"].T, KNM_new)
+            C += np.dot(KNM_new.T, KNM_new)
+            rhs += np.dot(KNM_new.T, batch["targets"])
+            batch["KNM"] = np.hstack([batch["KNM"], KNM_new])
+
+        self._cholesky.extend(B, C)
+        self._rhs = np.concatenate([self._rhs, rhs])
+        new_species = np.asarray(new_points.get_species(), dtype=int)
+        counts = {sp: np.sum(self._species == sp) for sp in np.unique(self._species)}
+        self._ranks = np.concatenate(
+            [self._ranks, self._get_ranks(new_species, counts)]
+        )
+        self._species = np.concatenate([self._species, new_species])
+        # the models that have been returned keep their sparse points
+        if self._X_sparse_is_shared:
+            self.X_sparse = copy.deepcopy(self.X_sparse)
+            self._X_sparse_is_shared = False
+        self.X_sparse.extend(managers, selected_ids)
+
+    def get_model(self):
+        """Solve the normal equations accumulated so far in O(M^2)
+
+        Returns
+        -------
+        KRR
+            the model trained on all the structures and sparse points that
+            have been added
+        """
+        weights = np.zeros((self._rhs.shape[0], 1))
+        weights[self._get_columns()] = self._cholesky.solve(self._rhs.reshape((-1, 1)))
+        self._X_sparse_is_shared = True
+        return KRR(
+            weights,
+            self.kernel,
+            self.X_sparse,
+            self.self_contributions,
+            baseline=self.baseline,
+        )
+
+    @staticmethod
+    def _get_ranks(species, counts):
+        """rank of the points among the ones of the same species, counting
+        from the number of points already in counts"""
+        counts = dict(counts)
+        ranks = np.zeros(len(species), dtype=int)
+        for i_point, sp in enumerate(species):
+            ranks[i_point] = counts.get(sp, 0)
+            counts[sp] = ranks[i_point] + 1
+        return ranks
+
+    def _get_columns(self):
+        """columns of X_sparse of the columns of the normal equations"""
+        offsets, offset = {}, 0
+        for sp in np.unique(self._species):
+            offsets[sp] = offset
+            offset += np.sum(self._species == sp)
+        return np.array(
+            [offsets[sp] + rank for sp, rank in zip(self._species, self._ranks)],
+            dtype=int,
+        )
@@ -0,0 +1,106 @@
+"""Tabulated pair potentials, e.g. ZBL, Lennard-Jones or Morse baselines
+
+Public classes:
+    PairPotential   Cubic spline pair potential evaluated on the neighbour
+                    lists of the structures
+"""
+from ..lib._rascal.models import PairPotential as PairPotentialcpp
+from ..neighbourlist import AtomsList
+from ..utils import BaseIO
+
+import numpy as np
+
+
+class PairPotential(BaseIO):
+    """Pair potential tabulated with a cubic spline for each pair of species.
+
+    The potential is evaluated on the neighbour lists of the structures, so
+    when it is used as the baseline of a model (see KRR) it costs a single
+    pass over the pairs already built for the representation instead of a
+    second neighbour search. The cutoff of the neighbour lists must be at
+    least as large as the largest tabulated distance.
+
+    Parameters
+    ----------
+    pairs : list(dict)
+        one table per pair of species of the form
+        dict(species=(1, 8), grid=[r_0, ..., r_n], values=[V(r_0), ..., V(r_n)])
+        with a uniform grid. An optional derivatives=[V'(r_0), V'(r_n)] entry
+        switches the spline to clamped boundary conditions. The potential is
+        zero beyond r_n so the tables should go smoothly to zero at the end
+        of the grid and the pairs of species that are not listed do not
+        interact.
+    """
+
+    def __init__(self, pairs):
+        self.pairs = []
+        for pair in pairs:
+            pair = dict(pair)
+            pair["species"] = [int(sp) for sp in pair["species"]]
+            pair["grid"] = np.asarray(pair["grid"], dtype=float).tolist()
+            pair["values"] = np.asarray(pair["values"], dtype=float).tolist()
+            if "derivatives" in pair:
+                pair["derivatives"] = [float(d) for d in pair["derivatives"]]
+            self.pairs.append(pair)
+        self._pair_potential = PairPotentialcpp(dict(pairs=self.pairs))
+
+    @classmethod
+    def from_functions(cls, functions, r_min, cutoff, n_grid=1000):
+        """Tabulate analytical pair potentials
+
+        Parameters
+        ----------
+        functions : dict
+            maps a pair of atomic numbers, e.g. (1, 8), to a function of the
+            distance returning the energy of the pair
+        r_min : float
+            shortest tabulated distance
+        cutoff : float
+            largest tabulated distance
+        n_grid : int, optional
+            number of points of the tables, by default 1000
+        """
+        grid = np.linspace(r_min, cutoff, n_grid)
+        pairs = []
+        for species, function in functions.items():
+            values = np.array([function(r) for r in grid])
+            pairs.append(dict(species=species, grid=grid, values=values))
+        return cls(pairs)
+
+    def get_cutoff(self):
+        return self._pair_potential.get_cutoff()
+
+    def compute(self, managers, compute_stress=True):
+        """Compute the energies, forces and stress of the structures
+
+        Parameters
+        ----------
+        managers : AtomsList
+            list of atomic structures, the cutoff of their neighbour lists
+            should be at least the one of the potential
+        compute_stress : bool, optional
+            compute the stress, by default True. The stress is returned
+            using the Voigt order: xx, yy, zz, yz, xz, xy.
+
+        Returns
+        -------
+        tuple(np.array)
+            energies of shape (n_structures,), forces of shape (n_atoms, 3)
+            and stress of shape (n_structures, 6) (zeros if compute_stress is
+            False)
+        """
+        if isinstance(managers, AtomsList):
+            managers = managers.managers
+        energies, gradients, neg_stress = self._pair_potential.compute(
+            managers, compute_stress
+        )
+        return energies.reshape((-1)), -gradients, -neg_stress
+
+    def _get_init_params(self):
+        return dict(pairs=self.pairs)
+
+    def _set_data(self, data):
+        super()._set_data(data)
+
+    def _get_data(self):
+        return super()._get_data()
@@ -50,6 +50,8 @@ class SparsePoints(BaseIO):
             self._sparse_points = _sparse_points[
                 "SparsePointsBlockSparse_SphericalInvariants"
             ]()
+        elif "ThreeBody" in str(representation):
+            self._sparse_points = _sparse_points["SparsePointsBlockSparse_ThreeBody"]()
         else:
             raise ValueError("No pseudo point is appropiate for " + str(representation))
 
@@ -88,3 +90,8 @@ class SparsePoints(BaseIO):
 
     def get_features(self):
         return self._sparse_points.get_features()
+
+    def get_species(self):
+        """Atomic number of the central atom of each sparse point, in the
+        order of the columns of the kernels"""
+        return self._sparse_points.get_species()
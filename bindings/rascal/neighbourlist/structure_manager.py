@@ -84,6 +84,105 @@ class AtomsList(object):
                 )
             self.managers = managers
 
+    @classmethod
+    def from_arrays(
+        cls,
+        positions,
+        numbers,
+        cells,
+        pbcs,
+        offsets,
+        nl_options,
+        center_atoms_mask=None,
+        wrap_pos=True,
+        n_threads=1,
+    ):
+        """Build an AtomsList from the concatenated arrays of many atomic
+        structures. All the managers are built in C++ in a single call, which
+        avoids the per structure overhead of converting ase.Atoms objects.
+
+        Parameters
+        -------
+        positions : np.array (n_atoms, 3)
+            positions of the atoms of all the structures, one after the other
+        numbers : np.array (n_atoms,)
+            atomic numbers of the atoms
+        cells : np.array (n_structures, 3, 3)
+            cell of each structure with the lattice vectors as rows, like in
+            ase. The cell of a non periodic structure can be filled with
+            zeros, it is then replaced by a bounding box of its atoms.
+        pbcs : np.array (n_structures, 3)
+            periodicity of each structure
+        offsets : np.array (n_structures + 1,)
+            index of the first atom of each structure followed by n_atoms,
+            i.e. the atoms of structure i are positions[offsets[i]:offsets[i+1]]
+        nl_options : dict
+            Parameters for each layer of the wrapped structure manager, see
+            __init__
+        center_atoms_mask : np.array (n_atoms,)
+            which atoms are centers, all of them by default
+        wrap_pos : bool
+            fold the atoms inside the cell along the periodic directions
+        n_threads : int
+            number of threads used to build the managers
+
+        Returns
+        -------
+        atoms_list : AtomsList
+            the frames of this AtomsList are None
+        """
+        positions = np.asarray(positions, dtype=np.float64)
+        numbers = np.asarray(numbers, dtype=np.int32).reshape(-1)
+        cells = np.asarray(cells, dtype=np.float64).reshape(-1, 3)
+        pbcs = np.asarray(pbcs, dtype=np.int32).reshape(-1, 3)
+        offsets = np.asarray(offsets, dtype=np.int32).reshape(-1)
+        if center_atoms_mask is None:
+            center_atoms_mask = np.ones(len(numbers), dtype=bool)
+        center_atoms_mask = np.asarray(center_atoms_mask, dtype=bool).reshape(-1)
+
+        managers = StructureCollectionFactory(nl_options)
+        # the transposed C ordered arrays have the column major layout
+        # expected on the C++ side so they are not copied
+        managers.add_structures(
+            positions.T,
+            numbers,
+            cells.T,
+            pbcs.T,
+            center_atoms_mask,
+            offsets,
+            wrap_positions=wrap_pos,
+            n_threads=n_threads,
+        )
+        return cls(None, nl_options, managers=managers)
+
+    def update_structures(self, positions, cells, wrap_pos=True, n_threads=1):
+        """Update in place the structures of this AtomsList, e.g. with the
+        next frames of a trajectory with a fixed composition. The atom types,
+        periodicity and center masks are kept and the managers are reused
+        instead of being built again, so a long trajectory can be processed
+        in chunks of the size of this AtomsList.
+
+        Parameters
+        -------
+        positions : np.array (n_structures, n_atoms, 3)
+            new positions of the atoms of each structure
+        cells : np.array (n_structures, 3, 3) or (3, 3)
+            new cells with the lattice vectors as rows, like in ase, a single
+            cell is used for all the structures
+        wrap_pos : bool
+            fold the atoms inside the cell along the periodic directions
+        n_threads : int
+            number of threads used to update the managers
+        """
+        positions = np.asarray(positions, dtype=np.float64)
+        positions = positions.reshape(positions.shape[0], -1)
+        cells = np.asarray(cells, dtype=np.float64).reshape(-1, 9)
+        self.managers.update_structures(
+            positions, cells, wrap_positions=wrap_pos, n_threads=n_threads
+        )
+        # the frames do not describe the structures anymore
+        self._frames = None
+
     def __iter__(self):
         return self.managers.__iter__()
 
@@ -97,6 +196,10 @@ class AtomsList(object):
         """Build a new AtomsList with only the selected atomic structures and
         corresponding neighborlist and representations (if present).
 
+        The structure managers are shared with this AtomsList, not copied, so
+        building a subset is cheap and the representations that are already
+        computed can be used from it without being computed again.
+
         Parameters
         -------
         selected_ids : list/array of indices
@@ -107,12 +210,62 @@ class AtomsList(object):
         """
         selected_ids = list(map(int, selected_ids))
         new_managers = self.managers.get_subset(selected_ids)
-        new_atom_list = AtomsList(
-            [self._frames[idx] for idx in selected_ids],
-            self.nl_options,
-            managers=new_managers,
-        )
-        return new_atom_list
+        return self._make_view(selected_ids, new_managers)
+
+    def get_complement(self, selected_ids):
+        """Build a new AtomsList with the atomic structures that are not
+        selected, sharing the structure managers like get_subset.
+
+        Parameters
+        -------
+        selected_ids : list/array of indices
+
+        Returns
+        -------
+        new_atom_list : AtomsList
+        """
+        selected_ids = list(map(int, selected_ids))
+        new_managers = self.managers.get_complement(selected_ids)
+        selected = set(selected_ids)
+        complement_ids = [idx for idx in range(len(self)) if idx not in selected]
+        return self._make_view(complement_ids, new_managers)
+
+    def get_folds(self, n_folds, shuffle=True, seed=None):
+        """Split the structures into n_folds folds for a cross-validation.
+        The AtomsList of the folds share the structure managers of this one,
+        so the representations are computed only once for all the folds.
+
+        Parameters
+        -------
+        n_folds : int
+            number of folds
+        shuffle : bool
+            shuffle the structures before splitting them
+        seed : int
+            seed of the shuffling
+
+        Returns
+        -------
+        generator of (train, validation, validation_ids) with train and
+        validation AtomsList and the indices of the validation structures
+        """
+        ids = np.arange(len(self))
+        if shuffle:
+            np.random.RandomState(seed).shuffle(ids)
+        for validation_ids in np.array_split(ids, n_folds):
+            validation_ids = np.sort(validation_ids)
+            yield (
+                self.get_complement(validation_ids),
+                self.get_subset(validation_ids),
+                validation_ids,
+            )
+
+    def _make_view(self, selected_ids, managers):
+        if self._frames is None:
+            new_frames = None
+        else:
+            new_frames = [self._frames[idx] for idx in selected_ids]
+        return AtomsList(new_frames, self.nl_options, managers=managers)
 
     def get_features(self, calculator, species=None):
         """
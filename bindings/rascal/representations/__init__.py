@@ -2,3 +2,4 @@ from .coulomb_matrix import SortedCoulombMatrix
 from .spherical_expansion import SphericalExpansion
 from .spherical_invariants import SphericalInvariants
 from .spherical_covariants import SphericalCovariants
+from .three_body import ThreeBody
@@ -11,6 +11,7 @@ _representations_list = [
     "sphericalexpansion",
     "sphericalinvariants",
     "sphericalcovariants",
+    "threebody",
 ]
 _representations = {}
 for k, v in representation_calculators.__dict__.items():
@@ -27,6 +27,9 @@ class SortedCoulombMatrix(BaseIO):
     size : int
         Larger or equal to the maximum number of neighbour an atom has in the structure.
 
+    n_threads : int
+        Number of threads computing the centers of a structure.
+
     Methods
     -------
     transform(frames)
@@ -46,6 +49,7 @@ class SortedCoulombMatrix(BaseIO):
         central_decay=-1,
         interaction_cutoff=10,
         interaction_decay=-1,
+        n_threads=1,
     ):
         self.name = "sortedcoulomb"
         self.size = size
@@ -57,6 +61,7 @@ class SortedCoulombMatrix(BaseIO):
             interaction_cutoff=interaction_cutoff,
             interaction_decay=interaction_decay,
             size=int(size),
+            n_threads=int(n_threads),
         )
 
         self.nl_options = [
@@ -78,6 +83,7 @@ class SortedCoulombMatrix(BaseIO):
             "interaction_cutoff",
             "interaction_decay",
             "size",
+            "n_threads",
         }
         hypers_clean = {key: hypers[key] for key in hypers if key in allowed_keys}
         self.hypers.update(hypers_clean)
@@ -126,6 +132,7 @@ class SortedCoulombMatrix(BaseIO):
             central_decay=self.hypers["central_decay"],
             interaction_cutoff=self.hypers["interaction_cutoff"],
             interaction_decay=self.hypers["interaction_decay"],
+            n_threads=self.hypers["n_threads"],
         )
         return init_params
 
@@ -3,7 +3,7 @@ import json
 from .base import CalculatorFactory, cutoff_function_dict_switch
 from ..neighbourlist import AtomsList
 import numpy as np
-from ..utils import BaseIO
+from ..utils import BaseIO, get_timings
 from copy import deepcopy
 
 
@@ -250,6 +250,15 @@ class SphericalCovariants(BaseIO):
         self._representation.compute(frames.managers)
         return frames
 
+    def get_timings(self):
+        """Return the built-in timers and counters of the spherical covariants
+        computations (including the spherical expansion), aggregated over
+        all the calls since the last rascal.utils.reset_timings().
+
+        See rascal.utils.get_timings for the format of the report.
+        """
+        return get_timings(["SphericalCovariants", "SphericalExpansion"])
+
     def get_num_coefficients(self, n_species=1):
         """Return the number of coefficients in the representation
 
@@ -3,7 +3,7 @@ import json
 from .base import CalculatorFactory, cutoff_function_dict_switch
 from ..neighbourlist import AtomsList
 import numpy as np
-from ..utils import BaseIO
+from ..utils import BaseIO, get_timings
 from copy import deepcopy
 
 
@@ -128,6 +128,55 @@ class SphericalExpansion(BaseIO):
 
         where :code:`...` should be replaced by the desired value.
 
+    incremental_update : dict or None
+        if not None, the spherical expansion of a structure that is computed
+        again after some of its atoms moved, e.g. when the same AtomsList is
+        updated along a MD trajectory, is only recomputed for the environments
+        affected by the moved atoms. It has the form
+
+        .. code:: python
+
+            dict(displacement_threshold=...,
+                 max_moved_fraction=...,
+                 full_refresh_period=...)
+
+        where atoms displaced by less than displacement_threshold (default 0)
+        are considered fixed, a full computation is done when more than
+        max_moved_fraction (default 0.25) of the atoms moved and every
+        full_refresh_period (default 100) computations to limit the
+        accumulation of round-off errors. With compute_gradients, only the
+        gradients of the pairs involving a moved atom are recomputed, the
+        others are kept in memory (about the size of the gradients).
+        It is not used with half neighbour lists.
+
+    long_range : dict or None
+        if not None, the expansion is the long-range (LODE) projection of the
+        potential generated by the Gaussian atom density, i.e. the
+        electrostatic potential of smeared unit charges, on the same GTO
+        radial basis and spherical harmonics instead of the local atom
+        density. It is computed in reciprocal space for periodic structures
+        and has the form
+
+        .. code:: python
+
+            dict(method=...,
+                 accuracy=...,
+                 spline_order=...,
+                 mesh_oversampling=...)
+
+        where method is 'PME' (default), a particle mesh evaluation with FFTs
+        scaling as O(N log N), or 'Ewald', a direct sum over the wave
+        vectors, accuracy (default 1e-8) sets the largest wave vector and
+        spline_order (default 6) and mesh_oversampling (default 2) set the
+        mesh of 'PME'. interaction_cutoff only sets the extent of the radial
+        basis and gaussian_sigma_constant the smearing of the density. The
+        gradients are not available.
+
+    n_threads : int
+        Number of threads computing the environments of a structure. The
+        features do not depend on it. The incremental update of the
+        spherical expansion is computed with one thread.
+
     Methods
     -------
     transform(frames)
@@ -155,6 +204,9 @@ class SphericalExpansion(BaseIO):
         global_species=None,
         compute_gradients=False,
         cutoff_function_parameters=dict(),
+        incremental_update=None,
+        long_range=None,
+        n_threads=1,
     ):
         """Construct a SphericalExpansion representation
 
@@ -176,7 +228,15 @@ class SphericalExpansion(BaseIO):
             expansion_by_species_method=expansion_by_species_method,
             global_species=global_species,
             compute_gradients=compute_gradients,
+            incremental_update=incremental_update,
+            long_range=long_range,
+            n_threads=int(n_threads),
         )
+        if self.hypers["incremental_update"] is None:
+            del self.hypers["incremental_update"]
+        if self.hypers["long_range"] is None:
+            del self.hypers["long_range"]
+
         self.cutoff_function_parameters = deepcopy(cutoff_function_parameters)
         cutoff_function_parameters.update(
             interaction_cutoff=interaction_cutoff,
@@ -253,6 +313,9 @@ class SphericalExpansion(BaseIO):
             "cutoff_function_parameters",
             "expansion_by_species_method",
             "global_species",
+            "incremental_update",
+            "long_range",
+            "n_threads",
         }
         hypers_clean = {key: hypers[key] for key in hypers if key in allowed_keys}
         self.hypers.update(hypers_clean)
@@ -276,6 +339,109 @@ class SphericalExpansion(BaseIO):
         self._representation.compute(frames.managers)
         return frames
 
+    def backward(self, manager, features_gradient):
+        """Vector-Jacobian product of the spherical expansion of one structure.
+
+        Given the gradient dL/dX of a scalar L w.r.t. the features X of the
+        structure, computes the gradient of L w.r.t. the atomic positions
+        without storing the gradients of the representation (the
+        compute_gradients hyperparameter is not needed).
+
+        Parameters
+        ----------
+        manager : StructureManager
+            one element of an AtomsList built with this representation, e.g.
+            self.transform([frame])[0]
+        features_gradient : np.array of shape (n_centers, n_features)
+            dL/dX with the layout of the features of the structure alone,
+            i.e. AtomsList.get_features(self) of this structure
+
+        Returns
+        -------
+        tuple(np.array)
+            dL/dr of shape (n_centers, 3), the derivatives w.r.t. the masked
+            atoms are not reported, and the virial of shape (1, 6), i.e.
+            minus the derivative w.r.t. the strain, in Voigt order (xx, yy,
+            zz, yz, xz, xy)
+        """
+        return self._representation.backward(manager, features_gradient)
+
+    def jvp(self, manager, displacements):
+        """Jacobian-vector product of the spherical expansion of one structure.
+
+        Computes the change of the features of the structure for the
+        displacements of its atoms, i.e. sum_k dX/dr_k . displacements_k,
+        without storing the gradients of the representation.
+
+        Parameters
+        ----------
+        manager : StructureManager
+            see backward
+        displacements : np.array of shape (n_centers, 3)
+            displacements of the atoms, the masked atoms are not displaced
+
+        Returns
+        -------
+        np.array of shape (n_centers, n_features)
+            change of the features with the layout of
+            AtomsList.get_features(self) of this structure
+        """
+        return self._representation.jvp(manager, displacements)
+
+    def backward_jvp(
+        self,
+        manager,
+        features_gradient,
+        features_gradient_change,
+        displacements,
+        fd_step=1e-5,
+    ):
+        """Change of the gradient returned by backward for the
+        displacements of the atoms of one structure and the change of dL/dX,
+        the building block of Hessian-vector products.
+
+        The second derivatives of the spherical expansion are computed with
+        centered finite differences of its gradients along each pair, so the
+        result is linear in the displacements only up to a relative error of
+        about 1e-9 with the default step. Its truncation error is O(fd_step^2)
+        and its rounding error O(1e-16 / fd_step), so steps smaller than 1e-6
+        or larger than 1e-3 degrade the accuracy.
+
+        Parameters
+        ----------
+        manager : StructureManager
+            see backward
+        features_gradient : np.array of shape (n_centers, n_features)
+            dL/dX, see backward
+        features_gradient_change : np.array of shape (n_centers, n_features)
+            change of dL/dX with the same layout
+        displacements : np.array of shape (n_centers, 3)
+            see jvp
+        fd_step : float
+            step of the finite differences in Angstrom
+
+        Returns
+        -------
+        np.array of shape (n_centers, 3)
+            change of dL/dr, the virial is not reported
+        """
+        return self._representation.backward_jvp(
+            manager,
+            features_gradient,
+            features_gradient_change,
+            displacements,
+            fd_step,
+        )
+
+    def get_timings(self):
+        """Return the built-in timers and counters of the spherical expansion
+        computations, aggregated over all the calls since the last
+        rascal.utils.reset_timings().
+
+        See rascal.utils.get_timings for the format of the report.
+        """
+        return get_timings(["SphericalExpansion"])
+
     def get_num_coefficients(self, n_species=1):
         """Return the number of coefficients in the spherical expansion
 
@@ -310,6 +476,7 @@ class SphericalExpansion(BaseIO):
             expansion_by_species_method=self.hypers["expansion_by_species_method"],
             global_species=self.hypers["global_species"],
             compute_gradients=self.hypers["compute_gradients"],
+            n_threads=self.hypers["n_threads"],
             gaussian_sigma_type=gaussian_density["type"],
             gaussian_sigma_constant=gaussian_density["gaussian_sigma"]["value"],
             cutoff_function_type=cutoff_function["type"],
@@ -317,6 +484,10 @@ class SphericalExpansion(BaseIO):
             optimization_args=self.optimization_args,
             cutoff_function_parameters=self.cutoff_function_parameters,
         )
+        if "incremental_update" in self.hypers:
+            init_params["incremental_update"] = self.hypers["incremental_update"]
+        if "long_range" in self.hypers:
+            init_params["long_range"] = self.hypers["long_range"]
         return init_params
 
     def _set_data(self, data):
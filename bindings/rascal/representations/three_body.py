@@ -0,0 +1,178 @@
+from itertools import combinations_with_replacement
+
+from .base import CalculatorFactory, cutoff_function_dict_switch
+from ..neighbourlist import AtomsList
+from ..utils import BaseIO, get_timings
+
+
+class ThreeBody(BaseIO):
+    """
+    Computes an explicit three-body descriptor of the atomic environments.
+
+    For each pair of species (a, b), a <= b, of the neighbours j and k of a
+    center i the features are
+
+        f^{ab}_{n1 n2 l} = sum_{j in a, k in b} R_{n1}(r_ij) R_{n2}(r_ik)
+                               T_l(cos theta_jik)
+
+    with R_n(r) = T_n(2 r / r_c - 1) f_c(r), T_n the Chebyshev polynomials of
+    the first kind and f_c the cutoff function.
+
+    Attributes
+    ----------
+    interaction_cutoff : float
+        Maximum pairwise distance for atoms to be considered in the
+        descriptor
+
+    cutoff_smooth_width : float
+        The distance over which the the interaction is smoothed to zero
+
+    max_radial : int
+        Number of Chebyshev polynomials of the radial basis
+
+    max_angular : int
+        Highest order of the Chebyshev polynomials of cos theta_jik
+
+    normalize : boolean
+        Whether to normalize so that the kernel between identical environments
+        is 1.  Default and highly recommended: True.
+
+    compute_gradients : bool
+        control the computation of the descriptor's gradients w.r.t. atomic
+        positions.
+
+    n_threads : int
+        Number of threads computing the centers of a structure.
+
+    Methods
+    -------
+    transform(frames)
+        Compute the representation for a list of ase.Atoms object.
+    """
+
+    def __init__(
+        self,
+        interaction_cutoff,
+        cutoff_smooth_width,
+        max_radial,
+        max_angular,
+        normalize=True,
+        compute_gradients=False,
+        n_threads=1,
+    ):
+        """Construct a ThreeBody representation
+
+        Required arguments are all the hyperparameters named in the
+        class documentation
+        """
+        self.name = "threebody"
+        self.hypers = dict()
+        self.update_hyperparameters(
+            max_radial=max_radial,
+            max_angular=max_angular,
+            normalize=normalize,
+            compute_gradients=compute_gradients,
+            n_threads=int(n_threads),
+        )
+
+        cutoff_function = cutoff_function_dict_switch(
+            "ShiftedCosine",
+            interaction_cutoff=interaction_cutoff,
+            cutoff_smooth_width=cutoff_smooth_width,
+        )
+        self.update_hyperparameters(cutoff_function=cutoff_function)
+
+        self.nl_options = [
+            dict(name="centers", args=[]),
+            dict(name="neighbourlist", args=dict(cutoff=interaction_cutoff)),
+            dict(name="centercontribution", args=dict()),
+            dict(name="strict", args=dict(cutoff=interaction_cutoff)),
+        ]
+
+        self.rep_options = dict(name=self.name, args=[self.hypers])
+
+        self._representation = CalculatorFactory(self.rep_options)
+
+    def update_hyperparameters(self, **hypers):
+        """Store the given dict of hyperparameters
+
+        Also updates the internal json-like representation
+
+        """
+        allowed_keys = {
+            "max_radial",
+            "max_angular",
+            "normalize",
+            "compute_gradients",
+            "cutoff_function",
+            "n_threads",
+        }
+        hypers_clean = {key: hypers[key] for key in hypers if key in allowed_keys}
+        self.hypers.update(hypers_clean)
+
+    def transform(self, frames):
+        """Compute the representation.
+
+        Parameters
+        ----------
+        frames : list(ase.Atoms) or AtomsList
+            List of atomic structures.
+
+        Returns
+        -------
+           AtomsList : Object containing the representation
+
+        """
+        if not isinstance(frames, AtomsList):
+            frames = AtomsList(frames, self.nl_options)
+
+        self._representation.compute(frames.managers)
+
+        return frames
+
+    def get_timings(self):
+        """Return the built-in timers and counters of the three-body
+        computations, aggregated over all the calls since the last
+        rascal.utils.reset_timings().
+
+        See rascal.utils.get_timings for the format of the report.
+        """
+        return get_timings(["ThreeBody"])
+
+    def get_num_coefficients(self, n_species=1):
+        """Return the number of coefficients in the representation
+
+        (this is the descriptor size per atomic centre)
+
+        """
+        n_pairs = n_species * (n_species + 1) // 2
+        return (
+            n_pairs
+            * self.hypers["max_radial"] ** 2
+            * (self.hypers["max_angular"] + 1)
+        )
+
+    def get_keys(self, species):
+        """
+        return the proper list of keys used to build the representation
+        """
+        return [list(key) for key in combinations_with_replacement(sorted(species), 2)]
+
+    def _get_init_params(self):
+        cutoff_function = self.hypers["cutoff_function"]
+        init_params = dict(
+            interaction_cutoff=cutoff_function["cutoff"]["value"],
+            cutoff_smooth_width=cutoff_function["smooth_width"]["value"],
+            max_radial=self.hypers["max_radial"],
+            max_angular=self.hypers["max_angular"],
+            normalize=self.hypers["normalize"],
+            compute_gradients=self.hypers["compute_gradients"],
+            n_threads=self.hypers["n_threads"],
+        )
+        return init_params
+
+    def _set_data(self, data):
+        super()._set_data(data)
+
+    def _get_data(self):
+        return super()._get_data()
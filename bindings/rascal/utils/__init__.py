@@ -7,6 +7,7 @@ from .io import (
     dump_obj,
     load_obj,
 )
+from .timings import get_timings, reset_timings
 
 # Warning potential dependency loop: FPS imports models, which imports KRR,
 # which imports this file again
@@ -0,0 +1,53 @@
+"""Access to the built-in timers and counters of the library
+
+The library records the time spent in the main phases of the computations
+(neighbour list, spherical expansion, invariants, kernels, predictions) and
+counts the processed pairs, centers, allocations and interpolator calls. The
+level of detail is chosen when building the library with the
+RASCAL_TIMERS_LEVEL cmake variable (0 removes the timers and is the default,
+1 times the main phases, 2 also times the steps of the inner loops). With the
+default level the reports are empty.
+"""
+import json
+
+from ..lib._rascal.utils import get_timings_report, reset_timings
+
+
+def get_timings(names=None):
+    """Returns the timers and counters aggregated over the threads
+
+    Parameters
+    ----------
+    names : list of str, optional
+        only keep the timers whose path contains one of these names and the
+        counters starting with one of these names, e.g.
+        ["SphericalInvariants"]. By default everything is returned.
+
+    Returns
+    -------
+    dict
+        {"timers": {path: {"count", "time", "max_thread_time", "n_threads"}},
+         "counters": {name: value}, "level": level}
+        The timers are identified by the names of the nested timers separated
+        with '/' and the times are in seconds.
+    """
+    report = json.loads(get_timings_report())
+    if names is None:
+        return report
+
+    def is_selected(path):
+        return any(
+            component.startswith(name)
+            for component in path.split("/")
+            for name in names
+        )
+
+    report["timers"] = {
+        path: timer for path, timer in report["timers"].items() if is_selected(path)
+    }
+    report["counters"] = {
+        name: value
+        for name, value in report["counters"].items()
+        if is_selected(name)
+    }
+    return report
@@ -0,0 +1,203 @@
+/**
+ * @file  performance/benchmarks/benchmark_representations.cc
+ *
+ * @date   18 October 2026
+ *
+ * @brief benchmarks of the neighbour list, the representations and the
+ *        sparse kernel models
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "benchmark_representations.hh"
+
+namespace rascal {
+  /**
+   * The throughput is reported with the counters centers/s and pairs/s. Run
+   * with
+   *
+   *     ./benchmark_representations --benchmark_out=results.json \
+   *         --benchmark_out_format=json
+   *
+   * from the root of the repository to store the results in a json file that
+   * can be compared between versions, e.g. with the compare.py tool of
+   * Google Benchmark.
+   *
+   * The calculators skip the computation when their property is already up
+   * to date, so the status of the properties of the manager stack is reset at
+   * each iteration.
+   */
+
+  using FullStack_t =
+      StructureManagerTypeHolder<StructureManagerCenters, AdaptorNeighbourList,
+                                 AdaptorCenterContribution, AdaptorStrict>;
+  using HalfStack_t =
+      StructureManagerTypeHolder<StructureManagerCenters, AdaptorNeighbourList,
+                                 AdaptorHalfList, AdaptorCenterContribution,
+                                 AdaptorStrict>;
+
+  const json full_stack_names{"AdaptorNeighbourList",
+                              "AdaptorCenterContribution", "AdaptorStrict"};
+  const json half_stack_names{"AdaptorNeighbourList", "AdaptorHalfList",
+                              "AdaptorCenterContribution", "AdaptorStrict"};
+
+  const json expansion_hypers{{"normalize", false}};
+  const json invariants_hypers{{"soap_type", "PowerSpectrum"},
+                               {"normalize", true}};
+  const json covariants_hypers{{"soap_type", "LambdaSpectrum"},
+                               {"covariant_lambda", 2},
+                               {"inversion_symmetry", true},
+                               {"normalize", true}};
+
+  // Benchmark of the update of the whole manager stack, i.e. the neighbour
+  // list and the filtering of the pairs within the cutoff. The neighbour list
+  // is only rebuilt when the positions change so the updates alternate
+  // between the structure and a rigidly translated copy with the same pairs,
+  // each iteration updates the stack twice.
+  template <class BFixture>
+  void bm_neighbour_list(benchmark::State & state, BFixture & fix) {
+    fix.setup(state);
+    AtomicStructure<3> translated_structure{fix.structure};
+    translated_structure.positions.array() += 1e-8;
+    for (auto _ : state) {
+      fix.manager->update(translated_structure);
+      fix.manager->update(fix.structure);
+    }
+    fix.set_structure_counters(state);
+  }
+
+  // Benchmark of the computation of a representation (and its gradients)
+  template <class BFixture>
+  void bm_representation(benchmark::State & state, BFixture & fix) {
+    fix.setup(state);
+    for (auto _ : state) {
+      fix.manager->set_updated_property_status(false);
+      fix.calculator->compute(fix.manager);
+    }
+    fix.set_structure_counters(state);
+    state.counters["max_radial"] = fix.max_radial;
+    state.counters["max_angular"] = fix.max_angular;
+    state.counters["gradients"] = fix.compute_gradients;
+  }
+
+  // Benchmark of the sparse kernel between the centers and the sparse points
+  template <class BFixture>
+  void bm_sparse_kernel(benchmark::State & state, BFixture & fix) {
+    fix.setup(state);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(
+          fix.kernel.compute(*fix.calculator, *fix.managers,
+                             *fix.sparse_points));
+    }
+    fix.set_structure_counters(state);
+    state.counters["n_sparse_points"] = fix.n_sparse_points;
+  }
+
+  // Benchmark of the derivatives of the sparse kernel (KNM) w.r.t. the atomic
+  // positions and the cell
+  template <class BFixture>
+  void bm_sparse_kernel_derivative(benchmark::State & state, BFixture & fix) {
+    fix.setup(state);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(fix.kernel.compute_derivative(
+          *fix.calculator, *fix.managers, *fix.sparse_points, true));
+    }
+    fix.set_structure_counters(state);
+    state.counters["n_sparse_points"] = fix.n_sparse_points;
+  }
+
+  // Benchmark of the prediction of the energy, forces and stress of a sparse
+  // GAP model given the representation and its gradients
+  template <class BFixture>
+  void bm_sparse_kernel_prediction(benchmark::State & state, BFixture & fix) {
+    fix.setup(state);
+    for (auto _ : state) {
+      // invalidates the predictions (and every other property of the stack)
+      // but marks the representation and its gradients as up to date again
+      // so that only the kernel part is timed
+      fix.manager->set_updated_property_status(false);
+      fix.manager->set_updated_property_status(fix.calculator->get_name(),
+                                               true);
+      fix.manager->set_updated_property_status(
+          fix.calculator->get_gradient_name(), true);
+      compute_sparse_kernel_predictions(*fix.calculator, fix.kernel,
+                                        *fix.managers, *fix.sparse_points,
+                                        fix.weights);
+    }
+    fix.set_structure_counters(state);
+    state.counters["n_sparse_points"] = fix.n_sparse_points;
+  }
+
+  /**
+   * Neighbour list benchmarks
+   */
+  StructureBFixture<NeighbourListDataset, FullStack_t> nl_full_fix{
+      full_stack_names};
+  BENCHMARK_CAPTURE(bm_neighbour_list, full_list, nl_full_fix)
+      ->Apply(all_combinations_of_arguments<NeighbourListDataset>);
+
+  /**
+   * Representation benchmarks
+   */
+  RepresentationBFixture<RepresentationDataset, FullStack_t,
+                         CalculatorSphericalExpansion>
+      expansion_fix{full_stack_names, expansion_hypers};
+  BENCHMARK_CAPTURE(bm_representation, expansion_full_list, expansion_fix)
+      ->Apply(all_combinations_of_arguments<RepresentationDataset>);
+
+  RepresentationBFixture<HalfListDataset, HalfStack_t,
+                         CalculatorSphericalExpansion>
+      expansion_half_fix{half_stack_names, expansion_hypers};
+  BENCHMARK_CAPTURE(bm_representation, expansion_half_list, expansion_half_fix)
+      ->Apply(all_combinations_of_arguments<HalfListDataset>);
+
+  // same structures as the half list benchmarks with the full list
+  RepresentationBFixture<HalfListDataset, FullStack_t,
+                         CalculatorSphericalExpansion>
+      expansion_half_ref_fix{full_stack_names, expansion_hypers};
+  BENCHMARK_CAPTURE(bm_representation, expansion_half_list_reference,
+                    expansion_half_ref_fix)
+      ->Apply(all_combinations_of_arguments<HalfListDataset>);
+
+  RepresentationBFixture<RepresentationDataset, FullStack_t,
+                         CalculatorSphericalInvariants>
+      invariants_fix{full_stack_names, invariants_hypers};
+  BENCHMARK_CAPTURE(bm_representation, invariants_full_list, invariants_fix)
+      ->Apply(all_combinations_of_arguments<RepresentationDataset>);
+
+  RepresentationBFixture<CovariantDataset, FullStack_t,
+                         CalculatorSphericalCovariants>
+      covariants_fix{full_stack_names, covariants_hypers};
+  BENCHMARK_CAPTURE(bm_representation, covariants_full_list, covariants_fix)
+      ->Apply(all_combinations_of_arguments<CovariantDataset>);
+
+  /**
+   * Sparse kernel benchmarks
+   */
+  SparseKernelBFixture<SparseKernelDataset, FullStack_t> sparse_kernel_fix{
+      full_stack_names, invariants_hypers};
+  BENCHMARK_CAPTURE(bm_sparse_kernel, gap, sparse_kernel_fix)
+      ->Apply(all_combinations_of_arguments<SparseKernelDataset>);
+  BENCHMARK_CAPTURE(bm_sparse_kernel_derivative, gap, sparse_kernel_fix)
+      ->Apply(all_combinations_of_arguments<SparseKernelDataset>);
+  BENCHMARK_CAPTURE(bm_sparse_kernel_prediction, gap, sparse_kernel_fix)
+      ->Apply(all_combinations_of_arguments<SparseKernelDataset>);
+
+}  // namespace rascal
+
+BENCHMARK_MAIN();
@@ -0,0 +1,418 @@
+/**
+ * @file  performance/benchmarks/benchmark_representations.hh
+ *
+ * @date   18 October 2026
+ *
+ * @brief contains the data and fixtures of the benchmarks of the neighbour
+ *        list, the representations and the sparse kernel models
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef PERFORMANCE_BENCHMARKS_BENCHMARK_REPRESENTATIONS_HH_
+#define PERFORMANCE_BENCHMARKS_BENCHMARK_REPRESENTATIONS_HH_
+
+#include "benchmarks.hh"
+
+#include "rascal/models/sparse_kernel_predict.hh"
+#include "rascal/models/sparse_kernels.hh"
+#include "rascal/models/sparse_points.hh"
+#include "rascal/representations/calculator_spherical_covariants.hh"
+#include "rascal/representations/calculator_spherical_expansion.hh"
+#include "rascal/representations/calculator_spherical_invariants.hh"
+#include "rascal/structure_managers/adaptor_center_contribution.hh"
+#include "rascal/structure_managers/adaptor_half_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+#include "rascal/structure_managers/structure_manager_collection.hh"
+#include "rascal/utils/json_io.hh"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rascal {
+
+  /* -------------------- benchmark-parameters-start -------------------- */
+  /**
+   * Representation Dataset explanation
+   *  static const json data = {
+   *      // structures: an isolated molecule, a bulk crystal and a small
+   *      // periodic cell (smaller than the cutoff)
+   *      {"filenames", {"reference_data/inputs/small_molecule.json"}},
+   *
+   *      // number of replicas of the cell along each periodic direction,
+   *      // i.e. the supercell has n_replicas^3 times more atoms
+   *      {"n_replicas", {1}},
+   *
+   *      // cutoff of the neighbour list and of the representation
+   *      {"cutoffs", {4}},
+   *
+   *      // pair of (max_radial, max_angular)
+   *      {"radial_angular", {std::make_pair(6, 4)}},
+   *
+   *      // the atoms are relabeled with n_species different species,
+   *      // 0 keeps the species of the structure
+   *      {"n_species", {0}},
+   *
+   *      // compute the gradients of the representation
+   *      {"compute_gradients", {false}}};
+   */
+  /* -------------------- benchmark-parameters-end -------------------- */
+
+  struct NeighbourListDataset {
+    static const json data() {
+      static const json data = {
+          {"filenames",
+           {"reference_data/inputs/small_molecule.json",
+            "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json",
+            "reference_data/inputs/diamond_cubic_distorted.json"}},
+          {"n_replicas", {1, 3}},
+          {"cutoffs", {3, 5}},
+          {"radial_angular", {std::make_pair(1, 0)}},  // dummy
+          {"n_species", {0}},                          // dummy
+          {"compute_gradients", {false}}};             // dummy
+      return data;
+    }
+  };
+
+  struct RepresentationDataset {
+    static const json data() {
+      static const json data = {
+          {"filenames",
+           {"reference_data/inputs/small_molecule.json",
+            "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json",
+            "reference_data/inputs/diamond_cubic_distorted.json"}},
+          {"n_replicas", {1}},
+          {"cutoffs", {4}},
+          {"radial_angular", {std::make_pair(4, 3), std::make_pair(8, 6)}},
+          {"n_species", {0, 4}},
+          {"compute_gradients", {false, true}}};
+      return data;
+    }
+  };
+
+  /**
+   * The spherical covariants do not implement gradients. Covers only the
+   * molecule and the bulk crystal to keep the number of benchmarks in check.
+   */
+  struct CovariantDataset {
+    static const json data() {
+      static const json data = {
+          {"filenames",
+           {"reference_data/inputs/small_molecule.json",
+            "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json"}},
+          {"n_replicas", {1}},
+          {"cutoffs", {4}},
+          {"radial_angular", {std::make_pair(4, 3), std::make_pair(8, 6)}},
+          {"n_species", {0, 4}},
+          {"compute_gradients", {false}}};
+      return data;
+    }
+  };
+
+  /**
+   * The half neighbour list is only used with the spherical expansion and
+   * requires periodic cells larger than twice the cutoff, hence the supercell
+   * of the small cell.
+   */
+  struct HalfListDataset {
+    static const json data() {
+      static const json data = {
+          {"filenames",
+           {"reference_data/inputs/small_molecule.json",
+            "reference_data/inputs/diamond_cubic_distorted.json"}},
+          {"n_replicas", {3}},
+          {"cutoffs", {4}},
+          {"radial_angular", {std::make_pair(4, 3), std::make_pair(8, 6)}},
+          {"n_species", {0}},
+          {"compute_gradients", {false, true}}};
+      return data;
+    }
+  };
+
+  struct SparseKernelDataset {
+    static const json data() {
+      static const json data = {
+          {"filenames",
+           {"reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json",
+            "reference_data/inputs/diamond_cubic_distorted.json"}},
+          {"n_replicas", {1, 2}},
+          {"cutoffs", {4}},
+          {"radial_angular", {std::make_pair(6, 4)}},
+          {"n_species", {0}},
+          {"compute_gradients", {true}}};
+      return data;
+    }
+  };
+
+  /**
+   * Build a supercell of structure with n_replicas copies of the cell along
+   * its periodic directions.
+   */
+  inline AtomicStructure<3> make_supercell(const AtomicStructure<3> & structure,
+                                           const int n_replicas) {
+    std::array<int, 3> n_copies{};
+    int n_tot{1};
+    for (int i_dim{0}; i_dim < 3; ++i_dim) {
+      n_copies[i_dim] = structure.pbc(i_dim) ? n_replicas : 1;
+      n_tot *= n_copies[i_dim];
+    }
+    const auto n_atoms{structure.positions.cols()};
+    AtomicStructure<3> supercell{};
+    supercell.positions.resize(3, n_atoms * n_tot);
+    supercell.atom_types.resize(n_atoms * n_tot);
+    supercell.center_atoms_mask.resize(n_atoms * n_tot);
+    int i_copy{0};
+    for (int ix{0}; ix < n_copies[0]; ++ix) {
+      for (int iy{0}; iy < n_copies[1]; ++iy) {
+        for (int iz{0}; iz < n_copies[2]; ++iz) {
+          Eigen::Vector3d shift{structure.cell * Eigen::Vector3d(ix, iy, iz)};
+          supercell.positions.middleCols(i_copy * n_atoms, n_atoms) =
+              structure.positions.colwise() + shift;
+          supercell.atom_types.segment(i_copy * n_atoms, n_atoms) =
+              structure.atom_types;
+          supercell.center_atoms_mask.segment(i_copy * n_atoms, n_atoms) =
+              structure.center_atoms_mask;
+          i_copy++;
+        }
+      }
+    }
+    supercell.cell = structure.cell;
+    for (int i_dim{0}; i_dim < 3; ++i_dim) {
+      supercell.cell.col(i_dim) *= n_copies[i_dim];
+    }
+    supercell.pbc = structure.pbc;
+    return supercell;
+  }
+
+  /**
+   * Builds the structure and the manager stack described by the benchmark
+   * state. They are only rebuilt when the parameters change between two
+   * consecutive benchmarks.
+   */
+  template <class Dataset, class ManagerTypeHolder>
+  class StructureBFixture : public BaseBFixture<Dataset> {
+   public:
+    using Parent = BaseBFixture<Dataset>;
+    using ManagerCollection_t =
+        typename TypeHolderInjector<ManagerCollection,
+                                    typename ManagerTypeHolder::type_list>::type;
+    using Manager_t = typename ManagerCollection_t::Manager_t;
+    using ManagerPtr_t = std::shared_ptr<Manager_t>;
+
+    explicit StructureBFixture(const json & adaptor_names)
+        : Parent(), adaptor_names(adaptor_names) {}
+
+    virtual ~StructureBFixture() = default;
+
+    void setup(const ::benchmark::State & state) {
+      const json data = Dataset::data();
+      json parameters{
+          {"filename",
+           this->template lookup<std::string>(data, "filenames", state)},
+          {"n_replicas", this->template lookup<int>(data, "n_replicas", state)},
+          {"cutoff", this->template lookup<double>(data, "cutoffs", state)},
+          {"n_species", this->template lookup<int>(data, "n_species", state)}};
+      const bool new_structure{parameters != this->structure_parameters};
+      if (new_structure) {
+        this->structure_parameters = parameters;
+        this->init_structure();
+      }
+      this->setup_hook(state, data, new_structure);
+    }
+
+    //! cumulated counters of the structure
+    void set_structure_counters(::benchmark::State & state) const {
+      state.counters["n_atoms"] =
+          static_cast<double>(this->structure.get_number_of_atoms());
+      state.counters["n_centers"] = static_cast<double>(this->n_centers);
+      state.counters["n_pairs"] = static_cast<double>(this->n_pairs);
+      state.counters["cutoff"] = this->cutoff;
+      state.counters["centers/s"] = ::benchmark::Counter(
+          static_cast<double>(this->n_centers),
+          ::benchmark::Counter::kIsIterationInvariantRate);
+      state.counters["pairs/s"] = ::benchmark::Counter(
+          static_cast<double>(this->n_pairs),
+          ::benchmark::Counter::kIsIterationInvariantRate);
+    }
+
+    json adaptor_names{};
+    json structure_parameters{};
+    AtomicStructure<3> structure{};
+    double cutoff{0.};
+    size_t n_centers{0};
+    size_t n_pairs{0};
+    std::unique_ptr<ManagerCollection_t> managers{};
+    ManagerPtr_t manager{};
+
+   protected:
+    //! called at each setup once the structure is up to date
+    virtual void setup_hook(const ::benchmark::State & /*state*/,
+                            const json & /*data*/,
+                            const bool /*new_structure*/) {}
+
+    void init_structure() {
+      this->cutoff = this->structure_parameters["cutoff"].get<double>();
+      AtomicStructure<3> structure_cell{};
+      structure_cell.set_structure(
+          this->structure_parameters["filename"].get<std::string>());
+      this->structure = make_supercell(
+          structure_cell, this->structure_parameters["n_replicas"].get<int>());
+      const int n_species{this->structure_parameters["n_species"].get<int>()};
+      if (n_species > 0) {
+        // hydrogen, carbon, nitrogen, oxygen, ...
+        for (int i_atom{0}; i_atom < this->structure.atom_types.size();
+             ++i_atom) {
+          this->structure.atom_types(i_atom) =
+              (i_atom % n_species == 0) ? 1 : 5 + i_atom % n_species;
+        }
+      }
+
+      json adaptors = json::array();
+      for (const auto & name : this->adaptor_names) {
+        json arguments = json::object();
+        if (name == "AdaptorNeighbourList") {
+          arguments = {{"cutoff", this->cutoff}, {"skin", 0.}};
+        } else if (name == "AdaptorStrict") {
+          arguments = {{"cutoff", this->cutoff}};
+        }
+        adaptors.push_back(
+            {{"name", name}, {"initialization_arguments", arguments}});
+      }
+      this->managers = std::make_unique<ManagerCollection_t>(adaptors);
+      this->managers->add_structures(
+          std::vector<AtomicStructure<3>>{this->structure});
+      this->manager = (*this->managers)[0];
+      this->n_centers = this->manager->size();
+      this->n_pairs = this->manager->get_nb_clusters(2);
+    }
+  };
+
+  /**
+   * Adds a calculator built with the hypers described by the benchmark
+   * state on top of StructureBFixture.
+   */
+  template <class Dataset, class ManagerTypeHolder, class Calculator>
+  class RepresentationBFixture
+      : public StructureBFixture<Dataset, ManagerTypeHolder> {
+   public:
+    using Parent = StructureBFixture<Dataset, ManagerTypeHolder>;
+
+    RepresentationBFixture(const json & adaptor_names,
+                           const json & representation_hypers)
+        : Parent(adaptor_names),
+          representation_hypers(representation_hypers) {}
+
+    json representation_hypers{};
+    json hypers{};
+    int max_radial{0};
+    int max_angular{0};
+    bool compute_gradients{false};
+    std::unique_ptr<Calculator> calculator{};
+
+   protected:
+    void setup_hook(const ::benchmark::State & state, const json & data,
+                    const bool new_structure) override {
+      auto radial_angular = this->template lookup<std::pair<int, int>>(
+          data, "radial_angular", state);
+      json hypers = this->representation_hypers;
+      hypers["max_radial"] = std::get<0>(radial_angular);
+      hypers["max_angular"] = std::get<1>(radial_angular);
+      hypers["compute_gradients"] =
+          this->template lookup<bool>(data, "compute_gradients", state);
+      hypers["cutoff_function"] = {
+          {"type", "ShiftedCosine"},
+          {"cutoff", {{"value", this->cutoff}, {"unit", "AA"}}},
+          {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
+      hypers["gaussian_density"] = {
+          {"type", "Constant"},
+          {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
+      hypers["radial_contribution"] = {{"type", "GTO"}};
+      const bool new_calculator{hypers != this->hypers or
+                                not this->calculator};
+      if (new_calculator) {
+        this->hypers = hypers;
+        this->max_radial = std::get<0>(radial_angular);
+        this->max_angular = std::get<1>(radial_angular);
+        this->compute_gradients = hypers["compute_gradients"].get<bool>();
+        this->calculator = std::make_unique<Calculator>(hypers);
+      }
+      if (new_structure or new_calculator) {
+        this->representation_hook();
+      }
+    }
+
+    //! called when the structure or the calculator have changed
+    virtual void representation_hook() {}
+  };
+
+  /**
+   * Adds a GAP sparse kernel with sparse points selected among the centers
+   * and random weights on top of RepresentationBFixture. The representation
+   * is computed during the setup.
+   */
+  template <class Dataset, class ManagerTypeHolder>
+  class SparseKernelBFixture
+      : public RepresentationBFixture<Dataset, ManagerTypeHolder,
+                                      CalculatorSphericalInvariants> {
+   public:
+    using Parent = RepresentationBFixture<Dataset, ManagerTypeHolder,
+                                          CalculatorSphericalInvariants>;
+    using SparsePoints_t =
+        SparsePointsBlockSparse<CalculatorSphericalInvariants>;
+
+    SparseKernelBFixture(const json & adaptor_names,
+                         const json & representation_hypers)
+        : Parent(adaptor_names, representation_hypers) {}
+
+    SparseKernel kernel{json{{"name", "GAP"},
+                             {"zeta", 2},
+                             {"target_type", "Structure"}}};
+    std::unique_ptr<SparsePoints_t> sparse_points{};
+    math::Vector_t weights{};
+    size_t n_sparse_points{0};
+
+   protected:
+    void representation_hook() override {
+      this->manager->set_updated_property_status(false);
+      this->calculator->compute(*this->managers);
+      // one sparse point every 4 centers of each species so that all the
+      // species of the structure have sparse points
+      std::vector<std::vector<int>> selected_ids(1);
+      std::map<int, int> n_centers_by_sp{};
+      int i_center{0};
+      for (auto center : this->manager) {
+        if (n_centers_by_sp[center.get_atom_type()]++ % 4 == 0) {
+          selected_ids[0].push_back(i_center);
+        }
+        i_center++;
+      }
+      this->sparse_points = std::make_unique<SparsePoints_t>();
+      this->sparse_points->push_back(*this->calculator, *this->managers,
+                                     selected_ids);
+      this->n_sparse_points = this->sparse_points->size();
+      this->weights = math::Vector_t::Random(this->n_sparse_points);
+    }
+  };
+
+}  // namespace rascal
+#endif  // PERFORMANCE_BENCHMARKS_BENCHMARK_REPRESENTATIONS_HH_
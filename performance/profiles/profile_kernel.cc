@@ -25,11 +25,9 @@
  * Boston, MA 02111-1307, USA.
  */
 
-#include "rascal/atomic_structure.hh"
-#include "rascal/basic_types.hh"
+#include "utils.hh"
+
 #include "rascal/models/kernels.hh"
-#include "rascal/representations/calculator_sorted_coulomb.hh"
-#include "rascal/representations/calculator_spherical_expansion.hh"
 #include "rascal/representations/calculator_spherical_invariants.hh"
 #include "rascal/structure_managers/adaptor_center_contribution.hh"
 #include "rascal/structure_managers/adaptor_neighbour_list.hh"
@@ -37,21 +35,12 @@
 #include "rascal/structure_managers/make_structure_manager.hh"
 #include "rascal/structure_managers/structure_manager_centers.hh"
 #include "rascal/structure_managers/structure_manager_collection.hh"
-#include "rascal/utils.hh"
 
-#include <chrono>
-#include <cmath>
-#include <functional>
-#include <initializer_list>
 #include <iostream>
-#include <list>
 #include <string>
 
-// using namespace std;
 using namespace rascal;  // NOLINT
 
-const int N_ITERATIONS = 100;
-
 using ManagerTypeHolder_t =
     StructureManagerTypeHolder<StructureManagerCenters, AdaptorNeighbourList,
                                AdaptorCenterContribution, AdaptorStrict>;
@@ -61,102 +50,82 @@ using ManagerCollection_t =
     typename TypeHolderInjector<ManagerCollection, ManagerTypeList_t>::type;
 using Representation_t = CalculatorSphericalInvariants;
 
-int main() {
-  std::string filename{"../reference_data/inputs/small_molecules-20.json"};
-
-  double cutoff{3.5};
-
+/**
+ * Profile of the global kernel between the structures of a dataset for the
+ * different ways of storing the species of the representation. Run from the
+ * root of the repository with
+ *
+ *     ./profile_kernel [config.json]
+ *
+ * where the optional config.json overrides the values of default_config.
+ * The misses are given per center.
+ */
+int main(int argc, char * argv[]) {
   json hypers{{"max_radial", 8},
               {"max_angular", 6},
               {"compute_gradients", false},
               {"soap_type", "PowerSpectrum"},
               {"normalize", true},
-              {"expansion_by_species_method", "user defined"},
               {"global_species", {1, 6, 7, 8}}};
-
-  json fc_hypers{{"type", "ShiftedCosine"},
-                 {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
-                 {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
-  json sigma_hypers{{"type", "Constant"},
-                    {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
-
-  hypers["cutoff_function"] = fc_hypers;
-  hypers["gaussian_density"] = sigma_hypers;
+  hypers["cutoff_function"] = {
+      {"type", "ShiftedCosine"},
+      {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
+  hypers["gaussian_density"] = {
+      {"type", "Constant"},
+      {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
   hypers["radial_contribution"] = {{"type", "GTO"}};
 
-  json kernel_hypers{
-      {"zeta", 2}, {"target_type", "Structure"}, {"name", "Cosine"}};
-
-  json structure{{"filename", filename}};
-  json adaptors;
-  json ad1{{"name", "AdaptorNeighbourList"},
-           {"initialization_arguments", {{"cutoff", cutoff}, {"skin", 0.}}}};
-  json ad1b{{"name", "AdaptorCenterContribution"},
-            {"initialization_arguments", {}}};
-  json ad2{{"name", "AdaptorStrict"},
-           {"initialization_arguments", {{"cutoff", cutoff}}}};
-  adaptors.emplace_back(ad1);
-  adaptors.emplace_back(ad1b);
-  adaptors.emplace_back(ad2);
+  json default_config{
+      {"filename", "reference_data/inputs/small_molecules-20.json"},
+      {"start", 0},
+      {"length", 20},
+      {"n_iterations", 100},
+      {"cutoff", 3.5},
+      {"hypers", hypers},
+      {"kernel_hypers",
+       {{"zeta", 2}, {"target_type", "Structure"}, {"name", "Cosine"}}},
+      {"expansion_by_species_methods",
+       {"user defined", "structure wise", "environment wise"}},
+      {"output", ""}};
+  json config = load_profile_config(argc, argv, default_config);
+  Profiler profiler{config};
+
+  const double cutoff{config.at("cutoff").get<double>()};
+  hypers = config.at("hypers");
+  hypers["cutoff_function"]["cutoff"] = {{"value", cutoff}, {"unit", "AA"}};
+  json adaptors{{{"name", "AdaptorNeighbourList"},
+                 {"initialization_arguments",
+                  {{"cutoff", cutoff}, {"skin", 0.}}}},
+                {{"name", "AdaptorCenterContribution"},
+                 {"initialization_arguments", {}}},
+                {{"name", "AdaptorStrict"},
+                 {"initialization_arguments", {{"cutoff", cutoff}}}}};
 
   ManagerCollection_t collection{adaptors};
-  collection.add_structures(filename, 0, 20);
-
-  Representation_t soap{hypers};
-
-  soap.compute(collection);
-
-  Kernel kernel{kernel_hypers};
-
-  std::cout << "structure filename: " << filename << std::endl;
-
-  std::chrono::duration<double> elapsed{};
-
-  math::Matrix_t aa{20, 20};
-  auto start = std::chrono::high_resolution_clock::now();
-  // This is the part that should get profiled
-  for (size_t looper{0}; looper < N_ITERATIONS + 600; looper++) {
-    auto kk = kernel.compute(soap, collection, collection);
-    aa += kk;
+  collection.add_structures(config.at("filename").get<std::string>(),
+                            config.at("start").get<int>(),
+                            config.at("length").get<int>());
+  size_t n_centers{0};
+  for (auto & manager : collection) {
+    n_centers += manager->size();
   }
-  auto finish = std::chrono::high_resolution_clock::now();
-
-  elapsed = finish - start;
-  std::cout << "Kernel with user defined species"
-            << " elapsed: " << elapsed.count() / (N_ITERATIONS + 600)
-            << " seconds" << std::endl;
-
-  hypers["expansion_by_species_method"] = "structure wise";
-  Representation_t soap_sw{hypers};
-
-  soap_sw.compute(collection);
-
-  start = std::chrono::high_resolution_clock::now();
-  for (size_t looper{0}; looper < N_ITERATIONS; looper++) {
-    auto kk = kernel.compute(soap_sw, collection, collection);
-    aa += kk;
-  }
-  finish = std::chrono::high_resolution_clock::now();
-
-  elapsed = finish - start;
-  std::cout << "Kernel with structure wise species"
-            << " elapsed: " << elapsed.count() / N_ITERATIONS << " seconds"
+  std::cout << "structure filename: " << config.at("filename") << ", "
+            << collection.size() << " structures, " << n_centers << " centers"
             << std::endl;
 
-  hypers["expansion_by_species_method"] = "environment wise";
-  Representation_t soap_ew{hypers};
-
-  soap_ew.compute(collection);
-
-  start = std::chrono::high_resolution_clock::now();
-  for (size_t looper{0}; looper < N_ITERATIONS; looper++) {
-    auto kk = kernel.compute(soap_ew, collection, collection);
-    aa += kk;
+  Kernel kernel{config.at("kernel_hypers")};
+  for (auto && method : config.at("expansion_by_species_methods")) {
+    hypers["expansion_by_species_method"] = method;
+    Representation_t soap{hypers};
+    soap.compute(collection);
+    profiler.profile(
+        "kernel", n_centers,
+        [&kernel, &soap, &collection]() {
+          math::Matrix_t kk = kernel.compute(soap, collection, collection);
+          (void)kk;
+        },
+        method.get<std::string>());
   }
-  finish = std::chrono::high_resolution_clock::now();
-
-  elapsed = finish - start;
-  std::cout << "Kernel with environment wise species"
-            << " elapsed: " << elapsed.count() / N_ITERATIONS << " seconds"
-            << std::endl;
+  profiler.write();
+  return 0;
 }
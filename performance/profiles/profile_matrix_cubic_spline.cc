@@ -34,9 +34,8 @@
 #include "rascal/representations/calculator_spherical_expansion.hh"
 #include "rascal/utils/json_io.hh"
 
-#include <chrono>
+#include <iostream>
 
-static constexpr int N_REPETITIONS = 200;
 static unsigned int SEED = 1597463007;
 
 using namespace rascal;  // NOLINT
@@ -52,11 +51,24 @@ using math::Vector_t;
  * interpolator. The computed grid is then used in the second run. If one wants
  * to profile the interpolate function together with the grid initialization
  * process, be sure to delete the *.grid file before.
+ *
+ * The optional json file given as argument overrides the values of
+ * default_config, the misses are given per interpolated point.
  */
-int main() {
+int main(int argc, char * argv[]) {
+  json default_config{{"n_iterations", 200},
+                      {"n_points", 1000000},
+                      {"n_evaluations", 100000},
+                      {"error_bound", 1e-10},
+                      {"max_radial", 3},
+                      {"max_angular", 3},
+                      {"output", ""}};
+  json config = load_profile_config(argc, argv, default_config);
+  Profiler profiler{config};
+
   // radial contribution parameters
-  int max_radial{3};
-  int max_angular{max_radial};
+  int max_radial{config.at("max_radial").get<int>()};
+  int max_angular{config.at("max_angular").get<int>()};
   json fc_hypers{{"type", "Constant"},
                  {"gaussian_sigma", {{"value", 0.5}, {"unit", "AA"}}}};
   json hypers{
@@ -78,9 +90,9 @@ int main() {
   std::shared_ptr<IntpVectorUniformCubicSpline> intp;
   double x1{0};
   double x2{8};
-  double error_bound{1e-10};
-  size_t nb_points = 1e6;
-  size_t nb_iterations = 100000;
+  double error_bound{config.at("error_bound").get<double>()};
+  size_t nb_points{config.at("n_points").get<size_t>()};
+  size_t nb_iterations{config.at("n_evaluations").get<size_t>()};
   const char * filename_grid{"profile_vector_cubic_spline_grid.grid"};
   const char * filename_evaluated_grid{
       "profile_vector_cubic_spline_grid.evaluated_grid"};
@@ -122,19 +134,12 @@ int main() {
   }
 
   Matrix_t mat_tmp = Matrix_t::Zero(max_radial, max_angular + 1);
-  std::chrono::duration<double> elapsed{};
-  auto start = std::chrono::high_resolution_clock::now();
-  for (int j{0}; j < N_REPETITIONS; j++) {
+  profiler.profile("interpolation", nb_iterations, [&]() {
     for (size_t i{0}; i < nb_iterations; i++) {
       mat_tmp = intp->interpolate(points(i % nb_points));
     }
-  }
-  auto finish = std::chrono::high_resolution_clock::now();
-
-  elapsed = finish - start;
-  std::cout << "Interpolation of " << nb_iterations << " points"
-            << " elapsed: " << elapsed.count() / N_REPETITIONS << " seconds"
-            << std::endl;
+  });
+  profiler.write();
 
   return 0;
 }
@@ -0,0 +1,147 @@
+/**
+ * @file  performance/profiles/profile_representation.hh
+ *
+ * @date   18 October 2026
+ *
+ * @brief Profile of the neighbour list and of a representation configured
+ *        from a json file
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef PERFORMANCE_PROFILES_PROFILE_REPRESENTATION_HH_
+#define PERFORMANCE_PROFILES_PROFILE_REPRESENTATION_HH_
+
+#include "utils.hh"
+
+#include "rascal/structure_managers/adaptor_center_contribution.hh"
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/atomic_structure.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+
+#include <array>
+#include <string>
+
+namespace rascal {
+
+  /**
+   * Default configuration of the representation profiles. The "cutoff" is
+   * used for the neighbour list and the cutoff function of the hypers.
+   */
+  inline json get_default_representation_profile_config() {
+    json hypers{{"max_radial", 8},
+                {"max_angular", 6},
+                {"soap_type", "PowerSpectrum"},
+                {"normalize", true}};
+    hypers["cutoff_function"] = {
+        {"type", "ShiftedCosine"},
+        {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
+    hypers["gaussian_density"] = {
+        {"type", "Constant"},
+        {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
+    hypers["radial_contribution"] = {{"type", "GTO"}};
+    return json{{"structures",
+                 {"reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json",
+                  "reference_data/inputs/small_molecule.json"}},
+                {"n_iterations", 20},
+                {"cutoff", 5.},
+                {"gradients", {false, true}},
+                {"hypers", hypers},
+                {"output", ""}};
+  }
+
+  /**
+   * Profiles for each structure of the configuration the update of the
+   * neighbour list and the computation of the representation without and
+   * with gradients (following the "gradients" list). The misses are given
+   * per pair of the neighbour list, one iteration of the neighbour list
+   * phase updates it twice.
+   */
+  template <class Calculator>
+  void profile_representation(const json & config, Profiler & profiler) {
+    const double cutoff{config.at("cutoff").get<double>()};
+    json hypers = config.at("hypers");
+    hypers["cutoff_function"]["cutoff"] = {{"value", cutoff}, {"unit", "AA"}};
+    json adaptors{{{"name", "AdaptorNeighbourList"},
+                   {"initialization_arguments",
+                    {{"cutoff", cutoff}, {"skin", 0.}}}},
+                  {{"name", "AdaptorCenterContribution"},
+                   {"initialization_arguments", {}}},
+                  {{"name", "AdaptorStrict"},
+                   {"initialization_arguments", {{"cutoff", cutoff}}}}};
+
+    for (auto && filename : config.at("structures")) {
+      json structure{{"filename", filename}};
+      auto manager =
+          make_structure_manager_stack<StructureManagerCenters,
+                                       AdaptorNeighbourList,
+                                       AdaptorCenterContribution,
+                                       AdaptorStrict>(structure, adaptors);
+      // the neighbour list is only rebuilt when the positions change so the
+      // updates alternate between the structure and a rigidly translated
+      // copy that has the same pairs
+      std::array<AtomicStructure<3>, 2> atomic_structures{};
+      atomic_structures[0].set_structure(filename.get<std::string>());
+      atomic_structures[1] = atomic_structures[0];
+      atomic_structures[1].positions.array() += 1e-8;
+
+      size_t n_pairs{0};
+      for (auto center : manager) {
+        for (auto neigh : center.pairs()) {
+          (void)neigh;
+          n_pairs++;
+        }
+      }
+      std::string label{filename.get<std::string>()};
+      label = label.substr(label.find_last_of('/') + 1);
+      std::cout << label << ": " << manager->size() << " centers, "
+                << n_pairs << " pairs" << std::endl;
+
+      profiler.profile(
+          "neighbour list", n_pairs,
+          [&manager, &atomic_structures]() {
+            for (auto & atomic_structure : atomic_structures) {
+              manager->update(atomic_structure);
+            }
+          },
+          label);
+
+      for (auto && compute_gradients : config.at("gradients")) {
+        hypers["compute_gradients"] = compute_gradients;
+        Calculator representation{hypers};
+        std::string name{"representation"};
+        if (compute_gradients.get<bool>()) {
+          name += " with gradients";
+        }
+        profiler.profile(
+            name, n_pairs,
+            [&manager, &representation]() {
+              // the calculators skip the properties that are up to date
+              manager->set_updated_property_status(false);
+              representation.compute(manager);
+            },
+            label);
+      }
+    }
+  }
+
+}  // namespace rascal
+
+#endif  // PERFORMANCE_PROFILES_PROFILE_REPRESENTATION_HH_
@@ -34,10 +34,8 @@
 #include "rascal/math/interpolator.hh"
 #include "rascal/utils/json_io.hh"
 
-#include <chrono>
 #include <iostream>
 
-static constexpr int N_REPETITIONS = 200;
 static unsigned int SEED = 1597463007;
 
 using namespace rascal;  // NOLINT
@@ -53,8 +51,19 @@ using math::Vector_t;
  * interpolator. The computed grid is then used in the second run. If one wants
  * to profile the interpolate function together with the grid initialization
  * process, be sure to delete the *.grid file before.
+ *
+ * The optional json file given as argument overrides the values of
+ * default_config, the misses are given per interpolated point.
  */
-int main() {
+int main(int argc, char * argv[]) {
+  json default_config{{"n_iterations", 200},
+                      {"n_points", 1000000},
+                      {"n_evaluations", 1000000},
+                      {"error_bound", 1e-5},
+                      {"output", ""}};
+  json config = load_profile_config(argc, argv, default_config);
+  Profiler profiler{config};
+
   // hyp1f1 parameters
   double n = 5;
   double l = 4;
@@ -71,11 +80,11 @@ int main() {
   std::shared_ptr<IntpScalarUniformCubicSpline> intp;
   double x1{0};
   double x2{8};
-  double error_bound{1e-5};
+  double error_bound{config.at("error_bound").get<double>()};
 
   // profile parameters
-  size_t nb_points = 1e6;
-  size_t nb_iterations = 1000000;
+  size_t nb_points{config.at("n_points").get<size_t>()};
+  size_t nb_iterations{config.at("n_evaluations").get<size_t>()};
   const char * filename_grid{"profile_scalar_cubic_spline_grid.grid"};
   const char * filename_evaluated_grid{
       "profile_scalar_cubic_spline_grid.evaluated_grid"};
@@ -110,19 +119,12 @@ int main() {
       << "interpolation of scalar radial contribution: interpolator grid size "
       << intp->get_grid_size() << std::endl;
 
-  std::chrono::duration<double> elapsed{};
-  auto start = std::chrono::high_resolution_clock::now();
-  for (int j{0}; j < N_REPETITIONS; j++) {
+  profiler.profile("interpolation", nb_iterations, [&]() {
     for (size_t i{0}; i < nb_iterations; i++) {
       points_tmp(i % nb_points) = intp->interpolate(points(i % nb_points));
     }
-  }
-  auto finish = std::chrono::high_resolution_clock::now();
-
-  elapsed = finish - start;
-  std::cout << "Interpolation of " << nb_iterations << " points"
-            << " elapsed: " << elapsed.count() / N_REPETITIONS << " seconds"
-            << std::endl;
+  });
+  profiler.write();
 
   return 0;
 }
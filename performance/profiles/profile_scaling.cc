@@ -0,0 +1,468 @@
+/**
+ * @file  performance/profiles/profile_scaling.cc
+ *
+ * @date   18 October 2026
+ *
+ * @brief Scaling of the full pipeline (neighbour list, SOAP, sparse kernel,
+ *        forces) with the size of the system and the number of threads
+ *        with a roofline style report
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "synthetic_structures.hh"
+#include "utils.hh"
+
+#include "rascal/models/sparse_kernel_predict.hh"
+#include "rascal/models/sparse_kernels.hh"
+#include "rascal/models/sparse_points.hh"
+#include "rascal/representations/calculator_spherical_invariants.hh"
+#include "rascal/structure_managers/domain_decomposition.hh"
+#include "rascal/structure_managers/structure_manager_collection.hh"
+#include "rascal/utils/parallel.hh"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace rascal;  // NOLINT
+
+using Representation_t = CalculatorSphericalInvariants;
+using SparsePoints_t = SparsePointsBlockSparse<Representation_t>;
+using ManagerCollection_t =
+    typename TypeHolderInjector<ManagerCollection,
+                                typename DomainDecomposition::
+                                    ManagerTypeHolder_t::type_list>::type;
+using Manager_t = typename ManagerCollection_t::Manager_t;
+using Property_t = typename Representation_t::Property_t<Manager_t>;
+
+//! keeps the results of the peak measurements from being optimized away
+volatile double peaks_sink{0.};  // NOLINT
+
+/**
+ * Measures the peak floating point throughput of n_threads threads with
+ * independent multiply-add chains that the compiler can vectorize.
+ *
+ * @return FLOP/s
+ */
+double measure_peak_flops(const size_t n_threads, const size_t n_repetitions) {
+  constexpr size_t Width{32};
+  std::vector<double> sums(n_threads, 0.);
+  Timer timer{};
+  internal::parallel_for(n_threads, n_threads, [&](size_t i_task, size_t) {
+    std::array<double, Width> acc{};
+    for (size_t i{0}; i < Width; ++i) {
+      acc[i] = 1e-3 * static_cast<double>(i + i_task);
+    }
+    const double a{0.999999}, b{1e-7};
+    for (size_t i_rep{0}; i_rep < n_repetitions; ++i_rep) {
+      for (size_t i{0}; i < Width; ++i) {
+        acc[i] = acc[i] * a + b;
+      }
+    }
+    double sum{0.};
+    for (size_t i{0}; i < Width; ++i) {
+      sum += acc[i];
+    }
+    sums[i_task] = sum;
+  });
+  const double elapsed{timer.elapsed()};
+  peaks_sink = peaks_sink + sums[0];
+  return 2. * Width * n_repetitions * n_threads / elapsed;
+}
+
+/**
+ * Measures the memory bandwidth of n_threads threads with the STREAM triad
+ * a = b + s * c on arrays of n_elements doubles, counting 24 bytes per
+ * element.
+ *
+ * @return bytes/s
+ */
+double measure_peak_bandwidth(const size_t n_threads, const size_t n_elements,
+                              const size_t n_repetitions) {
+  std::vector<double> a(n_elements, 0.), b(n_elements, 1.),
+      c(n_elements, 2.);
+  const size_t chunk{(n_elements + n_threads - 1) / n_threads};
+  double best{0.};
+  for (size_t i_rep{0}; i_rep < n_repetitions; ++i_rep) {
+    Timer timer{};
+    internal::parallel_for(n_threads, n_threads, [&](size_t i_task, size_t) {
+      const size_t end{std::min(n_elements, (i_task + 1) * chunk)};
+      for (size_t i{i_task * chunk}; i < end; ++i) {
+        a[i] = b[i] + 3. * c[i];
+      }
+    });
+    const double elapsed{timer.elapsed()};
+    best = std::max(best, 24. * n_elements / elapsed);
+  }
+  peaks_sink = peaks_sink + a[n_elements / 2];
+  return best;
+}
+
+/**
+ * Estimated floating point operations and compulsory memory traffic of the
+ * phases of the pipeline. The operations are counted in the innermost loops
+ * (accumulation of the expansion, contraction of the power spectrum and of
+ * the kernel) and the traffic is the size of the arrays that are written
+ * and read back once (expansion, features and their gradients, sparse
+ * points), so these are lower bounds of the actual costs.
+ */
+json estimate_costs(const json & hypers, const size_t n_species,
+                    const size_t n_centers, const size_t n_pairs,
+                    const size_t n_features, const size_t n_sparse,
+                    const size_t zeta) {
+  const double n_max{hypers.at("max_radial").get<double>()};
+  const double n_lm{std::pow(hypers.at("max_angular").get<double>() + 1, 2)};
+  const double n_sp{static_cast<double>(n_species)};
+  const double C{static_cast<double>(n_centers)};
+  const double P{static_cast<double>(n_pairs)};
+  // the gradients include the center itself
+  const double G{P + C};
+  const double F{static_cast<double>(n_features)};
+  const double K{static_cast<double>(n_sparse)};
+  const double word{sizeof(double)};
+
+  json costs{};
+  costs["neighbour list"] = {{"flops", 8. * P},
+                             {"bytes", C * 3 * word + P * (3 * word + 4.)}};
+  // expansion and its 3 gradients accumulated for each pair, then the
+  // power spectrum and the gradients of each species channel
+  costs["representation"] = {
+      {"flops", 2. * n_max * n_lm * 4. * P +
+                    2. * C * n_sp * (n_sp + 1) / 2 * n_max * n_max * n_lm +
+                    4. * G * 3 * n_sp * n_max * n_max * n_lm},
+      {"bytes", 2. * (C * n_sp + G * 3) * n_max * n_lm * word +
+                    (C + G * 3) * F * word}};
+  // kernel between the centers and the sparse points, its derivative
+  // w.r.t. the features and the contraction with the feature gradients
+  costs["kernel and forces"] = {
+      {"flops", 4. * C * K * F + 2. * C * K * zeta + 2. * G * 3 * F},
+      {"bytes", (C + K + G * 3) * F * word}};
+  double flops{0.}, bytes{0.};
+  for (auto && phase : costs) {
+    flops += phase["flops"].get<double>();
+    bytes += phase["bytes"].get<double>();
+  }
+  costs["pipeline"] = {{"flops", flops}, {"bytes", bytes}};
+  return costs;
+}
+
+/**
+ * Adds the achieved throughputs and the fraction of the roofline bound
+ * min(peak FLOP/s, arithmetic intensity * peak bandwidth) to the result of
+ * a phase.
+ */
+void add_roofline(json & result, const json & cost, const json & peaks) {
+  const double time{result.at("time").get<double>()};
+  const double flops{cost.at("flops").get<double>()};
+  const double bytes{cost.at("bytes").get<double>()};
+  const double intensity{flops / bytes};
+  const double bound{std::min(peaks.at("flops").get<double>(),
+                              intensity * peaks.at("bandwidth").get<double>())};
+  result["flops"] = flops;
+  result["bytes"] = bytes;
+  result["flop_rate"] = flops / time;
+  result["byte_rate"] = bytes / time;
+  result["arithmetic_intensity"] = intensity;
+  result["roofline_bound"] = bound;
+  result["roofline_fraction"] = flops / time / bound;
+}
+
+/**
+ * Profile of the scaling of the pipeline with the size of synthetic
+ * structures and the number of threads. Run with
+ *
+ *     ./profile_scaling [config.json]
+ *
+ * where the optional config.json overrides the values of default_config,
+ * e.g. {"n_threads": [1, 8, 16], "systems": [{"type": "liquid",
+ * "density": 0.1, "n_atoms": [1000, 8000]}]}.
+ *
+ * For each structure the phases of the pipeline are first profiled one by
+ * one in a single thread on the whole structure. Then the whole pipeline is
+ * run by domains (see DomainDecomposition), which is the threaded path of
+ * the library, for each number of threads; 1 is always added to them and
+ * is the reference of the speedups. The achieved FLOP/s and bytes/s are
+ * estimated with estimate_costs() and compared with the peaks of the
+ * machine measured with the same number of threads. The results are
+ * written in the "output" json file and a summary in the "summary" text
+ * file.
+ */
+int main(int argc, char * argv[]) {
+  json hypers{{"max_radial", 6},
+              {"max_angular", 4},
+              {"soap_type", "PowerSpectrum"},
+              {"normalize", true}};
+  hypers["cutoff_function"] = {
+      {"type", "ShiftedCosine"},
+      {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
+  hypers["gaussian_density"] = {
+      {"type", "Constant"},
+      {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
+  hypers["radial_contribution"] = {{"type", "GTO"}};
+
+  json default_config{
+      {"systems",
+       {{{"type", "liquid"}, {"density", 0.1}, {"n_atoms", {128, 512, 2048}}},
+        {{"type", "crystal"}, {"density", 0.08}, {"n_atoms", {256, 864}}},
+        {{"type", "molecules"},
+         {"density", 0.1},
+         {"molecule_size", 12},
+         {"n_atoms", {240, 960}}}}},
+      {"species", {1, 6, 8}},
+      {"seed", 10},
+      {"n_threads", {1, 2, 4}},
+      {"n_domains", {2, 2, 2}},
+      {"n_iterations", 3},
+      {"cutoff", 4.},
+      {"hypers", hypers},
+      {"zeta", 2},
+      {"n_sparse_per_species", 20},
+      {"peaks",
+       {{"flop_repetitions", 10000000},
+        {"bandwidth_array_size", 4194304},
+        {"n_repetitions", 5}}},
+      {"output", "scaling.json"},
+      {"summary", "scaling.txt"}};
+  json config = load_profile_config(argc, argv, default_config);
+  json profiler_config = config;
+  profiler_config["output"] = "";
+  Profiler profiler{profiler_config};
+
+  const double cutoff{config.at("cutoff").get<double>()};
+  hypers = config.at("hypers");
+  hypers["cutoff_function"]["cutoff"] = {{"value", cutoff}, {"unit", "AA"}};
+  hypers["compute_gradients"] = true;
+  // the single threaded measurements are the reference of the speedups so
+  // 1 is always part of the (sorted) numbers of threads
+  auto n_threads_list{config.at("n_threads").get<std::vector<size_t>>()};
+  n_threads_list.push_back(1);
+  std::sort(n_threads_list.begin(), n_threads_list.end());
+  n_threads_list.erase(
+      std::unique(n_threads_list.begin(), n_threads_list.end()),
+      n_threads_list.end());
+  const auto n_domains{config.at("n_domains").get<std::array<int, 3>>()};
+  const size_t zeta{config.at("zeta").get<size_t>()};
+  SparseKernel kernel{
+      json{{"name", "GAP"}, {"zeta", zeta}, {"target_type", "Structure"}}};
+
+  json report{};
+  report["config"] = config;
+
+  // peaks of the machine
+  const json & peaks_config{config.at("peaks")};
+  std::map<size_t, json> peaks{};
+  for (auto n_threads : n_threads_list) {
+    double flops{0.};
+    for (size_t i_rep{0};
+         i_rep < peaks_config.at("n_repetitions").get<size_t>(); ++i_rep) {
+      flops = std::max(
+          flops, measure_peak_flops(
+                     n_threads,
+                     peaks_config.at("flop_repetitions").get<size_t>()));
+    }
+    peaks[n_threads] = {
+        {"flops", flops},
+        {"bandwidth",
+         measure_peak_bandwidth(
+             n_threads, peaks_config.at("bandwidth_array_size").get<size_t>(),
+             peaks_config.at("n_repetitions").get<size_t>())}};
+    report["machine"][std::to_string(n_threads)] = peaks[n_threads];
+    std::cout << "peaks with " << n_threads << " threads: " << std::scientific
+              << std::setprecision(3) << peaks[n_threads]["flops"].get<double>()
+              << " FLOP/s, " << peaks[n_threads]["bandwidth"].get<double>()
+              << " B/s" << std::defaultfloat << std::endl;
+  }
+
+  std::stringstream summary{};
+  summary << std::left << std::setw(30) << "system" << std::setw(22)
+          << "phase" << std::right << std::setw(8) << "threads"
+          << std::setw(12) << "time [s]" << std::setw(10) << "speedup"
+          << std::setw(11) << "GFLOP/s" << std::setw(10) << "GB/s"
+          << std::setw(10) << "FLOP/B" << std::setw(11) << "roofline"
+          << "\n";
+
+  report["systems"] = json::array();
+  for (auto && system : config.at("systems")) {
+    for (auto && n_atoms : system.at("n_atoms")) {
+      json parameters = system;
+      parameters["n_atoms"] = n_atoms;
+      parameters["species"] = config.at("species");
+      parameters["seed"] = config.at("seed");
+      SyntheticStructureGenerator generator{parameters};
+      auto structure = generator.make_structure();
+
+      DomainDecomposition domains{structure, cutoff, n_domains};
+      ManagerCollection_t managers{domains.get_adaptor_inputs()};
+      managers.add_structures(std::vector<AtomicStructure<3>>{structure});
+      auto manager = managers[0];
+      Representation_t representation{hypers};
+      representation.compute(managers);
+
+      size_t n_pairs{0};
+      std::set<int> species{};
+      std::map<int, size_t> n_centers_by_sp{};
+      std::vector<std::vector<int>> selected_ids(1);
+      const size_t n_sparse_per_species{
+          config.at("n_sparse_per_species").get<size_t>()};
+      int i_center{0};
+      for (auto center : manager) {
+        species.insert(center.get_atom_type());
+        if (n_centers_by_sp[center.get_atom_type()]++ < n_sparse_per_species) {
+          selected_ids[0].push_back(i_center);
+        }
+        for (auto neigh : center.pairs()) {
+          (void)neigh;
+          n_pairs++;
+        }
+        i_center++;
+      }
+      SparsePoints_t sparse_points{};
+      sparse_points.push_back(representation, managers, selected_ids);
+      math::Vector_t weights{math::Vector_t::Random(sparse_points.size())};
+      const size_t n_features{static_cast<size_t>(
+          manager->template get_property<Property_t>(representation.get_name())
+              ->get_features()
+              .cols())};
+
+      std::stringstream label_stream{};
+      label_stream << parameters.at("type").get<std::string>() << " "
+                   << manager->size() << " atoms";
+      const std::string label{label_stream.str()};
+      std::cout << label << ": " << n_pairs << " pairs, " << n_features
+                << " features, " << sparse_points.size() << " sparse points"
+                << std::endl;
+      json costs = estimate_costs(hypers, species.size(), manager->size(),
+                                  n_pairs, n_features, sparse_points.size(),
+                                  zeta);
+
+      json system_report{{"parameters", parameters},
+                         {"n_atoms", manager->size()},
+                         {"n_pairs", n_pairs},
+                         {"n_features", n_features},
+                         {"n_sparse_points", sparse_points.size()},
+                         {"phases", json::array()}};
+      auto add_result = [&](json result, const std::string & phase,
+                            const size_t n_threads, const double reference) {
+        add_roofline(result, costs[phase], peaks[n_threads]);
+        result["n_threads"] = n_threads;
+        result["speedup"] = reference / result["time"].get<double>();
+        system_report["phases"].push_back(result);
+        summary << std::left << std::setw(30) << label << std::setw(22)
+                << phase << std::right << std::setw(8) << n_threads
+                << std::scientific << std::setprecision(3) << std::setw(12)
+                << result["time"].get<double>() << std::fixed
+                << std::setprecision(2) << std::setw(10)
+                << result["speedup"].get<double>() << std::setw(11)
+                << result["flop_rate"].get<double>() * 1e-9 << std::setw(10)
+                << result["byte_rate"].get<double>() * 1e-9 << std::setw(10)
+                << result["arithmetic_intensity"].get<double>()
+                << std::setw(10)
+                << 100. * result["roofline_fraction"].get<double>() << "%"
+                << std::defaultfloat << "\n";
+      };
+
+      // single threaded phases on the whole structure, the neighbour list
+      // is only rebuilt when the positions change so the updates alternate
+      // between the structure and a rigidly translated copy
+      const size_t n_threads_ref{1};
+      AtomicStructure<3> translated{structure};
+      translated.positions.array() += 1e-8;
+      json result = profiler.profile(
+          "neighbour list", n_pairs,
+          [&manager, &structure, &translated]() {
+            manager->update(translated);
+            manager->update(structure);
+          },
+          label);
+      result["time"] = result["time"].get<double>() / 2;
+      add_result(result, "neighbour list", n_threads_ref,
+                 result["time"].get<double>());
+
+      result = profiler.profile(
+          "representation", n_pairs,
+          [&manager, &managers, &representation]() {
+            manager->set_updated_property_status(false);
+            representation.compute(managers);
+          },
+          label);
+      add_result(result, "representation", n_threads_ref,
+                 result["time"].get<double>());
+
+      result = profiler.profile(
+          "kernel and forces", n_pairs,
+          [&]() {
+            // keeps the representation but recomputes the predictions
+            manager->set_updated_property_status(false);
+            manager->set_updated_property_status(representation.get_name(),
+                                                 true);
+            manager->set_updated_property_status(
+                representation.get_gradient_name(), true);
+            compute_sparse_kernel_predictions(representation, kernel,
+                                              managers, sparse_points,
+                                              weights);
+          },
+          label);
+      add_result(result, "kernel and forces", n_threads_ref,
+                 result["time"].get<double>());
+
+      // threaded pipeline by domains, the speedups are relative to the
+      // single threaded run which comes first
+      double reference{0.};
+      for (auto n_threads : n_threads_list) {
+        result = profiler.profile(
+            "pipeline", n_pairs,
+            [&]() {
+              compute_sparse_kernel_predictions_by_domains<Representation_t>(
+                  domains, hypers, kernel, sparse_points, weights, n_threads);
+            },
+            label + ", " + std::to_string(n_threads) + " threads");
+        if (reference == 0.) {
+          reference = result["time"].get<double>();
+        }
+        add_result(result, "pipeline", n_threads, reference);
+      }
+      report["systems"].push_back(system_report);
+    }
+  }
+
+  std::cout << "\n" << summary.str();
+  if (config.at("output").get<std::string>().size() > 0) {
+    std::ofstream out{config.at("output").get<std::string>()};
+    out << report.dump(2) << std::endl;
+  }
+  if (config.at("summary").get<std::string>().size() > 0) {
+    std::ofstream out{config.at("summary").get<std::string>()};
+    out << "peaks of the machine:\n";
+    for (auto && peak : peaks) {
+      out << std::setw(4) << peak.first << " threads: " << std::scientific
+          << std::setprecision(3) << peak.second["flops"].get<double>()
+          << " FLOP/s, " << peak.second["bandwidth"].get<double>()
+          << " B/s\n";
+    }
+    out << std::defaultfloat << "\n" << summary.str();
+  }
+  return 0;
+}
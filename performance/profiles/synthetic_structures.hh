@@ -0,0 +1,256 @@
+/**
+ * @file  performance/profiles/synthetic_structures.hh
+ *
+ * @date   18 October 2026
+ *
+ * @brief Generators of synthetic structures of arbitrary size for the
+ *        scaling profiles
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef PERFORMANCE_PROFILES_SYNTHETIC_STRUCTURES_HH_
+#define PERFORMANCE_PROFILES_SYNTHETIC_STRUCTURES_HH_
+
+#include "rascal/structure_managers/atomic_structure.hh"
+#include "rascal/utils/json_io.hh"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace rascal {
+
+  /**
+   * Builds synthetic structures from a json description:
+   *
+   *  - {"type": "liquid", "n_atoms": N, "density": rho}: N atoms placed at
+   *    random in a periodic cubic box of number density rho (atoms/AA^3)
+   *    with no two atoms closer than "min_distance"
+   *  - {"type": "crystal", "n_atoms": N, "density": rho}: periodic fcc
+   *    crystal with at least N atoms and number density rho, the atoms are
+   *    randomly displaced by up to "displacement"
+   *  - {"type": "molecules", "n_atoms": N, "molecule_size": M,
+   *     "density": rho}: N / M random compact molecules of M atoms (density
+   *    rho inside a molecule) put on a grid with at least "spacing" between
+   *    their atoms, without periodicity
+   *
+   * The species are drawn at random from "species" and the structures are
+   * reproducible for a given "seed".
+   */
+  class SyntheticStructureGenerator {
+   public:
+    using Structure_t = AtomicStructure<3>;
+
+    explicit SyntheticStructureGenerator(const json & parameters)
+        : type{parameters.at("type").get<std::string>()},
+          n_atoms{parameters.at("n_atoms").get<int>()},
+          density{parameters.at("density").get<double>()},
+          species{parameters.value("species", std::vector<int>{1, 6, 8})},
+          min_distance{parameters.value("min_distance", 1.)},
+          displacement{parameters.value("displacement", 0.1)},
+          molecule_size{parameters.value("molecule_size", 12)},
+          spacing{parameters.value("spacing", 6.)},
+          generator{parameters.value("seed", 10u)} {
+      if (this->n_atoms < 1 or this->density <= 0.) {
+        std::stringstream err_str{};
+        err_str << "The number of atoms and the density of a synthetic "
+                << "structure should be positive: '" << this->n_atoms
+                << "', '" << this->density << "'.";
+        throw std::runtime_error(err_str.str());
+      }
+    }
+
+    Structure_t make_structure() {
+      if (this->type == "liquid") {
+        return this->make_liquid();
+      } else if (this->type == "crystal") {
+        return this->make_crystal();
+      } else if (this->type == "molecules") {
+        return this->make_molecules();
+      } else {
+        std::stringstream err_str{};
+        err_str << "Unknown type of synthetic structure: '" << this->type
+                << "', expected 'liquid', 'crystal' or 'molecules'.";
+        throw std::runtime_error(err_str.str());
+      }
+    }
+
+   protected:
+    Structure_t make_liquid() {
+      const double length{std::cbrt(this->n_atoms / this->density)};
+      Structure_t structure{};
+      structure.cell = Eigen::Matrix3d::Identity() * length;
+      structure.pbc.setOnes();
+      structure.positions =
+          this->random_packing(this->n_atoms, length, structure.cell, true);
+      this->set_species(structure);
+      return structure;
+    }
+
+    Structure_t make_crystal() {
+      // 4 atoms per conventional fcc cell
+      const std::array<Eigen::Vector3d, 4> basis{
+          {Eigen::Vector3d{0., 0., 0.}, Eigen::Vector3d{0.5, 0.5, 0.},
+           Eigen::Vector3d{0.5, 0., 0.5}, Eigen::Vector3d{0., 0.5, 0.5}}};
+      const int n_replicas{
+          static_cast<int>(std::ceil(std::cbrt(this->n_atoms / 4.) - 1e-10))};
+      const double lattice{std::cbrt(4. / this->density)};
+      const int n_tot{4 * n_replicas * n_replicas * n_replicas};
+
+      Structure_t structure{};
+      structure.cell = Eigen::Matrix3d::Identity() * lattice * n_replicas;
+      structure.pbc.setOnes();
+      structure.positions.resize(3, n_tot);
+      std::uniform_real_distribution<double> shift(-this->displacement,
+                                                   this->displacement);
+      int i_atom{0};
+      for (int ix{0}; ix < n_replicas; ++ix) {
+        for (int iy{0}; iy < n_replicas; ++iy) {
+          for (int iz{0}; iz < n_replicas; ++iz) {
+            for (const auto & site : basis) {
+              for (int i_dim{0}; i_dim < 3; ++i_dim) {
+                structure.positions(i_dim, i_atom) = lattice * site(i_dim) +
+                                                     shift(this->generator);
+              }
+              structure.positions.col(i_atom) +=
+                  lattice * Eigen::Vector3d(ix, iy, iz);
+              // wrap the displaced atoms back in the cell
+              for (int i_dim{0}; i_dim < 3; ++i_dim) {
+                const double length{structure.cell(i_dim, i_dim)};
+                double & position{structure.positions(i_dim, i_atom)};
+                position -= length * std::floor(position / length);
+              }
+              i_atom++;
+            }
+          }
+        }
+      }
+      this->set_species(structure);
+      return structure;
+    }
+
+    Structure_t make_molecules() {
+      const int n_molecules{
+          std::max(this->n_atoms / this->molecule_size, 1)};
+      const int n_grid{static_cast<int>(std::ceil(std::cbrt(n_molecules)))};
+      // the atoms of a molecule are in a cube of this side
+      const double size{std::cbrt(this->molecule_size / this->density)};
+      const double pitch{size + this->spacing};
+
+      Structure_t structure{};
+      structure.cell = Eigen::Matrix3d::Identity() * pitch * n_grid;
+      structure.pbc.setZero();
+      structure.positions.resize(3, n_molecules * this->molecule_size);
+      for (int i_molecule{0}; i_molecule < n_molecules; ++i_molecule) {
+        Eigen::Vector3d origin{
+            Eigen::Vector3d(i_molecule % n_grid, (i_molecule / n_grid) % n_grid,
+                            i_molecule / (n_grid * n_grid)) *
+            pitch};
+        structure.positions.middleCols(i_molecule * this->molecule_size,
+                                       this->molecule_size) =
+            this->random_packing(this->molecule_size, size,
+                                 Eigen::Matrix3d::Identity() * size, false)
+                .colwise() +
+            origin;
+      }
+      this->set_species(structure);
+      return structure;
+    }
+
+    /**
+     * n_points random positions in a cube of side length with no two
+     * points closer than min_distance (accounting for the periodic images if
+     * periodic)
+     */
+    Eigen::MatrixXd random_packing(const int n_points, const double length,
+                                   const Eigen::Matrix3d & cell,
+                                   const bool periodic) {
+      const int max_attempts{1000};
+      const double min_distance2{this->min_distance * this->min_distance};
+      std::uniform_real_distribution<double> uniform(0., length);
+      Eigen::MatrixXd positions(3, n_points);
+      for (int i_point{0}; i_point < n_points; ++i_point) {
+        int i_attempt{0};
+        for (; i_attempt < max_attempts; ++i_attempt) {
+          Eigen::Vector3d position{uniform(this->generator),
+                                   uniform(this->generator),
+                                   uniform(this->generator)};
+          bool accepted{true};
+          for (int j_point{0}; j_point < i_point; ++j_point) {
+            Eigen::Vector3d diff{position - positions.col(j_point)};
+            if (periodic) {
+              for (int i_dim{0}; i_dim < 3; ++i_dim) {
+                diff(i_dim) -= cell(i_dim, i_dim) *
+                               std::round(diff(i_dim) / cell(i_dim, i_dim));
+              }
+            }
+            if (diff.squaredNorm() < min_distance2) {
+              accepted = false;
+              break;
+            }
+          }
+          if (accepted) {
+            positions.col(i_point) = position;
+            break;
+          }
+        }
+        if (i_attempt == max_attempts) {
+          std::stringstream err_str{};
+          err_str << "Could not place " << n_points << " atoms at least "
+                  << this->min_distance << " AA apart at the density "
+                  << this->density << ", decrease the density or the "
+                  << "min_distance.";
+          throw std::runtime_error(err_str.str());
+        }
+      }
+      return positions;
+    }
+
+    void set_species(Structure_t & structure) {
+      const auto n_tot{structure.positions.cols()};
+      std::uniform_int_distribution<size_t> pick(0, this->species.size() - 1);
+      structure.atom_types.resize(n_tot);
+      for (Eigen::Index i_atom{0}; i_atom < n_tot; ++i_atom) {
+        structure.atom_types(i_atom) = this->species[pick(this->generator)];
+      }
+      structure.center_atoms_mask.resize(n_tot);
+      structure.center_atoms_mask.setConstant(true);
+    }
+
+    std::string type;
+    int n_atoms;
+    double density;
+    std::vector<int> species;
+    double min_distance;
+    double displacement;
+    int molecule_size;
+    double spacing;
+    std::mt19937 generator;
+  };
+
+}  // namespace rascal
+
+#endif  // PERFORMANCE_PROFILES_SYNTHETIC_STRUCTURES_HH_
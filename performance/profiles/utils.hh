@@ -29,13 +29,25 @@
 #define PERFORMANCE_PROFILES_UTILS_HH_
 
 #include "rascal/math/utils.hh"
+#include "rascal/utils/json_io.hh"
 
 #include <sys/stat.h>
 #include <unistd.h>
 
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include <array>
 #include <chrono>  // for std::chrono functions
 #include <cmath>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
 
 namespace rascal {
 
@@ -95,5 +107,222 @@ namespace rascal {
     struct stat buffer;
     return (stat(name, &buffer) == 0);
   }
+
+  /**
+   * Hardware counters of the Linux perf_event interface (cycles,
+   * instructions, cache misses and branch misses) of the calling process.
+   * Only the user space is counted so that it works with the default
+   * perf_event_paranoid setting, and the counters are inherited by the
+   * threads created after the construction (e.g. by parallel_for).
+   *
+   * When an event is not available (not Linux, virtual machine without PMU,
+   * perf_event_open forbidden, ...) its count is reported as -1.
+   */
+  class PerfCounters {
+   public:
+    static constexpr size_t NEvents{4};
+    using Counts_t = std::array<long long, NEvents>;  // NOLINT
+
+    //! names of the events in the order of Counts_t
+    static const std::array<const char *, NEvents> & get_names() {
+      static const std::array<const char *, NEvents> names{
+          {"cycles", "instructions", "cache_misses", "branch_misses"}};
+      return names;
+    }
+
+    PerfCounters() {
+      this->fds.fill(-1);
+#ifdef __linux__
+      const std::array<uint64_t, NEvents> configs{
+          {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+           PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES}};
+      for (size_t i_event{0}; i_event < NEvents; ++i_event) {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = configs[i_event];
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        this->fds[i_event] = static_cast<int>(
+            syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+      }
+#endif
+    }
+
+    ~PerfCounters() {
+      for (auto fd : this->fds) {
+        if (fd >= 0) {
+          close(fd);
+        }
+      }
+    }
+
+    PerfCounters(const PerfCounters & other) = delete;
+    PerfCounters & operator=(const PerfCounters & other) = delete;
+
+    //! true if at least one of the events can be counted
+    bool is_available() const {
+      for (auto fd : this->fds) {
+        if (fd >= 0) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    //! reset and start the counters
+    void start() {
+#ifdef __linux__
+      for (auto fd : this->fds) {
+        if (fd >= 0) {
+          ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+          ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+      }
+#endif
+    }
+
+    //! stop the counters and return the counts since the last start()
+    Counts_t stop() {
+      Counts_t counts{};
+      counts.fill(-1);
+#ifdef __linux__
+      for (auto fd : this->fds) {
+        if (fd >= 0) {
+          ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+      }
+      for (size_t i_event{0}; i_event < NEvents; ++i_event) {
+        long long count{0};  // NOLINT
+        if (this->fds[i_event] >= 0 and
+            read(this->fds[i_event], &count, sizeof(count)) ==
+                static_cast<ssize_t>(sizeof(count))) {
+          counts[i_event] = count;
+        }
+      }
+#endif
+      return counts;
+    }
+
+   protected:
+    std::array<int, NEvents> fds{};
+  };
+
+  /**
+   * Returns the configuration of a profile: the json file given as first
+   * command line argument is merged (RFC 7396 merge patch) into the default
+   * configuration so only the values that differ need to be given, e.g.
+   *
+   *     {"n_iterations": 5, "hypers": {"max_radial": 12}}
+   */
+  inline json load_profile_config(int argc, char * argv[],
+                                  const json & default_config) {
+    json config = default_config;
+    if (argc > 1) {
+      config.merge_patch(json_io::load(argv[1]));
+    }
+    return config;
+  }
+
+  /**
+   * Runs the phases of a profile with the wall time and the hardware
+   * counters, prints the time per iteration, the instructions per cycle and
+   * the misses per element (e.g. per pair or per interpolated point) and
+   * gathers the results in a json that can be written to the "output" file
+   * of the configuration.
+   */
+  class Profiler {
+   public:
+    explicit Profiler(const json & config)
+        : n_iterations{config.at("n_iterations").get<size_t>()},
+          output{config.value("output", std::string{""})}, results{} {
+      this->results["config"] = config;
+      this->results["phases"] = json::array();
+      if (not this->counters.is_available()) {
+        std::cout << "Hardware counters are not available (see "
+                     "/proc/sys/kernel/perf_event_paranoid), only the wall "
+                     "time is reported."
+                  << std::endl;
+      }
+    }
+
+    /**
+     * Calls function n_iterations times and reports the measurements
+     * averaged over the iterations.
+     *
+     * @param name name of the phase
+     * @param n_elements number of elements processed by one call of
+     *                   function, used to normalize the misses
+     * @param label additional description of the phase, e.g. the structure
+     */
+    template <class Function>
+    json profile(const std::string & name, size_t n_elements,
+                 Function && function, const std::string & label = "") {
+      Timer timer{};
+      this->counters.start();
+      for (size_t i_iteration{0}; i_iteration < this->n_iterations;
+           ++i_iteration) {
+        function();
+      }
+      auto counts = this->counters.stop();
+      double elapsed{timer.elapsed()};
+
+      const double n_iter{static_cast<double>(this->n_iterations)};
+      json result{{"name", name},
+                  {"label", label},
+                  {"n_elements", n_elements},
+                  {"time", elapsed / n_iter}};
+      auto && names = PerfCounters::get_names();
+      for (size_t i_event{0}; i_event < PerfCounters::NEvents; ++i_event) {
+        if (counts[i_event] >= 0) {
+          result[names[i_event]] = static_cast<double>(counts[i_event]) / n_iter;
+        }
+      }
+
+      std::cout << std::left << std::setw(40) << name << " "
+                << std::setw(30) << label << std::right
+                << " time: " << std::scientific << std::setprecision(4)
+                << result["time"].get<double>() << " s";
+      if (result.count("cycles") and result.count("instructions") and
+          result["cycles"].get<double>() > 0) {
+        result["ipc"] = result["instructions"].get<double>() /
+                        result["cycles"].get<double>();
+        std::cout << "  IPC: " << std::fixed << std::setprecision(2)
+                  << result["ipc"].get<double>();
+      }
+      if (n_elements > 0) {
+        for (const std::string miss : {"cache_misses", "branch_misses"}) {
+          if (result.count(miss)) {
+            std::string key{miss + "_per_element"};
+            result[key] = result[miss].get<double>() / n_elements;
+            std::cout << "  " << key << ": " << std::fixed
+                      << std::setprecision(3) << result[key].get<double>();
+          }
+        }
+      }
+      std::cout << std::defaultfloat << std::endl;
+
+      this->results["phases"].push_back(result);
+      return result;
+    }
+
+    //! write the results in the output file of the configuration, if any
+    void write() const {
+      if (this->output.size() > 0) {
+        std::ofstream out{this->output};
+        out << this->results.dump(2) << std::endl;
+        std::cout << "Results written in " << this->output << std::endl;
+      }
+    }
+
+   protected:
+    size_t n_iterations;
+    std::string output;
+    json results;
+    PerfCounters counters{};
+  };
 }  // namespace rascal
 #endif  // PERFORMANCE_PROFILES_UTILS_HH_
@@ -189,3 +189,43 @@ void ModifiedSphericalBessel::set_small_bessel_values_to_zero() {
     }
   });
 }
+
+void rascal::math::compute_spherical_bessel(
+    double x, Eigen::Ref<Eigen::ArrayXd> values) {
+  const int l_max{static_cast<int>(values.size()) - 1};
+  values = 0.;
+  // j_l(x) ~ x^l / (2l+1)!!
+  if (x < 1e-10) {
+    values(0) = 1.;
+    return;
+  }
+  // j_l(x) decays quickly once l is larger than x so the recursion
+  // started from there converges to the minimal solution
+  const int l_start{l_max + 30 +
+                    static_cast<int>(x + 4. * std::sqrt(x + 1.))};
+  const double rescale{1e-200};
+  double j_next{0.}, j_curr{1.};
+  for (int l{l_start}; l > 0; --l) {
+    const double j_prev{(2 * l + 1) / x * j_curr - j_next};
+    j_next = j_curr;
+    j_curr = j_prev;
+    if (l - 1 <= l_max) {
+      values(l - 1) = j_curr;
+    }
+    if (std::abs(j_curr) > 1. / rescale) {
+      j_curr *= rescale;
+      j_next *= rescale;
+      if (l - 1 <= l_max) {
+        values.tail(l_max - l + 2) *= rescale;
+      }
+    }
+  }
+  // j_curr and j_next are now proportional to j_0 and j_1
+  const double j_0{std::sin(x) / x};
+  const double j_1{(std::sin(x) / x - std::cos(x)) / x};
+  if (std::abs(j_0) > std::abs(j_1)) {
+    values *= j_0 / j_curr;
+  } else {
+    values *= j_1 / j_next;
+  }
+}
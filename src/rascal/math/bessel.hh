@@ -204,6 +204,25 @@ namespace rascal {
       int n_max{};
     };
 
+    /**
+     * Computes the spherical Bessel functions of the first kind
+     * \f$j_\ell(x)\f$ for \f$\ell = 0, \dots, \ell_\text{max}\f$.
+     *
+     * The upward recursion is unstable for \f$\ell > x\f$ so Miller's
+     * downward recursion
+     * \f[
+     *    j_{\ell-1}(x) = (2\ell + 1)/x j_\ell(x) - j_{\ell+1}(x)
+     * \f]
+     * is started well above \f$\max(\ell_\text{max}, x)\f$ and the result
+     * is normalized with \f$j_0(x) = \sin(x)/x\f$ or
+     * \f$j_1(x) = \sin(x)/x^2 - \cos(x)/x\f$, whichever is the largest.
+     *
+     * @param x argument of the functions, x >= 0
+     * @param values array of size \f$\ell_\text{max}+1\f$ filled with the
+     *               values
+     */
+    void compute_spherical_bessel(double x, Eigen::Ref<Eigen::ArrayXd> values);
+
   }  // namespace math
 }  // namespace rascal
 
@@ -0,0 +1,168 @@
+/**
+ * @file   rascal/math/cholesky.hh
+ *
+ * @date   18 October 2026
+ *
+ * @brief  Cholesky factorisation that can be updated in place
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_RASCAL_MATH_CHOLESKY_HH_
+#define SRC_RASCAL_MATH_CHOLESKY_HH_
+
+#include "rascal/math/utils.hh"
+
+#include <Eigen/Dense>
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace rascal {
+  namespace math {
+
+    /**
+     * Lower Cholesky factor \f$L\f$ of a symmetric positive definite matrix
+     * \f$A = L L^T\f$ that follows the updates of \f$A\f$ without being
+     * recomputed:
+     *
+     * - add_rows: \f$A \leftarrow A + U^T U\f$ with k rows in \f$U\f$ costs
+     *   \f$O(k n^2)\f$ instead of \f$O(n^3)\f$,
+     * - extend: bordering \f$A\f$ with m rows and columns costs
+     *   \f$O(m n^2 + m^3)\f$.
+     *
+     * It is typically used to update the normal equations of a sparse GPR
+     * when training data or sparse points are added.
+     */
+    class UpdatableCholesky {
+     public:
+      using Factor_t = Eigen::MatrixXd;
+
+      UpdatableCholesky() = default;
+
+      //! Factorise the symmetric positive definite matrix A
+      explicit UpdatableCholesky(const Eigen::Ref<const Matrix_t> & A) {
+        this->extend(Matrix_t(0, A.cols()), A);
+      }
+
+      //! size of the factorised matrix
+      Eigen::Index size() const { return this->factor.rows(); }
+
+      //! lower triangular factor L
+      const Factor_t & get_factor() const { return this->factor; }
+
+      /**
+       * Update the factor of A to the one of A + U^T U, i.e. a rank k update
+       * with the k rows of U, with one sequence of Givens rotations per row.
+       */
+      void add_rows(const Eigen::Ref<const Matrix_t> & U) {
+        const Eigen::Index n{this->size()};
+        if (U.cols() != n) {
+          std::stringstream err_str{};
+          err_str << "The update has " << U.cols()
+                  << " columns but the factorised matrix has size " << n
+                  << ".";
+          throw std::runtime_error(err_str.str());
+        }
+        auto & L = this->factor;
+        // the rows of U are overwritten by the rotations
+        Matrix_t rows{U};
+        for (Eigen::Index i_row{0}; i_row < rows.rows(); ++i_row) {
+          auto x = rows.row(i_row);
+          for (Eigen::Index k{0}; k < n; ++k) {
+            const double r{std::hypot(L(k, k), x(k))};
+            const double c{r / L(k, k)};
+            const double s{x(k) / L(k, k)};
+            L(k, k) = r;
+            const Eigen::Index n_tail{n - k - 1};
+            if (n_tail > 0) {
+              auto L_tail = L.col(k).tail(n_tail);
+              auto x_tail = x.tail(n_tail).transpose();
+              L_tail = (L_tail + s * x_tail) / c;
+              x_tail = c * x_tail - s * L_tail;
+            }
+          }
+        }
+      }
+
+      /**
+       * Update the factor of A to the one of
+       *
+       * @f[
+       *    \begin{pmatrix} A & B \\ B^T & C \end{pmatrix},
+       * @f]
+       *
+       * i.e. append the rows and columns of new variables to A.
+       *
+       * @param B coupling between the current and the new variables
+       * @param C symmetric block of the new variables
+       * @throw runtime_error if the extended matrix is not positive definite
+       */
+      void extend(const Eigen::Ref<const Matrix_t> & B,
+                  const Eigen::Ref<const Matrix_t> & C) {
+        const Eigen::Index n{this->size()};
+        const Eigen::Index m{C.rows()};
+        if (B.rows() != n or B.cols() != m or C.cols() != m) {
+          std::stringstream err_str{};
+          err_str << "Extending a factor of size " << n
+                  << " needs B of shape (" << n << ", m) and C of shape (m, m)"
+                  << " but got (" << B.rows() << ", " << B.cols() << ") and ("
+                  << C.rows() << ", " << C.cols() << ").";
+          throw std::runtime_error(err_str.str());
+        }
+        // L_21 = (L^{-1} B)^T and L_22 L_22^T = C - L_21 L_21^T
+        Factor_t L_21{
+            this->factor.triangularView<Eigen::Lower>().solve(B).transpose()};
+        Factor_t S{C};
+        S.noalias() -= L_21 * L_21.transpose();
+        Eigen::LLT<Factor_t> llt{S};
+        if (llt.info() != Eigen::Success) {
+          throw std::runtime_error(
+              "The extended matrix is not positive definite, consider "
+              "increasing its diagonal.");
+        }
+        this->factor.conservativeResize(n + m, n + m);
+        this->factor.topRightCorner(n, m).setZero();
+        this->factor.bottomLeftCorner(m, n) = L_21;
+        this->factor.bottomRightCorner(m, m) = llt.matrixL();
+      }
+
+      //! solve A X = B
+      Factor_t solve(const Eigen::Ref<const Matrix_t> & B) const {
+        if (B.rows() != this->size()) {
+          std::stringstream err_str{};
+          err_str << "The right hand side has " << B.rows()
+                  << " rows but the factorised matrix has size "
+                  << this->size() << ".";
+          throw std::runtime_error(err_str.str());
+        }
+        Factor_t X{this->factor.triangularView<Eigen::Lower>().solve(B)};
+        this->factor.triangularView<Eigen::Lower>().transpose().solveInPlace(
+            X);
+        return X;
+      }
+
+     protected:
+      Factor_t factor{};
+    };
+
+  }  // namespace math
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_MATH_CHOLESKY_HH_
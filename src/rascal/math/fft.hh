@@ -0,0 +1,150 @@
+/**
+ * @file   rascal/math/fft.hh
+ *
+ * @date   18 October 2026
+ *
+ * @brief  Discrete Fourier transforms on periodic 3D meshes
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_RASCAL_MATH_FFT_HH_
+#define SRC_RASCAL_MATH_FFT_HH_
+
+#include <unsupported/Eigen/FFT>
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+namespace rascal {
+  namespace math {
+
+    /**
+     * Smallest integer larger or equal to n whose only prime factors are 2, 3
+     * and 5, i.e. a size for which the FFT is efficient.
+     */
+    inline size_t next_fft_size(size_t n) {
+      n = std::max(n, size_t(1));
+      while (true) {
+        size_t rest{n};
+        for (size_t factor : {2, 3, 5}) {
+          while (rest % factor == 0) {
+            rest /= factor;
+          }
+        }
+        if (rest == 1) {
+          return n;
+        }
+        ++n;
+      }
+    }
+
+    /**
+     * Unnormalized discrete Fourier transforms of complex fields on a 3D
+     * periodic mesh
+     *
+     * @f[
+     *    \hat{f}(\mathbf{m}) = \sum_\mathbf{g} f(\mathbf{g})
+     *        e^{\mp 2\pi i \sum_\alpha m_\alpha g_\alpha / K_\alpha},
+     * @f]
+     *
+     * with the minus sign for the forward transform and the plus sign for
+     * the inverse one, so that the inverse of the forward transform is the
+     * field multiplied by the number of mesh points. The fields are stored
+     * contiguously with the last index varying the fastest and are
+     * transformed with one dimensional FFTs along each axis.
+     */
+    class FFT3D {
+     public:
+      using Complex_t = std::complex<double>;
+      using Shape_t = std::array<size_t, 3>;
+
+      FFT3D() { this->fft.SetFlag(Eigen::FFT<double>::Unscaled); }
+
+      explicit FFT3D(const Shape_t & shape) : FFT3D{} {
+        this->set_shape(shape);
+      }
+
+      void set_shape(const Shape_t & shape) { this->shape = shape; }
+
+      const Shape_t & get_shape() const { return this->shape; }
+
+      //! number of points of the mesh
+      size_t size() const {
+        return this->shape[0] * this->shape[1] * this->shape[2];
+      }
+
+      //! flat index of a mesh point
+      size_t get_index(size_t g_0, size_t g_1, size_t g_2) const {
+        return (g_0 * this->shape[1] + g_1) * this->shape[2] + g_2;
+      }
+
+      void forward(std::vector<Complex_t> & field) {
+        this->transform(field, false);
+      }
+
+      void inverse(std::vector<Complex_t> & field) {
+        this->transform(field, true);
+      }
+
+     protected:
+      void transform(std::vector<Complex_t> & field, const bool inverse) {
+        if (field.size() != this->size()) {
+          throw std::runtime_error(
+              "The size of the field does not match the mesh.");
+        }
+        const std::array<size_t, 3> strides{
+            {this->shape[1] * this->shape[2], this->shape[2], 1}};
+        for (size_t axis{0}; axis < 3; ++axis) {
+          const size_t n_points{this->shape[axis]};
+          const size_t stride{strides[axis]};
+          this->line_in.resize(n_points);
+          this->line_out.resize(n_points);
+          // the first point of each line along axis
+          for (size_t i_start{0}; i_start < field.size(); ++i_start) {
+            if ((i_start / stride) % n_points != 0) {
+              continue;
+            }
+            for (size_t i_point{0}; i_point < n_points; ++i_point) {
+              this->line_in[i_point] = field[i_start + i_point * stride];
+            }
+            if (inverse) {
+              this->fft.inv(this->line_out, this->line_in);
+            } else {
+              this->fft.fwd(this->line_out, this->line_in);
+            }
+            for (size_t i_point{0}; i_point < n_points; ++i_point) {
+              field[i_start + i_point * stride] = this->line_out[i_point];
+            }
+          }
+        }
+      }
+
+      Shape_t shape{{1, 1, 1}};
+      Eigen::FFT<double> fft{};
+      std::vector<Complex_t> line_in{};
+      std::vector<Complex_t> line_out{};
+    };
+
+  }  // namespace math
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_MATH_FFT_HH_
@@ -32,8 +32,8 @@ using namespace rascal::math;  // NOLINT
 
 bool rascal::math::is_grid_uniform(const Vector_Ref & grid) {
   // checks if the grid is in ascending order
-  for (int i = 0; i < grid.size() - 2; i++) {
-    if (grid(i + 1) > grid(i)) {
+  for (int i = 0; i < grid.size() - 1; i++) {
+    if (grid(i + 1) <= grid(i)) {
       return false;
     }
   }
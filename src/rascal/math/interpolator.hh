@@ -694,7 +694,9 @@ namespace rascal {
       };
 
       Interpolator(Vector_t grid, bool /*dummy_for_overloading*/)
-          : grid{std::move(grid)} {}
+          : x1{grid.size() > 0 ? grid(0) : 0.},
+            x2{grid.size() > 0 ? grid(grid.size() - 1) : 0.},
+            grid{std::move(grid)} {}
 
       /**
        * The general procedure of the interpolatorar is to initialize the
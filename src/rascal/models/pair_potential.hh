@@ -0,0 +1,292 @@
+/**
+ * @file   rascal/models/pair_potential.hh
+ *
+ * @date   18 October 2026
+ *
+ * @brief  Tabulated pair potentials evaluated on the neighbour list of the
+ *         structure managers, e.g. as a baseline of a SOAP-GAP model
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_RASCAL_MODELS_PAIR_POTENTIAL_HH_
+#define SRC_RASCAL_MODELS_PAIR_POTENTIAL_HH_
+
+#include "rascal/math/interpolator.hh"
+#include "rascal/math/utils.hh"
+#include "rascal/structure_managers/atomic_structure.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/utils/json_io.hh"
+#include "rascal/utils/timer.hh"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+namespace rascal {
+
+  /**
+   * Pair potential tabulated with a cubic spline for each pair of species,
+   * e.g. a ZBL, Lennard-Jones or Morse baseline subtracted from the targets
+   * of a SOAP-GAP model. The energy of a structure is
+   *
+   * @f[
+   *    E = \sum_{i < j} V_{ab}(r_{ij}),
+   * @f]
+   *
+   * where a and b are the species of the atoms i and j. The potential is
+   * evaluated on the neighbour list of the structure managers, so when the
+   * same managers are used for the representation the baseline costs a
+   * single pass over the pairs that have already been built. The top adaptor
+   * should be an AdaptorStrict with a cutoff at least as large as the
+   * largest tabulated distance. Full and half neighbour lists are supported.
+   *
+   * The hypers are of the form
+   *
+   *     {"pairs": [{"species": [1, 8],
+   *                 "grid": [r_0, ..., r_n],
+   *                 "values": [V(r_0), ..., V(r_n)],
+   *                 "derivatives": [V'(r_0), V'(r_n)]}, ...]}
+   *
+   * where the grid must be uniform and the optional derivatives switch the
+   * spline to clamped boundary conditions. The potential is zero beyond r_n
+   * so the tables should go smoothly to zero at the end of the grid, and the
+   * pairs of species that are not listed do not interact. A pair closer than
+   * r_0 throws since the potential is not known there.
+   */
+  class PairPotential {
+   public:
+    using Hypers_t = json;
+    using Matrix_t = math::Matrix_t;
+    using Spline_t = math::InterpolatorScalarUniformCubicSpline<
+        math::RefinementMethod_t::Exponential>;
+
+    explicit PairPotential(const Hypers_t & hypers) : parameters{hypers} {
+      if (hypers.count("pairs") == 0) {
+        throw std::runtime_error(
+            R"(The pair potential needs a list of "pairs")");
+      }
+      for (const auto & pair : hypers.at("pairs")) {
+        auto species = pair.at("species").get<std::array<int, 2>>();
+        std::sort(species.begin(), species.end());
+        if (this->pair_ids.count(species) == 1) {
+          std::stringstream err_str{};
+          err_str << "The pair of species (" << species[0] << ", "
+                  << species[1] << ") is tabulated more than once.";
+          throw std::runtime_error(err_str.str());
+        }
+        auto grid_ = pair.at("grid").get<std::vector<double>>();
+        auto values_ = pair.at("values").get<std::vector<double>>();
+        if (grid_.size() < 3) {
+          std::stringstream err_str{};
+          err_str << "The grid of the pair of species (" << species[0] << ", "
+                  << species[1] << ") needs at least 3 points.";
+          throw std::runtime_error(err_str.str());
+        }
+        math::Vector_t grid =
+            Eigen::Map<math::Vector_t>(grid_.data(), grid_.size());
+        math::Vector_t values =
+            Eigen::Map<math::Vector_t>(values_.data(), values_.size());
+        this->pair_ids[species] = this->splines.size();
+        if (pair.count("derivatives") == 1) {
+          auto derivatives =
+              pair.at("derivatives").get<std::array<double, 2>>();
+          this->splines.emplace_back(grid, values, true, derivatives[0],
+                                     derivatives[1]);
+        } else {
+          this->splines.emplace_back(grid, values);
+        }
+        this->cutoff = std::max(this->cutoff, grid(grid.size() - 1));
+      }
+    }
+
+    //! largest distance at which the potential is not zero
+    double get_cutoff() const { return this->cutoff; }
+
+    /**
+     * Compute the energies, their gradients w.r.t. the atomic positions and
+     * the negative stress of a set of structures.
+     *
+     * @tparam StructureManagers should be an iterable over shared pointer
+     *          of structure managers like ManagerCollection
+     * @param managers a ManagerCollection or similar collection of
+     * structure managers
+     * @param compute_neg_stress if false the stress is not computed, e.g. for
+     * non periodic structures
+     * @return the energies [N_{structures}, 1], their gradients
+     * [N_{atoms}, 3] and the negative stress [N_{structures}, 6] in Voigt
+     * order (xx, yy, zz, yz, xz, xy), zeros if compute_neg_stress is false
+     *
+     * @throw std::runtime_error if the cutoff of a manager is smaller than
+     *        the cutoff of the potential
+     * @throw std::runtime_error if two atoms are closer than the start of
+     *        their table
+     */
+    template <class StructureManagers>
+    std::tuple<Matrix_t, Matrix_t, Matrix_t>
+    compute(StructureManagers & managers,
+            const bool compute_neg_stress = true) {
+      RASCAL_TIMER("PairPotential::compute");
+      size_t n_centers{0}, n_managers{0};
+      for (const auto & manager : managers) {
+        n_centers += manager->size();
+        ++n_managers;
+      }
+      Matrix_t energies{Matrix_t::Zero(n_managers, 1)};
+      Matrix_t gradients{Matrix_t::Zero(n_centers, ThreeD)};
+      Matrix_t neg_stress{Matrix_t::Zero(n_managers, 2 * ThreeD)};
+      size_t i_manager{0}, i_center{0};
+      for (const auto & manager : managers) {
+        const size_t manager_size{manager->size()};
+        auto manager_gradients =
+            gradients.block(i_center, 0, manager_size, ThreeD);
+        auto manager_neg_stress = neg_stress.row(i_manager);
+        energies(i_manager, 0) = this->compute_structure(
+            manager, compute_neg_stress, manager_gradients,
+            manager_neg_stress);
+        i_center += manager_size;
+        ++i_manager;
+      }
+      return std::make_tuple(energies, gradients, neg_stress);
+    }
+
+    //! hypers used to build the potential
+    Hypers_t parameters{};
+
+   protected:
+    /**
+     * Accumulate the contributions of the pairs of one structure. The
+     * gradients w.r.t. the ghost atoms are given to the atoms they are
+     * images of and the ones w.r.t. the masked atoms are not reported.
+     */
+    template <class StructureManager, class Gradients, class NegStress>
+    double compute_structure(std::shared_ptr<StructureManager> manager,
+                             const bool compute_neg_stress,
+                             Gradients & gradients, NegStress & neg_stress) {
+      if (manager->get_cutoff() < this->cutoff) {
+        std::stringstream err_str{};
+        err_str << "The cutoff of the structure manager '"
+                << manager->get_cutoff()
+                << "' is smaller than the cutoff of the pair potential '"
+                << this->cutoff << "'.";
+        throw std::runtime_error(err_str.str());
+      }
+      // with a full neighbour list each pair is visited twice, and so are
+      // the pairs with the ghost atoms with a half neighbour list
+      const bool is_half_list{StructureManager::traits::NeighbourListType ==
+                              AdaptorTraits::NeighbourListType::half};
+      // see compute_sparse_kernel_neg_stress for the Voigt order
+      const std::array<std::array<int, 2>, ThreeD> voigt_id_to_spatial_dim = {
+          {             // voigt_idx,  spatial_dim_idx
+           {{4, 2}},    //    xz,            z
+           {{5, 0}},    //    xy,            x
+           {{3, 1}}}};  //    yz,            y
+
+      const size_t n_centers{manager->size()};
+      double energy{0.};
+      std::array<int, 2> species{};
+      for (auto center : manager) {
+        const size_t i_atom{manager->get_atom_index(center.get_atom_tag())};
+        const Eigen::Vector3d r_i{center.get_position()};
+        for (auto neigh : center.pairs()) {
+          species[0] = center.get_atom_type();
+          species[1] = neigh.get_atom_type();
+          if (species[0] > species[1]) {
+            std::swap(species[0], species[1]);
+          }
+          auto pair_id = this->pair_ids.find(species);
+          if (pair_id == this->pair_ids.end()) {
+            continue;
+          }
+          auto & spline = this->splines[pair_id->second];
+          const double distance{manager->get_distance(neigh)};
+          if (distance >= spline.x2) {
+            continue;
+          }
+          if (distance < spline.x1) {
+            std::stringstream err_str{};
+            err_str << "The distance '" << distance
+                    << "' between atoms of species (" << species[0] << ", "
+                    << species[1]
+                    << ") is smaller than the start of their table '"
+                    << spline.x1 << "'.";
+            throw std::runtime_error(err_str.str());
+          }
+          const double pair_weight{
+              is_half_list and manager->is_center_atom(neigh) ? 1. : 0.5};
+          energy += pair_weight * spline.interpolate(distance);
+          // dE/dr_j, the direction vector goes from i to j
+          const Eigen::Vector3d pair_derivative{
+              pair_weight * spline.interpolate_derivative(distance) *
+              manager->get_direction_vector(neigh)};
+          const size_t j_atom{manager->get_atom_index(neigh.get_atom_tag())};
+          if (j_atom < n_centers) {
+            gradients.row(j_atom) += pair_derivative.transpose();
+          }
+          if (i_atom < n_centers) {
+            gradients.row(i_atom) -= pair_derivative.transpose();
+          }
+          if (compute_neg_stress) {
+            const Eigen::Vector3d r_ji{r_i - neigh.get_position()};
+            for (int i_der{0}; i_der < ThreeD; ++i_der) {
+              const auto & voigt = voigt_id_to_spatial_dim[i_der];
+              neg_stress(i_der) += r_ji(i_der) * pair_derivative(i_der);
+              neg_stress(voigt[0]) += r_ji(voigt[1]) * pair_derivative(i_der);
+            }
+          }
+        }
+      }
+      if (compute_neg_stress) {
+        auto manager_root = extract_underlying_manager<0>(manager);
+        json structure_copy = manager_root->get_atomic_structure();
+        auto atomic_structure =
+            structure_copy.template get<AtomicStructure<ThreeD>>();
+        neg_stress /= atomic_structure.get_volume();
+      }
+      return energy;
+    }
+
+    //! index of the spline of each pair of sorted species
+    std::map<std::array<int, 2>, size_t> pair_ids{};
+    std::vector<Spline_t> splines{};
+    double cutoff{0.};
+  };
+
+}  // namespace rascal
+
+namespace nlohmann {
+  /**
+   * Special specialization of the json serialization for non default
+   * constructible type.
+   */
+  template <>
+  struct adl_serializer<rascal::PairPotential> {
+    static rascal::PairPotential from_json(const json & j) {
+      return rascal::PairPotential{j};
+    }
+
+    static void to_json(json & j, const rascal::PairPotential & t) {
+      j = t.parameters;
+    }
+  };
+}  // namespace nlohmann
+
+#endif  // SRC_RASCAL_MODELS_PAIR_POTENTIAL_HH_
@@ -31,9 +31,16 @@
 #include "rascal/math/utils.hh"
 #include "rascal/models/kernels.hh"
 #include "rascal/models/sparse_kernels.hh"
+#include "rascal/structure_managers/domain_decomposition.hh"
 #include "rascal/structure_managers/property_block_sparse.hh"
 #include "rascal/structure_managers/structure_manager_collection.hh"
 #include "rascal/utils/json_io.hh"
+#include "rascal/utils/parallel.hh"
+#include "rascal/utils/timer.hh"
+
+#include <Eigen/Sparse>
+
+#include <tuple>
 
 namespace rascal {
 
@@ -65,17 +72,21 @@ namespace rascal {
    * the in the managers
    * @param pair_grad_atom_i_r_j_name name used to get/register the partial
    * gradients in the managers
+   * @param energy_name if not empty, name used to get/register the predicted
+   * property of the structure (sum of the atomic contributions) in a Property
+   * of Order 0. It reuses the linear kernel computed for the gradients so it
+   * comes at almost no extra cost.
    * @return
    */
   template <class Property_t, class PropertyGradient_t, class StructureManager,
             class SparsePoints>
-  void
-  compute_partial_gradients_gap(StructureManager & manager,
-                                SparsePoints & sparse_points,
-                                math::Vector_t & weights, const size_t zeta,
-                                const std::string & representation_name,
-                                const std::string & representation_grad_name,
-                                const std::string & pair_grad_atom_i_r_j_name) {
+  void compute_partial_gradients_gap(
+      StructureManager & manager, SparsePoints & sparse_points,
+      math::Vector_t & weights, const size_t zeta,
+      const std::string & representation_name,
+      const std::string & representation_grad_name,
+      const std::string & pair_grad_atom_i_r_j_name,
+      const std::string & energy_name = std::string("")) {
     using Manager_t = typename StructureManager::element_type;
     using Keys_t = typename SparsePoints::Keys_t;
     using Key_t = typename SparsePoints::Key_t;
@@ -113,15 +124,33 @@ namespace rascal {
         *manager
              ->template get_property<Property<double, 2, Manager_t, 1, ThreeD>>(
                  pair_grad_atom_i_r_j_name, true, true)};
+    const bool compute_energy{not energy_name.empty()};
+    // the energy is a by-product of the partial gradients so it is attached
+    // to the manager only when requested
+    std::shared_ptr<Property<double, 0, Manager_t, 1>> energy_ptr{nullptr};
+    if (compute_energy) {
+      energy_ptr =
+          manager->template get_property<Property<double, 0, Manager_t, 1>>(
+              energy_name, true, true);
+    }
     // don't recompute the partial gradients if already up to date
-    if (pair_grad_atom_i_r_j.is_updated()) {
+    if (pair_grad_atom_i_r_j.is_updated() and
+        ((not compute_energy) or energy_ptr->is_updated())) {
       return;
     }
 
     pair_grad_atom_i_r_j.resize();
     pair_grad_atom_i_r_j.setZero();
+    if (compute_energy) {
+      energy_ptr->resize();
+      energy_ptr->setZero();
+    }
 
     if (species_intersect.empty()) {
+      pair_grad_atom_i_r_j.set_updated_status(true);
+      if (compute_energy) {
+        energy_ptr->set_updated_status(true);
+      }
       return;
     }
 
@@ -129,15 +158,23 @@ namespace rascal {
     size_t i_row{0};
     for (auto center : manager) {
       const int a_sp{center.get_atom_type()};
+      // linear kernel (X_j \dot T_n), shared by the energy and the gradients
+      math::Matrix_t kernel_lin{sparse_points.dot(a_sp, prop[center])};
+      math::Matrix_t kernel_zeta_m1{
+          internal::pow_zeta(math::Matrix_t(kernel_lin), zeta - 1)};
+      if (compute_energy) {
+        // y_j = \sum_n \alpha_n (X_j \dot T_n)^{z}
+        (*energy_ptr)(0) += (weights.array() *
+                             kernel_zeta_m1.transpose().array() *
+                             kernel_lin.transpose().array())
+                                .sum();
+      }
       // compute contraction of the model weights with the gradient of the
       // kernel with respect to the representation in 2 steps
       // 1. \alpha_n^{scaled} = \alpha_n * [z* (X_j \dot T_n)^{z-1}]
       weights_scaled =
           (weights.array() *
-           (zeta *
-            internal::pow_zeta(sparse_points.dot(a_sp, prop[center]), zeta - 1))
-               .transpose()
-               .array())
+           (zeta * kernel_zeta_m1).transpose().array())
               .matrix();
       // 2. \sum_n \alpha_n^{scaled} T_n
       SparsePoints sparse_point_scaled{sparse_points.dot(a_sp, weights_scaled)};
@@ -178,6 +215,9 @@ namespace rascal {
       }
     }  // center
     pair_grad_atom_i_r_j.set_updated_status(true);
+    if (compute_energy) {
+      energy_ptr->set_updated_status(true);
+    }
   }
 
   /**
@@ -209,7 +249,9 @@ namespace rascal {
                                               StructureManagers & managers,
                                               SparsePoints & sparse_points,
                                               math::Vector_t & weights) {
+    RASCAL_TIMER("compute_sparse_kernel_gradients");
     using Manager_t = typename StructureManagers::Manager_t;
+    internal::check_full_neighbour_list<Manager_t>("compute_sparse_kernel_gradients");
     using Property_t = typename Calculator::template Property_t<Manager_t>;
     using PropertyGradient_t =
         typename Calculator::template PropertyGradient_t<Manager_t>;
@@ -257,7 +299,11 @@ namespace rascal {
       for (auto center : manager) {
         // accumulate partial gradients onto gradients
         for (auto neigh : center.pairs_with_self_pair()) {
-          gradients[neigh.get_atom_j()] += pair_grad_atom_i_r_j[neigh];
+          // gradients are only reported for the center atoms, i.e. not for
+          // the masked atoms, and the images of the center move with it
+          if (internal::is_center_gradient_pair(manager, center, neigh)) {
+            gradients[neigh.get_atom_j()] += pair_grad_atom_i_r_j[neigh];
+          }
         }
       }
       gradients.set_updated_status(true);
@@ -294,7 +340,9 @@ namespace rascal {
                                                StructureManagers & managers,
                                                SparsePoints & sparse_points,
                                                math::Vector_t & weights) {
+    RASCAL_TIMER("compute_sparse_kernel_neg_stress");
     using Manager_t = typename StructureManagers::Manager_t;
+    internal::check_full_neighbour_list<Manager_t>("compute_sparse_kernel_neg_stress");
     using Property_t = typename Calculator::template Property_t<Manager_t>;
     using PropertyGradient_t =
         typename Calculator::template PropertyGradient_t<Manager_t>;
@@ -375,5 +423,604 @@ namespace rascal {
     }  // manager
     return neg_stress_name;
   }
+
+  /**
+   * Predict the property, its gradients w.r.t. atomic positions and its
+   * negative stress (virial over volume) in a single pass using a sparse GPR
+   * model. Only SOAP-GAP model is implemented at the moment.
+   *
+   * Compared to calling separately the kernel, then
+   * compute_sparse_kernel_gradients and compute_sparse_kernel_neg_stress,
+   * the linear kernel between the representation and the sparse points is
+   * computed only once per center and the loop over the pairs accumulates
+   * the gradients and the virial at the same time.
+   *
+   * The same loop can also accumulate the virial of each atom, e.g. for the
+   * heat flux of Green-Kubo calculations. The contribution r_{ji} \otimes
+   * dy_i/dr_j of the pair ij to the virial is given to the neighbour j,
+   * i.e. W_j = \sum_i (r_i - r_j) \otimes dy_i/dr_j where i runs over the
+   * environments containing j, so that \sum_j W_j is the virial of the
+   * structure (the negative stress times the volume).
+   *
+   * The results are attached to the input managers using the same names as
+   * compute_sparse_kernel_gradients and compute_sparse_kernel_neg_stress so
+   * that subsequent calls to these functions will not recompute anything.
+   *  - property [1] in a Property of Order 0
+   *  - gradients [N_{atoms}, 3] in a Property of Order 1
+   *  - negative stress [6] in a Property of Order 0
+   *  - atomic virials [N_{atoms}, 6] in a Property of Order 1 in Voigt
+   *    order (xx, yy, zz, yz, xz, xy)
+   *
+   * @tparam StructureManagers should be an iterable over shared pointer
+   *          of structure managers like ManagerCollection
+   * @param sparse_points a SparsePoints* class
+   * @param managers a ManagerCollection or similar collection of
+   * structure managers
+   * @param weights regression weights of the sparse GPR model
+   * @param compute_neg_stress if false the stress is not computed, e.g. for
+   * non periodic structures
+   * @param compute_atomic_virials if true the virial of each atom is
+   * computed too
+   * @return names used to register the property, the gradients, the
+   * negative stress and the atomic virials in the managers
+   */
+  template <class Calculator, class StructureManagers, class SparsePoints>
+  std::array<std::string, 4> compute_sparse_kernel_predictions(
+      const Calculator & calculator, SparseKernel & kernel,
+      StructureManagers & managers, SparsePoints & sparse_points,
+      math::Vector_t & weights, const bool compute_neg_stress = true,
+      const bool compute_atomic_virials = false) {
+    RASCAL_TIMER("compute_sparse_kernel_predictions");
+    using Manager_t = typename StructureManagers::Manager_t;
+    internal::check_full_neighbour_list<Manager_t>("compute_sparse_kernel_predictions");
+    using Property_t = typename Calculator::template Property_t<Manager_t>;
+    using PropertyGradient_t =
+        typename Calculator::template PropertyGradient_t<Manager_t>;
+    auto && representation_name{calculator.get_name()};
+    const auto representation_grad_name{calculator.get_gradient_name()};
+
+    auto kernel_type_str = kernel.parameters.at("name").get<std::string>();
+    if (kernel_type_str != "GAP") {
+      std::stringstream err_str{};
+      err_str << "Fused predictions are not implemented for the kernel: '"
+              << kernel_type_str << "'.";
+      throw std::logic_error(err_str.str());
+    }
+    const auto zeta = kernel.parameters.at("zeta").get<size_t>();
+
+    // see compute_sparse_kernel_neg_stress
+    const std::array<std::array<int, 2>, ThreeD> voigt_id_to_spatial_dim = {
+        {             // voigt_idx,  spatial_dim_idx
+         {{4, 2}},    //    xz,            z
+         {{5, 0}},    //    xy,            x
+         {{3, 1}}}};  //    yz,            y
+
+    internal::Hash<math::Vector_t, double> hasher{};
+    std::string weight_hash = std::to_string(hasher(weights));
+    std::string prefix = std::string("kernel: ") + kernel_type_str +
+                         std::string(" ; ") + representation_grad_name;
+    std::string pair_grad_atom_i_r_j_name =
+        prefix + std::string(" partial gradients; weight_hash:") + weight_hash;
+    std::string energy_name = std::string("kernel: ") + kernel_type_str +
+                              std::string(" ; ") + representation_name +
+                              std::string(" prediction; weight_hash:") +
+                              weight_hash;
+    std::string gradient_name =
+        prefix + std::string(" gradients; weight_hash:") + weight_hash;
+    std::string neg_stress_name =
+        prefix + std::string(" negative stress; weight_hash:") + weight_hash;
+    std::string atomic_virials_name =
+        prefix + std::string(" atomic virials; weight_hash:") + weight_hash;
+
+    for (const auto & manager : managers) {
+      compute_partial_gradients_gap<Property_t, PropertyGradient_t>(
+          manager, sparse_points, weights, zeta, representation_name,
+          representation_grad_name, pair_grad_atom_i_r_j_name, energy_name);
+      RASCAL_COUNTER_ADD("compute_sparse_kernel_predictions::centers",
+                         manager->size());
+
+      auto && gradients{*manager->template get_property<
+          Property<double, 1, Manager_t, 1, ThreeD>>(gradient_name, true, true,
+                                                     true)};
+      auto && neg_stress{
+          *manager->template get_property<Property<double, 0, Manager_t, 6>>(
+              neg_stress_name, true, true, true)};
+      // the atomic virials are attached to the manager only when requested
+      std::shared_ptr<Property<double, 1, Manager_t, 6>> atomic_virials_ptr{
+          nullptr};
+      if (compute_atomic_virials) {
+        atomic_virials_ptr = manager->template get_property<
+            Property<double, 1, Manager_t, 6>>(atomic_virials_name, true, true,
+                                               true);
+      }
+      const bool do_gradients{not gradients.is_updated()};
+      const bool do_neg_stress{compute_neg_stress and
+                               (not neg_stress.is_updated())};
+      const bool do_atomic_virials{compute_atomic_virials and
+                                   (not atomic_virials_ptr->is_updated())};
+      if (not(do_gradients or do_neg_stress or do_atomic_virials)) {
+        continue;
+      }
+      if (do_gradients) {
+        gradients.resize();
+        gradients.setZero();
+      }
+      if (do_neg_stress) {
+        neg_stress.resize();
+        neg_stress.setZero();
+      }
+      if (do_atomic_virials) {
+        atomic_virials_ptr->resize();
+        atomic_virials_ptr->setZero();
+      }
+
+      auto && pair_grad_atom_i_r_j{*manager->template get_property<
+          Property<double, 2, Manager_t, 1, ThreeD>>(pair_grad_atom_i_r_j_name,
+                                                     true)};
+      const size_t manager_size{manager->size()};
+      Eigen::Matrix<double, 6, 1> pair_virial{};
+      for (auto center : manager) {
+        Eigen::Vector3d r_i = center.get_position();
+        for (auto neigh : center.pairs_with_self_pair()) {
+          auto && pair_grad{pair_grad_atom_i_r_j[neigh]};
+          // gradients are only reported for the center atoms
+          const bool is_center{manager->get_atom_index(neigh.get_atom_tag()) <
+                               manager_size};
+          if (do_gradients and
+              internal::is_center_gradient_pair(manager, center, neigh)) {
+            gradients[neigh.get_atom_j()] += pair_grad;
+          }
+          if (do_neg_stress or do_atomic_virials) {
+            Eigen::Vector3d r_ji = r_i - neigh.get_position();
+            for (int i_der{0}; i_der < ThreeD; i_der++) {
+              const auto & voigt = voigt_id_to_spatial_dim[i_der];
+              pair_virial(i_der) = r_ji(i_der) * pair_grad(i_der);
+              pair_virial(voigt[0]) = r_ji(voigt[1]) * pair_grad(i_der);
+            }
+            if (do_neg_stress) {
+              neg_stress[0] += pair_virial;
+            }
+            if (do_atomic_virials and is_center) {
+              (*atomic_virials_ptr)[neigh.get_atom_j()] += pair_virial;
+            }
+          }
+        }
+      }
+      if (do_gradients) {
+        gradients.set_updated_status(true);
+      }
+      if (do_neg_stress) {
+        auto manager_root = extract_underlying_manager<0>(manager);
+        json structure_copy = manager_root->get_atomic_structure();
+        auto atomic_structure =
+            structure_copy.template get<AtomicStructure<ThreeD>>();
+        neg_stress[0] /= atomic_structure.get_volume();
+        neg_stress.set_updated_status(true);
+      }
+      if (do_atomic_virials) {
+        atomic_virials_ptr->set_updated_status(true);
+      }
+    }  // manager
+    return {{energy_name, gradient_name, neg_stress_name, atomic_virials_name}};
+  }
+
+  /**
+   * Predict the property, its gradients w.r.t. atomic positions and its
+   * negative stress for a large structure using a sparse GPR model (only
+   * SOAP-GAP) domain by domain, see DomainDecomposition.
+   *
+   * The representation and the partial gradients of each domain are
+   * computed as in compute_sparse_kernel_predictions and the contributions
+   * of the pairs are accumulated onto the atoms of the original structure,
+   * including the halo atoms that belong to other domains, so the result is
+   * the same as with a single manager for the whole structure.
+   *
+   * @param hypers hyperparameters of the representation, one calculator is
+   *        built per thread since the calculators hold internal buffers
+   * @param n_threads number of threads processing the domains
+   * @param compute_neg_stress if false (or if the structure is not periodic)
+   *        the negative stress is returned as zeros
+   * @param compute_atomic_virials if false the atomic virials are returned as
+   *        zeros, see compute_sparse_kernel_predictions
+   * @return the property [1], its gradients [N_{centers}, 3] in the order of
+   * the centers of the original structure, the negative stress [1, 6] in
+   * Voigt order and the atomic virials [N_{centers}, 6]
+   */
+  template <class Calculator, class SparsePoints>
+  std::tuple<double, math::Matrix_t, math::Matrix_t, math::Matrix_t>
+  compute_sparse_kernel_predictions_by_domains(
+      const DomainDecomposition & domains, const json & hypers,
+      SparseKernel & kernel, SparsePoints & sparse_points,
+      math::Vector_t & weights, size_t n_threads,
+      const bool compute_neg_stress = true,
+      const bool compute_atomic_virials = false) {
+    RASCAL_TIMER("compute_sparse_kernel_predictions_by_domains");
+    using Manager_t = typename DomainDecomposition::Manager_t;
+    using ManagerPtr_t = typename DomainDecomposition::ManagerPtr_t;
+    using Property_t = typename Calculator::template Property_t<Manager_t>;
+    using PropertyGradient_t =
+        typename Calculator::template PropertyGradient_t<Manager_t>;
+
+    auto kernel_type_str = kernel.parameters.at("name").get<std::string>();
+    if (kernel_type_str != "GAP") {
+      std::stringstream err_str{};
+      err_str << "Predictions by domains are not implemented for the kernel: '"
+              << kernel_type_str << "'.";
+      throw std::logic_error(err_str.str());
+    }
+    const auto zeta = kernel.parameters.at("zeta").get<size_t>();
+    const bool do_neg_stress{compute_neg_stress and domains.is_periodic()};
+
+    // see compute_sparse_kernel_neg_stress
+    const std::array<std::array<int, 2>, ThreeD> voigt_id_to_spatial_dim = {
+        {             // voigt_idx,  spatial_dim_idx
+         {{4, 2}},    //    xz,            z
+         {{5, 0}},    //    xy,            x
+         {{3, 1}}}};  //    yz,            y
+
+    n_threads = std::max(std::min(n_threads, domains.size()), size_t(1));
+    std::vector<Calculator> calculators{};
+    calculators.reserve(n_threads);
+    for (size_t i_thread{0}; i_thread < n_threads; ++i_thread) {
+      calculators.emplace_back(hypers);
+    }
+    // each thread accumulates in its own buffers which are summed at the end
+    const size_t n_centers{domains.get_number_of_centers()};
+    std::vector<double> energy_by_thread(n_threads, 0.);
+    std::vector<math::Matrix_t> gradients_by_thread(
+        n_threads, math::Matrix_t::Zero(n_centers, ThreeD));
+    std::vector<Eigen::Matrix<double, 6, 1>> neg_stress_by_thread(
+        n_threads, Eigen::Matrix<double, 6, 1>::Zero());
+    std::vector<math::Matrix_t> atomic_virials_by_thread(
+        compute_atomic_virials ? n_threads : 0,
+        math::Matrix_t::Zero(n_centers, 6));
+
+    const auto & center_rows = domains.get_center_rows();
+    domains.for_each_domain(
+        [&](ManagerPtr_t & manager, const size_t i_domain,
+            const size_t i_thread) {
+          auto & calculator = calculators[i_thread];
+          calculator.compute(manager);
+          const std::string pair_grad_atom_i_r_j_name{
+              calculator.get_gradient_name() + " partial gradients"};
+          const std::string energy_name{calculator.get_name() +
+                                        " prediction"};
+          compute_partial_gradients_gap<Property_t, PropertyGradient_t>(
+              manager, sparse_points, weights, zeta, calculator.get_name(),
+              calculator.get_gradient_name(), pair_grad_atom_i_r_j_name,
+              energy_name);
+
+          energy_by_thread[i_thread] +=
+              (*manager->template get_property<
+                  Property<double, 0, Manager_t, 1>>(energy_name, true))(0);
+
+          auto && pair_grad_atom_i_r_j{*manager->template get_property<
+              Property<double, 2, Manager_t, 1, ThreeD>>(
+              pair_grad_atom_i_r_j_name, true)};
+          auto && gradients = gradients_by_thread[i_thread];
+          auto && neg_stress = neg_stress_by_thread[i_thread];
+          const auto & atom_indices = domains[i_domain].atom_indices;
+          auto manager_root = extract_underlying_manager<0>(manager);
+          Eigen::Matrix<double, 6, 1> pair_virial{};
+          for (auto center : manager) {
+            Eigen::Vector3d r_i = center.get_position();
+            for (auto neigh : center.pairs_with_self_pair()) {
+              auto && pair_grad{pair_grad_atom_i_r_j[neigh]};
+              // the halo atoms are masked in the domain but they are centers
+              // of the original structure
+              const size_t i_atom{atom_indices[manager_root->get_atom_index(
+                  manager->get_atom_index(neigh.get_atom_tag()))]};
+              const int i_row{center_rows[i_atom]};
+              if (i_row >= 0) {
+                gradients.row(i_row) += pair_grad.transpose();
+              }
+              if (do_neg_stress or compute_atomic_virials) {
+                Eigen::Vector3d r_ji = r_i - neigh.get_position();
+                for (int i_der{0}; i_der < ThreeD; i_der++) {
+                  const auto & voigt = voigt_id_to_spatial_dim[i_der];
+                  pair_virial(i_der) = r_ji(i_der) * pair_grad(i_der);
+                  pair_virial(voigt[0]) = r_ji(voigt[1]) * pair_grad(i_der);
+                }
+                if (do_neg_stress) {
+                  neg_stress += pair_virial;
+                }
+                if (compute_atomic_virials and i_row >= 0) {
+                  atomic_virials_by_thread[i_thread].row(i_row) +=
+                      pair_virial.transpose();
+                }
+              }
+            }
+          }
+        },
+        n_threads);
+
+    double energy{0.};
+    math::Matrix_t gradients = math::Matrix_t::Zero(n_centers, ThreeD);
+    math::Matrix_t neg_stress = math::Matrix_t::Zero(1, 6);
+    math::Matrix_t atomic_virials = math::Matrix_t::Zero(n_centers, 6);
+    for (size_t i_thread{0}; i_thread < n_threads; ++i_thread) {
+      energy += energy_by_thread[i_thread];
+      gradients += gradients_by_thread[i_thread];
+      neg_stress += neg_stress_by_thread[i_thread].transpose();
+      if (compute_atomic_virials) {
+        atomic_virials += atomic_virials_by_thread[i_thread];
+      }
+    }
+    if (do_neg_stress) {
+      neg_stress /= domains.get_volume();
+    }
+    return std::make_tuple(energy, gradients, neg_stress, atomic_virials);
+  }
+
+  namespace internal {
+    /**
+     * Loop over the blocks of the pseudo points of central atom type sp
+     * whose key is in the dense feature matrix described by feature_offsets
+     * (see BlockSparseProperty::get_feature_offsets()) and call
+     * function(offset, indices, pseudo_points) with the column offset of the
+     * key, the indices of the pseudo points in the full set and their block.
+     */
+    template <class SparsePoints, class FeatureOffsets, class Function>
+    void for_each_sparse_point_block(const SparsePoints & sparse_points,
+                                     const int sp,
+                                     const FeatureOffsets & feature_offsets,
+                                     Function && function) {
+      if (sparse_points.species().count(sp) == 0) {
+        return;
+      }
+      const int sp_offset{sparse_points.get_offsets().at(sp)};
+      const auto & values_by_sp = sparse_points.values.at(sp);
+      const auto & indices_by_sp = sparse_points.indices.at(sp);
+      for (const auto & key : sparse_points.keys_sp.at(sp)) {
+        auto offset_it = feature_offsets.find(key);
+        if (offset_it == feature_offsets.end()) {
+          continue;
+        }
+        const auto & indices_by_sp_key = indices_by_sp.at(key);
+        std::vector<size_t> indices(indices_by_sp_key.size());
+        for (size_t i_point{0}; i_point < indices.size(); ++i_point) {
+          indices[i_point] = sp_offset + indices_by_sp_key[i_point];
+        }
+        auto mat = Eigen::Map<const math::Matrix_t>(
+            values_by_sp.at(key).data(),
+            static_cast<Eigen::Index>(indices_by_sp_key.size()),
+            static_cast<Eigen::Index>(sparse_points.inner_size));
+        function(offset_it->second, indices, mat);
+      }
+    }
+
+    /**
+     * Given the representation X^{i} of the centers and its change
+     * \delta X^{i} (dense feature matrices), compute for the SOAP-GAP
+     * prediction y = \sum_i \sum_n \alpha_n (X^{i} \cdot T_n)^{\zeta}
+     * dy/dX^{i} = \sum_n \alpha_n \zeta k_{in}^{\zeta-1} T_n and its change
+     * \sum_n \alpha_n \zeta (\zeta-1) k_{in}^{\zeta-2}
+     * (\delta X^{i} \cdot T_n) T_n with k_{in} = X^{i} \cdot T_n.
+     */
+    template <class SparsePoints, class FeatureOffsets>
+    std::tuple<math::Matrix_t, math::Matrix_t> compute_gap_features_gradient(
+        const SparsePoints & sparse_points, const math::Vector_t & weights,
+        const size_t zeta, const std::vector<int> & center_types,
+        const FeatureOffsets & feature_offsets, const math::Matrix_t & features,
+        const math::Matrix_t & features_change) {
+      const size_t n_points{sparse_points.size()};
+      math::Matrix_t features_gradient{
+          math::Matrix_t::Zero(features.rows(), features.cols())};
+      math::Matrix_t features_gradient_change{
+          math::Matrix_t::Zero(features.rows(), features.cols())};
+      math::Vector_t kernel_lin(n_points);
+      math::Vector_t kernel_lin_change(n_points);
+      const int inner_size{static_cast<int>(sparse_points.inner_size)};
+      for (int i_center{0}; i_center < features.rows(); ++i_center) {
+        const int sp{center_types[i_center]};
+        kernel_lin.setZero();
+        kernel_lin_change.setZero();
+        for_each_sparse_point_block(
+            sparse_points, sp, feature_offsets,
+            [&](const int offset, const std::vector<size_t> & indices,
+                const auto & pseudo_points) {
+              const math::Vector_t dots{
+                  features.row(i_center).segment(offset, inner_size) *
+                  pseudo_points.transpose()};
+              const math::Vector_t dots_change{
+                  features_change.row(i_center).segment(offset, inner_size) *
+                  pseudo_points.transpose()};
+              for (size_t i_point{0}; i_point < indices.size(); ++i_point) {
+                kernel_lin(indices[i_point]) += dots(i_point);
+                kernel_lin_change(indices[i_point]) += dots_change(i_point);
+              }
+            });
+        math::Vector_t weights_scaled{
+            (weights.array() * zeta *
+             pow_zeta(math::Matrix_t(kernel_lin), zeta - 1).array())
+                .matrix()};
+        math::Vector_t weights_scaled_change{math::Vector_t::Zero(n_points)};
+        if (zeta > 1) {
+          weights_scaled_change =
+              (weights.array() * zeta * (zeta - 1) *
+               pow_zeta(math::Matrix_t(kernel_lin), zeta - 2).array() *
+               kernel_lin_change.array())
+                  .matrix();
+        }
+        for_each_sparse_point_block(
+            sparse_points, sp, feature_offsets,
+            [&](const int offset, const std::vector<size_t> & indices,
+                const auto & pseudo_points) {
+              for (size_t i_point{0}; i_point < indices.size(); ++i_point) {
+                features_gradient.row(i_center).segment(offset, inner_size) +=
+                    weights_scaled(indices[i_point]) *
+                    pseudo_points.row(i_point);
+                features_gradient_change.row(i_center).segment(offset,
+                                                               inner_size) +=
+                    weights_scaled_change(indices[i_point]) *
+                    pseudo_points.row(i_point);
+              }
+            });
+      }
+      return std::make_tuple(features_gradient, features_gradient_change);
+    }
+  }  // namespace internal
+
+  /**
+   * Hessian-vector product \sum_k d^2y/dr_i dr_k \delta r_k of the
+   * prediction y of a sparse GPR model (only SOAP-GAP) for one structure
+   * w.r.t. the positions of its atoms, i.e. the change of the gradients
+   * computed by compute_sparse_kernel_gradients for the displacements
+   * \delta r_k of the atoms.
+   *
+   * The kernel part is exact. The representation part is propagated by
+   * CalculatorSphericalInvariants::jvp() and backward_jvp() pair by pair,
+   * so no gradient is stored and the cost is of the order of a few
+   * evaluations of the forces. The representation does not need to compute
+   * its gradients.
+   *
+   * @param displacements \delta r_k of shape (n_centers, 3)
+   * @param fd_step step in Angstrom of the finite differences of the
+   *        gradients of the expansion, the only approximate part, see
+   *        CalculatorSphericalExpansion::backward_jvp()
+   * @return the Hessian-vector product of shape (n_centers, 3)
+   *
+   * @throw logic_error if the kernel is not GAP
+   */
+  template <class Calculator, class StructureManager, class SparsePoints>
+  math::Matrix_t compute_sparse_kernel_hessian_vector_product(
+      Calculator & calculator, SparseKernel & kernel,
+      std::shared_ptr<StructureManager> manager, SparsePoints & sparse_points,
+      math::Vector_t & weights,
+      const Eigen::Ref<const math::Matrix_t> & displacements,
+      const double fd_step = 1e-5) {
+    using Property_t =
+        typename Calculator::template Property_t<StructureManager>;
+    auto kernel_type_str = kernel.parameters.at("name").get<std::string>();
+    if (kernel_type_str != "GAP") {
+      std::stringstream err_str{};
+      err_str << "Hessian-vector products are not implemented for the "
+                 "kernel: '"
+              << kernel_type_str << "'.";
+      throw std::logic_error(err_str.str());
+    }
+    const auto zeta = kernel.parameters.at("zeta").get<size_t>();
+    // \delta X^{i}, also computes the representation if needed
+    const math::Matrix_t features_change{
+        calculator.jvp(manager, displacements)};
+    RASCAL_TIMER("compute_sparse_kernel_hessian_vector_product");
+    constexpr bool ExcludeGhosts{true};
+    auto && prop{*manager->template get_property<Property_t>(
+        calculator.get_name(), true, true, ExcludeGhosts)};
+    const math::Matrix_t features{prop.get_features()};
+    std::vector<int> center_types{};
+    for (auto center : manager) {
+      center_types.push_back(center.get_atom_type());
+    }
+    math::Matrix_t features_gradient{}, features_gradient_change{};
+    std::tie(features_gradient, features_gradient_change) =
+        internal::compute_gap_features_gradient(
+            sparse_points, weights, zeta, center_types,
+            prop.get_feature_offsets(), features, features_change);
+    return calculator.backward_jvp(manager, features_gradient,
+                                   features_gradient_change, displacements,
+                                   fd_step);
+  }
+
+  /**
+   * Assemble the Hessian d^2y/dr_i dr_k of the prediction y of a sparse GPR
+   * model (only SOAP-GAP) w.r.t. the positions of the atoms of a (small)
+   * structure from Hessian-vector products, see
+   * compute_sparse_kernel_hessian_vector_product. The rows and columns are
+   * ordered like the gradients, i.e. 3 i_atom + i_der.
+   *
+   * d^2y/dr_i dr_k vanishes unless i and k are in a common environment, so
+   * the atoms are colored such that two atoms sharing a coupled atom have
+   * different colors, and all the atoms of a color are displaced in the
+   * same product. The Hessian costs 3 n_colors products instead of 6 N
+   * evaluations of the forces with finite differences.
+   *
+   * @param fd_step see compute_sparse_kernel_hessian_vector_product
+   * @return the Hessian of shape (3 n_centers, 3 n_centers)
+   */
+  template <class Calculator, class StructureManager, class SparsePoints>
+  Eigen::SparseMatrix<double>
+  compute_sparse_kernel_hessian(Calculator & calculator, SparseKernel & kernel,
+                                std::shared_ptr<StructureManager> manager,
+                                SparsePoints & sparse_points,
+                                math::Vector_t & weights,
+                                const double fd_step = 1e-5) {
+    RASCAL_TIMER("compute_sparse_kernel_hessian");
+    const size_t n_centers{manager->size()};
+    // atoms in the environment of each center
+    std::vector<std::set<size_t>> environments(n_centers);
+    for (auto center : manager) {
+      const size_t i_atom{manager->get_atom_index(center.get_atom_tag())};
+      environments[i_atom].insert(i_atom);
+      for (auto neigh : center.pairs()) {
+        const size_t j_atom{manager->get_atom_index(neigh.get_atom_tag())};
+        if (j_atom >= n_centers) {
+          continue;
+        }
+        environments[i_atom].insert(j_atom);
+        // a half neighbour list has the pair only once
+        environments[j_atom].insert(i_atom);
+      }
+    }
+    // atoms k such that d^2y/dr_i dr_k can be non zero
+    std::vector<std::set<size_t>> coupled_atoms(n_centers);
+    for (const auto & environment : environments) {
+      for (const size_t i_atom : environment) {
+        coupled_atoms[i_atom].insert(environment.begin(), environment.end());
+      }
+    }
+    // greedy coloring of the atoms
+    std::vector<size_t> colors(n_centers, 0);
+    size_t n_colors{0};
+    for (size_t i_atom{0}; i_atom < n_centers; ++i_atom) {
+      std::set<size_t> forbidden_colors{};
+      for (const size_t k_atom : coupled_atoms[i_atom]) {
+        for (const size_t j_atom : coupled_atoms[k_atom]) {
+          if (j_atom < i_atom) {
+            forbidden_colors.insert(colors[j_atom]);
+          }
+        }
+      }
+      size_t color{0};
+      while (forbidden_colors.count(color)) {
+        ++color;
+      }
+      colors[i_atom] = color;
+      n_colors = std::max(n_colors, color + 1);
+    }
+
+    std::vector<Eigen::Triplet<double>> entries{};
+    math::Matrix_t displacements{n_centers, ThreeD};
+    for (size_t color{0}; color < n_colors; ++color) {
+      for (int i_der{0}; i_der < ThreeD; ++i_der) {
+        displacements.setZero();
+        for (size_t i_atom{0}; i_atom < n_centers; ++i_atom) {
+          if (colors[i_atom] == color) {
+            displacements(i_atom, i_der) = 1.;
+          }
+        }
+        const math::Matrix_t hessian_columns{
+            compute_sparse_kernel_hessian_vector_product(
+                calculator, kernel, manager, sparse_points, weights,
+                displacements, fd_step)};
+        for (size_t i_atom{0}; i_atom < n_centers; ++i_atom) {
+          if (colors[i_atom] != color) {
+            continue;
+          }
+          for (const size_t k_atom : coupled_atoms[i_atom]) {
+            for (int k_der{0}; k_der < ThreeD; ++k_der) {
+              entries.emplace_back(k_atom * ThreeD + k_der,
+                                   i_atom * ThreeD + i_der,
+                                   hessian_columns(k_atom, k_der));
+            }
+          }
+        }
+      }
+    }
+    Eigen::SparseMatrix<double> hessian(n_centers * ThreeD,
+                                        n_centers * ThreeD);
+    hessian.setFromTriplets(entries.begin(), entries.end());
+    return hessian;
+  }
 }  // namespace rascal
 #endif  // SRC_RASCAL_MODELS_SPARSE_KERNEL_PREDICT_HH_
@@ -32,10 +32,57 @@
 #include "rascal/models/kernels.hh"
 #include "rascal/structure_managers/structure_manager_collection.hh"
 #include "rascal/utils/json_io.hh"
+#include "rascal/utils/timer.hh"
+
+#include <sstream>
+#include <string>
 
 namespace rascal {
 
   namespace internal {
+    /**
+     * The gradient of a representation w.r.t. the position of its center,
+     * i.e. of the pair ii, accounts for the periodic images of the center
+     * since they move along with it. So the gradients of the pairs between a
+     * center and its own images only contribute to the stress, and the ones
+     * w.r.t. the masked atoms are not reported.
+     *
+     * @return true if the gradient of the pair is added to the gradient
+     * w.r.t. the position of one of the centers of the manager
+     */
+    template <class StructureManager, class Center, class Pair>
+    bool is_center_gradient_pair(
+        const std::shared_ptr<StructureManager> & manager,
+        const Center & center, Pair & neigh) {
+      const int atom_i_tag{center.get_atom_tag()};
+      if (manager->get_atom_index(neigh.get_atom_tag()) >= manager->size()) {
+        return false;
+      }
+      return neigh.get_atom_tag() == atom_i_tag or
+             neigh.get_atom_j().get_atom_tag() != atom_i_tag;
+    }
+
+    /**
+     * The kernel gradients are accumulated over the pairs of the neighbour
+     * list. With a half neighbour list the contributions of the missing
+     * pairs ji, i.e. \grad_i p^{j} (see
+     * CalculatorSphericalInvariants::get_reverse_gradient_name), would be
+     * silently dropped so these lists are rejected.
+     *
+     * @throw std::logic_error if StructureManager is a half neighbour list
+     */
+    template <class StructureManager>
+    void check_full_neighbour_list(const std::string & function_name) {
+      if (StructureManager::traits::NeighbourListType ==
+          AdaptorTraits::NeighbourListType::half) {
+        std::stringstream err_str{};
+        err_str << function_name
+                << " does not support half neighbour lists, the gradients "
+                   "of the kernels need a full neighbour list.";
+        throw std::logic_error(err_str.str());
+      }
+    }
+
     enum class SparseKernelType { GAP };
 
     template <internal::SparseKernelType Type>
@@ -88,6 +135,60 @@ namespace rascal {
         }
       }
 
+      /**
+       * Compute the kernels between a set of structure(s) and a set of pseudo
+       * points for several exponents at once. The dot products between the
+       * representations and the pseudo points, i.e. the linear kernel, are
+       * computed once per center and then raised to each exponent, which
+       * makes scanning over zeta about as cheap as a single kernel.
+       *
+       * @tparam Type whether the rows of the kernels are associated with the
+       *          structures or with the centers
+       * @param managers a ManagerCollection or similar collection of
+       * structure managers
+       * @param sparse_points a SparsePoints* class
+       * @param representation_name name under which the representation data
+       * has been registered in the elements of managers
+       * @param zetas exponents of the kernels
+       * @return one kernel matrix per element of zetas
+       */
+      template <class Property_t, internal::TargetType Type,
+                class StructureManagers, class SparsePoints>
+      std::vector<math::Matrix_t>
+      compute_for_zetas(const StructureManagers & managers,
+                        const SparsePoints & sparse_points,
+                        const std::string & representation_name,
+                        const std::vector<size_t> & zetas) {
+        constexpr bool per_structure{Type == internal::TargetType::Structure};
+        size_t nb_rows{0};
+        for (const auto & manager : managers) {
+          nb_rows += per_structure ? 1 : manager->size();
+        }
+        std::vector<math::Matrix_t> KNMs(
+            zetas.size(), math::Matrix_t::Zero(nb_rows, sparse_points.size()));
+        size_t ii_A{0};
+        for (auto & manager : managers) {
+          auto && propA{*manager->template get_property<Property_t>(
+              representation_name, true)};
+          for (auto center : manager) {
+            int sp = center.get_atom_type();
+            // only the pseudo points of species sp contribute
+            const math::Matrix_t dots{sparse_points.dot(sp, propA[center])};
+            for (size_t i_zeta{0}; i_zeta < zetas.size(); ++i_zeta) {
+              KNMs[i_zeta].row(ii_A) +=
+                  pow_zeta(math::Matrix_t(dots), zetas[i_zeta]).transpose();
+            }
+            if (not per_structure) {
+              ++ii_A;
+            }
+          }
+          if (per_structure) {
+            ++ii_A;
+          }
+        }
+        return KNMs;
+      }
+
       /**
        * Compute the kernel between a set of structure(s) and a set of pseudo
        * points, per structure.
@@ -108,45 +209,52 @@ namespace rascal {
       math::Matrix_t compute(StructureManagers & managers,
                              SparsePoints & sparse_points,
                              const std::string & representation_name) {
-        math::Matrix_t KNM(managers.size(), sparse_points.size());
-        KNM.setZero();
-        size_t ii_A{0};
-        for (auto & manager : managers) {
-          auto && propA{*manager->template get_property<Property_t>(
-              representation_name, true)};
-          for (auto center : manager) {
-            int sp = center.get_atom_type();
-            // only the pseudo points of species sp contribute
-            KNM.row(ii_A) +=
-                pow_zeta(sparse_points.dot(sp, propA[center]), this->zeta)
-                    .transpose();
-          }
-          ++ii_A;
-        }
-        return KNM;
+        auto KNMs = this->template compute_for_zetas<Property_t, Type>(
+            managers, sparse_points, representation_name, {this->zeta});
+        return std::move(KNMs.front());
       }
 
       /**
-       * Compute the kernel between a set of pseudo points.
+       * Compute the kernels between a set of pseudo points for several
+       * exponents, reusing the dot products between the pseudo points.
        *
-       * @tparam SparsePoints should be a set a set of SparsePoints
        * @param sparse_points a SparsePoints* class
-       * @return kernel matrix MxM
+       * @param zetas exponents of the kernels
+       * @return one MxM kernel matrix per element of zetas
        */
       template <class SparsePoints>
-      math::Matrix_t compute(SparsePoints & sparse_points) {
-        math::Matrix_t KMM(sparse_points.size(), sparse_points.size());
-        KMM.setZero();
+      std::vector<math::Matrix_t>
+      compute_for_zetas(const SparsePoints & sparse_points,
+                        const std::vector<size_t> & zetas) {
+        std::vector<math::Matrix_t> KMMs(
+            zetas.size(),
+            math::Matrix_t::Zero(sparse_points.size(), sparse_points.size()));
         int start{0};
         // loop over the species
         for (const int & sp : sparse_points.species()) {
           // only the pseudo points of the same species contribute
           auto block_size = sparse_points.size_by_species(sp);
-          KMM.block(start, start, block_size, block_size) =
-              pow_zeta(sparse_points.self_dot(sp), this->zeta);
+          const math::Matrix_t dots{sparse_points.self_dot(sp)};
+          for (size_t i_zeta{0}; i_zeta < zetas.size(); ++i_zeta) {
+            KMMs[i_zeta].block(start, start, block_size, block_size) =
+                pow_zeta(math::Matrix_t(dots), zetas[i_zeta]);
+          }
           start += block_size;
         }
-        return KMM;
+        return KMMs;
+      }
+
+      /**
+       * Compute the kernel between a set of pseudo points.
+       *
+       * @tparam SparsePoints should be a set a set of SparsePoints
+       * @param sparse_points a SparsePoints* class
+       * @return kernel matrix MxM
+       */
+      template <class SparsePoints>
+      math::Matrix_t compute(SparsePoints & sparse_points) {
+        auto KMMs = this->compute_for_zetas(sparse_points, {this->zeta});
+        return std::move(KMMs.front());
       }
 
       /**
@@ -168,25 +276,9 @@ namespace rascal {
       math::Matrix_t compute(const StructureManagers & managers,
                              const SparsePoints & sparse_points,
                              const std::string & representation_name) {
-        size_t n_centersA{0};
-        for (const auto & manager : managers) {
-          n_centersA += manager->size();
-        }
-        size_t nb_sparse_points{sparse_points.size()};
-        math::Matrix_t KNM(n_centersA, nb_sparse_points);
-        size_t ii_A{0};
-        for (auto & manager : managers) {
-          auto && propA{*manager->template get_property<Property_t>(
-              representation_name, true)};
-          for (auto center : manager) {
-            int sp = center.get_atom_type();
-            KNM.row(ii_A) =
-                pow_zeta(sparse_points.dot(sp, propA[center]), this->zeta)
-                    .transpose();
-            ii_A++;
-          }
-        }
-        return KNM;
+        auto KNMs = this->template compute_for_zetas<Property_t, Type>(
+            managers, sparse_points, representation_name, {this->zeta});
+        return std::move(KNMs.front());
       }
 
       /**
@@ -244,6 +336,10 @@ namespace rascal {
        * The elements are stored at the end of the returned matrix using the
        * Voigt format (xx, yy, zz, zy, zx, yx) in the order of managers.
        *
+       * When some center atoms are masked, only the environments of the
+       * centers contribute and only the gradients w.r.t. the centers
+       * are stored while the stress includes the masked neighbours.
+       *
        * @tparam StructureManagers should be an iterable over shared pointer
        *         of structure managers like ManagerCollection
        * @param sparse_points a SparsePoints* class
@@ -265,9 +361,34 @@ namespace rascal {
                          const std::string & representation_name,
                          const std::string & representation_grad_name,
                          const bool compute_neg_stress) {
-        using Manager_t = typename StructureManagers::Manager_t;
-        using Keys_t = typename SparsePoints::Keys_t;
-        using Key_t = typename SparsePoints::Key_t;
+        auto KNM_ders = this->template compute_derivative_for_zetas<
+            Property_t, PropertyGradient_t, Type>(
+            managers, sparse_points, representation_name,
+            representation_grad_name, compute_neg_stress, {this->zeta});
+        return std::move(KNM_ders.front());
+      }
+
+      /**
+       * Compute the kernel gradients of compute_derivative for several
+       * exponents at once. The expensive contractions of the representation
+       * gradients with the pseudo points, \f$\frac{ \partial X_j }{ \partial
+       * \mathbf{r}_i } \cdot T_m\f$, and the dot products
+       * \f$\sum_n X_{jn} T_{mn}\f$ are computed only once and shared by all
+       * the exponents.
+       *
+       * @param zetas exponents of the kernels
+       * @return one kernel gradient matrix per element of zetas, see
+       *         compute_derivative for their layout
+       */
+      template <class Property_t, class PropertyGradient_t,
+                internal::TargetType Type,
+                std::enable_if_t<Type == internal::TargetType::Atom, int> = 0,
+                class StructureManagers, class SparsePoints>
+      std::vector<math::Matrix_t> compute_derivative_for_zetas(
+          StructureManagers & managers, SparsePoints & sparse_points,
+          const std::string & representation_name,
+          const std::string & representation_grad_name,
+          const bool compute_neg_stress, const std::vector<size_t> & zetas) {
         // the nb of rows of the kernel matrix consist of:
         // - 3*nb_centers rows for each center for each spatial_dim
         // - 6 rows at the end for the stress tensor in voigt notation if
@@ -282,6 +403,46 @@ namespace rascal {
         if (compute_neg_stress) {
           nb_kernel_gradient_rows += 2 * SpatialDims * managers.size();
         }
+
+        std::vector<math::Matrix_t> KNM_ders(
+            zetas.size(), math::Matrix_t::Zero(nb_kernel_gradient_rows,
+                                               sparse_points.size()));
+        size_t idx_center{0};
+        // loop over the structures
+        for (auto & manager : managers) {
+          this->template add_derivative_for_zetas<Property_t,
+                                                  PropertyGradient_t>(
+              manager, sparse_points, representation_name,
+              representation_grad_name, compute_neg_stress, zetas, idx_center,
+              row_idx_stress, KNM_ders);
+          idx_center += SpatialDims * manager->size();
+          if (compute_neg_stress) {
+            row_idx_stress += SpatialDims * 2;
+          }
+        }  // managers
+        return KNM_ders;
+      }
+
+     protected:
+      /**
+       * Fill the rows of the kernel gradients associated with the centers of
+       * one structure, starting at idx_center, and its negative stress, at
+       * row_idx_stress, for each of the exponents in zetas.
+       */
+      template <class Property_t, class PropertyGradient_t, class ManagerPtr,
+                class SparsePoints>
+      void add_derivative_for_zetas(
+          ManagerPtr & manager, SparsePoints & sparse_points,
+          const std::string & representation_name,
+          const std::string & representation_grad_name,
+          const bool compute_neg_stress, const std::vector<size_t> & zetas,
+          const size_t idx_center, const size_t row_idx_stress,
+          std::vector<math::Matrix_t> & KNM_ders) {
+        using Manager_t = typename ManagerPtr::element_type;
+        using Keys_t = typename SparsePoints::Keys_t;
+        using Key_t = typename SparsePoints::Key_t;
+        using Gradient_t =
+            Eigen::Matrix<double, Eigen::Dynamic, SpatialDims, Eigen::ColMajor>;
         // Voigt order is xx, yy, zz, yz, xz, xy. To compute xx, yy, zz
         // and yz, xz, xy in one loop over the three spatial dimensions
         // dK/dr_{x,y,z}, we fill the off-diagonals yz, xz, xy by computing
@@ -295,127 +456,151 @@ namespace rascal {
                                         {{3, 1}}}};  //    yz,            y
 
         const size_t nb_sparse_points{sparse_points.size()};
-        math::Matrix_t KNM_der(nb_kernel_gradient_rows, nb_sparse_points);
-        KNM_der.setZero();
-        const size_t zeta{this->zeta};
-        size_t idx_center{0};
-        // loop over the structures
-        for (auto & manager : managers) {
-          auto && prop_repr{*manager->template get_property<Property_t>(
-              representation_name, true)};
-          auto && prop_repr_grad{
-              *manager->template get_property<PropertyGradient_t>(
-                  representation_grad_name, true)};
-          // dk/dr_i this is col major hence dim order
-          Property<double, 1, Manager_t, Eigen::Dynamic, SpatialDims> dkdr{
-              *manager, "dkdr", true};
-          dkdr.set_nb_row(nb_sparse_points);
-          dkdr.resize();
-          dkdr.setZero();
-
-          // dk/dX without sparse point factor T
-          Property<double, 1, Manager_t, Eigen::Dynamic, 1> dkdX_missing_T{
-              *manager, "dkdX without sparse point factor T", true};
-          dkdX_missing_T.set_nb_row(nb_sparse_points);
-          dkdX_missing_T.resize();
-          if (zeta > 1) {
-            dkdX_missing_T.setZero();
-            // zeta * (X * T)**(zeta-1)
-            for (auto center : manager) {
-              int a_species{center.get_atom_type()};
-              dkdX_missing_T[center] =
-                  zeta *
-                  pow_zeta(sparse_points.dot(a_species, prop_repr[center]),
-                           zeta - 1);
+        const size_t nb_zetas{zetas.size()};
+        bool any_zeta_above_one{false};
+        for (const size_t & zeta : zetas) {
+          any_zeta_above_one = any_zeta_above_one or zeta > 1;
+        }
+
+        auto && prop_repr{*manager->template get_property<Property_t>(
+            representation_name, true)};
+        auto && prop_repr_grad{
+            *manager->template get_property<PropertyGradient_t>(
+                representation_grad_name, true)};
+        // dk/dr_i this is col major hence dim order, the kernel gradients of
+        // the successive exponents are stacked along the rows
+        Property<double, 1, Manager_t, Eigen::Dynamic, SpatialDims> dkdr{
+            *manager, "dkdr", true};
+        dkdr.set_nb_row(nb_zetas * nb_sparse_points);
+        dkdr.resize();
+        dkdr.setZero();
+
+        // dk/dX without sparse point factor T, stacked like dkdr
+        Property<double, 1, Manager_t, Eigen::Dynamic, 1> dkdX_missing_T{
+            *manager, "dkdX without sparse point factor T", true};
+        dkdX_missing_T.set_nb_row(nb_zetas * nb_sparse_points);
+        dkdX_missing_T.resize();
+        // zeta * (X * T)**(zeta-1), which is 1 for zeta == 1
+        math::Matrix_t dots{};
+        for (auto center : manager) {
+          if (any_zeta_above_one) {
+            dots = sparse_points.dot(center.get_atom_type(), prop_repr[center]);
+          }
+          auto dkdX_i_missing_T = dkdX_missing_T[center];
+          for (size_t i_zeta{0}; i_zeta < nb_zetas; ++i_zeta) {
+            const size_t & zeta{zetas[i_zeta]};
+            auto dkdX_i_zeta = dkdX_i_missing_T.segment(
+                i_zeta * nb_sparse_points, nb_sparse_points);
+            if (zeta > 1) {
+              dkdX_i_zeta = zeta * pow_zeta(math::Matrix_t(dots), zeta - 1);
+            } else {
+              dkdX_i_zeta.setOnes();
             }
           }
-          //
-          const int block_size{prop_repr.get_nb_comp()};
+        }
+        //
+        const int block_size{prop_repr.get_nb_comp()};
 
-          bool do_block_by_key_dot{false};
-          if (prop_repr_grad.are_keys_uniform()) {
-            do_block_by_key_dot = true;
-          }
+        bool do_block_by_key_dot{false};
+        if (prop_repr_grad.are_keys_uniform()) {
+          do_block_by_key_dot = true;
+        }
 
-          std::set<int> unique_species{};
-          for (auto center : manager) {
-            unique_species.insert(center.get_atom_type());
-          }
+        std::set<int> unique_species{};
+        for (auto center : manager) {
+          unique_species.insert(center.get_atom_type());
+        }
 
-          // find shared central atom species
-          std::set<int> species_intersect{internal::set_intersection(
-              unique_species, sparse_points.species())};
+        // find shared central atom species
+        std::set<int> species_intersect{internal::set_intersection(
+            unique_species, sparse_points.species())};
 
-          if (species_intersect.size() == 0) {
-            return KNM_der;
-          }
+        // no center of this structure has pseudo points so its rows stay 0
+        if (species_intersect.size() == 0) {
+          return;
+        }
 
-          // find offsets along the sparse points spatial_dim
-          std::map<int, int> offsets{sparse_points.get_offsets()};
-          Keys_t repr_keys{prop_repr_grad.get_keys()};
-          std::map<int, Keys_t> keys_intersect{};
-          for (const int & species : species_intersect) {
-            keys_intersect[species] = internal::set_intersection(
-                repr_keys, sparse_points.keys_sp.at(species));
-          }
-          // compute dX/dr * T * k_{zeta-1} * zeta
-          if (do_block_by_key_dot) {
-            size_t idx_row{0};
-            auto repr_grads = prop_repr_grad.get_raw_data_view();
-            for (auto center : manager) {
-              int a_species{center.get_atom_type()};
-              Eigen::Vector3d r_i = center.get_position();
-              if (species_intersect.count(a_species) == 0) {
-                continue;
+        // find offsets along the sparse points spatial_dim
+        std::map<int, int> offsets{sparse_points.get_offsets()};
+        Keys_t repr_keys{prop_repr_grad.get_keys()};
+        std::map<int, Keys_t> keys_intersect{};
+        for (const int & species : species_intersect) {
+          keys_intersect[species] = internal::set_intersection(
+              repr_keys, sparse_points.keys_sp.at(species));
+        }
+        // compute dX/dr * T * k_{zeta-1} * zeta
+        if (do_block_by_key_dot) {
+          size_t idx_row{0};
+          auto repr_grads = prop_repr_grad.get_raw_data_view();
+          math::Matrix_t dXdr_T_block{};
+          math::Matrix_t scaled_block{};
+          for (auto center : manager) {
+            int a_species{center.get_atom_type()};
+            Eigen::Vector3d r_i = center.get_position();
+            if (species_intersect.count(a_species) == 0) {
+              continue;
+            }
+            auto dkdX_i_missing_T = dkdX_missing_T[center];
+            const int offset = offsets.at(a_species);
+            const auto & values_by_sp = sparse_points.values.at(a_species);
+            const auto & indices_by_sp = sparse_points.indices.at(a_species);
+            const size_t nb_rows{center.pairs_with_self_pair().size()};
+            for (const Key_t & key : keys_intersect.at(a_species)) {
+              const auto & indices_by_sp_key = indices_by_sp.at(key);
+              const auto & values_by_sp_key = values_by_sp.at(key);
+              const size_t nb_key_points{indices_by_sp_key.size()};
+              auto sparse_points_block = Eigen::Map<const math::Matrix_t>(
+                  values_by_sp_key.data(),
+                  static_cast<Eigen::Index>(nb_key_points),
+                  static_cast<Eigen::Index>(block_size));
+              assert(nb_key_points * block_size == values_by_sp_key.size());
+              // copy subset of k_{zeta-1} * zeta that matches a_species and
+              // key for each exponent
+              math::Matrix_t dkdX_i_missing_T_a_species_block(nb_zetas,
+                                                              nb_key_points);
+              for (size_t i_zeta{0}; i_zeta < nb_zetas; ++i_zeta) {
+                for (size_t idx_col{0}; idx_col < nb_key_points; idx_col++) {
+                  dkdX_i_missing_T_a_species_block(i_zeta, idx_col) =
+                      dkdX_i_missing_T(i_zeta * nb_sparse_points + offset +
+                                       indices_by_sp_key[idx_col]);
+                }  // sparse points
               }
-              auto dkdX_i_missing_T = dkdX_missing_T[center];
-              const int offset = offsets.at(a_species);
-              const auto & values_by_sp = sparse_points.values.at(a_species);
-              const auto & indices_by_sp = sparse_points.indices.at(a_species);
-              const size_t nb_rows{center.pairs_with_self_pair().size()};
-              for (const Key_t & key : keys_intersect.at(a_species)) {
-                const auto & indices_by_sp_key = indices_by_sp.at(key);
-                const auto & values_by_sp_key = values_by_sp.at(key);
-                auto sparse_points_block = Eigen::Map<const math::Matrix_t>(
-                    values_by_sp_key.data(),
-                    static_cast<Eigen::Index>(indices_by_sp_key.size()),
-                    static_cast<Eigen::Index>(block_size));
-                assert(indices_by_sp_key.size() * block_size ==
-                       values_by_sp_key.size());
-                math::Matrix_t KNM_der_block(nb_rows, indices_by_sp_key.size());
-                // copy subset of k_{zeta-1} * zeta that matches a_species and
-                // key
-                math::Vector_t dkdX_i_missing_T_a_species_block{
-                    indices_by_sp_key.size()};
-                if (zeta > 1) {
-                  for (size_t idx_col{0}; idx_col < indices_by_sp_key.size();
-                       idx_col++) {
-                    dkdX_i_missing_T_a_species_block(idx_col) =
-                        dkdX_i_missing_T(offset + indices_by_sp_key[idx_col]);
-                  }  // sparse points
-                }
-                int block_start_col_idx{
-                    prop_repr_grad.get_gradient_col_by_key(key)};
-                for (int idx_spatial_dim{0}; idx_spatial_dim < SpatialDims;
-                     idx_spatial_dim++) {
-                  // dX/dr * T
-                  KNM_der_block =
-                      repr_grads.block(idx_row,
-                                       block_start_col_idx +
-                                           idx_spatial_dim * block_size,
-                                       nb_rows, block_size) *
-                      sparse_points_block.transpose();
+              int block_start_col_idx{
+                  prop_repr_grad.get_gradient_col_by_key(key)};
+              for (int idx_spatial_dim{0}; idx_spatial_dim < SpatialDims;
+                   idx_spatial_dim++) {
+                // dX/dr * T
+                dXdr_T_block.noalias() =
+                    repr_grads.block(idx_row,
+                                     block_start_col_idx +
+                                         idx_spatial_dim * block_size,
+                                     nb_rows, block_size) *
+                    sparse_points_block.transpose();
+                for (size_t i_zeta{0}; i_zeta < nb_zetas; ++i_zeta) {
+                  const bool scale{zetas[i_zeta] > 1};
                   // * zeta * (X * T)**(zeta-1)
-                  if (zeta > 1) {
-                    KNM_der_block *=
-                        dkdX_i_missing_T_a_species_block.asDiagonal();
+                  if (scale) {
+                    scaled_block.noalias() =
+                        dXdr_T_block *
+                        dkdX_i_missing_T_a_species_block.row(i_zeta)
+                            .asDiagonal();
                   }
+                  const math::Matrix_t & KNM_der_block{
+                      scale ? scaled_block : dXdr_T_block};
+                  math::Matrix_t & KNM_der{KNM_ders[i_zeta]};
+                  const size_t zeta_offset{i_zeta * nb_sparse_points + offset};
                   int idx_neigh{0};
                   for (auto neigh : center.pairs_with_self_pair()) {
+                    // the gradients w.r.t. masked atoms and the images of
+                    // the center are not part of KNM
+                    if (not is_center_gradient_pair(manager, center, neigh)) {
+                      idx_neigh++;
+                      continue;
+                    }
                     auto dkdr_ji{dkdr[neigh.get_atom_j()]};
                     for (int idx_col{0}; idx_col < KNM_der_block.cols();
                          idx_col++) {
-                      dkdr_ji(offset + indices_by_sp_key[idx_col],
+                      dkdr_ji(zeta_offset + indices_by_sp_key[idx_col],
                               idx_spatial_dim) +=
                           KNM_der_block(idx_neigh, idx_col);
                     }  // sparse points
@@ -442,60 +627,84 @@ namespace rascal {
                       idx_neigh++;
                     }  // neigh
                   }    // if compute_neg_stress
-                }      // idx_spatial_dim
-              }        // key
-              idx_row += nb_rows;
-            }  // center
-          } else {
-            for (auto center : manager) {
-              int a_species{center.get_atom_type()};
-              Eigen::Vector3d r_i = center.get_position();
-              auto dkdX_i_missing_T = dkdX_missing_T[center];
-              for (auto neigh : center.pairs_with_self_pair()) {
-                // T * dX/dr
-                auto T_times_dXdr = sparse_points.dot_derivative(
-                    a_species, prop_repr_grad[neigh]);
+                }      // zeta
+              }        // idx_spatial_dim
+            }          // key
+            idx_row += nb_rows;
+          }  // center
+        } else {
+          Gradient_t scaled_T_times_dXdr{};
+          for (auto center : manager) {
+            int a_species{center.get_atom_type()};
+            Eigen::Vector3d r_i = center.get_position();
+            auto dkdX_i_missing_T = dkdX_missing_T[center];
+            for (auto neigh : center.pairs_with_self_pair()) {
+              // T * dX/dr
+              const Gradient_t T_times_dXdr = sparse_points.dot_derivative(
+                  a_species, prop_repr_grad[neigh]);
+              // the gradients w.r.t. masked atoms and the images of the
+              // center are not part of KNM
+              const bool is_center{
+                  is_center_gradient_pair(manager, center, neigh)};
+              Eigen::Vector3d r_ji = r_i - neigh.get_position();
+              for (size_t i_zeta{0}; i_zeta < nb_zetas; ++i_zeta) {
+                const bool scale{zetas[i_zeta] > 1};
                 // * zeta * (X * T)**(zeta-1)
-                if (zeta > 1) {
-                  T_times_dXdr.transpose() *= dkdX_i_missing_T.asDiagonal();
+                if (scale) {
+                  scaled_T_times_dXdr.noalias() =
+                      dkdX_i_missing_T
+                          .segment(i_zeta * nb_sparse_points,
+                                   nb_sparse_points)
+                          .asDiagonal() *
+                      T_times_dXdr;
+                }
+                const Gradient_t & dkdr_ij{scale ? scaled_T_times_dXdr
+                                                 : T_times_dXdr};
+                if (is_center) {
+                  dkdr[neigh.get_atom_j()].middleRows(
+                      i_zeta * nb_sparse_points, nb_sparse_points) += dkdr_ij;
                 }
-                dkdr[neigh.get_atom_j()] += T_times_dXdr;
                 if (compute_neg_stress) {
-                  Eigen::Vector3d r_ji = r_i - neigh.get_position();
+                  math::Matrix_t & KNM_der{KNM_ders[i_zeta]};
                   for (int i_der{0}; i_der < SpatialDims; i_der++) {
                     const auto & voigt = voigt_id_to_spatial_dim[i_der];
                     // computes in order xx, yy, zz
                     KNM_der.row(row_idx_stress + i_der) +=
-                        r_ji(i_der) * T_times_dXdr.transpose().row(i_der);
+                        r_ji(i_der) * dkdr_ij.col(i_der).transpose();
                     // computes in order xz, xy, yz
                     KNM_der.row(row_idx_stress + voigt[0]) +=
-                        r_ji(voigt[1]) * T_times_dXdr.transpose().row(i_der);
+                        r_ji(voigt[1]) * dkdr_ij.col(i_der).transpose();
                   }
                 }
-              }  // neigh
-            }    // center
-          }      // if do_block_by_key_dot
+              }  // zeta
+            }    // neigh
+          }      // center
+        }        // if do_block_by_key_dot
 
-          // copy the data to the kernel matrix
-          for (auto center : manager) {
-            KNM_der.block(idx_center, 0, SpatialDims, nb_sparse_points) =
-                dkdr[center].transpose();
-            idx_center += SpatialDims;
+        // copy the data to the kernel matrices
+        size_t idx_row{idx_center};
+        for (auto center : manager) {
+          for (size_t i_zeta{0}; i_zeta < nb_zetas; ++i_zeta) {
+            KNM_ders[i_zeta].block(idx_row, 0, SpatialDims, nb_sparse_points) =
+                dkdr[center]
+                    .middleRows(i_zeta * nb_sparse_points, nb_sparse_points)
+                    .transpose();
           }
-          if (compute_neg_stress) {
-            // TODO(alex) when we established how we deal with
-            // `get_atomic_structure` method for other root managers
-            // replace this part
-            auto manager_root = extract_underlying_manager<0>(manager);
-            json structure_copy = manager_root->get_atomic_structure();
-            auto atomic_structure =
-                structure_copy.template get<AtomicStructure<SpatialDims>>();
+          idx_row += SpatialDims;
+        }
+        if (compute_neg_stress) {
+          // TODO(alex) when we established how we deal with
+          // `get_atomic_structure` method for other root managers
+          // replace this part
+          auto manager_root = extract_underlying_manager<0>(manager);
+          json structure_copy = manager_root->get_atomic_structure();
+          auto atomic_structure =
+              structure_copy.template get<AtomicStructure<SpatialDims>>();
+          for (auto & KNM_der : KNM_ders) {
             KNM_der.block(row_idx_stress, 0, 6, KNM_der.cols()) /=
                 atomic_structure.get_volume();
-            row_idx_stress += SpatialDims * 2;
           }
-        }  // managers
-        return KNM_der;
+        }
       }
     };
   }  // namespace internal
@@ -577,6 +786,7 @@ namespace rascal {
     math::Matrix_t compute(const Calculator & calculator,
                            const StructureManagers & managers,
                            const SparsePoints & sparse_points) {
+      RASCAL_TIMER("SparseKernel::compute");
       using ManagerPtr_t = typename StructureManagers::value_type;
       using Manager_t = typename ManagerPtr_t::element_type;
       using Property_t = typename Calculator::template Property_t<Manager_t>;
@@ -622,6 +832,7 @@ namespace rascal {
 
     template <class SparsePoints>
     math::Matrix_t compute(const SparsePoints & sparse_points) {
+      RASCAL_TIMER("SparseKernel::compute_sparse_points");
       using internal::SparseKernelType;
 
       if (this->kernel_type == SparseKernelType::GAP) {
@@ -637,6 +848,80 @@ namespace rascal {
       }
     }
 
+    /**
+     * Compute the kernels between a set of structures and a set of pseudo
+     * points for several values of zeta. The linear kernel is computed once
+     * and shared by all the exponents, so that the exponent can be selected,
+     * e.g. by cross validation, at the cost of a single kernel evaluation.
+     *
+     * @param zetas exponents of the kernels, the zeta of the hypers is not
+     *        used
+     * @return one kernel matrix per element of zetas
+     */
+    template <class Calculator, class StructureManagers, class SparsePoints>
+    std::vector<math::Matrix_t>
+    compute_for_zetas(const Calculator & calculator,
+                      const StructureManagers & managers,
+                      const SparsePoints & sparse_points,
+                      const std::vector<size_t> & zetas) {
+      RASCAL_TIMER("SparseKernel::compute_for_zetas");
+      using ManagerPtr_t = typename StructureManagers::value_type;
+      using Manager_t = typename ManagerPtr_t::element_type;
+      using Property_t = typename Calculator::template Property_t<Manager_t>;
+      auto && representation_name{calculator.get_name()};
+      using internal::SparseKernelType;
+      using internal::TargetType;
+
+      if (this->kernel_type != SparseKernelType::GAP) {
+        throw std::logic_error(
+            "Given kernel_type " +
+            this->parameters["kernel_type"].get<std::string>() +
+            " is not known."
+            " It is 'GAP'");
+      }
+      auto kernel =
+          downcast_sparse_kernel_impl<SparseKernelType::GAP>(kernel_impl);
+      switch (this->target_type) {
+      case TargetType::Structure:
+        return kernel->template compute_for_zetas<Property_t,
+                                                  TargetType::Structure>(
+            managers, sparse_points, representation_name, zetas);
+      case TargetType::Atom:
+        return kernel->template compute_for_zetas<Property_t, TargetType::Atom>(
+            managers, sparse_points, representation_name, zetas);
+      default:
+        throw std::logic_error(
+            "Given target_type " +
+            this->parameters["target_type"].get<std::string>() +
+            " is not known."
+            " It is either 'Structure' or 'Atom')");
+      }
+    }
+
+    /**
+     * Compute the kernels between a set of pseudo points and itself for
+     * several values of zeta.
+     */
+    template <class SparsePoints>
+    std::vector<math::Matrix_t>
+    compute_for_zetas(const SparsePoints & sparse_points,
+                      const std::vector<size_t> & zetas) {
+      RASCAL_TIMER("SparseKernel::compute_sparse_points_for_zetas");
+      using internal::SparseKernelType;
+
+      if (this->kernel_type == SparseKernelType::GAP) {
+        auto kernel =
+            downcast_sparse_kernel_impl<SparseKernelType::GAP>(kernel_impl);
+        return kernel->compute_for_zetas(sparse_points, zetas);
+      } else {
+        throw std::logic_error(
+            "Given kernel_type " +
+            this->parameters["kernel_type"].get<std::string>() +
+            " is not known."
+            " It is 'GAP'");
+      }
+    }
+
     /**
      * The root compute kernel function. It computes the kernel between the
      * representation gradients of a set of structures with the set of pseudo
@@ -696,8 +981,11 @@ namespace rascal {
                                       const StructureManagers & managers,
                                       const SparsePoints & sparse_points,
                                       const bool compute_neg_stress) {
+      RASCAL_TIMER("SparseKernel::compute_derivative");
       using ManagerPtr_t = typename StructureManagers::value_type;
       using Manager_t = typename ManagerPtr_t::element_type;
+      internal::check_full_neighbour_list<Manager_t>(
+          "SparseKernel::compute_derivative");
       using Property_t = typename Calculator::template Property_t<Manager_t>;
       using PropertyGradient_t =
           typename Calculator::template PropertyGradient_t<Manager_t>;
@@ -726,6 +1014,55 @@ namespace rascal {
       }
     }
 
+    /**
+     * Compute the kernel gradients of compute_derivative for several values
+     * of zeta. The contractions of the representation gradients with the
+     * pseudo points are computed once and shared by all the exponents.
+     *
+     * @param zetas exponents of the kernels, the zeta of the hypers is not
+     *        used
+     * @return one kernel gradient matrix per element of zetas
+     */
+    template <class Calculator, class StructureManagers, class SparsePoints>
+    std::vector<math::Matrix_t>
+    compute_derivative_for_zetas(const Calculator & calculator,
+                                 const StructureManagers & managers,
+                                 const SparsePoints & sparse_points,
+                                 const bool compute_neg_stress,
+                                 const std::vector<size_t> & zetas) {
+      RASCAL_TIMER("SparseKernel::compute_derivative_for_zetas");
+      using ManagerPtr_t = typename StructureManagers::value_type;
+      using Manager_t = typename ManagerPtr_t::element_type;
+      internal::check_full_neighbour_list<Manager_t>(
+          "SparseKernel::compute_derivative_for_zetas");
+      using Property_t = typename Calculator::template Property_t<Manager_t>;
+      using PropertyGradient_t =
+          typename Calculator::template PropertyGradient_t<Manager_t>;
+      if (not calculator.does_gradients()) {
+        throw std::runtime_error(
+            "This representation does not compute gradients.");
+      }
+      const auto & representation_name{calculator.get_name()};
+      const auto representation_grad_name{calculator.get_gradient_name()};
+      using internal::SparseKernelType;
+      using internal::TargetType;
+
+      if (this->kernel_type == SparseKernelType::GAP) {
+        auto kernel =
+            downcast_sparse_kernel_impl<SparseKernelType::GAP>(kernel_impl);
+        return kernel->template compute_derivative_for_zetas<
+            Property_t, PropertyGradient_t, TargetType::Atom>(
+            managers, sparse_points, representation_name,
+            representation_grad_name, compute_neg_stress, zetas);
+      } else {
+        throw std::logic_error(
+            "Given kernel_type " +
+            this->parameters["kernel_type"].get<std::string>() +
+            " is not known."
+            " It is 'GAP'");
+      }
+    }
+
     //! list of names identifying the properties that should be used
     //! to compute the kernels
     std::vector<std::string> identifiers{};
@@ -31,11 +31,14 @@
 #include "rascal/representations/calculator_base.hh"
 #include "rascal/structure_managers/property.hh"
 #include "rascal/structure_managers/structure_manager.hh"
+#include "rascal/utils/parallel.hh"
+#include "rascal/utils/timer.hh"
 #include "rascal/utils/utils.hh"
 
 #include <math.h>
 
 #include <algorithm>
+#include <numeric>
 #include <vector>
 
 namespace rascal {
@@ -112,6 +115,24 @@ namespace rascal {
                          ordering::ascending);
         return order_coulomb;
       }
+
+      /**
+       * Same order as get_coulomb_matrix_sorting_order but only sorts the
+       * indices in order, using keys as a buffer.
+       */
+      static void get_sorting_order(
+          const Eigen::Ref<const Eigen::MatrixXd> & distance_mat,
+          const Eigen::Ref<const Eigen::MatrixXd> &,
+          Eigen::Ref<Eigen::ArrayXd> keys, std::vector<size_t> & order) {
+        keys = distance_mat.col(0).array();
+        keys(0) = 0.;
+        order.resize(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&keys](const size_t & a, const size_t & b) {
+                           return keys(a) < keys(b);
+                         });
+      }
     };
 
     template <>
@@ -151,9 +172,126 @@ namespace rascal {
 
         return order_coulomb;
       }
+
+      /**
+       * Same order as get_coulomb_matrix_sorting_order but only sorts the
+       * indices in order, using keys as a buffer.
+       */
+      static void get_sorting_order(
+          const Eigen::Ref<const Eigen::MatrixXd> &,
+          const Eigen::Ref<const Eigen::MatrixXd> & coulomb_mat,
+          Eigen::Ref<Eigen::ArrayXd> keys, std::vector<size_t> & order) {
+        keys = coulomb_mat.colwise().squaredNorm().transpose().array();
+        keys(0) = 1e200;
+        order.resize(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&keys](const size_t & a, const size_t & b) {
+                           return keys(a) > keys(b);
+                         });
+      }
     };
     /* -------------------- rep-options-impl-end -------------------- */
 
+    /**
+     * Smooth cutoff factor of CalculatorSortedCoulomb::get_cutoff_factor
+     * applied to an array of distances.
+     */
+    template <typename Derived>
+    Eigen::ArrayXd
+    get_coulomb_cutoff_factors(const Eigen::ArrayBase<Derived> & distances,
+                               const double cutoff, const double decay) {
+      return (distances <= cutoff - decay)
+          .select(1., (distances > cutoff)
+                          .select(0., 0.5 * (1. + (EIGEN_PI *
+                                                   (distances - cutoff + decay) /
+                                                   decay)
+                                                      .cos())));
+    }
+
+    /**
+     * Neighbourhoods of all the centers of a structure stored contiguously
+     * so that the coulomb matrices of the centers can be computed
+     * independently of the structure manager, e.g. by several threads.
+     *
+     * The atoms of the neighbourhood of a center are stored in the slots
+     * [offsets[i_center], offsets[i_center + 1]) with the center first and
+     * the neighbours at the position of their pair index + 1.
+     */
+    struct CoulombNeighbourhoods {
+      //! start of the neighbourhood of each center, and the total size
+      std::vector<size_t> offsets{};
+      //! positions of the atoms, 3 per slot
+      std::vector<double> positions{};
+      //! atomic numbers of the atoms
+      std::vector<double> atom_types{};
+      //! distance to the center given by the structure manager
+      std::vector<double> central_distances{};
+      //! false for the slots that are not filled by a neighbour
+      std::vector<bool> filled{};
+      //! where to store the linearized coulomb matrix of each center
+      std::vector<double *> outputs{};
+
+      void clear() {
+        this->offsets.assign(1, 0);
+        this->positions.clear();
+        this->atom_types.clear();
+        this->central_distances.clear();
+        this->filled.clear();
+        this->outputs.clear();
+      }
+
+      //! add a neighbourhood of n_atoms (including the center)
+      void add_center(const size_t n_atoms, double * output) {
+        const size_t n_slots{this->offsets.back() + n_atoms};
+        this->offsets.push_back(n_slots);
+        this->positions.resize(ThreeD * n_slots, 0.);
+        this->atom_types.resize(n_slots, 0.);
+        this->central_distances.resize(n_slots, 1.);
+        this->filled.resize(n_slots, false);
+        this->outputs.push_back(output);
+      }
+
+      template <typename Derived>
+      void set_atom(const size_t i_slot, const Eigen::MatrixBase<Derived> & pos,
+                    const double atom_type, const double central_distance) {
+        for (int i_dim{0}; i_dim < ThreeD; ++i_dim) {
+          this->positions[ThreeD * i_slot + i_dim] = pos(i_dim);
+        }
+        this->atom_types[i_slot] = atom_type;
+        this->central_distances[i_slot] = central_distance;
+        this->filled[i_slot] = true;
+      }
+
+      size_t size() const { return this->outputs.size(); }
+    };
+
+    /**
+     * Work arrays of one thread, allocated for the largest neighbourhood
+     * and reused for all the centers.
+     */
+    struct SortedCoulombBuffers {
+      Eigen::MatrixXd distance_mat{};
+      Eigen::MatrixXd type_factor_mat{};
+      Eigen::MatrixXd coulomb_mat{};
+      Eigen::ArrayXd central_factors{};
+      Eigen::ArrayXd interaction_factors{};
+      Eigen::ArrayXd sort_keys{};
+      std::vector<size_t> order{};
+
+      void reserve(const Eigen::Index max_n_atoms) {
+        if (this->distance_mat.rows() < max_n_atoms) {
+          this->distance_mat.resize(max_n_atoms, max_n_atoms);
+          this->type_factor_mat.resize(max_n_atoms, max_n_atoms);
+          this->coulomb_mat.resize(max_n_atoms, max_n_atoms);
+          this->central_factors.resize(max_n_atoms);
+          this->interaction_factors.resize(max_n_atoms);
+          this->sort_keys.resize(max_n_atoms);
+          this->order.reserve(max_n_atoms);
+        }
+      }
+    };
+
   }  // namespace internal
   /* ---------------------------------------------------------------------- */
   /* -------------------- rep-preamble-start -------------------- */
@@ -199,7 +337,9 @@ namespace rascal {
           central_decay{std::move(other.central_decay)},
           interaction_cutoff{std::move(other.interaction_cutoff)},
           interaction_decay{std::move(other.interaction_decay)},
-          size{std::move(other.size)} {}
+          size{std::move(other.size)}, n_threads{std::move(other.n_threads)},
+          neighbourhoods{std::move(other.neighbourhoods)},
+          buffers{std::move(other.buffers)} {}
 
     //! Destructor
     virtual ~CalculatorSortedCoulomb() = default;
@@ -285,12 +425,18 @@ namespace rascal {
     template <internal::CMSortAlgorithm AlgorithmType, class StructureManager>
     void compute_impl(std::shared_ptr<StructureManager> & manager);
 
-    //! returns the distance matrix for a central atom
-    template <class StructureManager>
-    void get_distance_matrix(std::shared_ptr<StructureManager> & manager,
-                             ClusterRef_t<StructureManager, 1> & center,
-                             Eigen::Ref<Eigen::MatrixXd> distance_mat,
-                             Eigen::Ref<Eigen::MatrixXd> type_factor_mat);
+    //! gather the neighbourhoods of the centers in this->neighbourhoods
+    template <class StructureManager, class Property>
+    void gather_neighbourhoods(std::shared_ptr<StructureManager> & manager,
+                               Property & coulomb_matrices);
+
+    /**
+     * Compute the sorted and linearized coulomb matrix of the center
+     * i_center of this->neighbourhoods using the work arrays of buffers.
+     */
+    template <internal::CMSortAlgorithm AlgorithmType>
+    void compute_center(const size_t i_center,
+                        internal::SortedCoulombBuffers & buffers) const;
 
     /**
      * Sort the coulomb matrix using the distance to the central atom
@@ -346,6 +492,13 @@ namespace rascal {
     double interaction_decay{};
     // at least equal to the largest number of neighours
     size_t size{};
+    // number of threads computing the centers of a structure
+    size_t n_threads{1};
+
+    //! neighbourhoods of the structure being computed
+    internal::CoulombNeighbourhoods neighbourhoods{};
+    //! work arrays of each thread
+    std::vector<internal::SortedCoulombBuffers> buffers{};
 
     //! reference the requiered hypers
     ReferenceHypers_t reference_hypers{
@@ -371,7 +524,12 @@ namespace rascal {
 
     this->size = hyper["size"];
 
-    this->set_name(hyper);
+    // optional, the number of threads does not change the representation
+    // so it is not part of its name
+    this->n_threads = std::max(hyper.value("n_threads", size_t(1)), size_t(1));
+    auto name_hypers = hyper;
+    name_hypers.erase("n_threads");
+    this->set_name(name_hypers);
   }
 
   inline void CalculatorSortedCoulomb::update_central_cutoff(double cutoff) {
@@ -453,6 +611,7 @@ namespace rascal {
       return;
     }
 
+    RASCAL_TIMER("SortedCoulomb::compute");
     this->check_size_compatibility(manager);
 
     // initialise the sorted coulomb_matrices in linear storage
@@ -460,101 +619,150 @@ namespace rascal {
     coulomb_matrices->set_nb_row(this->get_n_feature());
     coulomb_matrices->resize();
 
-    // initialize the sorted linear coulomb matrix
-    Eigen::MatrixXd lin_sorted_coulomb_mat(this->size * (this->size + 1) / 2,
-                                           1);
+    this->gather_neighbourhoods(manager, *coulomb_matrices);
 
-    // loop over the centers
-    for (auto center : manager) {
-      // re-use the temporary coulomb mat in linear storage
-      // need to be zeroed because old data might not be overwritten
-      lin_sorted_coulomb_mat =
-          Eigen::MatrixXd::Zero(this->size * (this->size + 1) / 2, 1);
-
-      // n_neighbour counts the central atom and the neighbours
-      size_t n_neighbour{center.pairs().size() + 1};
-
-      // the local distance matrix. Ones to avoid overflow in the div.
-      Eigen::MatrixXd distance_mat =
-          Eigen::MatrixXd::Ones(n_neighbour, n_neighbour);
-      // the matrix with the prefactor on the .
-      Eigen::MatrixXd type_factor_mat =
-          Eigen::MatrixXd::Zero(n_neighbour, n_neighbour);
-
-      // the local coulomb matrix
-      Eigen::MatrixXd coulomb_mat =
-          Eigen::MatrixXd::Ones(n_neighbour, n_neighbour);
-
-      this->get_distance_matrix(manager, center, distance_mat, type_factor_mat);
-
-      // Compute Coulomb Mat element wise.
-      coulomb_mat.array() = type_factor_mat.array() / distance_mat.array();
-
-      using Sorter = internal::SortCoulomMatrix<AlgorithmType>;
-      auto sort_order{
-          Sorter::get_coulomb_matrix_sorting_order(distance_mat, coulomb_mat)};
-      // inject the coulomb matrix into the sorted linear storage
-      this->sort_and_linearize_coulomb_matrix(
-          coulomb_mat, lin_sorted_coulomb_mat, sort_order);
-
-      (*coulomb_matrices)[center] = lin_sorted_coulomb_mat;
+    const size_t n_centers{this->neighbourhoods.size()};
+    const size_t n_threads{std::min(this->n_threads, n_centers)};
+    if (this->buffers.size() < n_threads) {
+      this->buffers.resize(n_threads);
+    }
+    for (auto & buffer : this->buffers) {
+      buffer.reserve(this->size + 1);
     }
+    internal::parallel_for(n_centers, n_threads,
+                           [this](size_t i_center, size_t i_thread) {
+                             this->compute_center<AlgorithmType>(
+                                 i_center, this->buffers[i_thread]);
+                           });
   }
   /* -------------------- rep-options-compute-impl-end -------------------- */
 
   /* ---------------------------------------------------------------------- */
-  template <class StructureManager>
-  void CalculatorSortedCoulomb::get_distance_matrix(
+  template <class StructureManager, class Property>
+  void CalculatorSortedCoulomb::gather_neighbourhoods(
       std::shared_ptr<StructureManager> & manager,
-      CalculatorSortedCoulomb::ClusterRef_t<StructureManager, 1> & center,
-      Eigen::Ref<Eigen::MatrixXd> distance_mat,
-      Eigen::Ref<Eigen::MatrixXd> type_factor_mat) {
-    // the coulomb mat first row and col corresponds
-    // to central atom to neighbours
-    auto && Zk{center.get_atom_type()};
-    auto && central_cutoff{this->central_cutoff};
+      Property & coulomb_matrices) {
+    auto & neighbourhoods{this->neighbourhoods};
+    neighbourhoods.clear();
+    for (auto center : manager) {
+      // the neighbourhood counts the central atom and the neighbours
+      const size_t offset{neighbourhoods.offsets.back()};
+      neighbourhoods.add_center(center.pairs().size() + 1,
+                                coulomb_matrices[center].data());
+      neighbourhoods.set_atom(offset, center.get_position(),
+                              center.get_atom_type(), 0.);
+      for (auto neigh : center.pairs()) {
+        neighbourhoods.set_atom(offset + neigh.get_index() + 1,
+                                neigh.get_position(), neigh.get_atom_type(),
+                                manager->get_distance(neigh));
+      }
+    }
+  }
 
+  /* ---------------------------------------------------------------------- */
+  template <internal::CMSortAlgorithm AlgorithmType>
+  void CalculatorSortedCoulomb::compute_center(
+      const size_t i_center, internal::SortedCoulombBuffers & buffers) const {
+    const auto & neighbourhoods{this->neighbourhoods};
+    const size_t offset{neighbourhoods.offsets[i_center]};
+    const Eigen::Index n_atoms{static_cast<Eigen::Index>(
+        neighbourhoods.offsets[i_center + 1] - offset)};
+    const Eigen::Index n_neigh{n_atoms - 1};
+    Eigen::Map<const Eigen::Matrix3Xd> positions{
+        &neighbourhoods.positions[ThreeD * offset], ThreeD, n_atoms};
+    Eigen::Map<const Eigen::ArrayXd> atom_types{
+        &neighbourhoods.atom_types[offset], n_atoms};
+    Eigen::Map<const Eigen::ArrayXd> central_distances{
+        &neighbourhoods.central_distances[offset], n_atoms};
+
+    // Ones in the distance matrix to avoid overflow in the division
+    auto distance_mat = buffers.distance_mat.topLeftCorner(n_atoms, n_atoms);
+    auto type_factor_mat =
+        buffers.type_factor_mat.topLeftCorner(n_atoms, n_atoms);
+    auto coulomb_mat = buffers.coulomb_mat.topLeftCorner(n_atoms, n_atoms);
+    distance_mat.setOnes();
+    type_factor_mat.setZero();
+
+    // cutoff factors of the distances to the center, computed from the
+    // manager's distances for the central cutoff and from the positions for
+    // the interaction cutoff
+    auto central_factors = buffers.central_factors.head(n_atoms);
+    central_factors = internal::get_coulomb_cutoff_factors(
+        central_distances, this->central_cutoff, this->central_decay);
+    auto interaction_factors = buffers.interaction_factors.head(n_atoms);
+    interaction_factors = internal::get_coulomb_cutoff_factors(
+        (positions.colwise() - positions.col(0))
+            .colwise()
+            .norm()
+            .transpose()
+            .array(),
+        this->interaction_cutoff, this->interaction_decay);
+
+    // the coulomb mat first row and col corresponds to central atom to
+    // neighbours
+    const double Zk{atom_types(0)};
     type_factor_mat(0, 0) = 0.5 * std::pow(Zk, 2.4);
-    for (auto neigh_i : center.pairs()) {
-      size_t idx_i{neigh_i.get_index() + 1};
-      auto && Zi{neigh_i.get_atom_type()};
-      double dik{manager->get_distance(neigh_i)};
-      double fac_ik{
-          get_cutoff_factor(dik, central_cutoff, this->central_decay)};
-
-      type_factor_mat(idx_i, 0) = Zk * Zi * fac_ik * fac_ik;
-      type_factor_mat(idx_i, idx_i) = 0.5 * std::pow(Zi, 2.4) * fac_ik * fac_ik;
-      distance_mat(idx_i, 0) = dik;
-      type_factor_mat(0, idx_i) = type_factor_mat(idx_i, 0);
-      distance_mat(0, idx_i) = distance_mat(idx_i, 0);
+    type_factor_mat.col(0).tail(n_neigh).array() =
+        Zk * atom_types.tail(n_neigh) * central_factors.tail(n_neigh).square();
+    type_factor_mat.row(0).tail(n_neigh) =
+        type_factor_mat.col(0).tail(n_neigh).transpose();
+    type_factor_mat.diagonal().tail(n_neigh).array() =
+        0.5 * atom_types.tail(n_neigh).pow(2.4) *
+        central_factors.tail(n_neigh).square();
+    distance_mat.col(0).tail(n_neigh) =
+        central_distances.tail(n_neigh).matrix();
+    distance_mat.row(0).tail(n_neigh) =
+        distance_mat.col(0).tail(n_neigh).transpose();
+
+    // neighbour to neighbour part, column by column on the lower triangle
+    for (Eigen::Index idx_i{1}; idx_i < n_neigh; ++idx_i) {
+      const Eigen::Index n_lower{n_atoms - idx_i - 1};
+      auto dij = distance_mat.col(idx_i).tail(n_lower);
+      dij = (positions.rightCols(n_lower).colwise() - positions.col(idx_i))
+                .colwise()
+                .norm()
+                .transpose();
+      auto tij = type_factor_mat.col(idx_i).tail(n_lower);
+      tij.array() =
+          atom_types.tail(n_lower) * atom_types(idx_i) *
+          internal::get_coulomb_cutoff_factors(
+              dij.array(), this->interaction_cutoff, this->interaction_decay) *
+          central_factors(idx_i) * interaction_factors.tail(n_lower);
+      distance_mat.row(idx_i).tail(n_lower) = dij.transpose();
+      type_factor_mat.row(idx_i).tail(n_lower) = tij.transpose();
+    }
+
+    // the slots that are not filled by a neighbour keep a null row
+    for (Eigen::Index idx_i{1}; idx_i < n_atoms; ++idx_i) {
+      if (not neighbourhoods.filled[offset + idx_i]) {
+        distance_mat.row(idx_i).setOnes();
+        distance_mat.col(idx_i).setOnes();
+        type_factor_mat.row(idx_i).setZero();
+        type_factor_mat.col(idx_i).setZero();
+      }
     }
 
-    // compute the neighbour to neighbour part of the coulomb matrix
-    for (auto neigh_i : center.pairs()) {
-      size_t idx_i{neigh_i.get_index() + 1};
-      auto && Zi{neigh_i.get_atom_type()};
-      double dik{manager->get_distance(neigh_i)};
-      double fac_ik{
-          get_cutoff_factor(dik, central_cutoff, this->central_decay)};
-
-      for (auto neigh_j : center.pairs()) {
-        size_t idx_j{neigh_j.get_index() + 1};
-        // work only on the lower diagonal
-        if (idx_i >= idx_j)
-          continue;
-        auto && Zj{neigh_j.get_atom_type()};
-        double dij{(neigh_i.get_position() - neigh_j.get_position()).norm()};
-        double fac_ij{get_cutoff_factor(dij, this->interaction_cutoff,
-                                        this->interaction_decay)};
-
-        double djk{(center.get_position() - neigh_j.get_position()).norm()};
-        double fac_jk{get_cutoff_factor(djk, this->interaction_cutoff,
-                                        this->interaction_decay)};
-
-        type_factor_mat(idx_j, idx_i) = Zj * Zi * fac_ij * fac_ik * fac_jk;
-        distance_mat(idx_j, idx_i) = dij;
-        type_factor_mat(idx_i, idx_j) = type_factor_mat(idx_j, idx_i);
-        distance_mat(idx_i, idx_j) = distance_mat(idx_j, idx_i);
+    // Compute Coulomb Mat element wise.
+    coulomb_mat.array() = type_factor_mat.array() / distance_mat.array();
+
+    using Sorter = internal::SortCoulomMatrix<AlgorithmType>;
+    auto sort_keys = buffers.sort_keys.head(n_atoms);
+    Sorter::get_sorting_order(distance_mat, coulomb_mat, sort_keys,
+                              buffers.order);
+
+    // inject the coulomb matrix into the sorted linear storage, the
+    // remaining entries are zeros
+    const auto & order{buffers.order};
+    Eigen::Map<Eigen::ArrayXd> linear_coulomb{
+        neighbourhoods.outputs[i_center],
+        static_cast<Eigen::Index>(this->size * (this->size + 1) / 2)};
+    linear_coulomb.setZero();
+    size_t lin_id{0};
+    for (Eigen::Index idx_i{0}; idx_i < n_atoms; ++idx_i) {
+      const size_t idx_is{order[idx_i]};
+      for (Eigen::Index idx_j{0}; idx_j < idx_i + 1; ++idx_j) {
+        linear_coulomb(lin_id) = coulomb_mat(idx_is, order[idx_j]);
+        lin_id += 1;
       }
     }
   }
@@ -38,6 +38,7 @@
 #include "rascal/structure_managers/property.hh"
 #include "rascal/structure_managers/property_block_sparse.hh"
 #include "rascal/structure_managers/structure_manager.hh"
+#include "rascal/utils/timer.hh"
 #include "rascal/utils/utils.hh"
 
 #include <Eigen/Dense>
@@ -400,6 +401,7 @@ namespace rascal {
     using math::pow;
     using complex = std::complex<double>;
 
+    RASCAL_TIMER("SphericalCovariants::compute");
     // Compute the spherical expansions of the current structure
     rep_expansion.compute(manager);
     constexpr bool ExcludeGhosts{true};
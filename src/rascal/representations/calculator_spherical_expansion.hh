@@ -39,9 +39,12 @@
 #include "rascal/math/utils.hh"
 #include "rascal/representations/calculator_base.hh"
 #include "rascal/representations/cutoff_functions.hh"
+#include "rascal/representations/spherical_expansion_long_range.hh"
 #include "rascal/structure_managers/make_structure_manager.hh"
 #include "rascal/structure_managers/property_block_sparse.hh"
 #include "rascal/structure_managers/structure_manager.hh"
+#include "rascal/utils/parallel.hh"
+#include "rascal/utils/timer.hh"
 #include "rascal/utils/utils.hh"
 
 #include <Eigen/Dense>
@@ -51,8 +54,13 @@
 #include <array>
 #include <cmath>
 #include <exception>
+#include <limits>
+#include <map>
 #include <memory>
+#include <set>
 #include <sstream>
+#include <string>
+#include <tuple>
 #include <unordered_set>
 #include <vector>
 
@@ -1146,6 +1154,264 @@ namespace rascal {
         internal::RadialContributionHandler<RBT, AST, OT>>(radial_integral);
   }
 
+  namespace internal {
+    /**
+     * Options of the incremental update of the spherical expansion, see
+     * CalculatorSphericalExpansion::update_expansion_incrementally.
+     */
+    struct SphericalExpansionIncrementalOptions {
+      //! is the incremental update active
+      bool enabled{false};
+      //! atoms displaced by less than this distance are considered fixed
+      double displacement_threshold{0.};
+      //! above this fraction of moved atoms a full computation is done
+      double max_moved_fraction{0.25};
+      //! number of incremental updates between two full computations
+      size_t full_refresh_period{100};
+    };
+
+    /**
+     * Data kept between two computations of the spherical expansion of a
+     * structure to be able to update it incrementally.
+     *
+     * The un-normalized coefficients of each center are stored together with
+     * the geometry of the pairs that have been summed into them so that the
+     * old contribution of a moved neighbour can be removed exactly.
+     */
+    struct SphericalExpansionIncrementalState {
+      //! reference positions of the atoms (3 x n_atoms)
+      Eigen::Matrix<double, ThreeD, Eigen::Dynamic> positions{};
+      //! cell used for the reference computation
+      Eigen::Matrix<double, ThreeD, ThreeD> cell{};
+      //! atom types used for the reference computation
+      std::vector<int> atom_types{};
+      //! atom index of each center in the neighbour list
+      std::vector<size_t> center_indices{};
+      //! coefficients before finalize_coefficients, stored with the same
+      //! layout as the values of the expansion property
+      Eigen::VectorXd raw_coefficients{};
+      //! pairs summed in raw_coefficients stored in CSR format
+      std::vector<size_t> pair_offsets{};
+      std::vector<size_t> pair_neigh_indices{};
+      std::vector<int> pair_neigh_types{};
+      std::vector<double> pair_distances{};
+      std::vector<Eigen::Vector3d> pair_directions{};
+      //! buffers used to build the next pair list without allocations
+      std::vector<size_t> next_pair_offsets{};
+      std::vector<size_t> next_pair_neigh_indices{};
+      std::vector<int> next_pair_neigh_types{};
+      std::vector<double> next_pair_distances{};
+      std::vector<Eigen::Vector3d> next_pair_directions{};
+      /**
+       * Finalized gradients \grad_j c^{ij} of the pairs of each center in
+       * the order of the neighbour list, stored in CSR format with the
+       * geometry r_{ij} they have been computed for. Each pair is a block of
+       * 3*max_radial rows of pair_gradients. Only used with the gradients.
+       */
+      std::vector<size_t> gradient_offsets{};
+      std::vector<size_t> gradient_neigh_indices{};
+      std::vector<Eigen::Vector3d> gradient_vectors{};
+      math::Matrix_t pair_gradients{};
+      //! buffers used to build the next gradient list without allocations
+      std::vector<size_t> next_gradient_offsets{};
+      std::vector<size_t> next_gradient_neigh_indices{};
+      std::vector<Eigen::Vector3d> next_gradient_vectors{};
+      math::Matrix_t next_pair_gradients{};
+      //! \grad_j c^{ij} of the pair being computed
+      math::Matrix_t pair_gradient{};
+      //! flag the atoms displaced beyond the threshold (by atom tag)
+      std::vector<bool> moved{};
+      //! flag the centers whose coefficients changed during the last update
+      std::vector<bool> center_changed{};
+      //! was the last update incremental
+      bool last_update_incremental{false};
+      //! has the reference data been recorded
+      bool is_initialized{false};
+      //! number of incremental updates since the last full computation
+      size_t n_updates_since_refresh{0};
+
+      //! start recording a new pair list
+      void clear_pairs() {
+        this->next_pair_offsets.clear();
+        this->next_pair_neigh_indices.clear();
+        this->next_pair_neigh_types.clear();
+        this->next_pair_distances.clear();
+        this->next_pair_directions.clear();
+        this->next_pair_offsets.push_back(0);
+      }
+
+      //! add a pair to the pair list being recorded
+      void add_pair(size_t neigh_index, int neigh_type, double distance,
+                    const Eigen::Vector3d & direction) {
+        this->next_pair_neigh_indices.push_back(neigh_index);
+        this->next_pair_neigh_types.push_back(neigh_type);
+        this->next_pair_distances.push_back(distance);
+        this->next_pair_directions.push_back(direction);
+      }
+
+      //! add the pair i_pair of the current pair list to the one recorded
+      void keep_pair(size_t i_pair) {
+        this->add_pair(this->pair_neigh_indices[i_pair],
+                       this->pair_neigh_types[i_pair],
+                       this->pair_distances[i_pair],
+                       this->pair_directions[i_pair]);
+      }
+
+      //! all the pairs of the current center have been recorded
+      void close_center() {
+        this->next_pair_offsets.push_back(this->next_pair_neigh_indices.size());
+      }
+
+      /**
+       * Start recording the gradients of n_pairs pairs, each one a block of
+       * n_rows x n_cols values
+       */
+      void clear_gradients(size_t n_pairs, size_t n_rows, size_t n_cols) {
+        this->next_gradient_offsets.clear();
+        this->next_gradient_neigh_indices.clear();
+        this->next_gradient_vectors.clear();
+        this->next_gradient_offsets.push_back(0);
+        this->next_pair_gradients.resize(n_pairs * n_rows, n_cols);
+        this->pair_gradient.resize(n_rows, n_cols);
+      }
+
+      //! add the gradient of a pair to the gradient list being recorded
+      template <typename Derived>
+      void add_gradient(size_t neigh_index, const Eigen::Vector3d & r_ij,
+                        const Eigen::MatrixBase<Derived> & gradient) {
+        const auto n_rows{gradient.rows()};
+        this->next_pair_gradients.middleRows(
+            this->next_gradient_neigh_indices.size() * n_rows, n_rows) =
+            gradient;
+        this->next_gradient_neigh_indices.push_back(neigh_index);
+        this->next_gradient_vectors.push_back(r_ij);
+      }
+
+      //! all the pair gradients of the current center have been recorded
+      void close_gradient_center() {
+        this->next_gradient_offsets.push_back(
+            this->next_gradient_neigh_indices.size());
+      }
+
+      /**
+       * Find the gradient recorded for the center i_center and the neighbour
+       * neigh_index that has been computed for the geometry closest to
+       * r_ij, i.e. the right periodic image of the neighbour. The pairs
+       * are usually in the same order as in the previous neighbour list so
+       * hint is checked first.
+       *
+       * @return the index of the pair or -1 if there is none
+       */
+      int find_gradient(size_t i_center, size_t neigh_index,
+                        const Eigen::Vector3d & r_ij, size_t hint) const {
+        const size_t begin{this->gradient_offsets[i_center]};
+        const size_t end{this->gradient_offsets[i_center + 1]};
+        if (hint >= begin and hint < end and
+            this->gradient_neigh_indices[hint] == neigh_index and
+            (this->gradient_vectors[hint] - r_ij).squaredNorm() < 1e-4) {
+          return static_cast<int>(hint);
+        }
+        int found{-1};
+        double min_distance2{std::numeric_limits<double>::max()};
+        for (size_t i_pair{begin}; i_pair < end; ++i_pair) {
+          if (this->gradient_neigh_indices[i_pair] != neigh_index) {
+            continue;
+          }
+          const double distance2{
+              (this->gradient_vectors[i_pair] - r_ij).squaredNorm()};
+          if (distance2 < min_distance2) {
+            min_distance2 = distance2;
+            found = static_cast<int>(i_pair);
+          }
+        }
+        return found;
+      }
+
+      //! the recorded pair list becomes the current one
+      void swap_pairs() {
+        std::swap(this->pair_offsets, this->next_pair_offsets);
+        std::swap(this->pair_neigh_indices, this->next_pair_neigh_indices);
+        std::swap(this->pair_neigh_types, this->next_pair_neigh_types);
+        std::swap(this->pair_distances, this->next_pair_distances);
+        std::swap(this->pair_directions, this->next_pair_directions);
+        std::swap(this->gradient_offsets, this->next_gradient_offsets);
+        std::swap(this->gradient_neigh_indices,
+                  this->next_gradient_neigh_indices);
+        std::swap(this->gradient_vectors, this->next_gradient_vectors);
+        std::swap(this->pair_gradients, this->next_pair_gradients);
+      }
+    };
+
+    /**
+     * Work arrays of one of the threads computing the spherical expansion.
+     * The spherical harmonics and the radial integral keep the values of the
+     * last pair so each thread needs its own instances.
+     */
+    struct SphericalExpansionWorkspace {
+      math::SphericalHarmonics spherical_harmonics{};
+      std::shared_ptr<RadialContributionBase> radial_integral{};
+      //! coeff C^{ij}_{nlm} of the current pair
+      math::Matrix_t c_ij_nlm{};
+      //! \grad_j C^{ij}_{nlm} of the current pair
+      math::Matrix_t pair_gradient{};
+      //! change of \grad_j C^{ij}_{nlm} for a displacement of the pair
+      math::Matrix_t pair_gradient_change{};
+      //! timers and counters of the thread, flushed by the calling thread
+      TimeAccumulator harmonics_timer{};
+      TimeAccumulator radial_timer{};
+      TimeAccumulator accumulation_timer{};
+      TimeAccumulator gradients_timer{};
+      TimeAccumulator finalize_timer{};
+      LocalCounter n_pairs{};
+      LocalCounter n_interpolations{};
+    };
+
+    /**
+     * Dense view of NDims stacked blocks of expansion coefficients, e.g. the
+     * gradient of a pair, with the interface of the coefficients of a center
+     * so that finalize_coefficients() of the radial contributions can be
+     * applied to it.
+     */
+    template <int NDims>
+    struct StackedCoefficientsView {
+      template <typename Derived>
+      void lhs_dot(const Eigen::EigenBase<Derived> & left_side_mat) {
+        const auto n_rows{this->coefficients.rows() / NDims};
+        for (int i_dim{0}; i_dim < NDims; ++i_dim) {
+          this->coefficients.middleRows(i_dim * n_rows, n_rows).transpose() *=
+              left_side_mat;
+        }
+      }
+
+      Eigen::Ref<math::Matrix_t> coefficients;
+    };
+
+    /**
+     * Check that a dense matrix has one row per center and the columns of
+     * the dense feature matrix of property, see
+     * BlockSparseProperty::get_features().
+     *
+     * @throw runtime_error if it is not the case
+     */
+    template <class Property>
+    void check_feature_matrix_shape(
+        const Property & property,
+        const Eigen::Ref<const math::Matrix_t> & features,
+        const std::string & name) {
+      const size_t n_features{property.get_keys().size() *
+                              static_cast<size_t>(property.get_nb_comp())};
+      if (static_cast<size_t>(features.rows()) != property.size() or
+          static_cast<size_t>(features.cols()) != n_features) {
+        std::stringstream err_str{};
+        err_str << name << " should have the shape (" << property.size()
+                << ", " << n_features << ") of the features of the "
+                << "structure but has the shape (" << features.rows() << ", "
+                << features.cols() << ").";
+        throw std::runtime_error(err_str.str());
+      }
+    }
+  }  // namespace internal
+
   /**
    * Handles the expansion of an environment in a spherical and radial basis.
    *
@@ -1245,6 +1511,29 @@ namespace rascal {
         this->global_species.clear();
       }
 
+      this->incremental_update =
+          internal::SphericalExpansionIncrementalOptions{};
+      if (hypers.count("incremental_update")) {
+        auto incremental_hypers = hypers.at("incremental_update").get<json>();
+        this->incremental_update.enabled = true;
+        if (incremental_hypers.count("displacement_threshold")) {
+          this->incremental_update.displacement_threshold =
+              incremental_hypers.at("displacement_threshold").get<double>();
+        }
+        if (incremental_hypers.count("max_moved_fraction")) {
+          this->incremental_update.max_moved_fraction =
+              incremental_hypers.at("max_moved_fraction").get<double>();
+        }
+        if (incremental_hypers.count("full_refresh_period")) {
+          this->incremental_update.full_refresh_period =
+              incremental_hypers.at("full_refresh_period").get<size_t>();
+        }
+        if (this->incremental_update.displacement_threshold < 0.) {
+          throw std::logic_error(
+              "incremental_update: displacement_threshold should be positive");
+        }
+      }
+
       this->spherical_harmonics.precompute(this->max_angular,
                                            this->compute_gradients);
 
@@ -1319,50 +1608,9 @@ namespace rascal {
         this->optimization_type = OptimizationType::None;
       }
 
-      switch (internal::combine_to_radial_contribution_type(
-          this->radial_integral_type, this->atomic_smearing_type,
-          this->optimization_type)) {
-      case internal::combine_to_radial_contribution_type(
-          RadialBasisType::GTO, AtomicSmearingType::Constant,
-          OptimizationType::None): {
-        auto rc_shared = std::make_shared<internal::RadialContributionHandler<
-            RadialBasisType::GTO, AtomicSmearingType::Constant,
-            OptimizationType::None>>(hypers);
-        this->radial_integral = rc_shared;
-        break;
-      }
-      case internal::combine_to_radial_contribution_type(
-          RadialBasisType::GTO, AtomicSmearingType::Constant,
-          OptimizationType::Interpolator): {
-        auto rc_shared = std::make_shared<internal::RadialContributionHandler<
-            RadialBasisType::GTO, AtomicSmearingType::Constant,
-            OptimizationType::Interpolator>>(hypers);
-        this->radial_integral = rc_shared;
-        break;
-      }
-      case internal::combine_to_radial_contribution_type(
-          RadialBasisType::DVR, AtomicSmearingType::Constant,
-          OptimizationType::None): {
-        auto rc_shared = std::make_shared<internal::RadialContributionHandler<
-            RadialBasisType::DVR, AtomicSmearingType::Constant,
-            OptimizationType::None>>(hypers);
-        this->radial_integral = rc_shared;
-        break;
-      }
-      case internal::combine_to_radial_contribution_type(
-          RadialBasisType::DVR, AtomicSmearingType::Constant,
-          OptimizationType::Interpolator): {
-        auto rc_shared = std::make_shared<internal::RadialContributionHandler<
-            RadialBasisType::DVR, AtomicSmearingType::Constant,
-            OptimizationType::Interpolator>>(hypers);
-        this->radial_integral = rc_shared;
-        break;
-      }
-      default:
-        throw std::logic_error(
-            "The desired combination of parameters can not be handled.");
-        break;
-      }
+      this->radial_integral = this->make_radial_contribution_handler(hypers);
+      // the work arrays of the threads hold their own radial integrals
+      this->workspaces.clear();
 
       auto fc_hypers = hypers.at("cutoff_function").get<json>();
       auto fc_type = fc_hypers.at("type").get<std::string>();
@@ -1382,7 +1630,42 @@ namespace rascal {
                                ": \'ShiftedCosine\' or 'RadialScaling'.");
       }
 
-      this->set_name(hypers);
+      // optional, the long-range (LODE) expansion of the atom density
+      // potential replaces the local expansion
+      this->long_range.reset();
+      if (hypers.count("long_range")) {
+        if (this->radial_integral_type != RadialBasisType::GTO) {
+          throw std::logic_error(
+              "The long range expansion is only implemented for the 'GTO' "
+              "radial basis.");
+        }
+        if (this->compute_gradients) {
+          throw std::logic_error("The gradients of the long range expansion "
+                                 "have not been implemented.");
+        }
+        if (this->incremental_update.enabled) {
+          throw std::logic_error("The long range expansion can not be "
+                                 "updated incrementally.");
+        }
+        internal::RadialContribution<RadialBasisType::GTO> radial_basis{
+            hypers};
+        this->long_range =
+            std::make_shared<internal::SphericalExpansionLongRange>(
+                hypers.at("long_range").get<json>(),
+                smearing_hypers.at("gaussian_sigma")
+                    .at("value")
+                    .get<double>(),
+                this->max_radial, this->max_angular,
+                radial_basis.radial_sigmas, radial_basis.radial_ortho_matrix);
+      }
+
+      // optional, the number of threads does not change the representation
+      // so it is not part of its name
+      this->n_threads =
+          std::max(hypers.value("n_threads", size_t(1)), size_t(1));
+      auto name_hypers = hypers;
+      name_hypers.erase("n_threads");
+      this->set_name(name_hypers);
     }
 
     bool operator==(const CalculatorSphericalExpansion & other) const {
@@ -1396,7 +1679,9 @@ namespace rascal {
           (this->atomic_smearing_type == other.atomic_smearing_type) and
           (this->radial_integral_type == other.radial_integral_type) and
           (this->optimization_type == other.optimization_type) and
-          (this->cutoff_function_type == other.cutoff_function_type)};
+          (this->cutoff_function_type == other.cutoff_function_type) and
+          (this->hypers.value("long_range", json{}) ==
+           other.hypers.value("long_range", json{}))};
       return is_equal;
     }
 
@@ -1447,7 +1732,13 @@ namespace rascal {
           optimization_type{std::move(other.optimization_type)},
           cutoff_function{std::move(other.cutoff_function)},
           cutoff_function_type{std::move(other.cutoff_function_type)},
-          spherical_harmonics{std::move(other.spherical_harmonics)} {}
+          spherical_harmonics{std::move(other.spherical_harmonics)},
+          incremental_update{std::move(other.incremental_update)},
+          incremental_states{std::move(other.incremental_states)},
+          n_threads{std::move(other.n_threads)},
+          workspaces{std::move(other.workspaces)},
+          derivative_workspaces{std::move(other.derivative_workspaces)},
+          long_range{std::move(other.long_range)} {}
 
     //! Destructor
     virtual ~CalculatorSphericalExpansion() = default;
@@ -1502,6 +1793,39 @@ namespace rascal {
       this->compute_impl<FcType, RadialType, SmearingType, OptType>(manager);
     }
 
+    //! loop over a collection of managers for the long-range expansion
+    template <class StructureManager,
+              std::enable_if_t<
+                  internal::is_proper_iterator<StructureManager>::value, int> =
+                  0>
+    void compute_long_range_loop(StructureManager & managers) {
+      for (auto & manager : managers) {
+        this->compute_long_range(manager);
+      }
+    }
+
+    //! single manager case
+    template <class StructureManager,
+              std::enable_if_t<
+                  not(internal::is_proper_iterator<StructureManager>::value),
+                  int> = 0>
+    void compute_long_range_loop(StructureManager & manager) {
+      this->compute_long_range(manager);
+    }
+
+    /**
+     * Compute the long-range expansion of a periodic structure, see
+     * internal::SphericalExpansionLongRange. All the species of the
+     * structure contribute to the potential at every center so the keys of
+     * the centers are the species of the structure, or global_species with
+     * the 'user defined' expansion_by_species_method.
+     *
+     * @throw runtime_error if the structure is not periodic in all
+     *        directions
+     */
+    template <class StructureManager>
+    void compute_long_range(std::shared_ptr<StructureManager> manager);
+
     //! Compute the spherical exansion given several options
     template <internal::CutoffFunctionType FcType,
               internal::RadialBasisType RadialType,
@@ -1509,7 +1833,330 @@ namespace rascal {
               internal::OptimizationType OptType, class StructureManager>
     void compute_impl(std::shared_ptr<StructureManager> manager);
 
+    /**
+     * Returns the data used to update incrementally the expansion of
+     * manager or nullptr if the incremental update is not used.
+     * In particular, center_changed tells which centers have been modified
+     * by the last computation when last_update_incremental is true.
+     */
+    template <class StructureManager>
+    const internal::SphericalExpansionIncrementalState *
+    get_incremental_state(const std::shared_ptr<StructureManager> & manager) {
+      auto it = this->incremental_states.find(
+          std::weak_ptr<StructureManagerBase>(manager));
+      if (it == this->incremental_states.end()) {
+        return nullptr;
+      }
+      return &(it->second);
+    }
+
+    //! is the incremental update of the expansion active
+    bool does_incremental_update() const {
+      return this->incremental_update.enabled;
+    }
+
+    /**
+     * Vector-Jacobian product of the expansion of a structure: given the
+     * gradient dL/dc of a scalar L w.r.t. the expansion of the centers,
+     * computes the gradient dL/dr_k w.r.t. the positions of the atoms and
+     * the virial \sum_{ij} (r_i - r_j) \otimes dL/dr_j, where dL/dr_j is
+     * the part of the gradient coming from the pair ij, i.e. -dL/d\epsilon
+     * for a strain \epsilon of the structure.
+     *
+     * The gradients of the expansion are computed pair by pair and
+     * contracted right away so they are never stored, and the calculator
+     * does not need to compute the gradients.
+     *
+     * @param coefficients_gradient dL/dc with the layout of the dense
+     *        feature matrix of the expansion of the structure, see
+     *        BlockSparseProperty::get_features()
+     *
+     * @return dL/dr_k of shape (n_centers, 3), as for the gradients of the
+     *         models the derivatives w.r.t. the masked atoms are not
+     *         reported, and the virial of shape (1, 6) in Voigt order (xx,
+     *         yy, zz, yz, xz, xy)
+     *
+     * @throw runtime_error if the shape of coefficients_gradient does not
+     *        match the expansion of the structure
+     */
+    template <class StructureManager>
+    std::tuple<math::Matrix_t, math::Matrix_t>
+    backward(std::shared_ptr<StructureManager> manager,
+             const Eigen::Ref<const math::Matrix_t> & coefficients_gradient);
+
+    /**
+     * Jacobian-vector product of the expansion of a structure: the change
+     * \sum_k \grad_k c^{i} \cdot \delta r_k of the expansion of the centers
+     * for the displacements \delta r_k of the atoms, computed pair by pair
+     * without storing the gradients of the expansion.
+     *
+     * @param displacements \delta r_k of shape (n_centers, 3), the masked
+     *        atoms are not displaced
+     *
+     * @return the change of the expansion with the layout of the dense
+     *         feature matrix of the expansion of the structure
+     *
+     * @throw runtime_error if the shape of displacements does not match the
+     *        structure
+     */
+    template <class StructureManager>
+    math::Matrix_t jvp(std::shared_ptr<StructureManager> manager,
+                       const Eigen::Ref<const math::Matrix_t> & displacements);
+
+    /**
+     * Change of the gradient dL/dr_k returned by backward() when the atoms
+     * are displaced by \delta r_k and dL/dc changes by \delta(dL/dc), i.e.
+     * \sum_{ij} [\grad c^{ij}]^T \delta(dL/dc) + [\delta \grad c^{ij}]^T dL/dc.
+     * It is the building block of the Hessian-vector products of models
+     * built on the expansion.
+     *
+     * The second derivatives of the radial integrals and of the spherical
+     * harmonics are not available so \delta \grad c^{ij} is the centered
+     * finite difference of the analytical \grad c^{ij} along the
+     * displacement of the pair with a step h (fd_step). Its truncation error
+     * is O(h^2) and its rounding error O(\epsilon / h), with \epsilon the
+     * machine precision, so with the default step of 1e-5 Angstrom, close
+     * to the optimal one, the result is linear in the displacements only up
+     * to a relative error of about 1e-9. Steps smaller than 1e-6 or larger
+     * than 1e-3 Angstrom degrade the accuracy.
+     *
+     * @param coefficients_gradient dL/dc, see backward()
+     * @param coefficients_gradient_change \delta(dL/dc) with the same layout
+     * @param displacements \delta r_k, see jvp()
+     * @param fd_step step h of the finite differences in Angstrom
+     *
+     * @return the change of dL/dr_k of shape (n_centers, 3)
+     *
+     * @throw runtime_error if the shapes of the inputs do not match the
+     *        structure or if fd_step is not positive
+     */
+    template <class StructureManager>
+    math::Matrix_t backward_jvp(
+        std::shared_ptr<StructureManager> manager,
+        const Eigen::Ref<const math::Matrix_t> & coefficients_gradient,
+        const Eigen::Ref<const math::Matrix_t> & coefficients_gradient_change,
+        const Eigen::Ref<const math::Matrix_t> & displacements,
+        const double fd_step = 1e-5);
+
    protected:
+    /**
+     * Calls function(cutoff_function, radial_integrals) with the cutoff
+     * function and the radial contributions of n_threads threads downcast to
+     * their actual types. The radial contributions and the work arrays of
+     * derivative_workspaces always compute the derivatives.
+     */
+    template <class Function>
+    void visit_derivative_contributions(const size_t n_threads,
+                                        Function && function);
+
+    //! choose the RadialBasisType and AtomicSmearingType from the hypers
+    template <internal::CutoffFunctionType FcType, class Function>
+    void visit_derivative_contributions_by_radial(const size_t n_threads,
+                                                  Function && function);
+
+    template <internal::CutoffFunctionType FcType,
+              internal::RadialBasisType RadialType,
+              internal::AtomicSmearingType SmearingType,
+              internal::OptimizationType OptType, class Function>
+    void visit_derivative_contributions_impl(const size_t n_threads,
+                                             Function && function);
+
+    //! Set up the work arrays of the Jacobian products for n_threads threads
+    void prepare_derivative_workspaces(const size_t n_threads) {
+      while (this->derivative_workspaces.size() < n_threads) {
+        this->derivative_workspaces.emplace_back();
+        auto & workspace = this->derivative_workspaces.back();
+        workspace.spherical_harmonics.precompute(this->max_angular, true);
+        if (this->compute_gradients and
+            this->derivative_workspaces.size() == 1) {
+          workspace.radial_integral = this->radial_integral;
+        } else {
+          auto hypers = this->hypers;
+          hypers["compute_gradients"] = true;
+          workspace.radial_integral =
+              this->make_radial_contribution_handler(hypers);
+        }
+        const size_t n_col{math::pow(this->max_angular + 1, 2_size_t)};
+        workspace.c_ij_nlm.resize(this->max_radial, n_col);
+        workspace.pair_gradient.resize(ThreeD * this->max_radial, n_col);
+        workspace.pair_gradient_change.resize(ThreeD * this->max_radial,
+                                              n_col);
+      }
+    }
+
+    /**
+     * Compute the gradient \grad_j c^{ij}_{nlm} of the contribution of a
+     * neighbour at distance*direction to the expansion (before
+     * finalize_coefficients()). The Cartesian components are stacked in
+     * pair_gradient like in the gradients of the expansion.
+     */
+    template <class CutoffFunction, class RadialIntegral, class ClusterRef>
+    void compute_pair_gradient(const Eigen::Vector3d & direction,
+                               const double distance,
+                               CutoffFunction & cutoff_function,
+                               RadialIntegral & radial_integral,
+                               math::SphericalHarmonics & spherical_harmonics,
+                               const ClusterRef & cluster,
+                               Matrix_t & pair_gradient);
+
+    /**
+     * Contract a (finalized) pair gradient with the dL/dc^{i} of the
+     * expansion it contributes to, i.e. \sum_{nlm} dL/dc^{i}_{nlm}
+     * [\grad_j c^{ij}_{nlm}]_\alpha. With flip_odd_l the gradient is the one
+     * of c^{ji}_{nlm} = (-1)^l c^{ij}_{nlm}.
+     */
+    Eigen::Vector3d
+    contract_pair_gradient(const Eigen::Map<const Matrix_t> & upstream,
+                           const Matrix_t & pair_gradient,
+                           const bool flip_odd_l) const {
+      const size_t n_row{this->max_radial};
+      Eigen::Vector3d contraction{};
+      for (int i_der{0}; i_der < ThreeD; ++i_der) {
+        if (not flip_odd_l) {
+          contraction(i_der) =
+              (upstream.array() *
+               pair_gradient.middleRows(i_der * n_row, n_row).array())
+                  .sum();
+          continue;
+        }
+        contraction(i_der) = 0.;
+        size_t l_block_idx{0};
+        double parity{1.};
+        for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+             ++angular_l) {
+          size_t l_block_size{2 * angular_l + 1};
+          contraction(i_der) +=
+              parity *
+              (upstream.middleCols(l_block_idx, l_block_size).array() *
+               pair_gradient
+                   .block(i_der * n_row, l_block_idx, n_row, l_block_size)
+                   .array())
+                  .sum();
+          l_block_idx += l_block_size;
+          parity *= -1.;
+        }
+      }
+      return contraction;
+    }
+
+    /**
+     * Update the coefficients of the expansion of the centers affected by
+     * the atoms that moved since the last computation.
+     *
+     * An atom is considered moved if it is displaced by more than
+     * displacement_threshold from its reference position. For a moved
+     * center the coefficients are recomputed from scratch, while for the
+     * other centers the old contributions of the moved neighbours
+     * are subtracted and their new contributions added. Only the
+     * coefficients of the affected centers are finalized again.
+     *
+     * With the gradients, \grad_j c^{ij} is only recomputed for the pairs
+     * with a moved center or neighbour, the (finalized) gradients of the
+     * other pairs are copied from the previous computation so the
+     * neighbour list may change between the two computations.
+     *
+     * @return false if the update could not be done incrementally, i.e. no
+     * reference, changed cell/composition/centers, species keys of the
+     * expansion that would change, too many moved atoms or
+     * full_refresh_period reached. In this case the full computation has to
+     * be done.
+     */
+    template <class StructureManager, class CutoffFunction,
+              class RadialIntegral>
+    bool update_expansion_incrementally(
+        std::shared_ptr<StructureManager> & manager,
+        internal::SphericalExpansionIncrementalState & state,
+        CutoffFunction & cutoff_function, RadialIntegral & radial_integral,
+        Property_t<StructureManager> & expansions_coefficients,
+        PropertyGradient_t<StructureManager> &
+            expansions_coefficients_gradient);
+
+    /**
+     * Create the class computing the radial terms of the expansion for the
+     * radial basis, atomic smearing and optimization types of the
+     * calculator.
+     */
+    std::shared_ptr<internal::RadialContributionBase>
+    make_radial_contribution_handler(const Hypers_t & hypers) const {
+      using internal::AtomicSmearingType;
+      using internal::OptimizationType;
+      using internal::RadialBasisType;
+      switch (internal::combine_to_radial_contribution_type(
+          this->radial_integral_type, this->atomic_smearing_type,
+          this->optimization_type)) {
+      case internal::combine_to_radial_contribution_type(
+          RadialBasisType::GTO, AtomicSmearingType::Constant,
+          OptimizationType::None): {
+        auto rc_shared = std::make_shared<internal::RadialContributionHandler<
+            RadialBasisType::GTO, AtomicSmearingType::Constant,
+            OptimizationType::None>>(hypers);
+        return rc_shared;
+      }
+      case internal::combine_to_radial_contribution_type(
+          RadialBasisType::GTO, AtomicSmearingType::Constant,
+          OptimizationType::Interpolator): {
+        auto rc_shared = std::make_shared<internal::RadialContributionHandler<
+            RadialBasisType::GTO, AtomicSmearingType::Constant,
+            OptimizationType::Interpolator>>(hypers);
+        return rc_shared;
+      }
+      case internal::combine_to_radial_contribution_type(
+          RadialBasisType::DVR, AtomicSmearingType::Constant,
+          OptimizationType::None): {
+        auto rc_shared = std::make_shared<internal::RadialContributionHandler<
+            RadialBasisType::DVR, AtomicSmearingType::Constant,
+            OptimizationType::None>>(hypers);
+        return rc_shared;
+      }
+      case internal::combine_to_radial_contribution_type(
+          RadialBasisType::DVR, AtomicSmearingType::Constant,
+          OptimizationType::Interpolator): {
+        auto rc_shared = std::make_shared<internal::RadialContributionHandler<
+            RadialBasisType::DVR, AtomicSmearingType::Constant,
+            OptimizationType::Interpolator>>(hypers);
+        return rc_shared;
+      }
+      default:
+        throw std::logic_error(
+            "The desired combination of parameters can not be handled.");
+      }
+    }
+
+    /**
+     * Set up the work arrays of n_threads threads. The first thread uses the
+     * radial integral of the calculator and the others their own copies.
+     */
+    void prepare_workspaces(const size_t n_threads) {
+      while (this->workspaces.size() < n_threads) {
+        this->workspaces.emplace_back();
+        auto & workspace = this->workspaces.back();
+        workspace.spherical_harmonics.precompute(this->max_angular,
+                                                 this->compute_gradients);
+        if (this->workspaces.size() == 1) {
+          workspace.radial_integral = this->radial_integral;
+        } else {
+          workspace.radial_integral =
+              this->make_radial_contribution_handler(this->hypers);
+        }
+        workspace.c_ij_nlm.resize(this->max_radial,
+                                  math::pow(this->max_angular + 1, 2_size_t));
+      }
+    }
+
+    /**
+     * Compute the contribution c^{ij}_{nlm} of a neighbour at
+     * distance*direction to the expansion (before finalize_coefficients) and
+     * add it with the factor prefactor to coefficients_by_type.
+     */
+    template <class CutoffFunction, class RadialIntegral, class ClusterRef,
+              class Coefficients>
+    void add_pair_contribution(const Eigen::Vector3d & direction,
+                               const double distance, const double prefactor,
+                               CutoffFunction & cutoff_function,
+                               RadialIntegral & radial_integral,
+                               const ClusterRef & cluster,
+                               Coefficients coefficients_by_type);
+
     //! cutoff radius r_c defining the size of the atom centered environment
     double interaction_cutoff{};
     //! size of the transition region r_t spanning [r_c-r_t, r_c] in which the
@@ -1549,6 +2196,27 @@ namespace rascal {
 
     math::SphericalHarmonics spherical_harmonics{};
 
+    //! options of the incremental update of the expansion
+    internal::SphericalExpansionIncrementalOptions incremental_update{};
+
+    //! per structure data for the incremental update
+    std::map<std::weak_ptr<StructureManagerBase>,
+             internal::SphericalExpansionIncrementalState,
+             std::owner_less<std::weak_ptr<StructureManagerBase>>>
+        incremental_states{};
+
+    //! number of threads computing the centers of a structure
+    size_t n_threads{1};
+
+    //! work arrays of each thread
+    std::vector<internal::SphericalExpansionWorkspace> workspaces{};
+
+    //! work arrays of each thread for the Jacobian products
+    std::vector<internal::SphericalExpansionWorkspace> derivative_workspaces{};
+
+    //! long-range expansion, nullptr for the local expansion
+    std::shared_ptr<internal::SphericalExpansionLongRange> long_range{};
+
     /**
      * set up chemical keys of the expension so that only species appearing in
      * the environment are present and initialize coeffs to zero.
@@ -1603,6 +2271,10 @@ namespace rascal {
   // compute classes template construction
   template <class StructureManager>
   void CalculatorSphericalExpansion::compute(StructureManager & managers) {
+    if (this->long_range) {
+      this->compute_long_range_loop(managers);
+      return;
+    }
     // specialize based on the cutoff function
     using internal::CutoffFunctionType;
 
@@ -1691,29 +2363,118 @@ namespace rascal {
     }
   }  // namespace rascal
 
-  /**
-   * Compute the spherical expansion
-   */
-  template <internal::CutoffFunctionType FcType,
-            internal::RadialBasisType RadialType,
-            internal::AtomicSmearingType SmearingType,
-            internal::OptimizationType OptType, class StructureManager>
-  void CalculatorSphericalExpansion::compute_impl(
+  template <class StructureManager>
+  void CalculatorSphericalExpansion::compute_long_range(
       std::shared_ptr<StructureManager> manager) {
     using Prop_t = Property_t<StructureManager>;
     using PropGrad_t = PropertyGradient_t<StructureManager>;
-    constexpr static bool IsHalfNL{
-        StructureManager::traits::NeighbourListType ==
-        AdaptorTraits::NeighbourListType::half};
-    using math::PI;
-    using math::pow;
     constexpr bool ExcludeGhosts{true};
-    const bool is_not_masked{manager->is_not_masked()};
-    const bool compute_gradients{this->compute_gradients};
-    if (not is_not_masked and compute_gradients) {
-      throw std::logic_error("Can't compute spherical expansion gradients with "
-                             "masked center atoms");
+
+    auto && expansions_coefficients{*manager->template get_property<Prop_t>(
+        this->get_name(), true, true, ExcludeGhosts)};
+    auto && expansions_coefficients_gradient{
+        *manager->template get_property<PropGrad_t>(this->get_gradient_name(),
+                                                    true, true)};
+    if (expansions_coefficients.is_updated()) {
+      return;
+    }
+    RASCAL_TIMER("SphericalExpansion::compute_long_range");
+
+    auto manager_root = extract_underlying_manager<0>(manager);
+    auto pbc = manager_root->get_periodic_boundary_conditions();
+    if (pbc.minCoeff() == 0) {
+      std::stringstream err_str{};
+      err_str << "The long range expansion needs a structure that is "
+              << "periodic in all directions but pbc is ["
+              << pbc.transpose() << "].";
+      throw std::runtime_error(err_str.str());
     }
+    const Eigen::Matrix3d cell{manager_root->get_cell()};
+    const Eigen::Matrix3Xd positions{manager_root->get_positions()};
+    auto atom_types_root = manager_root->get_atom_types();
+    const std::vector<int> atom_types(
+        atom_types_root.data(), atom_types_root.data() + atom_types_root.size());
+    const std::set<int> structure_species(atom_types.begin(), atom_types.end());
+
+    std::set<Key_t> keys{};
+    if (this->expansion_by_species == "user defined") {
+      Key_t missing_keys{};
+      for (const int & species : structure_species) {
+        if (not internal::is_element_in(species, this->global_species)) {
+          missing_keys.push_back(species);
+        }
+      }
+      if (missing_keys.size() > 0) {
+        std::stringstream err_str{};
+        err_str << "global_species is missing the species [";
+        for (const auto & key : missing_keys) {
+          err_str << key << ", ";
+        }
+        err_str << "] of the structure.";
+        throw std::runtime_error(err_str.str());
+      }
+      keys = this->global_species;
+    } else {
+      for (const int & species : structure_species) {
+        keys.insert({species});
+      }
+    }
+
+    Eigen::Matrix3Xd centers(ThreeD, manager->size());
+    size_t i_center{0};
+    for (auto center : manager) {
+      centers.col(i_center) = center.get_position();
+      ++i_center;
+    }
+    const std::vector<int> species(structure_species.begin(),
+                                   structure_species.end());
+    Matrix_t coefficients{this->long_range->compute(
+        cell, positions, atom_types, centers, species)};
+
+    const size_t n_row{this->max_radial};
+    const size_t n_col{(this->max_angular + 1) * (this->max_angular + 1)};
+    expansions_coefficients.clear();
+    expansions_coefficients.set_shape(n_row, n_col);
+    std::vector<std::set<Key_t>> keys_list(manager->size(), keys);
+    expansions_coefficients.resize(keys_list);
+    expansions_coefficients.setZero();
+    expansions_coefficients_gradient.resize();
+
+    i_center = 0;
+    for (auto center : manager) {
+      auto & coefficients_center = expansions_coefficients[center];
+      for (size_t i_species{0}; i_species < species.size(); ++i_species) {
+        Key_t key{species[i_species]};
+        coefficients_center[key] = Eigen::Map<const Matrix_t>(
+            coefficients.row(i_center * species.size() + i_species).data(),
+            n_row, n_col);
+      }
+      ++i_center;
+    }
+  }
+
+  /**
+   * Compute the spherical expansion
+   */
+  template <internal::CutoffFunctionType FcType,
+            internal::RadialBasisType RadialType,
+            internal::AtomicSmearingType SmearingType,
+            internal::OptimizationType OptType, class StructureManager>
+  void CalculatorSphericalExpansion::compute_impl(
+      std::shared_ptr<StructureManager> manager) {
+    using Prop_t = Property_t<StructureManager>;
+    using PropGrad_t = PropertyGradient_t<StructureManager>;
+    constexpr static bool IsHalfNL{
+        StructureManager::traits::NeighbourListType ==
+        AdaptorTraits::NeighbourListType::half};
+    using math::PI;
+    using math::pow;
+    constexpr bool ExcludeGhosts{true};
+    // with masked center atoms only the centers are expanded and the
+    // gradients are computed only for their pairs, i.e. w.r.t. the centers and
+    // their (possibly masked) neighbours
+    const bool is_not_masked{manager->is_not_masked()};
+    const bool compute_gradients{this->compute_gradients};
     if (not is_not_masked and IsHalfNL) {
       std::stringstream err_str{};
       err_str << "Half neighbor list should only be used when all the "
@@ -1754,6 +2515,7 @@ namespace rascal {
     if (expansions_coefficients.is_updated()) {
       return;
     }
+    RASCAL_TIMER("SphericalExpansion::compute");
 
     // downcast cutoff and radial contributions so they are functional
     auto cutoff_function{
@@ -1762,6 +2524,29 @@ namespace rascal {
         downcast_radial_integral_handler<RadialType, SmearingType, OptType>(
             this->radial_integral)};
 
+    // the incremental update relies on each center accumulating only its own
+    // pairs
+    const bool use_incremental{this->incremental_update.enabled and
+                               (not IsHalfNL)};
+    internal::SphericalExpansionIncrementalState * incremental_state{nullptr};
+    if (use_incremental) {
+      // forget about the structures that do not exist anymore
+      for (auto it = this->incremental_states.begin();
+           it != this->incremental_states.end();) {
+        if (it->first.expired()) {
+          it = this->incremental_states.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      incremental_state = &this->incremental_states[manager];
+      if (this->update_expansion_incrementally(
+              manager, *incremental_state, cutoff_function, radial_integral,
+              expansions_coefficients, expansions_coefficients_gradient)) {
+        return;
+      }
+    }
+
     auto n_row{this->max_radial};
     // to store linearly all l,m components with
     // -l-1<=m<=l+1 needs (l+1)**2 elements
@@ -1775,23 +2560,151 @@ namespace rascal {
       expansions_coefficients_gradient.set_shape(ThreeD * n_row, n_col);
     }
 
-    if (this->expansion_by_species == "environment wise") {
-      this->initialize_expansion_environment_wise(
-          manager, expansions_coefficients, expansions_coefficients_gradient);
-    } else if (this->expansion_by_species == "user defined") {
-      this->initialize_expansion_with_global_species(
-          manager, expansions_coefficients, expansions_coefficients_gradient);
-    } else if (this->expansion_by_species == "structure wise") {
-      this->initialize_expansion_structure_wise(
-          manager, expansions_coefficients, expansions_coefficients_gradient);
-    } else {
-      throw std::runtime_error("should not arrive here");
+    {
+      RASCAL_TIMER("initialize");
+      if (this->expansion_by_species == "environment wise") {
+        this->initialize_expansion_environment_wise(
+            manager, expansions_coefficients,
+            expansions_coefficients_gradient);
+      } else if (this->expansion_by_species == "user defined") {
+        this->initialize_expansion_with_global_species(
+            manager, expansions_coefficients,
+            expansions_coefficients_gradient);
+      } else if (this->expansion_by_species == "structure wise") {
+        this->initialize_expansion_structure_wise(
+            manager, expansions_coefficients,
+            expansions_coefficients_gradient);
+      } else {
+        throw std::runtime_error("should not arrive here");
+      }
     }
 
-    // coeff C^{ij}_{nlm}
-    auto c_ij_nlm = math::Matrix_t(n_row, n_col);
+    if (use_incremental) {
+      // record the reference used by the following incremental updates
+      auto & state = *incremental_state;
+      auto manager_root = extract_underlying_manager<0>(manager);
+      state.positions = manager_root->get_positions();
+      state.cell = manager_root->get_cell();
+      auto atom_types = manager_root->get_atom_types();
+      state.atom_types.assign(atom_types.data(),
+                              atom_types.data() + atom_types.size());
+      state.center_indices.clear();
+      size_t n_values{0};
+      for (auto center : manager) {
+        auto & coefficients_center = expansions_coefficients[center];
+        n_values = std::max(n_values, coefficients_center.global_offset +
+                                          coefficients_center.size());
+      }
+      state.raw_coefficients.resize(n_values);
+      state.clear_pairs();
+      if (compute_gradients) {
+        size_t n_pairs{0};
+        for (auto center : manager) {
+          for (auto neigh : center.pairs()) {
+            (void)neigh;  // to avoid compiler warning
+            ++n_pairs;
+          }
+        }
+        state.clear_gradients(n_pairs, ThreeD * n_row, n_col);
+      }
+      state.center_changed.assign(manager->size(), true);
+      state.last_update_incremental = false;
+      state.n_updates_since_refresh = 0;
+      state.is_initialized = true;
+    }
 
-    for (auto center : manager) {
+    // the centers are distributed over the threads, the incremental update
+    // records the pairs in the order of the centers so it stays serial
+    const size_t n_centers{manager->size()};
+    const size_t n_threads{
+        use_incremental ? size_t(1)
+                        : std::max(std::min(this->n_threads, n_centers),
+                                   size_t(1))};
+    this->prepare_workspaces(n_threads);
+    std::vector<decltype(radial_integral)> radial_integrals{};
+    for (size_t i_thread{0}; i_thread < n_threads; ++i_thread) {
+      radial_integrals.push_back(
+          downcast_radial_integral_handler<RadialType, SmearingType, OptType>(
+              this->workspaces[i_thread].radial_integral));
+    }
+
+    /*
+     * With a half neighbour list the pair ij also contributes to the
+     * expansion of the center j through c^{ji}_{nlm} = (-1)^l c^{ij}_{nlm}.
+     * In serial these contributions are added to j directly but with
+     * several threads j might be computed at the same time, so c^{ij} is
+     * stored in a slot of half_list_contributions and the slots are gathered
+     * by j once all the centers have been computed. The slots of a center are
+     * in the order of its pairs and gathered in the order of the centers so
+     * the result does not depend on the scheduling of the threads.
+     */
+    const bool gather_half_list{IsHalfNL and n_threads > 1};
+    struct HalfListSlot {
+      //! index of the slot in half_list_contributions
+      size_t slot;
+      //! type of the center i
+      int center_type;
+      //! grad_j c^{i} of the pair (if the gradients are computed)
+      typename PropGrad_t::InputData_t * gradient_pair;
+    };
+    //! first slot of each center
+    std::vector<size_t> slot_offsets{};
+    //! slots gathered by each center in CSR format
+    std::vector<size_t> gather_offsets{};
+    std::vector<HalfListSlot> gather_slots{};
+    Matrix_t half_list_contributions{};
+    if (gather_half_list) {
+      std::map<int, size_t> center_tag2idx{};
+      size_t i_center{0};
+      for (auto center : manager) {
+        center_tag2idx[center.get_atom_tag()] = i_center;
+        ++i_center;
+      }
+      std::vector<HalfListSlot> slots{};
+      std::vector<size_t> slot_targets{};
+      slot_offsets.assign(n_centers + 1, 0);
+      i_center = 0;
+      for (auto center : manager) {
+        for (auto neigh : center.pairs()) {
+          if (manager->is_center_atom(neigh)) {
+            auto atom_j = neigh.get_atom_j();
+            slot_targets.push_back(center_tag2idx[atom_j.get_atom_tag()]);
+            slots.push_back(
+                {slots.size(), center.get_atom_type(),
+                 compute_gradients ? &expansions_coefficients_gradient[neigh]
+                                   : nullptr});
+          }
+        }
+        ++i_center;
+        slot_offsets[i_center] = slots.size();
+      }
+      // counting sort of the slots by gathering center
+      gather_offsets.assign(n_centers + 1, 0);
+      for (const auto & target : slot_targets) {
+        gather_offsets[target + 1]++;
+      }
+      for (i_center = 0; i_center < n_centers; ++i_center) {
+        gather_offsets[i_center + 1] += gather_offsets[i_center];
+      }
+      gather_slots.resize(slots.size());
+      std::vector<size_t> cursors(gather_offsets.begin(),
+                                  gather_offsets.end() - 1);
+      for (size_t i_slot{0}; i_slot < slots.size(); ++i_slot) {
+        gather_slots[cursors[slot_targets[i_slot]]++] = slots[i_slot];
+      }
+      half_list_contributions.resize(slots.size() * n_row, n_col);
+    }
+    RASCAL_TIMER("expansion");
+    // computes the expansion of a center with the work arrays of a thread
+    auto compute_center = [&](auto & center, const size_t i_center,
+                              const size_t i_thread) {
+      auto & work = this->workspaces[i_thread];
+      auto & thread_radial_integral = radial_integrals[i_thread];
+      auto & spherical_harmonics = work.spherical_harmonics;
+      // coeff C^{ij}_{nlm}
+      auto & c_ij_nlm = work.c_ij_nlm;
+      // slot of the next pair gathered by its neighbour
+      size_t i_slot{gather_half_list ? slot_offsets[i_center] : 0};
       // c^{i}
       auto & coefficients_center = expansions_coefficients[center];
       // \grad_i c^{i}
@@ -1802,7 +2715,7 @@ namespace rascal {
 
       // Start the accumulation with the central atom contribution
       coefficients_center[center_type].col(0) +=
-          radial_integral->template compute_center_contribution(center) /
+          thread_radial_integral->template compute_center_contribution(center) /
           sqrt(4.0 * PI);
 
       for (auto neigh : center.pairs()) {
@@ -1813,16 +2726,33 @@ namespace rascal {
         const double & dist{manager->get_distance(neigh)};
         const auto direction{manager->get_direction_vector(neigh)};
         Key_t neigh_type{neigh.get_atom_type()};
-        this->spherical_harmonics.calc(direction, compute_gradients);
+        RASCAL_LOCAL_COUNTER_ADD(work.n_pairs, 1);
+        if (OptType == internal::OptimizationType::Interpolator) {
+          // the derivative is interpolated separately
+          RASCAL_LOCAL_COUNTER_ADD(work.n_interpolations,
+                                   compute_gradients ? 2 : 1);
+        }
+        RASCAL_FINE_TIMER_START(work.harmonics_timer);
+        spherical_harmonics.calc(direction, compute_gradients);
+        RASCAL_FINE_TIMER_STOP(work.harmonics_timer);
         auto && harmonics{spherical_harmonics.get_harmonics()};
         auto && harmonics_gradients{
             spherical_harmonics.get_harmonics_derivatives()};
+        RASCAL_FINE_TIMER_START(work.radial_timer);
         auto && neighbour_contribution =
-            radial_integral->template compute_neighbour_contribution(dist,
+            thread_radial_integral->template compute_neighbour_contribution(dist,
                                                                      neigh);
+        RASCAL_FINE_TIMER_STOP(work.radial_timer);
+        RASCAL_FINE_TIMER_START(work.accumulation_timer);
         double f_c{cutoff_function->f_c(dist)};
         auto coefficients_center_by_type{coefficients_center[neigh_type]};
 
+        if (use_incremental) {
+          incremental_state->add_pair(
+              manager->get_atom_index(neigh.get_atom_tag()), neigh_type[0],
+              dist, direction);
+        }
+
         // compute the coefficients
         size_t l_block_idx{0};
         for (size_t angular_l{0}; angular_l < this->max_angular + 1;
@@ -1838,7 +2768,11 @@ namespace rascal {
 
         // half list branch for c^{ji} terms using
         // c^{ij}_{nlm} = (-1)^l c^{ji}_{nlm}.
-        if (IsHalfNL) {
+        if (IsHalfNL and is_center_atom and gather_half_list) {
+          half_list_contributions.block(i_slot * max_radial, 0, max_radial,
+                                        c_ij_nlm.cols()) = c_ij_nlm;
+          ++i_slot;
+        } else if (IsHalfNL) {
           if (is_center_atom) {
             auto & coefficients_neigh{expansions_coefficients[atom_j]};
             auto coefficients_neigh_by_type{coefficients_neigh[center_type]};
@@ -1856,6 +2790,7 @@ namespace rascal {
             }
           }
         }
+        RASCAL_FINE_TIMER_STOP(work.accumulation_timer);
 
         // compute the gradients of the coefficients with respect to
         // atoms positions
@@ -1863,12 +2798,13 @@ namespace rascal {
         // (the periodic images move with the center, so their contribution to
         // the center gradient is zero)
         if (compute_gradients) {  // NOLINT
+          RASCAL_FINE_TIMER_START(work.gradients_timer);
           // \grad_j c^i
           auto & coefficients_neigh_gradient =
               expansions_coefficients_gradient[neigh];
 
           auto && neighbour_derivative =
-              radial_integral->compute_neighbour_derivative(dist, neigh);
+              thread_radial_integral->compute_neighbour_derivative(dist, neigh);
           double df_c{cutoff_function->df_c(dist)};
           // The type of the contribution c^{ij} to the coefficient c^{i}
           // depends on the type of j (and it is the same for the gradients)
@@ -1924,8 +2860,9 @@ namespace rascal {
           }    // for cartesian_idx
 
           // half list branch for accumulating parts of grad_j c^{j} using
-          // grad_j c^{ji a} = (-1)^l grad_j c^{ij b}
-          if (IsHalfNL) {
+          // grad_j c^{ji a} = (-1)^l grad_j c^{ij b}, they are gathered by
+          // the center j when computed with several threads
+          if (IsHalfNL and not gather_half_list) {
             if (is_center_atom) {
               // grad_j c^{j}
               auto & coefficients_neigh_center_gradient =
@@ -1956,17 +2893,982 @@ namespace rascal {
               }    // for cartesian_idx
             }      // if (is_center_atom)
           }        // if (IsHalfNL)
+          RASCAL_FINE_TIMER_STOP(work.gradients_timer);
         }          // if (compute_gradients)
       }            // for (neigh : center)
 
-      // Normalize and orthogonalize the radial coefficients
-      radial_integral->finalize_coefficients(coefficients_center);
+      if (use_incremental) {
+        incremental_state->center_indices.push_back(
+            manager->get_atom_index(atom_i_tag));
+        incremental_state->raw_coefficients.segment(
+            coefficients_center.global_offset, coefficients_center.size()) =
+            coefficients_center.get_full_vector();
+        incremental_state->close_center();
+      }
+
+      // Normalize and orthogonalize the radial coefficients, the gathered
+      // contributions have to be added first
+      if (not gather_half_list) {
+        RASCAL_FINE_TIMER_START(work.finalize_timer);
+        thread_radial_integral->finalize_coefficients(coefficients_center);
+        if (compute_gradients) {
+          thread_radial_integral->template finalize_coefficients_der<ThreeD>(
+              expansions_coefficients_gradient, center);
+        }
+        RASCAL_FINE_TIMER_STOP(work.finalize_timer);
+      }
+
+      if (use_incremental and compute_gradients) {
+        for (auto neigh : center.pairs()) {
+          Key_t neigh_type{neigh.get_atom_type()};
+          incremental_state->add_gradient(
+              manager->get_atom_index(neigh.get_atom_tag()),
+              manager->get_direction_vector(neigh) *
+                  manager->get_distance(neigh),
+              expansions_coefficients_gradient[neigh][neigh_type]);
+        }
+        incremental_state->close_gradient_center();
+      }
+    };  // compute_center
+
+    if (n_threads == 1) {
+      size_t i_center{0};
+      for (auto center : manager) {
+        compute_center(center, i_center, 0);
+        ++i_center;
+      }
+    } else {
+      internal::parallel_for(
+          n_centers, n_threads, [&](size_t i_center, size_t i_thread) {
+            auto center_it = manager->get_iterator_at(i_center);
+            auto center = *center_it;
+            compute_center(center, i_center, i_thread);
+          });
+    }
+
+    if (gather_half_list) {
+      // add c^{ji} and grad_j c^{ji} to the centers j and finalize c^{j}
+      internal::parallel_for(
+          n_centers, n_threads, [&](size_t i_center, size_t i_thread) {
+            auto center_it = manager->get_iterator_at(i_center);
+            auto center = *center_it;
+            auto & coefficients_center = expansions_coefficients[center];
+            Key_t center_type{center.get_atom_type()};
+            for (size_t i_gather{gather_offsets[i_center]};
+                 i_gather < gather_offsets[i_center + 1]; ++i_gather) {
+              const auto & slot = gather_slots[i_gather];
+              Key_t neigh_type{slot.center_type};
+              RASCAL_FINE_TIMER_START(
+                  this->workspaces[i_thread].accumulation_timer);
+              auto coefficients_center_by_type{
+                  coefficients_center[neigh_type]};
+              size_t l_block_idx{0};
+              double parity{1.};
+              for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+                   ++angular_l) {
+                size_t l_block_size{2 * angular_l + 1};
+                coefficients_center_by_type.block(0, l_block_idx, max_radial,
+                                                  l_block_size) +=
+                    parity * half_list_contributions.block(
+                                 slot.slot * max_radial, l_block_idx,
+                                 max_radial, l_block_size);
+                l_block_idx += l_block_size;
+                parity *= -1.;
+              }
+              RASCAL_FINE_TIMER_STOP(
+                  this->workspaces[i_thread].accumulation_timer);
+
+              if (compute_gradients) {
+                RASCAL_FINE_TIMER_START(
+                    this->workspaces[i_thread].gradients_timer);
+                // grad_j c^{j a} += (-1)^l grad_j c^{ij b}
+                auto && gradient_center_by_type{
+                    expansions_coefficients_gradient[center.get_atom_ii()]
+                                                    [neigh_type]};
+                auto && gradient_pair_by_type{
+                    (*slot.gradient_pair)[center_type]};
+                for (int cartesian_idx{0}; cartesian_idx < ThreeD;
+                     ++cartesian_idx) {
+                  l_block_idx = 0;
+                  parity = 1.;
+                  for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+                       ++angular_l) {
+                    size_t l_block_size{2 * angular_l + 1};
+                    gradient_center_by_type.block(cartesian_idx * max_radial,
+                                                  l_block_idx, max_radial,
+                                                  l_block_size) +=
+                        parity * gradient_pair_by_type.block(
+                                     cartesian_idx * max_radial, l_block_idx,
+                                     max_radial, l_block_size);
+                    l_block_idx += l_block_size;
+                    parity *= -1.;
+                  }
+                }
+                RASCAL_FINE_TIMER_STOP(
+                    this->workspaces[i_thread].gradients_timer);
+              }
+            }
+            RASCAL_FINE_TIMER_START(
+                this->workspaces[i_thread].finalize_timer);
+            radial_integrals[i_thread]->finalize_coefficients(
+                coefficients_center);
+            RASCAL_FINE_TIMER_STOP(
+                this->workspaces[i_thread].finalize_timer);
+          });
+
+      // the gradients of the pairs of a center are read while gathering so
+      // they are finalized afterwards
       if (compute_gradients) {
-        radial_integral->template finalize_coefficients_der<ThreeD>(
-            expansions_coefficients_gradient, center);
+        internal::parallel_for(
+            n_centers, n_threads, [&](size_t i_center, size_t i_thread) {
+              auto center_it = manager->get_iterator_at(i_center);
+              auto center = *center_it;
+              RASCAL_FINE_TIMER_START(
+                  this->workspaces[i_thread].finalize_timer);
+              radial_integrals[i_thread]
+                  ->template finalize_coefficients_der<ThreeD>(
+                      expansions_coefficients_gradient, center);
+              RASCAL_FINE_TIMER_STOP(
+                  this->workspaces[i_thread].finalize_timer);
+            });
       }
+    }
+
+    if (use_incremental) {
+      incremental_state->swap_pairs();
+    }
+
+    for (size_t i_thread{0}; i_thread < n_threads; ++i_thread) {
+      auto & work = this->workspaces[i_thread];
+      RASCAL_FINE_TIMER_FLUSH(work.harmonics_timer, "spherical_harmonics");
+      RASCAL_FINE_TIMER_FLUSH(work.radial_timer, "radial_integral");
+      RASCAL_FINE_TIMER_FLUSH(work.accumulation_timer, "accumulation");
+      RASCAL_FINE_TIMER_FLUSH(work.gradients_timer, "gradients");
+      RASCAL_FINE_TIMER_FLUSH(work.finalize_timer, "finalize");
+      RASCAL_LOCAL_COUNTER_FLUSH(work.n_pairs, "SphericalExpansion::pairs");
+      RASCAL_LOCAL_COUNTER_FLUSH(work.n_interpolations,
+                                 "SphericalExpansion::interpolator_calls");
+      (void)work;  // to avoid compiler warning without timers
+    }
+    RASCAL_COUNTER_ADD("SphericalExpansion::centers", n_centers);
+  }  // compute()
+
+  template <class StructureManager, class CutoffFunction, class RadialIntegral>
+  bool CalculatorSphericalExpansion::update_expansion_incrementally(
+      std::shared_ptr<StructureManager> & manager,
+      internal::SphericalExpansionIncrementalState & state,
+      CutoffFunction & cutoff_function, RadialIntegral & radial_integral,
+      Property_t<StructureManager> & expansions_coefficients,
+      PropertyGradient_t<StructureManager> & expansions_coefficients_gradient) {
+    using math::PI;
+    state.last_update_incremental = false;
+    if (not state.is_initialized) {
+      return false;
+    }
+    if (state.n_updates_since_refresh + 1 >=
+        this->incremental_update.full_refresh_period) {
+      return false;
+    }
+
+    // check that the structure changed only through the positions
+    auto manager_root = extract_underlying_manager<0>(manager);
+    auto positions = manager_root->get_positions();
+    auto atom_types = manager_root->get_atom_types();
+    const size_t n_atoms{static_cast<size_t>(positions.cols())};
+    const size_t n_centers{manager->size()};
+    if (n_atoms != static_cast<size_t>(state.positions.cols()) or
+        n_centers != state.center_indices.size() or n_centers == 0 or
+        expansions_coefficients.size() != n_centers or
+        manager_root->get_cell() != state.cell) {
+      return false;
+    }
+    for (size_t i_atom{0}; i_atom < n_atoms; ++i_atom) {
+      if (atom_types(i_atom) != state.atom_types[i_atom]) {
+        return false;
+      }
+    }
+    size_t i_center{0};
+    for (auto center : manager) {
+      if (manager->get_atom_index(center.get_atom_tag()) !=
+          state.center_indices[i_center]) {
+        return false;
+      }
+      ++i_center;
+    }
+
+    // find the atoms that moved beyond the threshold
+    const double threshold2{this->incremental_update.displacement_threshold *
+                            this->incremental_update.displacement_threshold};
+    state.moved.assign(n_atoms, false);
+    size_t n_moved{0};
+    for (size_t atom_tag{0}; atom_tag < n_atoms; ++atom_tag) {
+      // moved is indexed like the neighbours while positions are indexed
+      // with the atom index of the root manager
+      const size_t i_atom{
+          manager_root->get_atom_index(static_cast<int>(atom_tag))};
+      if ((positions.col(i_atom) - state.positions.col(i_atom))
+              .squaredNorm() > threshold2) {
+        state.moved[atom_tag] = true;
+        ++n_moved;
+      }
+    }
+    if (static_cast<double>(n_moved) >
+        this->incremental_update.max_moved_fraction *
+            static_cast<double>(n_atoms)) {
+      return false;
+    }
+
+    // the keys of the expansion are kept so they should not depend on the
+    // new positions
+    const size_t n_lm{(this->max_angular + 1) * (this->max_angular + 1)};
+    const size_t block_size{this->max_radial * n_lm};
+    std::set<int> structure_types{};
+    size_t n_structure_keys{0};
+    for (auto center : manager) {
+      auto & coefficients_center = expansions_coefficients[center];
+      std::set<int> center_types{center.get_atom_type()};
+      for (auto neigh : center.pairs()) {
+        center_types.insert(neigh.get_atom_type());
+      }
+      for (const auto & type : center_types) {
+        if (coefficients_center.count(Key_t{type}) == 0) {
+          return false;
+        }
+      }
+      n_structure_keys = coefficients_center.size() / block_size;
+      if (this->expansion_by_species == "environment wise" and
+          n_structure_keys != center_types.size()) {
+        return false;
+      }
+      structure_types.insert(center_types.begin(), center_types.end());
+    }
+    if (this->expansion_by_species == "structure wise" and
+        n_structure_keys != structure_types.size()) {
+      return false;
+    }
+
+    // the pairs of the neighbour list might have changed so the layout of
+    // the gradients is built again, \grad_i c^{i} has the keys of c^{i} and
+    // \grad_j c^{i} the key of j
+    const bool compute_gradients{this->compute_gradients};
+    if (compute_gradients) {
+      std::vector<std::set<Key_t>> keys_list_grad{};
+      for (auto center : manager) {
+        auto keys_center = expansions_coefficients[center].get_keys();
+        keys_list_grad.emplace_back(keys_center.begin(), keys_center.end());
+        for (auto neigh : center.pairs()) {
+          keys_list_grad.push_back({Key_t{neigh.get_atom_type()}});
+        }
+      }
+      expansions_coefficients_gradient.clear();
+      expansions_coefficients_gradient.resize(keys_list_grad);
+      expansions_coefficients_gradient.setZero();
+      state.clear_gradients(keys_list_grad.size() - n_centers,
+                            ThreeD * this->max_radial, n_lm);
+    }
+
+    state.clear_pairs();
+    state.center_changed.assign(n_centers, false);
+    i_center = 0;
+    for (auto center : manager) {
+      auto & coefficients_center = expansions_coefficients[center];
+      auto raw_center = state.raw_coefficients.segment(
+          coefficients_center.global_offset, coefficients_center.size());
+      auto raw_by_type = [&state, &coefficients_center, n_lm,
+                          this](int type) {
+        return Eigen::Map<Matrix_t>(
+            state.raw_coefficients.data() +
+                coefficients_center.get_location_by_key(Key_t{type}),
+            this->max_radial, n_lm);
+      };
+      const size_t pair_begin{state.pair_offsets[i_center]};
+      const size_t pair_end{state.pair_offsets[i_center + 1]};
+      const bool center_moved{state.moved[state.center_indices[i_center]]};
+      bool changed{center_moved};
+      if (center_moved) {
+        // everything changes so start from scratch
+        raw_center.setZero();
+        raw_by_type(center.get_atom_type()).col(0) +=
+            radial_integral->template compute_center_contribution(center) /
+            sqrt(4.0 * PI);
+      } else {
+        // remove the old contributions of the moved neighbours and keep the
+        // pairs with fixed neighbours
+        for (size_t i_pair{pair_begin}; i_pair < pair_end; ++i_pair) {
+          if (state.moved[state.pair_neigh_indices[i_pair]]) {
+            this->add_pair_contribution(
+                state.pair_directions[i_pair], state.pair_distances[i_pair],
+                -1., cutoff_function, radial_integral, center,
+                raw_by_type(state.pair_neigh_types[i_pair]));
+            changed = true;
+          } else {
+            state.keep_pair(i_pair);
+          }
+        }
+      }
+      // add the new contributions
+      for (auto neigh : center.pairs()) {
+        const size_t neigh_index{manager->get_atom_index(neigh.get_atom_tag())};
+        if (center_moved or state.moved[neigh_index]) {
+          const double & dist{manager->get_distance(neigh)};
+          const Eigen::Vector3d direction{
+              manager->get_direction_vector(neigh)};
+          const int neigh_type{neigh.get_atom_type()};
+          this->add_pair_contribution(direction, dist, 1., cutoff_function,
+                                      radial_integral, neigh,
+                                      raw_by_type(neigh_type));
+          state.add_pair(neigh_index, neigh_type, dist, direction);
+          changed = true;
+        }
+      }
+      state.close_center();
+
+      if (changed) {
+        coefficients_center.get_full_vector() = raw_center;
+        radial_integral->finalize_coefficients(coefficients_center);
+        state.center_changed[i_center] = true;
+      }
+
+      if (compute_gradients) {
+        internal::StackedCoefficientsView<ThreeD> pair_gradient_view{
+            state.pair_gradient};
+        auto & gradient_center =
+            expansions_coefficients_gradient[center.get_atom_ii()];
+        size_t hint{state.gradient_offsets[i_center]};
+        for (auto neigh : center.pairs()) {
+          const size_t neigh_index{
+              manager->get_atom_index(neigh.get_atom_tag())};
+          const Key_t neigh_type{neigh.get_atom_type()};
+          const Eigen::Vector3d r_ij{manager->get_direction_vector(neigh) *
+                                     manager->get_distance(neigh)};
+          int i_pair{-1};
+          if (not(center_moved or state.moved[neigh_index])) {
+            i_pair = state.find_gradient(i_center, neigh_index, r_ij, hint);
+          }
+          // \grad_j c^{ij}
+          auto & gradient_neigh = expansions_coefficients_gradient[neigh];
+          auto && gradient_pair{gradient_neigh[neigh_type]};
+          if (i_pair >= 0) {
+            gradient_pair = state.pair_gradients.middleRows(
+                i_pair * state.pair_gradient.rows(),
+                state.pair_gradient.rows());
+            state.add_gradient(neigh_index, state.gradient_vectors[i_pair],
+                               gradient_pair);
+            hint = i_pair + 1;
+          } else {
+            this->compute_pair_gradient(
+                manager->get_direction_vector(neigh),
+                manager->get_distance(neigh), cutoff_function, radial_integral,
+                this->spherical_harmonics, neigh, state.pair_gradient);
+            radial_integral->finalize_coefficients(pair_gradient_view);
+            gradient_pair = state.pair_gradient;
+            state.add_gradient(neigh_index, r_ij, state.pair_gradient);
+          }
+          // \grad_i c^{i} = - \sum_{j} \grad_j c^{ij}, without the images
+          // of the center
+          if (neigh.get_atom_j().get_atom_tag() != center.get_atom_tag()) {
+            gradient_center[neigh_type] -= gradient_pair;
+          }
+        }
+        state.close_gradient_center();
+      }
+      ++i_center;
     }  // for (center : manager)
-  }    // compute()
+    state.swap_pairs();
+
+    // the reference of the moved atoms is their current position
+    for (size_t atom_tag{0}; atom_tag < n_atoms; ++atom_tag) {
+      if (state.moved[atom_tag]) {
+        const size_t i_atom{
+          manager_root->get_atom_index(static_cast<int>(atom_tag))};
+        state.positions.col(i_atom) = positions.col(i_atom);
+      }
+    }
+    state.last_update_incremental = true;
+    ++state.n_updates_since_refresh;
+    return true;
+  }
+
+  template <class CutoffFunction, class RadialIntegral, class ClusterRef,
+            class Coefficients>
+  void CalculatorSphericalExpansion::add_pair_contribution(
+      const Eigen::Vector3d & direction, const double distance,
+      const double prefactor, CutoffFunction & cutoff_function,
+      RadialIntegral & radial_integral, const ClusterRef & cluster,
+      Coefficients coefficients_by_type) {
+    this->spherical_harmonics.calc(direction, false);
+    auto && harmonics{this->spherical_harmonics.get_harmonics()};
+    auto && neighbour_contribution =
+        radial_integral->template compute_neighbour_contribution(distance,
+                                                                 cluster);
+    const double f_c{prefactor * cutoff_function->f_c(distance)};
+    size_t l_block_idx{0};
+    for (size_t angular_l{0}; angular_l < this->max_angular + 1; ++angular_l) {
+      size_t l_block_size{2 * angular_l + 1};
+      coefficients_by_type.block(0, l_block_idx, this->max_radial,
+                                 l_block_size) +=
+          f_c * neighbour_contribution.col(angular_l) *
+          harmonics.segment(l_block_idx, l_block_size);
+      l_block_idx += l_block_size;
+    }
+  }
+
+  template <class CutoffFunction, class RadialIntegral, class ClusterRef>
+  void CalculatorSphericalExpansion::compute_pair_gradient(
+      const Eigen::Vector3d & direction, const double distance,
+      CutoffFunction & cutoff_function, RadialIntegral & radial_integral,
+      math::SphericalHarmonics & spherical_harmonics,
+      const ClusterRef & cluster, Matrix_t & pair_gradient) {
+    spherical_harmonics.calc(direction, true);
+    auto && harmonics{spherical_harmonics.get_harmonics()};
+    auto && harmonics_gradients{
+        spherical_harmonics.get_harmonics_derivatives()};
+    auto && neighbour_contribution =
+        radial_integral->template compute_neighbour_contribution(distance,
+                                                                 cluster);
+    auto && neighbour_derivative =
+        radial_integral->compute_neighbour_derivative(distance, cluster);
+    const double f_c{cutoff_function->f_c(distance)};
+    const double df_c{cutoff_function->df_c(distance)};
+    // d/dr_{ij} (c_{ij} f_c{r_{ij}})
+    Matrix_t radial_derivative =
+        neighbour_derivative * f_c + neighbour_contribution * df_c;
+    const size_t n_row{this->max_radial};
+    for (int cartesian_idx{0}; cartesian_idx < ThreeD; ++cartesian_idx) {
+      size_t l_block_idx{0};
+      for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+           ++angular_l) {
+        size_t l_block_size{2 * angular_l + 1};
+        pair_gradient.block(cartesian_idx * n_row, l_block_idx, n_row,
+                            l_block_size) =
+            radial_derivative.col(angular_l) *
+                harmonics.segment(l_block_idx, l_block_size) *
+                direction(cartesian_idx) +
+            neighbour_contribution.col(angular_l) *
+                harmonics_gradients.block(cartesian_idx, l_block_idx, 1,
+                                          l_block_size) *
+                f_c / distance;
+        l_block_idx += l_block_size;
+      }
+    }
+  }
+
+  template <class Function>
+  void CalculatorSphericalExpansion::visit_derivative_contributions(
+      const size_t n_threads, Function && function) {
+    using internal::CutoffFunctionType;
+    switch (this->cutoff_function_type) {
+    case CutoffFunctionType::ShiftedCosine:
+      this->visit_derivative_contributions_by_radial<
+          CutoffFunctionType::ShiftedCosine>(n_threads, function);
+      break;
+    case CutoffFunctionType::RadialScaling:
+      this->visit_derivative_contributions_by_radial<
+          CutoffFunctionType::RadialScaling>(n_threads, function);
+      break;
+    default:
+      std::basic_ostringstream<char> err_message;
+      err_message << "Invalid cutoff function type encountered ";
+      err_message << "(This is a bug.  Debug info for developers: ";
+      err_message << "cutoff_function_type == ";
+      err_message << static_cast<int>(this->cutoff_function_type);
+      err_message << ")" << std::endl;
+      throw std::logic_error(err_message.str());
+    }
+  }
+
+  template <internal::CutoffFunctionType FcType, class Function>
+  void CalculatorSphericalExpansion::visit_derivative_contributions_by_radial(
+      const size_t n_threads, Function && function) {
+    using internal::AtomicSmearingType;
+    using internal::OptimizationType;
+    using internal::RadialBasisType;
+    switch (internal::combine_to_radial_contribution_type(
+        this->radial_integral_type, this->atomic_smearing_type,
+        this->optimization_type)) {
+    case internal::combine_to_radial_contribution_type(
+        RadialBasisType::GTO, AtomicSmearingType::Constant,
+        OptimizationType::None): {
+      this->visit_derivative_contributions_impl<
+          FcType, RadialBasisType::GTO, AtomicSmearingType::Constant,
+          OptimizationType::None>(n_threads, function);
+      break;
+    }
+    case internal::combine_to_radial_contribution_type(
+        RadialBasisType::GTO, AtomicSmearingType::Constant,
+        OptimizationType::Interpolator): {
+      this->visit_derivative_contributions_impl<
+          FcType, RadialBasisType::GTO, AtomicSmearingType::Constant,
+          OptimizationType::Interpolator>(n_threads, function);
+      break;
+    }
+    case internal::combine_to_radial_contribution_type(
+        RadialBasisType::DVR, AtomicSmearingType::Constant,
+        OptimizationType::None): {
+      this->visit_derivative_contributions_impl<
+          FcType, RadialBasisType::DVR, AtomicSmearingType::Constant,
+          OptimizationType::None>(n_threads, function);
+      break;
+    }
+    case internal::combine_to_radial_contribution_type(
+        RadialBasisType::DVR, AtomicSmearingType::Constant,
+        OptimizationType::Interpolator): {
+      this->visit_derivative_contributions_impl<
+          FcType, RadialBasisType::DVR, AtomicSmearingType::Constant,
+          OptimizationType::Interpolator>(n_threads, function);
+      break;
+    }
+    default:
+      throw std::logic_error(
+          "The desired combination of parameters can not be handled.");
+    }
+  }
+
+  template <internal::CutoffFunctionType FcType,
+            internal::RadialBasisType RadialType,
+            internal::AtomicSmearingType SmearingType,
+            internal::OptimizationType OptType, class Function>
+  void CalculatorSphericalExpansion::visit_derivative_contributions_impl(
+      const size_t n_threads, Function && function) {
+    this->prepare_derivative_workspaces(n_threads);
+    auto cutoff_function{
+        downcast_cutoff_function<FcType>(this->cutoff_function)};
+    using RadialIntegral_t =
+        decltype(downcast_radial_integral_handler<RadialType, SmearingType,
+                                                  OptType>(
+            this->radial_integral));
+    std::vector<RadialIntegral_t> radial_integrals{};
+    for (size_t i_thread{0}; i_thread < n_threads; ++i_thread) {
+      radial_integrals.push_back(
+          downcast_radial_integral_handler<RadialType, SmearingType, OptType>(
+              this->derivative_workspaces[i_thread].radial_integral));
+    }
+    function(cutoff_function, radial_integrals);
+  }
+
+  template <class StructureManager>
+  std::tuple<math::Matrix_t, math::Matrix_t>
+  CalculatorSphericalExpansion::backward(
+      std::shared_ptr<StructureManager> manager,
+      const Eigen::Ref<const math::Matrix_t> & coefficients_gradient) {
+    using Prop_t = Property_t<StructureManager>;
+    using ConstMap_t = Eigen::Map<const Matrix_t>;
+    // with a half neighbour list the pairs between centers also contribute
+    // to the expansion of the neighbour
+    const bool is_half_list{StructureManager::traits::NeighbourListType ==
+                            AdaptorTraits::NeighbourListType::half};
+    constexpr bool ExcludeGhosts{true};
+    // the layout of dL/dc is the one of the expansion
+    this->compute(manager);
+    RASCAL_TIMER("SphericalExpansion::backward");
+    auto && expansions_coefficients{*manager->template get_property<Prop_t>(
+        this->get_name(), true, true, ExcludeGhosts)};
+    internal::check_feature_matrix_shape(
+        expansions_coefficients, coefficients_gradient,
+        "coefficients_gradient");
+    const auto feature_offsets{expansions_coefficients.get_feature_offsets()};
+
+    // see compute_sparse_kernel_neg_stress for the Voigt order
+    const std::array<std::array<int, 2>, ThreeD> voigt_id_to_spatial_dim = {
+        {             // voigt_idx,  spatial_dim_idx
+         {{4, 2}},    //    xz,            z
+         {{5, 0}},    //    xy,            x
+         {{3, 1}}}};  //    yz,            y
+
+    const size_t n_centers{manager->size()};
+    const size_t n_threads{
+        std::max(std::min(this->n_threads, n_centers), size_t(1))};
+    const size_t n_row{this->max_radial};
+    const size_t n_col{math::pow(this->max_angular + 1, 2_size_t)};
+    // dL/dr_j of each pair ij and the virial of each center are reduced in
+    // the order of the centers so the result does not depend on the threads
+    std::vector<size_t> pair_offsets{0};
+    std::vector<size_t> pair_atoms{};
+    for (auto center : manager) {
+      for (auto neigh : center.pairs()) {
+        pair_atoms.push_back(manager->get_atom_index(neigh.get_atom_tag()));
+      }
+      pair_offsets.push_back(pair_atoms.size());
+    }
+    Matrix_t pair_derivatives{Matrix_t::Zero(pair_atoms.size(), ThreeD)};
+    Matrix_t center_virials{Matrix_t::Zero(n_centers, 2 * ThreeD)};
+
+    this->visit_derivative_contributions(n_threads, [&](auto & cutoff_function,
+                                                        auto &
+                                                            radial_integrals) {
+      internal::parallel_for(
+          n_centers, n_threads, [&](size_t i_center, size_t i_thread) {
+            auto & work = this->derivative_workspaces[i_thread];
+            auto & pair_gradient = work.pair_gradient;
+            internal::StackedCoefficientsView<ThreeD> pair_gradient_view{
+                pair_gradient};
+            auto center_it = manager->get_iterator_at(i_center);
+            auto center = *center_it;
+            const Key_t center_type{center.get_atom_type()};
+            const Eigen::Vector3d r_i{center.get_position()};
+            size_t i_pair{pair_offsets[i_center]};
+            for (auto neigh : center.pairs()) {
+              const Key_t neigh_type{neigh.get_atom_type()};
+              // \grad_j c^{ij}
+              this->compute_pair_gradient(
+                  manager->get_direction_vector(neigh),
+                  manager->get_distance(neigh), cutoff_function,
+                  radial_integrals[i_thread], work.spherical_harmonics, neigh,
+                  pair_gradient);
+              radial_integrals[i_thread]->finalize_coefficients(
+                  pair_gradient_view);
+
+              // dL/dc^{ib}
+              ConstMap_t upstream_center(
+                  coefficients_gradient.row(i_center).data() +
+                      feature_offsets.at(neigh_type),
+                  n_row, n_col);
+              Eigen::Vector3d pair_derivative{this->contract_pair_gradient(
+                  upstream_center, pair_gradient, false)};
+              // with a half neighbour list the pair also contributes to
+              // c^{ja} through c^{ji}_{nlm} = (-1)^l c^{ij}_{nlm}
+              if (is_half_list and manager->is_center_atom(neigh)) {
+                // dL/dc^{ja}
+                ConstMap_t upstream_neigh(
+                    coefficients_gradient.row(pair_atoms[i_pair]).data() +
+                        feature_offsets.at(center_type),
+                    n_row, n_col);
+                pair_derivative += this->contract_pair_gradient(
+                    upstream_neigh, pair_gradient, true);
+              }
+              pair_derivatives.row(i_pair) = pair_derivative.transpose();
+
+              const Eigen::Vector3d r_ji{r_i - neigh.get_position()};
+              for (int i_der{0}; i_der < ThreeD; ++i_der) {
+                const auto & voigt = voigt_id_to_spatial_dim[i_der];
+                center_virials(i_center, i_der) +=
+                    r_ji(i_der) * pair_derivative(i_der);
+                center_virials(i_center, voigt[0]) +=
+                    r_ji(voigt[1]) * pair_derivative(i_der);
+              }
+              ++i_pair;
+            }
+          });
+    });
+
+    Matrix_t gradients{Matrix_t::Zero(n_centers, ThreeD)};
+    Matrix_t virial{Matrix_t::Zero(1, 2 * ThreeD)};
+    for (size_t i_center{0}; i_center < n_centers; ++i_center) {
+      for (size_t i_pair{pair_offsets[i_center]};
+           i_pair < pair_offsets[i_center + 1]; ++i_pair) {
+        // the gradients w.r.t. the masked atoms are not reported
+        if (pair_atoms[i_pair] < n_centers) {
+          gradients.row(pair_atoms[i_pair]) += pair_derivatives.row(i_pair);
+        }
+        gradients.row(i_center) -= pair_derivatives.row(i_pair);
+      }
+      virial += center_virials.row(i_center);
+    }
+    return std::make_tuple(gradients, virial);
+  }
+
+  template <class StructureManager>
+  math::Matrix_t CalculatorSphericalExpansion::jvp(
+      std::shared_ptr<StructureManager> manager,
+      const Eigen::Ref<const math::Matrix_t> & displacements) {
+    using Prop_t = Property_t<StructureManager>;
+    using Map_t = Eigen::Map<Matrix_t>;
+    constexpr static bool IsHalfNL{
+        StructureManager::traits::NeighbourListType ==
+        AdaptorTraits::NeighbourListType::half};
+    constexpr bool ExcludeGhosts{true};
+    // the layout of the result is the one of the expansion
+    this->compute(manager);
+    RASCAL_TIMER("SphericalExpansion::jvp");
+    auto && expansions_coefficients{*manager->template get_property<Prop_t>(
+        this->get_name(), true, true, ExcludeGhosts)};
+    const size_t n_centers{manager->size()};
+    if (static_cast<size_t>(displacements.rows()) != n_centers or
+        displacements.cols() != ThreeD) {
+      std::stringstream err_str{};
+      err_str << "displacements should have the shape (" << n_centers
+              << ", 3) but has the shape (" << displacements.rows() << ", "
+              << displacements.cols() << ").";
+      throw std::runtime_error(err_str.str());
+    }
+    const auto feature_offsets{expansions_coefficients.get_feature_offsets()};
+    const size_t n_threads{
+        std::max(std::min(this->n_threads, n_centers), size_t(1))};
+    const size_t n_row{this->max_radial};
+    const size_t n_col{math::pow(this->max_angular + 1, 2_size_t)};
+
+    /*
+     * With a half neighbour list the pair ij also changes c^{j} through
+     * c^{ji}_{nlm} = (-1)^l c^{ij}_{nlm}, so like in compute_impl the change
+     * of c^{ij} is stored in a slot and the slots are added to the centers j
+     * in the order of the pairs once all the centers have been computed.
+     */
+    std::vector<size_t> slot_offsets{0};
+    std::vector<size_t> slot_targets{};
+    std::vector<Key_t> slot_types{};
+    if (IsHalfNL) {
+      for (auto center : manager) {
+        for (auto neigh : center.pairs()) {
+          if (manager->is_center_atom(neigh)) {
+            slot_targets.push_back(
+                manager->get_atom_index(neigh.get_atom_tag()));
+            slot_types.push_back(Key_t{center.get_atom_type()});
+          }
+        }
+        slot_offsets.push_back(slot_targets.size());
+      }
+    }
+    Matrix_t half_list_contributions{slot_targets.size() * n_row, n_col};
+
+    Matrix_t coefficients_change{Matrix_t::Zero(
+        n_centers, feature_offsets.size() *
+                       static_cast<size_t>(
+                           expansions_coefficients.get_nb_comp()))};
+
+    this->visit_derivative_contributions(n_threads, [&](auto & cutoff_function,
+                                                        auto &
+                                                            radial_integrals) {
+      // Normalize and orthogonalize the radial coefficients of a center
+      auto finalize_center = [&](const size_t i_center,
+                                 const size_t i_thread) {
+        for (const auto & key_offset : feature_offsets) {
+          internal::StackedCoefficientsView<1> view{
+              Map_t(coefficients_change.row(i_center).data() +
+                        key_offset.second,
+                    n_row, n_col)};
+          radial_integrals[i_thread]->finalize_coefficients(view);
+        }
+      };
+
+      internal::parallel_for(
+          n_centers, n_threads, [&](size_t i_center, size_t i_thread) {
+            auto & work = this->derivative_workspaces[i_thread];
+            auto & pair_gradient = work.pair_gradient;
+            auto & pair_change = work.c_ij_nlm;
+            auto center_it = manager->get_iterator_at(i_center);
+            auto center = *center_it;
+            size_t i_slot{IsHalfNL ? slot_offsets[i_center] : 0};
+            for (auto neigh : center.pairs()) {
+              const Key_t neigh_type{neigh.get_atom_type()};
+              const size_t j_atom{
+                  manager->get_atom_index(neigh.get_atom_tag())};
+              // \delta r_j - \delta r_i
+              Eigen::Vector3d delta_r{-displacements.row(i_center).transpose()};
+              if (j_atom < n_centers) {
+                delta_r += displacements.row(j_atom).transpose();
+              }
+              // \grad_j c^{ij}
+              this->compute_pair_gradient(
+                  manager->get_direction_vector(neigh),
+                  manager->get_distance(neigh), cutoff_function,
+                  radial_integrals[i_thread], work.spherical_harmonics, neigh,
+                  pair_gradient);
+              pair_change = pair_gradient.topRows(n_row) * delta_r(0);
+              for (int i_der{1}; i_der < ThreeD; ++i_der) {
+                pair_change +=
+                    pair_gradient.middleRows(i_der * n_row, n_row) *
+                    delta_r(i_der);
+              }
+              Map_t change_center(coefficients_change.row(i_center).data() +
+                                      feature_offsets.at(neigh_type),
+                                  n_row, n_col);
+              change_center += pair_change;
+              if (IsHalfNL and manager->is_center_atom(neigh)) {
+                half_list_contributions.middleRows(i_slot * n_row, n_row) =
+                    pair_change;
+                ++i_slot;
+              }
+            }
+            if (not IsHalfNL) {
+              finalize_center(i_center, i_thread);
+            }
+          });
+
+      if (IsHalfNL) {
+        for (size_t i_slot{0}; i_slot < slot_targets.size(); ++i_slot) {
+          Map_t change_neigh(coefficients_change.row(slot_targets[i_slot])
+                                     .data() +
+                                 feature_offsets.at(slot_types[i_slot]),
+                             n_row, n_col);
+          size_t l_block_idx{0};
+          double parity{1.};
+          for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+               ++angular_l) {
+            size_t l_block_size{2 * angular_l + 1};
+            change_neigh.middleCols(l_block_idx, l_block_size) +=
+                parity * half_list_contributions.block(
+                             i_slot * n_row, l_block_idx, n_row, l_block_size);
+            l_block_idx += l_block_size;
+            parity *= -1.;
+          }
+        }
+        internal::parallel_for(n_centers, n_threads, finalize_center);
+      }
+    });
+    return coefficients_change;
+  }
+
+  template <class StructureManager>
+  math::Matrix_t CalculatorSphericalExpansion::backward_jvp(
+      std::shared_ptr<StructureManager> manager,
+      const Eigen::Ref<const math::Matrix_t> & coefficients_gradient,
+      const Eigen::Ref<const math::Matrix_t> & coefficients_gradient_change,
+      const Eigen::Ref<const math::Matrix_t> & displacements,
+      const double fd_step) {
+    using Prop_t = Property_t<StructureManager>;
+    using ConstMap_t = Eigen::Map<const Matrix_t>;
+    const bool is_half_list{StructureManager::traits::NeighbourListType ==
+                            AdaptorTraits::NeighbourListType::half};
+    constexpr bool ExcludeGhosts{true};
+    if (not(fd_step > 0.)) {
+      std::stringstream err_str{};
+      err_str << "The step of the finite differences should be positive but "
+              << "is " << fd_step << ".";
+      throw std::runtime_error(err_str.str());
+    }
+    this->compute(manager);
+    RASCAL_TIMER("SphericalExpansion::backward_jvp");
+    auto && expansions_coefficients{*manager->template get_property<Prop_t>(
+        this->get_name(), true, true, ExcludeGhosts)};
+    internal::check_feature_matrix_shape(
+        expansions_coefficients, coefficients_gradient,
+        "coefficients_gradient");
+    internal::check_feature_matrix_shape(expansions_coefficients,
+                                         coefficients_gradient_change,
+                                         "coefficients_gradient_change");
+    const size_t n_centers{manager->size()};
+    if (static_cast<size_t>(displacements.rows()) != n_centers or
+        displacements.cols() != ThreeD) {
+      std::stringstream err_str{};
+      err_str << "displacements should have the shape (" << n_centers
+              << ", 3) but has the shape (" << displacements.rows() << ", "
+              << displacements.cols() << ").";
+      throw std::runtime_error(err_str.str());
+    }
+    const auto feature_offsets{expansions_coefficients.get_feature_offsets()};
+    const size_t n_threads{
+        std::max(std::min(this->n_threads, n_centers), size_t(1))};
+    const size_t n_row{this->max_radial};
+    const size_t n_col{math::pow(this->max_angular + 1, 2_size_t)};
+    // see backward()
+    std::vector<size_t> pair_offsets{0};
+    std::vector<size_t> pair_atoms{};
+    for (auto center : manager) {
+      for (auto neigh : center.pairs()) {
+        pair_atoms.push_back(manager->get_atom_index(neigh.get_atom_tag()));
+      }
+      pair_offsets.push_back(pair_atoms.size());
+    }
+    Matrix_t pair_derivatives_change{Matrix_t::Zero(pair_atoms.size(), ThreeD)};
+
+    this->visit_derivative_contributions(n_threads, [&](auto & cutoff_function,
+                                                        auto &
+                                                            radial_integrals) {
+      internal::parallel_for(
+          n_centers, n_threads, [&](size_t i_center, size_t i_thread) {
+            auto & work = this->derivative_workspaces[i_thread];
+            auto & pair_gradient = work.pair_gradient;
+            auto & pair_gradient_change = work.pair_gradient_change;
+            internal::StackedCoefficientsView<ThreeD> pair_gradient_view{
+                pair_gradient};
+            internal::StackedCoefficientsView<ThreeD>
+                pair_gradient_change_view{pair_gradient_change};
+            auto & radial_integral = radial_integrals[i_thread];
+            auto center_it = manager->get_iterator_at(i_center);
+            auto center = *center_it;
+            const Key_t center_type{center.get_atom_type()};
+            size_t i_pair{pair_offsets[i_center]};
+            for (auto neigh : center.pairs()) {
+              const Key_t neigh_type{neigh.get_atom_type()};
+              const size_t j_atom{pair_atoms[i_pair]};
+              // \delta r_j - \delta r_i
+              Eigen::Vector3d delta_r{-displacements.row(i_center).transpose()};
+              if (j_atom < n_centers) {
+                delta_r += displacements.row(j_atom).transpose();
+              }
+              const Eigen::Vector3d r_ij{manager->get_direction_vector(neigh) *
+                                         manager->get_distance(neigh)};
+              // \delta \grad_j c^{ij} = [\grad_j c^{ij}(r_{ij} + h u) -
+              // \grad_j c^{ij}(r_{ij} - h u)] |\delta r| / 2h with
+              // u = \delta r / |\delta r|
+              const double delta_r_norm{delta_r.norm()};
+              pair_gradient_change.setZero();
+              if (delta_r_norm > 0.) {
+                const Eigen::Vector3d shift{delta_r *
+                                            (fd_step / delta_r_norm)};
+                Eigen::Vector3d r_ij_shifted{r_ij + shift};
+                this->compute_pair_gradient(
+                    r_ij_shifted.normalized(), r_ij_shifted.norm(),
+                    cutoff_function, radial_integral, work.spherical_harmonics,
+                    neigh, pair_gradient_change);
+                r_ij_shifted = r_ij - shift;
+                this->compute_pair_gradient(
+                    r_ij_shifted.normalized(), r_ij_shifted.norm(),
+                    cutoff_function, radial_integral, work.spherical_harmonics,
+                    neigh, pair_gradient);
+                pair_gradient_change -= pair_gradient;
+                pair_gradient_change *= delta_r_norm / (2. * fd_step);
+                radial_integral->finalize_coefficients(
+                    pair_gradient_change_view);
+              }
+              // \grad_j c^{ij}
+              this->compute_pair_gradient(
+                  manager->get_direction_vector(neigh),
+                  manager->get_distance(neigh), cutoff_function,
+                  radial_integral, work.spherical_harmonics, neigh,
+                  pair_gradient);
+              radial_integral->finalize_coefficients(pair_gradient_view);
+
+              // dL/dc^{ib} and its change
+              ConstMap_t upstream_center(
+                  coefficients_gradient.row(i_center).data() +
+                      feature_offsets.at(neigh_type),
+                  n_row, n_col);
+              ConstMap_t upstream_change_center(
+                  coefficients_gradient_change.row(i_center).data() +
+                      feature_offsets.at(neigh_type),
+                  n_row, n_col);
+              Eigen::Vector3d pair_derivative_change{
+                  this->contract_pair_gradient(upstream_change_center,
+                                               pair_gradient, false) +
+                  this->contract_pair_gradient(upstream_center,
+                                               pair_gradient_change, false)};
+              if (is_half_list and manager->is_center_atom(neigh)) {
+                // dL/dc^{ja} and its change
+                ConstMap_t upstream_neigh(
+                    coefficients_gradient.row(j_atom).data() +
+                        feature_offsets.at(center_type),
+                    n_row, n_col);
+                ConstMap_t upstream_change_neigh(
+                    coefficients_gradient_change.row(j_atom).data() +
+                        feature_offsets.at(center_type),
+                    n_row, n_col);
+                pair_derivative_change +=
+                    this->contract_pair_gradient(upstream_change_neigh,
+                                                 pair_gradient, true) +
+                    this->contract_pair_gradient(upstream_neigh,
+                                                 pair_gradient_change, true);
+              }
+              pair_derivatives_change.row(i_pair) =
+                  pair_derivative_change.transpose();
+              ++i_pair;
+            }
+          });
+    });
+
+    Matrix_t gradients_change{Matrix_t::Zero(n_centers, ThreeD)};
+    for (size_t i_center{0}; i_center < n_centers; ++i_center) {
+      for (size_t i_pair{pair_offsets[i_center]};
+           i_pair < pair_offsets[i_center + 1]; ++i_pair) {
+        if (pair_atoms[i_pair] < n_centers) {
+          gradients_change.row(pair_atoms[i_pair]) +=
+              pair_derivatives_change.row(i_pair);
+        }
+        gradients_change.row(i_center) -= pair_derivatives_change.row(i_pair);
+      }
+    }
+    return gradients_change;
+  }
 
   template <class StructureManager>
   void CalculatorSphericalExpansion::initialize_expansion_environment_wise(
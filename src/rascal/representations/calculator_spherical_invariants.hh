@@ -36,6 +36,8 @@
 #include "rascal/representations/calculator_spherical_expansion.hh"
 #include "rascal/structure_managers/property_block_sparse.hh"
 #include "rascal/structure_managers/structure_manager.hh"
+#include "rascal/utils/parallel.hh"
+#include "rascal/utils/timer.hh"
 #include "rascal/utils/utils.hh"
 
 #include <wigxjpf.h>
@@ -46,6 +48,7 @@
 #include <algorithm>
 #include <cmath>
 #include <exception>
+#include <tuple>
 #include <unordered_set>
 #include <vector>
 
@@ -142,6 +145,20 @@ namespace rascal {
 
       return wigner_w3js;
     }
+
+    /**
+     * Work arrays, timers and counters of a thread computing the power
+     * spectrum of some of the centers of a structure.
+     */
+    struct SphericalInvariantsWorkspace {
+      //! \grad_i c^{j} of a pair of a half neighbour list
+      math::Matrix_t reverse_coefficients_gradient{};
+      //! timers and counters of the thread, flushed by the calling thread
+      TimeAccumulator power_spectrum_timer{};
+      TimeAccumulator normalize_timer{};
+      TimeAccumulator gradients_timer{};
+      LocalCounter n_centers{};
+    };
   }  // namespace internal
 
   class CalculatorSphericalInvariants : public CalculatorBase {
@@ -193,6 +210,7 @@ namespace rascal {
           normalize{std::move(other.normalize)}, compute_gradients{std::move(
                                                      other.compute_gradients)},
           inversion_symmetry{std::move(other.inversion_symmetry)},
+          n_threads{std::move(other.n_threads)},
           rep_expansion{std::move(other.rep_expansion)},
           type{std::move(other.type)}, l_factors{std::move(other.l_factors)},
           wigner_w3js{std::move(other.wigner_w3js)} {}
@@ -288,7 +306,23 @@ namespace rascal {
             ": 'PowerSpectrum', 'RadialSpectrum', or 'BiSpectrum'.");
       }
 
-      this->set_name(hypers);
+      // the number of threads does not change the representation
+      this->n_threads =
+          std::max(hypers.value("n_threads", size_t(1)), size_t(1));
+      auto name_hypers = hypers;
+      name_hypers.erase("n_threads");
+      this->set_name(name_hypers);
+    }
+
+    /**
+     * Name of the property holding, with a half neighbour list, the
+     * gradients \grad_i p^{j} of the pairs ij whose neighbour j is a center,
+     * i.e. the gradients of the pairs ji missing from the half list. They
+     * are not used by the sparse kernels, whose gradients require a full
+     * neighbour list.
+     */
+    std::string get_reverse_gradient_name() const {
+      return this->get_name() + "_reverse_gradients";
     }
 
     /**
@@ -555,6 +589,77 @@ namespace rascal {
               class StructureManager>
     void compute_impl(std::shared_ptr<StructureManager> manager);
 
+    /**
+     * Vector-Jacobian product of the power spectrum of a structure, see
+     * CalculatorSphericalExpansion::backward(). The gradient dL/dp^{i} is
+     * propagated center by center through the normalization and the power
+     * spectrum to dL/dc^{i}, which is then contracted with the gradients of
+     * the expansion pair by pair, so neither the gradients of the power
+     * spectrum nor the ones of the expansion are stored.
+     *
+     * @param soap_vectors_gradient dL/dp with the layout of the dense
+     *        feature matrix of the representation of the structure
+     *
+     * @return dL/dr_k of shape (n_centers, 3) and the virial of shape (1, 6)
+     *
+     * @throw logic_error if the representation is not the PowerSpectrum
+     * @throw runtime_error if the shape of soap_vectors_gradient does not
+     *        match the representation of the structure
+     */
+    template <class StructureManager>
+    std::tuple<math::Matrix_t, math::Matrix_t>
+    backward(std::shared_ptr<StructureManager> manager,
+             const Eigen::Ref<const math::Matrix_t> & soap_vectors_gradient);
+
+    /**
+     * Jacobian-vector product of the power spectrum of a structure: the
+     * change of the power spectrum of the centers for the displacements
+     * \delta r_k of the atoms, obtained from the change of the expansion
+     * (see CalculatorSphericalExpansion::jvp()) without storing any gradient.
+     *
+     * @param displacements \delta r_k of shape (n_centers, 3)
+     *
+     * @return the change of the representation with the layout of its dense
+     *         feature matrix
+     *
+     * @throw logic_error if the representation is not the PowerSpectrum
+     */
+    template <class StructureManager>
+    math::Matrix_t jvp(std::shared_ptr<StructureManager> manager,
+                       const Eigen::Ref<const math::Matrix_t> & displacements);
+
+    /**
+     * Change of the gradient dL/dr_k returned by backward() when the atoms
+     * are displaced by \delta r_k and dL/dp changes by \delta(dL/dp), see
+     * CalculatorSphericalExpansion::backward_jvp(). The second derivatives
+     * of the normalization and of the power spectrum are applied center by
+     * center before calling the one of the expansion.
+     *
+     * With \delta(dL/dp) = d^2L/dp^2 jvp(\delta r) it gives the
+     * Hessian-vector product of L w.r.t. the positions.
+     *
+     * @param soap_vectors_gradient dL/dp, see backward()
+     * @param soap_vectors_gradient_change \delta(dL/dp) with the same layout
+     * @param displacements \delta r_k of shape (n_centers, 3)
+     * @param fd_step step in Angstrom of the finite differences of the
+     *        gradients of the expansion, which bound the relative accuracy
+     *        to about 1e-9 with the default value, see
+     *        CalculatorSphericalExpansion::backward_jvp()
+     *
+     * @return the change of dL/dr_k of shape (n_centers, 3)
+     *
+     * @throw logic_error if the representation is not the PowerSpectrum
+     * @throw runtime_error if the shapes of the inputs do not match the
+     *        structure or if fd_step is not positive
+     */
+    template <class StructureManager>
+    math::Matrix_t backward_jvp(
+        std::shared_ptr<StructureManager> manager,
+        const Eigen::Ref<const math::Matrix_t> & soap_vectors_gradient,
+        const Eigen::Ref<const math::Matrix_t> & soap_vectors_gradient_change,
+        const Eigen::Ref<const math::Matrix_t> & displacements,
+        const double fd_step = 1e-5);
+
     //! initialize the soap vectors with only the keys needed for each center
     template <class StructureManager, class Invariants,
               class InvariantsDerivative, class ExpansionCoeff>
@@ -563,6 +668,18 @@ namespace rascal {
         ExpansionCoeff & expansions_coefficients,
         std::shared_ptr<StructureManager> manager);
 
+    /**
+     * initialize the gradients \grad_i p^{j} of the pairs ij of a half
+     * neighbour list whose neighbour j is a center, the other pairs have
+     * no keys
+     */
+    template <class StructureManager, class InvariantsDerivative,
+              class Invariants, class ExpansionCoeff>
+    void initialize_powerspectrum_reverse_gradients(
+        InvariantsDerivative & soap_vector_reverse_gradients,
+        Invariants & soap_vectors, ExpansionCoeff & expansions_coefficients,
+        std::shared_ptr<StructureManager> manager);
+
     template <class StructureManager, class Invariants,
               class InvariantsDerivative, class ExpansionCoeff>
     void initialize_per_center_radialspectrum_soap_vectors(
@@ -591,67 +708,287 @@ namespace rascal {
         PropertyGradient_t<StructureManager> & soap_vector_gradients,
         std::shared_ptr<StructureManager> manager, SpectrumNorm & inv_norms,
         const size_t & grad_component_size) {
+      // the gradients of a center only depend on its own soap vector
+      internal::parallel_for(
+          manager->size(), std::min(this->n_threads, manager->size()),
+          [&](size_t i_center, size_t) {
+            auto center_it = manager->get_iterator_at(i_center);
+            auto center = *center_it;
+            for (auto neigh : center.pairs_with_self_pair()) {
+              this->normalize_gradient(
+                  soap_vectors[center], soap_vector_gradients[neigh],
+                  inv_norms[center], grad_component_size);
+            }
+          });
+    }
+
+    /**
+     * Update one gradient \grad_k p^{i} to \grad_k \tilde{p}^{i}, see
+     * update_gradients_for_normalization().
+     *
+     * @param soap_vector the normalized soap vector \tilde{p}^{i}
+     * @param inv_norm 1 / N_i
+     */
+    template <class SoapVector, class SoapGradient>
+    static void normalize_gradient(const SoapVector & soap_vector,
+                                   SoapGradient & soap_gradient,
+                                   const double inv_norm,
+                                   const size_t grad_component_size) {
       using MapSoapGradFlat_t = Eigen::Map<
           Eigen::Matrix<double, ThreeD, Eigen::Dynamic, Eigen::RowMajor>>;
       using ConstMapSoapFlat_t = const Eigen::Map<const Eigen::VectorXd>;
-      // divide all gradients with the normalization factor N_i
-      for (auto center : manager) {
-        for (auto neigh : center.pairs_with_self_pair()) {
-          soap_vector_gradients[neigh].multiply_elements_by(inv_norms[center]);
-        }
-      }
+      // divide the gradient with the normalization factor N_i
+      soap_gradient.multiply_elements_by(inv_norm);
 
       // \tilde{p}^{i} \cdot \grad_k p^{i} / N_i
       Eigen::Vector3d soap_vector_dot_gradient{};
-
-      // compute the dot product and update the gradients to be normalized
-      for (auto center : manager) {
-        for (auto neigh : center.pairs_with_self_pair()) {
-          const auto & soap_vector = soap_vectors[center];
-          auto & soap_vector_gradients_by_neigh = soap_vector_gradients[neigh];
-          soap_vector_dot_gradient.setZero();
-          // make sure to iterate over keys that are present in both soap_vector
-          // and soap_vector_gradients_by_neigh
-          const auto keys_grad = soap_vector_gradients_by_neigh.get_keys();
-          const auto keys_intersect = soap_vector.intersection(keys_grad);
-          // compute \tilde{p}^{i} \cdot \grad_k p^{i} / N_i
-          for (const auto & key : keys_intersect) {
-            auto soap_gradient_by_species_pair =
-                soap_vector_gradients_by_neigh[key];
-            const auto & soap_vector_by_species_pair = soap_vector[key];
-            // reshape for easy dot prod
-            MapSoapGradFlat_t soap_gradient_dim_N(
-                soap_gradient_by_species_pair.data(), ThreeD,
-                grad_component_size);
-            ConstMapSoapFlat_t soap_vector_N(soap_vector_by_species_pair.data(),
-                                             grad_component_size);
-            // dot
-            soap_vector_dot_gradient += (soap_gradient_dim_N * soap_vector_N);
-          }  // for (const auto& key : keys_intersect)
-
-          // Now update each species-pair-block using the dot-product just
-          // computed
-          // for (const auto & key : keys_grad) {
-          for (const auto & key : soap_vector.get_keys()) {
-            auto soap_gradient_by_species_pair =
-                soap_vector_gradients_by_neigh[key];
-            const auto & soap_vector_by_species_pair = soap_vector[key];
-            // reshape for easy dot prod
-            MapSoapGradFlat_t soap_gradient_dim_N(
-                soap_gradient_by_species_pair.data(), ThreeD,
-                grad_component_size);
-            ConstMapSoapFlat_t soap_vector_N(soap_vector_by_species_pair.data(),
-                                             grad_component_size);
-            // compute \tilde{p}^{i} [\tilde{p}^{i} \cdot \grad_k p^{i} / N_i]
-            // as an outer product
-            soap_gradient_dim_N -=
-                soap_vector_dot_gradient * soap_vector_N.transpose();
-          }  // for (const auto& key : keys_intersect)
-        }    // (auto neigh : center.pairs_with_self_pair())
-      }      // (auto center : manager)
+      soap_vector_dot_gradient.setZero();
+      // make sure to iterate over keys that are present in both soap_vector
+      // and soap_gradient
+      const auto keys_grad = soap_gradient.get_keys();
+      const auto keys_intersect = soap_vector.intersection(keys_grad);
+      // compute \tilde{p}^{i} \cdot \grad_k p^{i} / N_i
+      for (const auto & key : keys_intersect) {
+        auto soap_gradient_by_species_pair = soap_gradient[key];
+        const auto & soap_vector_by_species_pair = soap_vector[key];
+        // reshape for easy dot prod
+        MapSoapGradFlat_t soap_gradient_dim_N(
+            soap_gradient_by_species_pair.data(), ThreeD, grad_component_size);
+        ConstMapSoapFlat_t soap_vector_N(soap_vector_by_species_pair.data(),
+                                         grad_component_size);
+        // dot
+        soap_vector_dot_gradient += (soap_gradient_dim_N * soap_vector_N);
+      }  // for (const auto& key : keys_intersect)
+
+      // Now update each species-pair-block using the dot-product just
+      // computed
+      for (const auto & key : soap_vector.get_keys()) {
+        auto soap_gradient_by_species_pair = soap_gradient[key];
+        const auto & soap_vector_by_species_pair = soap_vector[key];
+        // reshape for easy dot prod
+        MapSoapGradFlat_t soap_gradient_dim_N(
+            soap_gradient_by_species_pair.data(), ThreeD, grad_component_size);
+        ConstMapSoapFlat_t soap_vector_N(soap_vector_by_species_pair.data(),
+                                         grad_component_size);
+        // compute \tilde{p}^{i} [\tilde{p}^{i} \cdot \grad_k p^{i} / N_i]
+        // as an outer product
+        soap_gradient_dim_N -=
+            soap_vector_dot_gradient * soap_vector_N.transpose();
+      }  // for (const auto& key : soap_vector.get_keys())
     }
 
    protected:
+    /**
+     * @return the power spectrum coefficients of a pair of species, empty
+     * if the pair is not part of the (sparsified) power spectrum. Unlike
+     * coeff_indices_map[key] it never inserts so it can be used from
+     * several threads.
+     */
+    const std::vector<PowerSpectrumCoeffIndex> &
+    get_coeff_indices(const internal::SortedKey<Key_t> & spair_type) const {
+      static const std::vector<PowerSpectrumCoeffIndex> no_coeff_indices{};
+      auto it = this->coeff_indices_map.find(spair_type);
+      if (it == this->coeff_indices_map.end()) {
+        return no_coeff_indices;
+      }
+      return it->second;
+    }
+
+    /**
+     * Computes \grad_k p^{i} from the expansion c^{i} and its gradient
+     * \grad_k c^{i} and adds it to soap_gradient (which is expected to be
+     * zero initially).
+     *
+     * @param gradient_keys species a of the non zero \grad_k c^{i a}
+     * @param get_gradient callable returning \grad_k c^{i a} for a key of
+     *        gradient_keys
+     * @param coefficients c^{i}
+     * @param soap_gradient \grad_k p^{i}
+     */
+    template <class GetGradient, class Coefficients, class SoapGradient>
+    void compute_powerspectrum_gradient(
+        const std::vector<Key_t> & gradient_keys, GetGradient && get_gradient,
+        Coefficients & coefficients, SoapGradient & soap_gradient) const {
+      Key_t pair_type{0, 0};
+      internal::SortedKey<Key_t> spair_type{pair_type};
+      std::vector<Key_t> keys_coef{coefficients.get_keys()};
+
+      std::set<internal::SortedKey<Key_t>, internal::CompareSortedKeyLess>
+          grad_neigh_keys{};
+      // \grad_k p^{iab} = \grad_k c^{i a} c^{i b} + c^{i a} \grad_k c^{i b}
+      // by definition \grad_k c^{i a} is non zero for one key 'a' for k!=i
+      // so either a == b and we compute one term with a factor of 2 or only
+      // one of the two terms is non zero hence the swap of entry when
+      // spair_type[0] > spair_type[1] == true
+      for (const auto & coef_key_1 : gradient_keys) {
+        // \grad_k c^{i a}
+        auto && grad_neigh_coefficients_1{get_gradient(coef_key_1)};
+
+        for (const auto & coef_key_2 : keys_coef) {
+          // c^{i b}
+          const auto & expansion_coefficients_2{coefficients[coef_key_2]};
+          bool sorted{true}, equal{false};
+          // make sure spair_type has sorted entries
+          if (coef_key_1[0] > coef_key_2[0]) {
+            sorted = false;
+            spair_type[0] = coef_key_2[0];
+            spair_type[1] = coef_key_1[0];
+          } else if (coef_key_1[0] == coef_key_2[0]) {
+            equal = true;
+            spair_type[0] = coef_key_1[0];
+            spair_type[1] = coef_key_2[0];
+          } else {
+            spair_type[0] = coef_key_1[0];
+            spair_type[1] = coef_key_2[0];
+          }
+
+          const auto & coef_ids{this->get_coeff_indices(spair_type)};
+          if (coef_ids.empty()) {
+            continue;
+          }
+          grad_neigh_keys.insert(spair_type);
+          // \grad_k p^{i ab}
+          auto soap_neigh_gradient_by_species_pair{
+              soap_gradient[this->key_map.at(spair_type)]};
+
+          // computes  \grad_k c^{i a}_{n_1} c^{i b}_{n_2}
+          if (sorted or equal) {
+            for (size_t cartesian_idx{0}; cartesian_idx < 3; ++cartesian_idx) {
+              const size_t cartesian_offset_n{cartesian_idx * this->max_radial};
+              const size_t cartesian_offset_n1n2{
+                  cartesian_idx * this->inner_invariants_shape[0]};
+              for (const auto & coef_idx : coef_ids) {
+                // clang-format off
+                soap_neigh_gradient_by_species_pair(
+                  coef_idx.n1n2 + cartesian_offset_n1n2, coef_idx.l) +=
+                  (grad_neigh_coefficients_1.block(
+                      coef_idx.n1 + cartesian_offset_n,
+                      coef_idx.l_block_idx, 1,
+                      coef_idx.l_block_size).array() *
+                   expansion_coefficients_2.block(
+                      coef_idx.n2, coef_idx.l_block_idx,
+                      1,  coef_idx.l_block_size).array()).sum()
+                  * coef_idx.l_factor;
+                // clang-format on
+              }  // for const auto& coef_idx : coef_ids
+            }    // for cartesian_idx
+          }      // if (sorted or equal)
+
+          // computes c^{i a}_{n_1} \grad_k c^{i b}_{n_2}
+          if (not sorted or equal) {
+            for (size_t cartesian_idx{0}; cartesian_idx < 3; ++cartesian_idx) {
+              const size_t cartesian_offset_n{cartesian_idx * this->max_radial};
+              const size_t cartesian_offset_n1n2{
+                  cartesian_idx * this->inner_invariants_shape[0]};
+              for (const auto & coef_idx : coef_ids) {
+                // clang-format off
+                soap_neigh_gradient_by_species_pair(
+                  coef_idx.n1n2 + cartesian_offset_n1n2, coef_idx.l) +=
+                  (grad_neigh_coefficients_1.block(
+                        coef_idx.n2 + cartesian_offset_n,
+                        coef_idx.l_block_idx,
+                        1, coef_idx.l_block_size).array() *
+                   expansion_coefficients_2.block(
+                        coef_idx.n1, coef_idx.l_block_idx,
+                        1, coef_idx.l_block_size).array()).sum()
+                  * coef_idx.l_factor;
+                // clang-format on
+              }  // for const auto& coef_idx : coef_ids
+            }    // for cartesian_idx
+          }      // if (not sorted or equal)
+        }        // keys_coef
+      }          // gradient_keys
+
+      // multiply with \sqrt(2) factor to account
+      // for the missing (b,a) components
+      for (const auto & key : grad_neigh_keys) {
+        if (key[0] != key[1]) {
+          auto soap_neigh_gradient_by_species_pair{
+              soap_gradient[this->key_map.at(key)]};
+          const auto & coef_ids{this->get_coeff_indices(key)};
+          for (size_t cartesian_idx{0}; cartesian_idx < 3; ++cartesian_idx) {
+            const size_t cartesian_offset_n1n2{cartesian_idx *
+                                               this->inner_invariants_shape[0]};
+            for (const auto & coef_idx : coef_ids) {
+              soap_neigh_gradient_by_species_pair(
+                  coef_idx.n1n2 + cartesian_offset_n1n2, coef_idx.l) *=
+                  math::SQRT_TWO;
+            }
+          }
+        }
+      }
+    }
+
+    /**
+     * @return the change \delta p^{i} of the power spectrum (before
+     * normalization) of the centers for the change \delta c^{i} of their
+     * expansion, both with the layout of the dense feature matrices
+     */
+    template <class StructureManager>
+    math::Matrix_t
+    compute_powerspectrum_change(std::shared_ptr<StructureManager> manager,
+                                 const math::Matrix_t & coefficients_change);
+
+    /**
+     * Calls function(spair_type, el1, el2, coef_ids, prefactor) for the
+     * pairs of species a <= b of the expansion c^{i} that are part of the
+     * power spectrum p^{iab}, where el1 and el2 are the (key, block) of
+     * c^{ia} and c^{ib} and prefactor the \sqrt(2) factor accounting for the
+     * missing (b,a) components.
+     */
+    template <class Coefficients, class Function>
+    void for_each_powerspectrum_block(Coefficients & coefficients,
+                                      Function && function) const {
+      Key_t pair_type{0, 0};
+      internal::SortedKey<Key_t> spair_type{pair_type};
+      for (const auto & el1 : coefficients) {
+        spair_type[0] = el1.first[0];
+        for (const auto & el2 : coefficients) {
+          if (spair_type[0] > el2.first[0]) {
+            continue;
+          }
+          spair_type[1] = el2.first[0];
+          const auto & coef_ids{this->get_coeff_indices(spair_type)};
+          if (coef_ids.empty()) {
+            continue;
+          }
+          const double prefactor{spair_type[0] < spair_type[1]
+                                     ? math::SQRT_TWO
+                                     : 1.};
+          function(spair_type, el1, el2, coef_ids, prefactor);
+        }
+      }
+    }
+
+    /**
+     * @return the norm of the power spectrum p^{i} of the expansion c^{i}
+     * (before normalization)
+     */
+    template <class Coefficients>
+    double compute_powerspectrum_norm(Coefficients & coefficients) const {
+      double norm2{0.};
+      this->for_each_powerspectrum_block(
+          coefficients,
+          [&norm2](const internal::SortedKey<Key_t> &, const auto & el1,
+                   const auto & el2, const auto & coef_ids,
+                   const double prefactor) {
+            for (const auto & coef_idx : coef_ids) {
+              const double value{(el1.second
+                                      .block(coef_idx.n1, coef_idx.l_block_idx,
+                                             1, coef_idx.l_block_size)
+                                      .array() *
+                                  el2.second
+                                      .block(coef_idx.n2, coef_idx.l_block_idx,
+                                             1, coef_idx.l_block_size)
+                                      .array())
+                                     .sum() *
+                                 coef_idx.l_factor * prefactor};
+              norm2 += value * value;
+            }
+          });
+      return std::sqrt(norm2);
+    }
+
     size_t max_radial{};
     size_t max_angular{};
     // shape of the inner dense section of the computed invariant coefficients
@@ -659,6 +996,8 @@ namespace rascal {
     bool normalize{};
     bool compute_gradients{};
     bool inversion_symmetry{false};
+    //! number of threads computing the centers of a structure
+    size_t n_threads{1};
 
     CalculatorSphericalExpansion rep_expansion;
 
@@ -706,7 +1045,11 @@ namespace rascal {
     using PropGrad_t = PropertyGradient_t<StructureManager>;
     using internal::SphericalInvariantsType;
     using math::pow;
+    constexpr static bool IsHalfNL{
+        StructureManager::traits::NeighbourListType ==
+        AdaptorTraits::NeighbourListType::half};
 
+    RASCAL_TIMER("SphericalInvariants::compute");
     // Compute the spherical expansions of the current structure
     rep_expansion.compute(manager);
 
@@ -731,22 +1074,57 @@ namespace rascal {
       return;
     }
 
-    this->initialize_per_center_powerspectrum_soap_vectors(
-        soap_vectors, soap_vector_gradients, expansions_coefficients, manager);
-
-    Key_t pair_type{0, 0};
-    // use special container to tell that there is not need to sort when
-    // using operator[] of soap_vector
-    internal::SortedKey<Key_t> spair_type{pair_type};
+    // when the expansion has been updated incrementally only the centers
+    // whose expansion changed need to be recomputed, with the gradients the
+    // pairs of the neighbour list might have changed so everything is
+    // recomputed
+    const auto * incremental_state{
+        this->rep_expansion.get_incremental_state(manager)};
+    const bool update_changed_centers_only{
+        incremental_state != nullptr and
+        incremental_state->last_update_incremental and
+        (not this->compute_gradients) and
+        soap_vectors.size() == manager->size()};
+
+    if (not update_changed_centers_only) {
+      RASCAL_TIMER("initialize");
+      this->initialize_per_center_powerspectrum_soap_vectors(
+          soap_vectors, soap_vector_gradients, expansions_coefficients,
+          manager);
+    }
 
     // to store the norm of the soap vectors
     SpectrumNorm_t<StructureManager> soap_vector_norm_inv{
         *manager, "power spectrums inverse norms", true};
     soap_vector_norm_inv.resize();
 
-    for (auto center : manager) {
+    // the centers are independent so they are split between the threads,
+    // every thread only writes to the entries of its centers and of their
+    // pairs
+    const size_t n_centers{manager->size()};
+    const size_t n_threads{
+        std::max(std::min(this->n_threads, n_centers), size_t(1))};
+    std::vector<internal::SphericalInvariantsWorkspace> workspaces(n_threads);
+
+    RASCAL_TIMER("invariants");
+    auto compute_center = [&](auto & center, const size_t i_center,
+                              const size_t i_thread) {
+      auto & work = workspaces[i_thread];
+      (void)work;  // to avoid compiler warning without timers
+      if (update_changed_centers_only) {
+        if (not incremental_state->center_changed[i_center]) {
+          return;
+        }
+        soap_vectors[center].get_full_vector().setZero();
+      }
+      RASCAL_LOCAL_COUNTER_ADD(work.n_centers, 1);
+      Key_t pair_type{0, 0};
+      // use special container to tell that there is not need to sort when
+      // using operator[] of soap_vector
+      internal::SortedKey<Key_t> spair_type{pair_type};
       auto & coefficients{expansions_coefficients[center]};
       auto & soap_vector{soap_vectors[center]};
+      RASCAL_FINE_TIMER_START(work.power_spectrum_timer);
       // Compute the Powerspectrum coefficients
       for (const auto & el1 : coefficients) {
         spair_type[0] = el1.first[0];
@@ -760,8 +1138,12 @@ namespace rascal {
 
           spair_type[1] = el2.first[0];
           auto & coef2{el2.second};
-          auto && soap_vector_by_pair{soap_vector[this->key_map[spair_type]]};
-          const auto & coef_ids{coeff_indices_map[spair_type]};
+          const auto & coef_ids{this->get_coeff_indices(spair_type)};
+          if (coef_ids.empty()) {
+            continue;
+          }
+          auto && soap_vector_by_pair{
+              soap_vector[this->key_map.at(spair_type)]};
           for (const auto & coef_idx : coef_ids) {
             // the Powerspectrum coefficient and
             // multiply with the constant 1 / \sqrt(2l+1)
@@ -786,150 +1168,538 @@ namespace rascal {
           }
         }  // for el1 : coefficients
       }    // for el2 : coefficients
+      RASCAL_FINE_TIMER_STOP(work.power_spectrum_timer);
 
       // normalize the soap vector
       if (this->normalize) {
+        RASCAL_FINE_TIMER_START(work.normalize_timer);
         double norm_inv{1. / soap_vector.normalize_and_get_norm()};
         soap_vector_norm_inv[center] = norm_inv;
+        RASCAL_FINE_TIMER_STOP(work.normalize_timer);
       }
 
       if (this->compute_gradients) {
-        // const int atom_i_tag{center.get_atom_tag()};
-        // c^{i}
-        auto & coefficients{expansions_coefficients[center]};
-        std::vector<Key_t> keys_coef{coefficients.get_keys()};
-
+        RASCAL_FINE_TIMER_START(work.gradients_timer);
         // Sum the gradients wrt the neighbour atom position
         // compute the \grad_k p^{i} coeffs where k is either i or j
         for (auto neigh : center.pairs_with_self_pair()) {
           // \grad_k c^{i}
           auto & grad_neigh_coefficients{
               expansions_coefficients_gradient[neigh]};
-          std::vector<Key_t> keys_coef_grad_neigh{
-              grad_neigh_coefficients.get_keys()};
-          // \grad_k p^{i}
-          auto & soap_neigh_gradient{soap_vector_gradients[neigh]};
-
-          std::set<internal::SortedKey<Key_t>, internal::CompareSortedKeyLess>
-              grad_neigh_keys{};
-          // \grad_k p^{iab} = \grad_k c^{i a} c^{i b} + c^{i a} \grad_k c^{i b}
-          // by definition \grad_k c^{i a} is non zero for one key 'a' for k!=i
-          // so either a == b and we compute one term with a factor of 2 or only
-          // one of the two terms is non zero hence the swap of entry when
-          // spair_type[0] > spair_type[1] == true
-          for (const auto & coef_key_1 : keys_coef_grad_neigh) {
-            // \grad_k c^{i a}
-            const auto & grad_neigh_coefficients_1{
-                grad_neigh_coefficients[coef_key_1]};
-
-            for (const auto & coef_key_2 : keys_coef) {
-              // c^{i b}
-              const auto & expansion_coefficients_2{coefficients[coef_key_2]};
-              bool sorted{true}, equal{false};
-              // make sure spair_type has sorted entries
-              if (coef_key_1[0] > coef_key_2[0]) {
-                sorted = false;
-                spair_type[0] = coef_key_2[0];
-                spair_type[1] = coef_key_1[0];
-              } else if (coef_key_1[0] == coef_key_2[0]) {
-                equal = true;
-                spair_type[0] = coef_key_1[0];
-                spair_type[1] = coef_key_2[0];
-              } else {
-                spair_type[0] = coef_key_1[0];
-                spair_type[1] = coef_key_2[0];
-              }
-
-              grad_neigh_keys.insert(spair_type);
-              // \grad_k p^{i ab}
-              auto soap_neigh_gradient_by_species_pair{
-                  soap_neigh_gradient[this->key_map[spair_type]]};
-              const auto & coef_ids{coeff_indices_map[spair_type]};
-
-              // computes  \grad_k c^{i a}_{n_1} c^{i b}_{n_2}
-              if (sorted or equal) {
-                for (size_t cartesian_idx{0}; cartesian_idx < 3;
-                     ++cartesian_idx) {
-                  const size_t cartesian_offset_n{cartesian_idx *
-                                                  this->max_radial};
-                  const size_t cartesian_offset_n1n2{
-                      cartesian_idx * this->inner_invariants_shape[0]};
-                  for (const auto & coef_idx : coef_ids) {
-                    // clang-format off
-                    soap_neigh_gradient_by_species_pair(
-                      coef_idx.n1n2 + cartesian_offset_n1n2, coef_idx.l) +=
-                      (grad_neigh_coefficients_1.block(
-                          coef_idx.n1 + cartesian_offset_n,
-                          coef_idx.l_block_idx, 1,
-                          coef_idx.l_block_size).array() *
-                       expansion_coefficients_2.block(
-                          coef_idx.n2, coef_idx.l_block_idx,
-                          1,  coef_idx.l_block_size).array()).sum()
-                      * coef_idx.l_factor;
-                    // clang-format on
-                  }  // for const auto& coef_idx : coef_ids
-                }    // for cartesian_idx
-              }      // if (sorted or equal)
-
-              // computes c^{i a}_{n_1} \grad_k c^{i b}_{n_2}
-              if (not sorted or equal) {
-                for (size_t cartesian_idx{0}; cartesian_idx < 3;
-                     ++cartesian_idx) {
-                  const size_t cartesian_offset_n{cartesian_idx *
-                                                  this->max_radial};
-                  const size_t cartesian_offset_n1n2{
-                      cartesian_idx * this->inner_invariants_shape[0]};
-                  for (const auto & coef_idx : coef_ids) {
-                    // clang-format off
-                    soap_neigh_gradient_by_species_pair(
-                      coef_idx.n1n2 + cartesian_offset_n1n2, coef_idx.l) +=
-                      (grad_neigh_coefficients_1.block(
-                            coef_idx.n2 + cartesian_offset_n,
-                            coef_idx.l_block_idx,
-                            1, coef_idx.l_block_size).array() *
-                       expansion_coefficients_2.block(
-                            coef_idx.n1, coef_idx.l_block_idx,
-                            1, coef_idx.l_block_size).array()).sum()
-                      * coef_idx.l_factor;
-                    // clang-format on
-                  }  // for const auto& coef_idx : coef_ids
-                }    // for cartesian_idx
-              }      // if (not sorted or equal)
-            }        // keys_coef
-          }          // keys_coef_grad_neigh
-
-          // multiply with \sqrt(2) factor to account
-          // for the missing (b,a) components
-          for (const auto & key : grad_neigh_keys) {
-            if (key[0] != key[1]) {
-              auto soap_neigh_gradient_by_species_pair{
-                  soap_neigh_gradient[this->key_map[key]]};
-              const auto & coef_ids{coeff_indices_map[key]};
-              for (size_t cartesian_idx{0}; cartesian_idx < 3;
-                   ++cartesian_idx) {
-                const size_t cartesian_offset_n1n2{
-                    cartesian_idx * this->inner_invariants_shape[0]};
-                for (const auto & coef_idx : coef_ids) {
-                  soap_neigh_gradient_by_species_pair(
-                      coef_idx.n1n2 + cartesian_offset_n1n2, coef_idx.l) *=
-                      math::SQRT_TWO;
-                }
-              }
-            }
-          }
+          this->compute_powerspectrum_gradient(
+              grad_neigh_coefficients.get_keys(),
+              [&grad_neigh_coefficients](const Key_t & key) {
+                return grad_neigh_coefficients[key];
+              },
+              coefficients, soap_vector_gradients[neigh]);
         }  // for neigh : center
-      }    // if compute gradients
-    }      // for center : manager
+        RASCAL_FINE_TIMER_STOP(work.gradients_timer);
+      }  // if compute gradients
+    };   // compute_center
 
+    if (n_threads == 1) {
+      size_t i_center{0};
+      for (auto center : manager) {
+        compute_center(center, i_center, 0);
+        ++i_center;
+      }
+    } else {
+      internal::parallel_for(
+          n_centers, n_threads, [&](size_t i_center, size_t i_thread) {
+            auto center_it = manager->get_iterator_at(i_center);
+            auto center = *center_it;
+            compute_center(center, i_center, i_thread);
+          });
+    }
+    for (auto & work : workspaces) {
+      (void)work;
+      RASCAL_FINE_TIMER_FLUSH(work.power_spectrum_timer, "power_spectrum");
+      RASCAL_FINE_TIMER_FLUSH(work.normalize_timer, "normalize");
+      RASCAL_FINE_TIMER_FLUSH(work.gradients_timer, "gradients");
+      RASCAL_LOCAL_COUNTER_FLUSH(work.n_centers,
+                                 "SphericalInvariants::centers");
+    }
+
+    const size_t grad_component_size{this->inner_invariants_shape[0] *
+                                     this->inner_invariants_shape[1]};
     if (this->normalize and this->compute_gradients) {
-      const size_t grad_component_size{this->inner_invariants_shape[0] *
-                                       this->inner_invariants_shape[1]};
+      RASCAL_TIMER("normalize_gradients");
       this->update_gradients_for_normalization(
           soap_vectors, soap_vector_gradients, manager, soap_vector_norm_inv,
           grad_component_size);
     }  // if normalize and compute_gradients
+
+    if (IsHalfNL and this->compute_gradients) {
+      RASCAL_TIMER("reverse_gradients");
+      auto && soap_vector_reverse_gradients{
+          *manager->template get_property<PropGrad_t>(
+              this->get_reverse_gradient_name(), true, true)};
+      this->initialize_powerspectrum_reverse_gradients(
+          soap_vector_reverse_gradients, soap_vectors, expansions_coefficients,
+          manager);
+      /*
+       * With a half neighbour list the pair ji of a pair ij between two
+       * centers is missing, so \grad_i p^{j} is computed from the gradient
+       * of the pair ij using \grad_i c^{ji}_{nlm} = -(-1)^l \grad_j
+       * c^{ij}_{nlm}. It needs the final c^{j} and p^{j} so it is computed
+       * once all the centers are done.
+       */
+      internal::parallel_for(
+          n_centers, n_threads, [&](size_t i_center, size_t i_thread) {
+            auto & work = workspaces[i_thread];
+            auto center_it = manager->get_iterator_at(i_center);
+            auto center = *center_it;
+            const int atom_i_tag{center.get_atom_tag()};
+            const Key_t center_type{center.get_atom_type()};
+            for (auto neigh : center.pairs_with_self_pair()) {
+              if (neigh.get_atom_tag() == atom_i_tag or
+                  not manager->is_center_atom(neigh)) {
+                continue;
+              }
+              auto atom_j = neigh.get_atom_j();
+              const Key_t neigh_type{neigh.get_atom_type()};
+              // \grad_i c^{j a} = -(-1)^l \grad_j c^{ij b}
+              auto && gradient_pair_by_type{
+                  expansions_coefficients_gradient[neigh][neigh_type]};
+              auto & reverse_gradient = work.reverse_coefficients_gradient;
+              reverse_gradient = -gradient_pair_by_type;
+              size_t l_block_idx{0};
+              for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+                   ++angular_l) {
+                const size_t l_block_size{2 * angular_l + 1};
+                if (angular_l % 2 == 1) {
+                  reverse_gradient.middleCols(l_block_idx, l_block_size) *=
+                      -1.;
+                }
+                l_block_idx += l_block_size;
+              }
+              auto & soap_reverse_gradient{
+                  soap_vector_reverse_gradients[neigh]};
+              this->compute_powerspectrum_gradient(
+                  std::vector<Key_t>{center_type},
+                  [&reverse_gradient](const Key_t &) -> const math::Matrix_t & {
+                    return reverse_gradient;
+                  },
+                  expansions_coefficients[atom_j], soap_reverse_gradient);
+              if (this->normalize) {
+                this->normalize_gradient(
+                    soap_vectors[atom_j], soap_reverse_gradient,
+                    soap_vector_norm_inv[atom_j], grad_component_size);
+              }
+            }
+          });
+    }  // if IsHalfNL and compute_gradients
   }    // compute_powerspectrum()
 
+  template <class StructureManager>
+  std::tuple<math::Matrix_t, math::Matrix_t>
+  CalculatorSphericalInvariants::backward(
+      std::shared_ptr<StructureManager> manager,
+      const Eigen::Ref<const math::Matrix_t> & soap_vectors_gradient) {
+    using PropExp_t =
+        typename CalculatorSphericalExpansion::Property_t<StructureManager>;
+    using Prop_t = Property_t<StructureManager>;
+    using Map_t = Eigen::Map<math::Matrix_t>;
+    using ConstMap_t = Eigen::Map<const math::Matrix_t>;
+    if (this->type != internal::SphericalInvariantsType::PowerSpectrum) {
+      throw std::logic_error(
+          "backward() is only implemented for the PowerSpectrum.");
+    }
+    this->compute(manager);
+    RASCAL_TIMER("SphericalInvariants::backward");
+    constexpr bool ExcludeGhosts{true};
+    auto && expansions_coefficients{*manager->template get_property<PropExp_t>(
+        rep_expansion.get_name(), true, true, ExcludeGhosts)};
+    auto && soap_vectors{*manager->template get_property<Prop_t>(
+        this->get_name(), true, true, ExcludeGhosts)};
+    internal::check_feature_matrix_shape(soap_vectors, soap_vectors_gradient,
+                                         "soap_vectors_gradient");
+    const auto soap_offsets{soap_vectors.get_feature_offsets()};
+    const auto expansion_offsets{expansions_coefficients.get_feature_offsets()};
+    const size_t n_centers{manager->size()};
+    const size_t n_threads{
+        std::max(std::min(this->n_threads, n_centers), size_t(1))};
+    const auto & shape{this->inner_invariants_shape};
+    const size_t n_row{this->max_radial};
+    const size_t n_col{math::pow(this->max_angular + 1, 2_size_t)};
+
+    // dL/dc^{i}
+    math::Matrix_t coefficients_gradient{math::Matrix_t::Zero(
+        n_centers, expansion_offsets.size() * n_row * n_col)};
+    internal::parallel_for(
+        n_centers, n_threads, [&](size_t i_center, size_t) {
+          auto center_it = manager->get_iterator_at(i_center);
+          auto center = *center_it;
+          auto & coefficients{expansions_coefficients[center]};
+          auto & soap_vector{soap_vectors[center]};
+          auto upstream = [&](const Key_t & key) {
+            return ConstMap_t(soap_vectors_gradient.row(i_center).data() +
+                                  soap_offsets.at(key),
+                              shape[0], shape[1]);
+          };
+          // with the normalization \tilde{p}^{i} = p^{i} / N_i
+          // dL/dp^{i} = (dL/d\tilde{p}^{i} - \tilde{p}^{i} [\tilde{p}^{i}
+          // \cdot dL/d\tilde{p}^{i}]) / N_i
+          double inv_norm{1.};
+          double soap_vector_dot_upstream{0.};
+          if (this->normalize) {
+            inv_norm = 1. / this->compute_powerspectrum_norm(coefficients);
+            for (const auto & key : soap_vector.get_keys()) {
+              soap_vector_dot_upstream +=
+                  (soap_vector[key].array() * upstream(key).array()).sum();
+            }
+          }
+          this->for_each_powerspectrum_block(
+              coefficients,
+              [&](const internal::SortedKey<Key_t> & spair_type,
+                  const auto & el1, const auto & el2, const auto & coef_ids,
+                  const double prefactor) {
+                const Key_t & soap_key{this->key_map.at(spair_type).get_key()};
+                const auto & upstream_by_pair{upstream(soap_key)};
+                const auto & soap_vector_by_pair{soap_vector[soap_key]};
+                // dL/dc^{ia} and dL/dc^{ib}
+                Map_t gradient_1(coefficients_gradient.row(i_center).data() +
+                                     expansion_offsets.at(el1.first),
+                                 n_row, n_col);
+                Map_t gradient_2(coefficients_gradient.row(i_center).data() +
+                                     expansion_offsets.at(el2.first),
+                                 n_row, n_col);
+                for (const auto & coef_idx : coef_ids) {
+                  double weight{upstream_by_pair(coef_idx.n1n2, coef_idx.l)};
+                  if (this->normalize) {
+                    weight -= soap_vector_by_pair(coef_idx.n1n2, coef_idx.l) *
+                              soap_vector_dot_upstream;
+                  }
+                  weight *= inv_norm * coef_idx.l_factor * prefactor;
+                  // p^{iab}_{n1n2l} \propto \sum_m c^{ia}_{n1lm} c^{ib}_{n2lm}
+                  gradient_1.block(coef_idx.n1, coef_idx.l_block_idx, 1,
+                                   coef_idx.l_block_size) +=
+                      weight * el2.second.block(coef_idx.n2,
+                                                coef_idx.l_block_idx, 1,
+                                                coef_idx.l_block_size);
+                  gradient_2.block(coef_idx.n2, coef_idx.l_block_idx, 1,
+                                   coef_idx.l_block_size) +=
+                      weight * el1.second.block(coef_idx.n1,
+                                                coef_idx.l_block_idx, 1,
+                                                coef_idx.l_block_size);
+                }
+              });
+        });
+    return this->rep_expansion.backward(manager, coefficients_gradient);
+  }
+
+  template <class StructureManager>
+  math::Matrix_t CalculatorSphericalInvariants::jvp(
+      std::shared_ptr<StructureManager> manager,
+      const Eigen::Ref<const math::Matrix_t> & displacements) {
+    using PropExp_t =
+        typename CalculatorSphericalExpansion::Property_t<StructureManager>;
+    using Prop_t = Property_t<StructureManager>;
+    using Map_t = Eigen::Map<math::Matrix_t>;
+    if (this->type != internal::SphericalInvariantsType::PowerSpectrum) {
+      throw std::logic_error(
+          "jvp() is only implemented for the PowerSpectrum.");
+    }
+    this->compute(manager);
+    // \delta c^{i}
+    const math::Matrix_t coefficients_change{
+        this->rep_expansion.jvp(manager, displacements)};
+    // \delta p^{i}
+    math::Matrix_t soap_vectors_change{
+        this->compute_powerspectrum_change(manager, coefficients_change)};
+    if (not this->normalize) {
+      return soap_vectors_change;
+    }
+    RASCAL_TIMER("SphericalInvariants::jvp");
+    constexpr bool ExcludeGhosts{true};
+    auto && expansions_coefficients{*manager->template get_property<PropExp_t>(
+        rep_expansion.get_name(), true, true, ExcludeGhosts)};
+    auto && soap_vectors{*manager->template get_property<Prop_t>(
+        this->get_name(), true, true, ExcludeGhosts)};
+    const auto soap_offsets{soap_vectors.get_feature_offsets()};
+    const size_t n_centers{manager->size()};
+    const size_t n_threads{
+        std::max(std::min(this->n_threads, n_centers), size_t(1))};
+    const auto & shape{this->inner_invariants_shape};
+    internal::parallel_for(
+        n_centers, n_threads, [&](size_t i_center, size_t) {
+          auto center_it = manager->get_iterator_at(i_center);
+          auto center = *center_it;
+          auto & coefficients{expansions_coefficients[center]};
+          auto & soap_vector{soap_vectors[center]};
+          auto change = [&](const Key_t & key) {
+            return Map_t(soap_vectors_change.row(i_center).data() +
+                             soap_offsets.at(key),
+                         shape[0], shape[1]);
+          };
+          // \delta \tilde{p}^{i} = (\delta p^{i} - \tilde{p}^{i}
+          // [\tilde{p}^{i} \cdot \delta p^{i}]) / N_i
+          const double inv_norm{
+              1. / this->compute_powerspectrum_norm(coefficients)};
+          const auto keys{soap_vector.get_keys()};
+          double soap_vector_dot_change{0.};
+          for (const auto & key : keys) {
+            soap_vector_dot_change +=
+                (soap_vector[key].array() * change(key).array()).sum();
+          }
+          for (const auto & key : keys) {
+            auto change_by_pair{change(key)};
+            change_by_pair -= soap_vector_dot_change * soap_vector[key];
+            change_by_pair *= inv_norm;
+          }
+        });
+    return soap_vectors_change;
+  }
+
+  template <class StructureManager>
+  math::Matrix_t CalculatorSphericalInvariants::backward_jvp(
+      std::shared_ptr<StructureManager> manager,
+      const Eigen::Ref<const math::Matrix_t> & soap_vectors_gradient,
+      const Eigen::Ref<const math::Matrix_t> & soap_vectors_gradient_change,
+      const Eigen::Ref<const math::Matrix_t> & displacements,
+      const double fd_step) {
+    using PropExp_t =
+        typename CalculatorSphericalExpansion::Property_t<StructureManager>;
+    using Prop_t = Property_t<StructureManager>;
+    using Map_t = Eigen::Map<math::Matrix_t>;
+    using ConstMap_t = Eigen::Map<const math::Matrix_t>;
+    if (this->type != internal::SphericalInvariantsType::PowerSpectrum) {
+      throw std::logic_error(
+          "backward_jvp() is only implemented for the PowerSpectrum.");
+    }
+    this->compute(manager);
+    constexpr bool ExcludeGhosts{true};
+    auto && expansions_coefficients{*manager->template get_property<PropExp_t>(
+        rep_expansion.get_name(), true, true, ExcludeGhosts)};
+    auto && soap_vectors{*manager->template get_property<Prop_t>(
+        this->get_name(), true, true, ExcludeGhosts)};
+    internal::check_feature_matrix_shape(soap_vectors, soap_vectors_gradient,
+                                         "soap_vectors_gradient");
+    internal::check_feature_matrix_shape(soap_vectors,
+                                         soap_vectors_gradient_change,
+                                         "soap_vectors_gradient_change");
+    // \delta c^{i} and \delta p^{i}
+    const math::Matrix_t coefficients_change{
+        this->rep_expansion.jvp(manager, displacements)};
+    const math::Matrix_t powerspectrum_change{
+        this->compute_powerspectrum_change(manager, coefficients_change)};
+    RASCAL_TIMER("SphericalInvariants::backward_jvp");
+    const auto soap_offsets{soap_vectors.get_feature_offsets()};
+    const auto expansion_offsets{expansions_coefficients.get_feature_offsets()};
+    const size_t n_centers{manager->size()};
+    const size_t n_threads{
+        std::max(std::min(this->n_threads, n_centers), size_t(1))};
+    const auto & shape{this->inner_invariants_shape};
+    const size_t n_row{this->max_radial};
+    const size_t n_col{math::pow(this->max_angular + 1, 2_size_t)};
+
+    // dL/dc^{i} and its change
+    math::Matrix_t coefficients_gradient{math::Matrix_t::Zero(
+        n_centers, expansion_offsets.size() * n_row * n_col)};
+    math::Matrix_t coefficients_gradient_change{
+        math::Matrix_t::Zero(coefficients_gradient.rows(),
+                             coefficients_gradient.cols())};
+    internal::parallel_for(
+        n_centers, n_threads, [&](size_t i_center, size_t) {
+          auto center_it = manager->get_iterator_at(i_center);
+          auto center = *center_it;
+          auto & coefficients{expansions_coefficients[center]};
+          auto & soap_vector{soap_vectors[center]};
+          auto by_key = [&](const auto & features, const Key_t & key) {
+            return ConstMap_t(features.row(i_center).data() +
+                                  soap_offsets.at(key),
+                              shape[0], shape[1]);
+          };
+          /*
+           * With the normalization \tilde{p} = p / N, s = \tilde{p} \cdot
+           * dL/d\tilde{p} and \delta N = \tilde{p} \cdot \delta p:
+           * dL/dp = (dL/d\tilde{p} - \tilde{p} s) / N
+           * \delta(dL/dp) = (\delta(dL/d\tilde{p}) - \delta\tilde{p} s -
+           *                  \tilde{p} \delta s - dL/dp \delta N) / N
+           */
+          double inv_norm{1.};
+          double soap_vector_dot_upstream{0.};
+          double norm_change{0.};
+          double soap_vector_dot_upstream_change{0.};
+          if (this->normalize) {
+            inv_norm = 1. / this->compute_powerspectrum_norm(coefficients);
+            const auto keys{soap_vector.get_keys()};
+            for (const auto & key : keys) {
+              norm_change += (soap_vector[key].array() *
+                              by_key(powerspectrum_change, key).array())
+                                 .sum();
+              soap_vector_dot_upstream +=
+                  (soap_vector[key].array() *
+                   by_key(soap_vectors_gradient, key).array())
+                      .sum();
+            }
+            for (const auto & key : keys) {
+              soap_vector_dot_upstream_change +=
+                  ((by_key(powerspectrum_change, key) -
+                    norm_change * soap_vector[key])
+                       .array() *
+                   by_key(soap_vectors_gradient, key).array())
+                          .sum() *
+                      inv_norm +
+                  (soap_vector[key].array() *
+                   by_key(soap_vectors_gradient_change, key).array())
+                      .sum();
+            }
+          }
+          this->for_each_powerspectrum_block(
+              coefficients,
+              [&](const internal::SortedKey<Key_t> & spair_type,
+                  const auto & el1, const auto & el2, const auto & coef_ids,
+                  const double prefactor) {
+                const Key_t & soap_key{this->key_map.at(spair_type).get_key()};
+                const auto & upstream{by_key(soap_vectors_gradient, soap_key)};
+                const auto & upstream_change{
+                    by_key(soap_vectors_gradient_change, soap_key)};
+                const auto & change_by_pair{
+                    by_key(powerspectrum_change, soap_key)};
+                const auto & soap_vector_by_pair{soap_vector[soap_key]};
+                auto map = [&](math::Matrix_t & features, const Key_t & key) {
+                  return Map_t(features.row(i_center).data() +
+                                   expansion_offsets.at(key),
+                               n_row, n_col);
+                };
+                auto gradient_1{map(coefficients_gradient, el1.first)};
+                auto gradient_2{map(coefficients_gradient, el2.first)};
+                auto gradient_change_1{
+                    map(coefficients_gradient_change, el1.first)};
+                auto gradient_change_2{
+                    map(coefficients_gradient_change, el2.first)};
+                // \delta c^{ia} and \delta c^{ib}
+                ConstMap_t change_1(coefficients_change.row(i_center).data() +
+                                        expansion_offsets.at(el1.first),
+                                    n_row, n_col);
+                ConstMap_t change_2(coefficients_change.row(i_center).data() +
+                                        expansion_offsets.at(el2.first),
+                                    n_row, n_col);
+                for (const auto & coef_idx : coef_ids) {
+                  double weight{upstream(coef_idx.n1n2, coef_idx.l)};
+                  double weight_change{
+                      upstream_change(coef_idx.n1n2, coef_idx.l)};
+                  if (this->normalize) {
+                    const double value{
+                        soap_vector_by_pair(coef_idx.n1n2, coef_idx.l)};
+                    const double value_change{
+                        (change_by_pair(coef_idx.n1n2, coef_idx.l) -
+                         value * norm_change) *
+                        inv_norm};
+                    weight = (weight - value * soap_vector_dot_upstream) *
+                             inv_norm;
+                    weight_change =
+                        (weight_change -
+                         value_change * soap_vector_dot_upstream -
+                         value * soap_vector_dot_upstream_change -
+                         weight * norm_change) *
+                        inv_norm;
+                  }
+                  weight *= coef_idx.l_factor * prefactor;
+                  weight_change *= coef_idx.l_factor * prefactor;
+                  // clang-format off
+                  const auto coefficients_1{el1.second.block(
+                      coef_idx.n1, coef_idx.l_block_idx,
+                      1, coef_idx.l_block_size)};
+                  const auto coefficients_2{el2.second.block(
+                      coef_idx.n2, coef_idx.l_block_idx,
+                      1, coef_idx.l_block_size)};
+                  gradient_1.block(coef_idx.n1, coef_idx.l_block_idx,
+                                   1, coef_idx.l_block_size) +=
+                      weight * coefficients_2;
+                  gradient_2.block(coef_idx.n2, coef_idx.l_block_idx,
+                                   1, coef_idx.l_block_size) +=
+                      weight * coefficients_1;
+                  gradient_change_1.block(coef_idx.n1, coef_idx.l_block_idx,
+                                          1, coef_idx.l_block_size) +=
+                      weight_change * coefficients_2 +
+                      weight * change_2.block(coef_idx.n2,
+                                              coef_idx.l_block_idx,
+                                              1, coef_idx.l_block_size);
+                  gradient_change_2.block(coef_idx.n2, coef_idx.l_block_idx,
+                                          1, coef_idx.l_block_size) +=
+                      weight_change * coefficients_1 +
+                      weight * change_1.block(coef_idx.n1,
+                                              coef_idx.l_block_idx,
+                                              1, coef_idx.l_block_size);
+                  // clang-format on
+                }
+              });
+        });
+    return this->rep_expansion.backward_jvp(manager, coefficients_gradient,
+                                            coefficients_gradient_change,
+                                            displacements, fd_step);
+  }
+
+  template <class StructureManager>
+  math::Matrix_t CalculatorSphericalInvariants::compute_powerspectrum_change(
+      std::shared_ptr<StructureManager> manager,
+      const math::Matrix_t & coefficients_change) {
+    using PropExp_t =
+        typename CalculatorSphericalExpansion::Property_t<StructureManager>;
+    using Prop_t = Property_t<StructureManager>;
+    using Map_t = Eigen::Map<math::Matrix_t>;
+    using ConstMap_t = Eigen::Map<const math::Matrix_t>;
+    RASCAL_TIMER("SphericalInvariants::compute_powerspectrum_change");
+    constexpr bool ExcludeGhosts{true};
+    auto && expansions_coefficients{*manager->template get_property<PropExp_t>(
+        rep_expansion.get_name(), true, true, ExcludeGhosts)};
+    auto && soap_vectors{*manager->template get_property<Prop_t>(
+        this->get_name(), true, true, ExcludeGhosts)};
+    const auto soap_offsets{soap_vectors.get_feature_offsets()};
+    const auto expansion_offsets{expansions_coefficients.get_feature_offsets()};
+    const size_t n_centers{manager->size()};
+    const size_t n_threads{
+        std::max(std::min(this->n_threads, n_centers), size_t(1))};
+    const auto & shape{this->inner_invariants_shape};
+    const size_t n_row{this->max_radial};
+    const size_t n_col{math::pow(this->max_angular + 1, 2_size_t)};
+
+    math::Matrix_t soap_vectors_change{math::Matrix_t::Zero(
+        n_centers, soap_offsets.size() * shape[0] * shape[1])};
+    internal::parallel_for(
+        n_centers, n_threads, [&](size_t i_center, size_t) {
+          auto center_it = manager->get_iterator_at(i_center);
+          auto center = *center_it;
+          auto & coefficients{expansions_coefficients[center]};
+          this->for_each_powerspectrum_block(
+              coefficients,
+              [&](const internal::SortedKey<Key_t> & spair_type,
+                  const auto & el1, const auto & el2, const auto & coef_ids,
+                  const double prefactor) {
+                Map_t change_by_pair(
+                    soap_vectors_change.row(i_center).data() +
+                        soap_offsets.at(this->key_map.at(spair_type).get_key()),
+                    shape[0], shape[1]);
+                // \delta c^{ia} and \delta c^{ib}
+                ConstMap_t change_1(coefficients_change.row(i_center).data() +
+                                        expansion_offsets.at(el1.first),
+                                    n_row, n_col);
+                ConstMap_t change_2(coefficients_change.row(i_center).data() +
+                                        expansion_offsets.at(el2.first),
+                                    n_row, n_col);
+                for (const auto & coef_idx : coef_ids) {
+                  // clang-format off
+                  change_by_pair(coef_idx.n1n2, coef_idx.l) +=
+                      ((change_1.block(coef_idx.n1, coef_idx.l_block_idx,
+                                       1, coef_idx.l_block_size).array() *
+                        el2.second.block(coef_idx.n2, coef_idx.l_block_idx,
+                                         1, coef_idx.l_block_size).array())
+                           .sum() +
+                       (el1.second.block(coef_idx.n1, coef_idx.l_block_idx,
+                                         1, coef_idx.l_block_size).array() *
+                        change_2.block(coef_idx.n2, coef_idx.l_block_idx,
+                                       1, coef_idx.l_block_size).array())
+                           .sum()) *
+                      coef_idx.l_factor * prefactor;
+                  // clang-format on
+                }
+              });
+        });
+    return soap_vectors_change;
+  }
+
   template <
       internal::SphericalInvariantsType BodyOrder,
       std::enable_if_t<
@@ -947,6 +1717,7 @@ namespace rascal {
     using math::pow;
     constexpr bool ExcludeGhosts{true};
 
+    RASCAL_TIMER("SphericalInvariants::compute");
     rep_expansion.compute(manager);
 
     auto && expansions_coefficients{*manager->template get_property<PropExp_t>(
@@ -1023,6 +1794,7 @@ namespace rascal {
     using internal::SphericalInvariantsType;
     using math::pow;
 
+    RASCAL_TIMER("SphericalInvariants::compute");
     rep_expansion.compute(manager);
 
     constexpr bool ExcludeGhosts{true};
@@ -1398,6 +2170,59 @@ namespace rascal {
     }
   }
 
+  template <class StructureManager, class InvariantsDerivative,
+            class Invariants, class ExpansionCoeff>
+  void CalculatorSphericalInvariants::initialize_powerspectrum_reverse_gradients(
+      InvariantsDerivative & soap_vector_reverse_gradients,
+      Invariants & soap_vectors, ExpansionCoeff & expansions_coefficients,
+      std::shared_ptr<StructureManager> manager) {
+    soap_vector_reverse_gradients.clear();
+    soap_vector_reverse_gradients.set_shape(
+        ThreeD * this->inner_invariants_shape[0],
+        this->inner_invariants_shape[1]);
+
+    internal::Sorted<true> is_sorted{};
+    Key_t pair_type{0, 0};
+    std::vector<
+        std::set<internal::SortedKey<Key_t>, internal::CompareSortedKeyLess>>
+        keys_list_grad{};
+    for (auto center : manager) {
+      const int atom_i_tag{center.get_atom_tag()};
+      const int center_type{center.get_atom_type()};
+      for (auto neigh : center.pairs_with_self_pair()) {
+        std::set<internal::SortedKey<Key_t>, internal::CompareSortedKeyLess>
+            grad_pair_list{};
+        if (neigh.get_atom_tag() != atom_i_tag and
+            manager->is_center_atom(neigh)) {
+          auto atom_j = neigh.get_atom_j();
+          if (this->normalize or this->is_sparsified) {
+            // \grad_i \tilde{p}^{j} ~ \tilde{p}^{j}
+            for (const auto & key : soap_vectors[atom_j].get_keys()) {
+              grad_pair_list.insert({is_sorted, key});
+            }
+          } else {
+            // \grad_i p^{j ab} is not zero only if a or b is the type of i
+            auto keys_j = expansions_coefficients[atom_j].get_keys();
+            for (const auto & neigh_1_type : keys_j) {
+              for (const auto & neigh_2_type : keys_j) {
+                if (neigh_1_type[0] <= neigh_2_type[0] and
+                    (center_type == neigh_1_type[0] or
+                     center_type == neigh_2_type[0])) {
+                  pair_type[0] = neigh_1_type[0];
+                  pair_type[1] = neigh_2_type[0];
+                  grad_pair_list.insert({is_sorted, pair_type});
+                }
+              }
+            }
+          }
+        }
+        keys_list_grad.emplace_back(grad_pair_list);
+      }
+    }
+    soap_vector_reverse_gradients.resize(keys_list_grad);
+    soap_vector_reverse_gradients.setZero();
+  }
+
   template <class StructureManager, class Invariants,
             class InvariantsDerivative, class ExpansionCoeff>
   void CalculatorSphericalInvariants::
@@ -0,0 +1,752 @@
+/**
+ * @file   rascal/representations/calculator_three_body.hh
+ *
+ * @date   18 October 2026
+ *
+ * @brief  Explicit three-body descriptor on a Chebyshev basis of the
+ *         distances and of the angle of the triplets
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_RASCAL_REPRESENTATIONS_CALCULATOR_THREE_BODY_HH_
+#define SRC_RASCAL_REPRESENTATIONS_CALCULATOR_THREE_BODY_HH_
+
+#include "rascal/representations/calculator_base.hh"
+#include "rascal/representations/cutoff_functions.hh"
+#include "rascal/structure_managers/implicit_triplet_list.hh"
+#include "rascal/structure_managers/property_block_sparse.hh"
+#include "rascal/structure_managers/structure_manager.hh"
+#include "rascal/utils/parallel.hh"
+#include "rascal/utils/timer.hh"
+#include "rascal/utils/utils.hh"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <array>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace rascal {
+
+  namespace internal {
+
+    /**
+     * Chebyshev polynomials of the first kind T_0(x) ... T_{n-1}(x) and
+     * their derivatives, with n = values.size(), from the recurrence
+     * T_{n+1} = 2 x T_n - T_{n-1}.
+     */
+    template <typename DerivedA, typename DerivedB>
+    void compute_chebyshev(const double x,
+                           const Eigen::MatrixBase<DerivedA> & values_,
+                           const Eigen::MatrixBase<DerivedB> & derivatives_) {
+      auto & values{const_cast<Eigen::MatrixBase<DerivedA> &>(values_)};
+      auto & derivatives{
+          const_cast<Eigen::MatrixBase<DerivedB> &>(derivatives_)};
+      const Eigen::Index n_values{values.size()};
+      values(0) = 1.;
+      derivatives(0) = 0.;
+      if (n_values > 1) {
+        values(1) = x;
+        derivatives(1) = 1.;
+      }
+      for (Eigen::Index n{2}; n < n_values; ++n) {
+        values(n) = 2. * x * values(n - 1) - values(n - 2);
+        derivatives(n) = 2. * values(n - 1) + 2. * x * derivatives(n - 1) -
+                         derivatives(n - 2);
+      }
+    }
+
+    /**
+     * Pairs of species (a, b), a <= b, of the angular neighbours of a
+     * center. The features of the center hold one block per pair, in the
+     * lexicographic order of the keys of BlockSparseProperty, so the keys
+     * only depend on the species in the environment like the ones of the
+     * power spectrum (the block (a, a) of a single neighbour of species a
+     * is zero).
+     */
+    struct ThreeBodySpeciesPairs {
+      //! sorted species of the angular neighbours
+      std::vector<int> species{};
+      //! block of (species[p], species[q]), p <= q, at p * n_species + q
+      std::vector<int> blocks{};
+      int n_blocks{0};
+
+      //! the species of the n_neighbours neighbours are types[0 ... n - 1]
+      template <class Types>
+      void update(const Types & types, const size_t n_neighbours) {
+        this->species.clear();
+        for (size_t i_neigh{0}; i_neigh < n_neighbours; ++i_neigh) {
+          this->species.push_back(types[i_neigh]);
+        }
+        std::sort(this->species.begin(), this->species.end());
+        this->species.erase(
+            std::unique(this->species.begin(), this->species.end()),
+            this->species.end());
+        const size_t n_species{this->species.size()};
+        this->blocks.assign(n_species * n_species, -1);
+        this->n_blocks = 0;
+        for (size_t p{0}; p < n_species; ++p) {
+          for (size_t q{p}; q < n_species; ++q) {
+            this->blocks[p * n_species + q] = this->n_blocks++;
+          }
+        }
+      }
+
+      //! position of type in species
+      int get_species_index(const int type) const {
+        return static_cast<int>(
+            std::lower_bound(this->species.begin(), this->species.end(),
+                             type) -
+            this->species.begin());
+      }
+
+      int get_block(const int p, const int q) const {
+        return this->blocks[p * this->species.size() + q];
+      }
+
+      template <class Key_t, class KeySet>
+      void get_keys(KeySet & keys) const {
+        const size_t n_species{this->species.size()};
+        internal::Sorted<true> is_sorted{};
+        for (size_t p{0}; p < n_species; ++p) {
+          for (size_t q{p}; q < n_species; ++q) {
+            Key_t pair_type{this->species[p], this->species[q]};
+            keys.insert({is_sorted, pair_type});
+          }
+        }
+      }
+    };
+
+    /**
+     * Data of the centers of a structure gathered from the structure
+     * manager so that the centers can be computed independently, e.g. by
+     * several threads. The entries per pair are at the offset of the center
+     * in the ImplicitTripletList plus the index of the pair in the
+     * iteration over center.pairs().
+     */
+    struct ThreeBodyNeighbourhoods {
+      //! species of the neighbours
+      std::vector<int> neighbour_types{};
+      //! whether each neighbour is a periodic image of its center
+      std::vector<bool> center_images{};
+      //! where to store the features of each center, nullptr without triplet
+      std::vector<double *> features{};
+      //! where to store the gradients w.r.t. the center of each center
+      std::vector<double *> center_gradients{};
+      //! where to store the gradients w.r.t. each neighbour
+      std::vector<double *> neighbour_gradients{};
+
+      void clear() {
+        this->neighbour_types.clear();
+        this->center_images.clear();
+        this->features.clear();
+        this->center_gradients.clear();
+        this->neighbour_gradients.clear();
+      }
+
+      size_t size() const { return this->features.size(); }
+    };
+
+    /**
+     * Work arrays of one thread, allocated for the largest neighbourhood
+     * and reused for all the centers.
+     */
+    struct ThreeBodyBuffers {
+      ThreeBodySpeciesPairs species_pairs{};
+      //! position of the species of each angular neighbour in species_pairs
+      std::vector<int> species_indices{};
+      //! R_n(r_ij) and dR_n/dr_ij, one column per angular neighbour
+      Eigen::MatrixXd radial{};
+      Eigen::MatrixXd radial_derivatives{};
+      //! T_l(cos theta_jik) and its derivative
+      Eigen::VectorXd angular{};
+      Eigen::VectorXd angular_derivatives{};
+      //! product of the radial functions of j and k and its derivatives
+      Eigen::VectorXd pair_product{};
+      Eigen::VectorXd pair_product_j{};
+      Eigen::VectorXd pair_product_k{};
+      //! projections of the gradients on the normalized features
+      Eigen::Vector3d projections{};
+
+      void reserve(const size_t max_radial, const size_t max_angular,
+                   const Eigen::Index max_n_neighbours) {
+        const Eigen::Index n_radial{static_cast<Eigen::Index>(max_radial)};
+        if (this->radial.cols() < max_n_neighbours or
+            this->radial.rows() != n_radial) {
+          this->radial.resize(n_radial, max_n_neighbours);
+          this->radial_derivatives.resize(n_radial, max_n_neighbours);
+        }
+        this->angular.resize(max_angular + 1);
+        this->angular_derivatives.resize(max_angular + 1);
+        this->pair_product.resize(n_radial * n_radial);
+        this->pair_product_j.resize(n_radial * n_radial);
+        this->pair_product_k.resize(n_radial * n_radial);
+      }
+    };
+
+  }  // namespace internal
+
+  /**
+   * Explicit three-body descriptor of the environment of a center i, built
+   * on the triplets (i, j, k) of ImplicitTripletList.
+   *
+   * For each pair of species (a, b), a <= b, of the neighbours j and k the
+   * features are
+   *
+   *    f^{ab}_{n1 n2 l} = sum_{j in a, k in b} R_{n1}(r_ij) R_{n2}(r_ik)
+   *                           T_l(cos theta_jik)
+   *
+   * with R_n(r) = T_n(2 r / r_c - 1) f_c(r), T_n the Chebyshev polynomials
+   * and f_c the cutoff function. The sum runs over the unordered pairs
+   * {j, k} within the cutoff so for a == b the radial part is symmetrized.
+   * The block of a key is n1 * max_radial + n2 by l.
+   *
+   * The gradients w.r.t. the positions of the neighbours are analytic. As
+   * for the spherical expansion, the gradient w.r.t. the center accounts for
+   * its periodic images, whose own pairs only contribute to the virial, and
+   * the gradient w.r.t. another atom is the sum over the pairs of its images.
+   * The centers are computed in parallel with "n_threads" threads.
+   */
+  class CalculatorThreeBody : public CalculatorBase {
+   public:
+    using Parent = CalculatorBase;
+    using Hypers_t = typename Parent::Hypers_t;
+    using Key_t = typename Parent::Key_t;
+
+    template <class StructureManager>
+    using Property_t = BlockSparseProperty<double, 1, StructureManager, Key_t>;
+
+    template <class StructureManager>
+    using PropertyGradient_t =
+        BlockSparseProperty<double, 2, StructureManager, Key_t>;
+
+    template <class StructureManager, size_t Order>
+    using ClusterRef_t = typename StructureManager::template ClusterRef<Order>;
+
+    explicit CalculatorThreeBody(const Hypers_t & hypers) : CalculatorBase{} {
+      this->set_default_prefix("three_body_");
+      this->set_hyperparameters(hypers);
+    }
+
+    //! Copy constructor
+    CalculatorThreeBody(const CalculatorThreeBody & other) = delete;
+
+    //! Move constructor
+    CalculatorThreeBody(CalculatorThreeBody && other) noexcept
+        : CalculatorBase{std::move(other)}, max_radial{other.max_radial},
+          max_angular{other.max_angular}, cutoff{other.cutoff},
+          smooth_width{other.smooth_width}, normalize{other.normalize},
+          compute_gradients{other.compute_gradients},
+          n_threads{other.n_threads}, neighbourhoods{std::move(
+                                          other.neighbourhoods)},
+          buffers{std::move(other.buffers)} {}
+
+    //! Destructor
+    virtual ~CalculatorThreeBody() = default;
+
+    //! Copy assignment operator
+    CalculatorThreeBody & operator=(const CalculatorThreeBody & other) = delete;
+
+    //! Move assignment operator
+    CalculatorThreeBody & operator=(CalculatorThreeBody && other) = default;
+
+    bool operator==(const CalculatorThreeBody & other) const {
+      return (this->max_radial == other.max_radial and
+              this->max_angular == other.max_angular and
+              this->cutoff == other.cutoff and
+              this->smooth_width == other.smooth_width and
+              this->normalize == other.normalize and
+              this->compute_gradients == other.compute_gradients);
+    }
+
+    void set_hyperparameters(const Hypers_t & hypers) override;
+
+    bool does_gradients() const override { return this->compute_gradients; }
+
+    /**
+     * Compute representation for a given structure manager.
+     *
+     * @tparam StructureManager a (single or collection)
+     * of structure manager(s) (in an iterator) held in shared_ptr
+     */
+    template <class StructureManager>
+    void compute(StructureManager & managers) {
+      this->compute_loop(managers);
+    }
+
+    //! loop over a collection of manangers
+    template <
+        class StructureManager,
+        std::enable_if_t<internal::is_proper_iterator<StructureManager>::value,
+                         int> = 0>
+    void compute_loop(StructureManager & managers) {
+      for (auto & manager : managers) {
+        this->compute_impl(manager);
+      }
+    }
+
+    //! if it is not a list of managers
+    template <class StructureManager,
+              std::enable_if_t<
+                  not(internal::is_proper_iterator<StructureManager>::value),
+                  int> = 0>
+    void compute_loop(StructureManager & manager) {
+      this->compute_impl(manager);
+    }
+
+    //! Implementation of compute representation
+    template <class StructureManager>
+    void compute_impl(std::shared_ptr<StructureManager> manager);
+
+    //! number of features of a key
+    size_t get_n_feature() const {
+      return this->max_radial * this->max_radial * (this->max_angular + 1);
+    }
+
+   protected:
+    /**
+     * Sets the keys of the features and of their gradients from the species
+     * of the triplets and gathers the neighbourhoods in
+     * this->neighbourhoods.
+     */
+    template <class StructureManager, class Triplets>
+    void initialize_neighbourhoods(
+        std::shared_ptr<StructureManager> & manager, const Triplets & triplets,
+        Property_t<StructureManager> & features,
+        PropertyGradient_t<StructureManager> & gradients);
+
+    //! compute the features of the i_center-th center
+    template <class Triplets>
+    void compute_center(const size_t i_center, const Triplets & triplets,
+                        internal::ThreeBodyBuffers & buffers) const;
+
+    //! R_n(r) and dR_n/dr of the radial basis
+    template <typename DerivedA, typename DerivedB>
+    void compute_radial(const double distance,
+                        const Eigen::MatrixBase<DerivedA> & values,
+                        const Eigen::MatrixBase<DerivedB> & derivatives) const {
+      auto & values_{const_cast<Eigen::MatrixBase<DerivedA> &>(values)};
+      auto & derivatives_{
+          const_cast<Eigen::MatrixBase<DerivedB> &>(derivatives)};
+      const double scale{2. / this->cutoff};
+      internal::compute_chebyshev(scale * distance - 1., values_,
+                                  derivatives_);
+      const double f_c{internal::switching_function_cosine(
+          distance, this->cutoff, this->smooth_width)};
+      const double df_c{internal::derivative_switching_funtion_cosine(
+          distance, this->cutoff, this->smooth_width)};
+      derivatives_ = scale * f_c * derivatives_ + df_c * values_;
+      values_ *= f_c;
+    }
+
+    //! number of radial functions
+    size_t max_radial{};
+    //! largest degree of the angular functions
+    size_t max_angular{};
+    double cutoff{};
+    double smooth_width{};
+    bool normalize{true};
+    bool compute_gradients{false};
+    //! number of threads computing the centers of a structure
+    size_t n_threads{1};
+
+    //! neighbourhoods of the structure being computed
+    internal::ThreeBodyNeighbourhoods neighbourhoods{};
+    //! work arrays of each thread
+    std::vector<internal::ThreeBodyBuffers> buffers{};
+  };
+
+  /* ---------------------------------------------------------------------- */
+  inline void
+  CalculatorThreeBody::set_hyperparameters(const Hypers_t & hypers) {
+    this->hypers = hypers;
+    this->max_radial = hypers.at("max_radial").get<size_t>();
+    this->max_angular = hypers.at("max_angular").get<size_t>();
+    if (this->max_radial < 1) {
+      throw std::logic_error("max_radial should be at least 1");
+    }
+    this->normalize = hypers.at("normalize").get<bool>();
+    this->compute_gradients = hypers.value("compute_gradients", false);
+
+    auto && fc_hypers{hypers.at("cutoff_function")};
+    auto fc_type{fc_hypers.at("type").get<std::string>()};
+    if (fc_type != "ShiftedCosine") {
+      std::stringstream err_str{};
+      err_str << "The cutoff function '" << fc_type << "' is not implemented "
+              << "for the three-body descriptor, use 'ShiftedCosine'.";
+      throw std::logic_error(err_str.str());
+    }
+    this->cutoff = fc_hypers.at("cutoff").at("value").get<double>();
+    this->smooth_width =
+        fc_hypers.at("smooth_width").at("value").get<double>();
+
+    // optional, the number of threads does not change the representation
+    // so it is not part of its name
+    this->n_threads = std::max(hypers.value("n_threads", size_t(1)), size_t(1));
+    auto name_hypers = hypers;
+    name_hypers.erase("n_threads");
+    this->set_name(name_hypers);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <class StructureManager>
+  void CalculatorThreeBody::compute_impl(
+      std::shared_ptr<StructureManager> manager) {
+    using Prop_t = Property_t<StructureManager>;
+    using PropGrad_t = PropertyGradient_t<StructureManager>;
+    static_assert(StructureManager::traits::HasCenterPair,
+                  "The three-body descriptor needs the center pairs, add "
+                  "AdaptorCenterContribution to the structure manager stack.");
+
+    constexpr bool ExcludeGhosts{true};
+    auto && features{*manager->template get_property<Prop_t>(
+        this->get_name(), true, true, ExcludeGhosts)};
+    auto && gradients{*manager->template get_property<PropGrad_t>(
+        this->get_gradient_name(), true, true)};
+
+    // if the representation has already been computed for the current
+    // structure then do nothing
+    if (features.is_updated()) {
+      return;
+    }
+
+    RASCAL_TIMER("ThreeBody::compute");
+    ImplicitTripletList<StructureManager> triplets{this->cutoff};
+    triplets.update(manager);
+
+    this->initialize_neighbourhoods(manager, triplets, features, gradients);
+
+    size_t max_n_neighbours{0};
+    for (size_t i_center{0}; i_center < triplets.size(); ++i_center) {
+      max_n_neighbours = std::max(max_n_neighbours,
+                                  triplets.get_nb_angular_neighbours(i_center));
+    }
+    const size_t n_centers{this->neighbourhoods.size()};
+    const size_t n_threads{std::min(this->n_threads, n_centers)};
+    if (this->buffers.size() < n_threads) {
+      this->buffers.resize(n_threads);
+    }
+    for (auto & buffer : this->buffers) {
+      buffer.reserve(this->max_radial, this->max_angular, max_n_neighbours);
+    }
+    internal::parallel_for(
+        n_centers, n_threads,
+        [this, &triplets](size_t i_center, size_t i_thread) {
+          this->compute_center(i_center, triplets, this->buffers[i_thread]);
+        });
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <class StructureManager, class Triplets>
+  void CalculatorThreeBody::initialize_neighbourhoods(
+      std::shared_ptr<StructureManager> & manager, const Triplets & triplets,
+      Property_t<StructureManager> & features,
+      PropertyGradient_t<StructureManager> & gradients) {
+    using KeySet_t =
+        std::set<internal::SortedKey<Key_t>, internal::CompareSortedKeyLess>;
+    auto & neighbourhoods{this->neighbourhoods};
+    neighbourhoods.clear();
+    neighbourhoods.neighbour_types.resize(triplets.get_nb_pairs());
+    neighbourhoods.center_images.resize(triplets.get_nb_pairs());
+    for (auto center : manager) {
+      const size_t offset{triplets.get_offset(neighbourhoods.features.size())};
+      const int atom_i_tag{center.get_atom_tag()};
+      size_t pair_index{0};
+      for (auto neigh : center.pairs()) {
+        neighbourhoods.neighbour_types[offset + pair_index] =
+            neigh.get_atom_type();
+        neighbourhoods.center_images[offset + pair_index] =
+            neigh.get_atom_j().get_atom_tag() == atom_i_tag;
+        ++pair_index;
+      }
+      neighbourhoods.features.push_back(nullptr);
+    }
+
+    const int n_row{static_cast<int>(this->max_radial * this->max_radial)};
+    const int n_col{static_cast<int>(this->max_angular + 1)};
+    features.clear();
+    features.set_shape(n_row, n_col);
+    if (this->compute_gradients) {
+      gradients.clear();
+      gradients.set_shape(ThreeD * n_row, n_col);
+    }
+
+    std::vector<KeySet_t> keys_list{};
+    std::vector<KeySet_t> keys_list_grad{};
+    internal::ThreeBodySpeciesPairs species_pairs{};
+    std::vector<int> types{};
+    for (size_t i_center{0}; i_center < triplets.size(); ++i_center) {
+      const size_t offset{triplets.get_offset(i_center)};
+      const size_t n_angular{triplets.get_nb_angular_neighbours(i_center)};
+      types.resize(n_angular);
+      for (size_t i_neigh{0}; i_neigh < n_angular; ++i_neigh) {
+        types[i_neigh] = neighbourhoods.neighbour_types
+                             [offset + triplets.get_pair_index(offset + i_neigh)];
+      }
+      species_pairs.update(types, n_angular);
+      KeySet_t keys{};
+      species_pairs.template get_keys<Key_t>(keys);
+      keys_list.push_back(keys);
+      if (this->compute_gradients) {
+        // the center pair comes first
+        keys_list_grad.insert(keys_list_grad.end(),
+                              triplets.get_nb_neighbours(i_center) + 1, keys);
+      }
+    }
+    features.resize(keys_list);
+    features.setZero();
+    if (this->compute_gradients) {
+      gradients.resize(keys_list_grad);
+      gradients.setZero();
+      neighbourhoods.center_gradients.resize(triplets.size(), nullptr);
+      neighbourhoods.neighbour_gradients.resize(triplets.get_nb_pairs(),
+                                                nullptr);
+    }
+
+    size_t i_center{0};
+    for (auto center : manager) {
+      if (keys_list[i_center].size() == 0) {
+        ++i_center;
+        continue;
+      }
+      neighbourhoods.features[i_center] =
+          features[center].get_full_vector().data();
+      if (this->compute_gradients) {
+        const size_t offset{triplets.get_offset(i_center)};
+        neighbourhoods.center_gradients[i_center] =
+            gradients[center.get_atom_ii()].get_full_vector().data();
+        size_t pair_index{0};
+        for (auto neigh : center.pairs()) {
+          neighbourhoods.neighbour_gradients[offset + pair_index] =
+              gradients[neigh].get_full_vector().data();
+          ++pair_index;
+        }
+      }
+      ++i_center;
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <class Triplets>
+  void CalculatorThreeBody::compute_center(
+      const size_t i_center, const Triplets & triplets,
+      internal::ThreeBodyBuffers & buffers) const {
+    using RowMatrixMap_t = Eigen::Map<
+        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
+    const auto & neighbourhoods{this->neighbourhoods};
+    double * const features_data{neighbourhoods.features[i_center]};
+    if (features_data == nullptr) {
+      // no triplet within the cutoff
+      return;
+    }
+    const bool compute_gradients{this->compute_gradients};
+    const size_t offset{triplets.get_offset(i_center)};
+    const size_t n_angular{triplets.get_nb_angular_neighbours(i_center)};
+    const Eigen::Index n_radial{static_cast<Eigen::Index>(this->max_radial)};
+    const Eigen::Index n_row{n_radial * n_radial};
+    const Eigen::Index n_col{static_cast<Eigen::Index>(this->max_angular + 1)};
+    const Eigen::Index block_size{n_row * n_col};
+    const Eigen::Index grad_block_size{ThreeD * block_size};
+
+    // species of the neighbours and keys of the center, in the order of
+    // initialize_neighbourhoods
+    auto & species_pairs{buffers.species_pairs};
+    auto & species_indices{buffers.species_indices};
+    species_indices.resize(n_angular);
+    for (size_t i_neigh{0}; i_neigh < n_angular; ++i_neigh) {
+      species_indices[i_neigh] =
+          neighbourhoods.neighbour_types[offset + triplets.get_pair_index(
+                                                      offset + i_neigh)];
+    }
+    species_pairs.update(species_indices, n_angular);
+    for (size_t i_neigh{0}; i_neigh < n_angular; ++i_neigh) {
+      species_indices[i_neigh] =
+          species_pairs.get_species_index(species_indices[i_neigh]);
+    }
+    const Eigen::Index n_blocks{species_pairs.n_blocks};
+
+    for (size_t i_neigh{0}; i_neigh < n_angular; ++i_neigh) {
+      this->compute_radial(triplets.get_distance(offset + i_neigh),
+                           buffers.radial.col(i_neigh),
+                           buffers.radial_derivatives.col(i_neigh));
+    }
+
+    auto & angular{buffers.angular};
+    auto & angular_derivatives{buffers.angular_derivatives};
+    auto & product{buffers.pair_product};
+    auto & product_j{buffers.pair_product_j};
+    auto & product_k{buffers.pair_product_k};
+    RowMatrixMap_t product_mat{product.data(), n_radial, n_radial};
+    RowMatrixMap_t product_j_mat{product_j.data(), n_radial, n_radial};
+    RowMatrixMap_t product_k_mat{product_k.data(), n_radial, n_radial};
+    triplets.for_each_triplet(i_center, [&](size_t i_pair_j, size_t i_pair_k,
+                                            double cosine) {
+      int p{species_indices[i_pair_j - offset]};
+      int q{species_indices[i_pair_k - offset]};
+      // j has the smaller species
+      if (p > q) {
+        std::swap(i_pair_j, i_pair_k);
+        std::swap(p, q);
+      }
+      const Eigen::Index neigh_j{static_cast<Eigen::Index>(i_pair_j - offset)};
+      const Eigen::Index neigh_k{static_cast<Eigen::Index>(i_pair_k - offset)};
+      const Eigen::Index i_block{species_pairs.get_block(p, q)};
+      auto radial_j{buffers.radial.col(neigh_j)};
+      auto radial_k{buffers.radial.col(neigh_k)};
+      if (p == q) {
+        product_mat.noalias() = 0.5 * (radial_j * radial_k.transpose() +
+                                       radial_k * radial_j.transpose());
+      } else {
+        product_mat.noalias() = radial_j * radial_k.transpose();
+      }
+      internal::compute_chebyshev(cosine, angular, angular_derivatives);
+      RowMatrixMap_t features_block{features_data + i_block * block_size,
+                                    n_row, n_col};
+      features_block.noalias() += product * angular.transpose();
+
+      if (not compute_gradients) {
+        return;
+      }
+      auto d_radial_j{buffers.radial_derivatives.col(neigh_j)};
+      auto d_radial_k{buffers.radial_derivatives.col(neigh_k)};
+      if (p == q) {
+        product_j_mat.noalias() = 0.5 * (d_radial_j * radial_k.transpose() +
+                                         radial_k * d_radial_j.transpose());
+        product_k_mat.noalias() = 0.5 * (radial_j * d_radial_k.transpose() +
+                                         d_radial_k * radial_j.transpose());
+      } else {
+        product_j_mat.noalias() = d_radial_j * radial_k.transpose();
+        product_k_mat.noalias() = radial_j * d_radial_k.transpose();
+      }
+      const auto direction_j{triplets.get_direction(i_pair_j)};
+      const auto direction_k{triplets.get_direction(i_pair_k)};
+      // d cos(theta_jik) / d r_j and d r_k
+      const Eigen::Vector3d d_cosine_j{(direction_k - cosine * direction_j) /
+                                       triplets.get_distance(i_pair_j)};
+      const Eigen::Vector3d d_cosine_k{(direction_j - cosine * direction_k) /
+                                       triplets.get_distance(i_pair_k)};
+      const std::array<size_t, 2> pair_indices{
+          {offset + triplets.get_pair_index(i_pair_j),
+           offset + triplets.get_pair_index(i_pair_k)}};
+      for (size_t i_neigh{0}; i_neigh < 2; ++i_neigh) {
+        double * gradient_data{
+            neighbourhoods.neighbour_gradients[pair_indices[i_neigh]]};
+        const auto & d_product{i_neigh == 0 ? product_j : product_k};
+        const auto & direction{i_neigh == 0 ? direction_j : direction_k};
+        const auto & d_cosine{i_neigh == 0 ? d_cosine_j : d_cosine_k};
+        for (int i_dim{0}; i_dim < ThreeD; ++i_dim) {
+          RowMatrixMap_t gradient_block{gradient_data +
+                                            i_block * grad_block_size +
+                                            i_dim * block_size,
+                                        n_row, n_col};
+          gradient_block.noalias() +=
+              (direction(i_dim) * d_product) * angular.transpose();
+          gradient_block.noalias() +=
+              (d_cosine(i_dim) * product) * angular_derivatives.transpose();
+        }
+      }
+    });
+
+    const Eigen::Index n_features{n_blocks * block_size};
+    Eigen::Map<Eigen::VectorXd> features{features_data, n_features};
+
+    if (compute_gradients) {
+      // grad_i f^i = - sum_j grad_j f^i, the periodic images of the center
+      // move along with it so they do not contribute, their own pairs only
+      // contribute to the virial
+      Eigen::Map<Eigen::VectorXd> center_gradient{
+          neighbourhoods.center_gradients[i_center], ThreeD * n_features};
+      for (size_t i_neigh{0}; i_neigh < triplets.get_nb_neighbours(i_center);
+           ++i_neigh) {
+        if (neighbourhoods.center_images[offset + i_neigh]) {
+          continue;
+        }
+        center_gradient -= Eigen::Map<Eigen::VectorXd>(
+            neighbourhoods.neighbour_gradients[offset + i_neigh],
+            ThreeD * n_features);
+      }
+    }
+
+    if (not this->normalize) {
+      return;
+    }
+    const double norm{features.norm()};
+    if (norm == 0.) {
+      return;
+    }
+    features /= norm;
+    if (not compute_gradients) {
+      return;
+    }
+    // grad \tilde{f} = grad f / |f| - \tilde{f} (\tilde{f} . grad f) / |f|
+    auto normalize_gradient = [&](double * gradient_data) {
+      auto & projections{buffers.projections};
+      projections.setZero();
+      for (Eigen::Index i_block{0}; i_block < n_blocks; ++i_block) {
+        Eigen::Map<Eigen::VectorXd> features_block{
+            features_data + i_block * block_size, block_size};
+        for (int i_dim{0}; i_dim < ThreeD; ++i_dim) {
+          Eigen::Map<Eigen::VectorXd> gradient_block{
+              gradient_data + i_block * grad_block_size + i_dim * block_size,
+              block_size};
+          projections(i_dim) += features_block.dot(gradient_block);
+        }
+      }
+      for (Eigen::Index i_block{0}; i_block < n_blocks; ++i_block) {
+        Eigen::Map<Eigen::VectorXd> features_block{
+            features_data + i_block * block_size, block_size};
+        for (int i_dim{0}; i_dim < ThreeD; ++i_dim) {
+          Eigen::Map<Eigen::VectorXd> gradient_block{
+              gradient_data + i_block * grad_block_size + i_dim * block_size,
+              block_size};
+          gradient_block -= projections(i_dim) * features_block;
+          gradient_block /= norm;
+        }
+      }
+    };
+    normalize_gradient(neighbourhoods.center_gradients[i_center]);
+    for (size_t i_neigh{0}; i_neigh < triplets.get_nb_neighbours(i_center);
+         ++i_neigh) {
+      normalize_gradient(neighbourhoods.neighbour_gradients[offset + i_neigh]);
+    }
+  }
+
+}  // namespace rascal
+
+namespace nlohmann {
+  /**
+   * Special specialization of the json serialization for non default
+   * constructible type.
+   */
+  template <>
+  struct adl_serializer<rascal::CalculatorThreeBody> {
+    static rascal::CalculatorThreeBody from_json(const json & j) {
+      return rascal::CalculatorThreeBody{j};
+    }
+
+    static void to_json(json & j, const rascal::CalculatorThreeBody & t) {
+      j = t.hypers;
+    }
+  };
+}  // namespace nlohmann
+
+#endif  // SRC_RASCAL_REPRESENTATIONS_CALCULATOR_THREE_BODY_HH_
@@ -0,0 +1,187 @@
+/**
+ * @file   rascal/representations/compute_by_batch.hh
+ *
+ * @date   18 October 2026
+ *
+ * @brief  streaming computation of a representation by batches of centers
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_RASCAL_REPRESENTATIONS_COMPUTE_BY_BATCH_HH_
+#define SRC_RASCAL_REPRESENTATIONS_COMPUTE_BY_BATCH_HH_
+
+#include "rascal/math/utils.hh"
+#include "rascal/structure_managers/atomic_structure.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/utils/json_io.hh"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+namespace rascal {
+
+  /**
+   * Compute the representation of a structure by batches of at most
+   * batch_size centers and hand each batch to a callback, so that the
+   * features of all the centers are never held at the same time.
+   *
+   * The manager stack of the whole structure is built once. Each batch is
+   * then computed on an isolated cluster made of the centers of the batch
+   * followed by their neighbours, or periodic images of neighbours, taken
+   * from the pairs of the whole stack and masked with center_atoms_mask. So
+   * the neighbour search over the whole structure is done once and each
+   * batch only costs a neighbour list over its own environments. The same
+   * cluster manager stack and feature buffer are reused for all the
+   * batches.
+   *
+   * func is called as func(features, atom_indices) where features is a
+   * (n_batch, inner_size * keys.size()) Eigen::Ref to the feature buffer
+   * filled in the order of keys (missing keys are zeros) and atom_indices
+   * holds the index in the structure of each row. The data referenced by the
+   * arguments is overwritten by the next batch so func has to copy what it
+   * wants to keep.
+   *
+   * Only calculators with a BlockSparseProperty as Property_t are
+   * supported, e.g. SphericalExpansion, SphericalInvariants and
+   * SphericalCovariants.
+   *
+   * @tparam Manager root structure manager of the stack, e.g.
+   *         StructureManagerCenters
+   * @tparam Adaptor adaptors of the stack, e.g. AdaptorNeighbourList,
+   *         AdaptorCenterContribution, AdaptorStrict
+   * @param calculator calculator of the representation
+   * @param structure the structure, its center_atoms_mask is honoured
+   * @param adaptor_inputs parameters of the adaptors of the stack (same
+   *        format as for ManagerCollection)
+   * @param keys keys of the features to return, e.g. the keys of the
+   *        sparse points of a model or of a reference set of structures
+   * @param batch_size maximum number of centers per batch
+   *
+   * @throw std::runtime_error if batch_size is zero
+   */
+  template <typename Manager, template <class> class... Adaptor,
+            class Calculator, class Func>
+  void compute_by_batch(
+      Calculator & calculator, const AtomicStructure<3> & structure,
+      const json & adaptor_inputs,
+      const typename Calculator::template Property_t<
+          typename StructureManagerTypeHolder<Manager, Adaptor...>::type>::
+          Keys_t & keys,
+      const size_t batch_size, Func && func) {
+    using Manager_t =
+        typename StructureManagerTypeHolder<Manager, Adaptor...>::type;
+    using Property_t = typename Calculator::template Property_t<Manager_t>;
+    if (batch_size == 0) {
+      throw std::runtime_error("compute_by_batch: batch_size should be > 0");
+    }
+
+    // neighbours of all the centers of the structure
+    auto manager = make_structure_manager_stack<Manager, Adaptor...>(
+        json::object(), adaptor_inputs);
+    manager->update(structure);
+    const size_t n_centers{manager->size()};
+    if (n_centers == 0) {
+      return;
+    }
+    auto manager_root = extract_underlying_manager<0>(manager);
+
+    auto manager_batch = make_structure_manager_stack<Manager, Adaptor...>(
+        json::object(), adaptor_inputs);
+    AtomicStructure<3> structure_batch{};
+    structure_batch.pbc.setZero();
+
+    math::Matrix_t features{};
+    std::vector<size_t> atom_indices{};
+    atom_indices.reserve(std::min(batch_size, n_centers));
+    // tags in the whole stack of the atoms of the cluster
+    std::unordered_set<int> cluster_tags{};
+    std::vector<Eigen::Vector3d> positions{};
+    std::vector<int> atom_types{};
+    for (size_t i_start{0}; i_start < n_centers; i_start += batch_size) {
+      const size_t n_batch{std::min(batch_size, n_centers - i_start)};
+      // the centers of the batch come first and keep their order
+      atom_indices.clear();
+      cluster_tags.clear();
+      positions.clear();
+      atom_types.clear();
+      for (size_t i_center{i_start}; i_center < i_start + n_batch;
+           ++i_center) {
+        auto center_it = manager->get_iterator_at(i_center);
+        auto center = *center_it;
+        cluster_tags.insert(center.get_atom_tag());
+        atom_indices.push_back(
+            manager_root->get_atom_index(center.get_atom_tag()));
+        positions.push_back(center.get_position());
+        atom_types.push_back(center.get_atom_type());
+      }
+      for (size_t i_center{i_start}; i_center < i_start + n_batch;
+           ++i_center) {
+        auto center_it = manager->get_iterator_at(i_center);
+        auto center = *center_it;
+        for (auto neigh : center.pairs()) {
+          if (cluster_tags.insert(neigh.get_atom_tag()).second) {
+            positions.push_back(neigh.get_position());
+            atom_types.push_back(neigh.get_atom_type());
+          }
+        }
+      }
+
+      const size_t n_cluster{positions.size()};
+      structure_batch.positions.resize(ThreeD, n_cluster);
+      structure_batch.atom_types.resize(n_cluster);
+      for (size_t i_atom{0}; i_atom < n_cluster; ++i_atom) {
+        structure_batch.positions.col(i_atom) = positions[i_atom];
+        structure_batch.atom_types(i_atom) = atom_types[i_atom];
+      }
+      structure_batch.center_atoms_mask.setConstant(n_cluster, false);
+      structure_batch.center_atoms_mask.head(n_batch).setConstant(true);
+      // the cluster is isolated: shift it into an orthorhombic box that
+      // contains all its atoms as the neighbour list requires
+      const Eigen::Vector3d pos_min{
+          structure_batch.positions.rowwise().minCoeff()};
+      const Eigen::Vector3d extent{
+          structure_batch.positions.rowwise().maxCoeff() - pos_min};
+      structure_batch.positions.colwise() -= pos_min;
+      structure_batch.cell =
+          extent.array().max(manager->get_cutoff()).matrix().asDiagonal();
+      manager_batch->update(structure_batch);
+      calculator.compute(manager_batch);
+
+      auto && property{*manager_batch->template get_property<Property_t>(
+          calculator.get_name(), true)};
+      const Eigen::Index n_cols{property.get_nb_comp() *
+                                static_cast<Eigen::Index>(keys.size())};
+      if (features.cols() != n_cols or
+          features.rows() < static_cast<Eigen::Index>(n_batch)) {
+        features.resize(std::min(batch_size, n_centers), n_cols);
+      }
+      auto batch_features = features.topRows(n_batch);
+      batch_features.setZero();
+      property.fill_dense_feature_matrix(batch_features, keys);
+      func(Eigen::Ref<const math::Matrix_t>(batch_features), atom_indices);
+    }
+  }
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_REPRESENTATIONS_COMPUTE_BY_BATCH_HH_
@@ -0,0 +1,622 @@
+/**
+ * @file   rascal/representations/spherical_expansion_long_range.hh
+ *
+ * @date   18 October 2026
+ *
+ * @brief  Reciprocal space evaluation of the long-range (LODE) spherical
+ *         expansion with a direct Ewald sum or a smooth particle mesh
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_RASCAL_REPRESENTATIONS_SPHERICAL_EXPANSION_LONG_RANGE_HH_
+#define SRC_RASCAL_REPRESENTATIONS_SPHERICAL_EXPANSION_LONG_RANGE_HH_
+
+#include "rascal/math/bessel.hh"
+#include "rascal/math/fft.hh"
+#include "rascal/math/gauss_legendre.hh"
+#include "rascal/math/interpolator.hh"
+#include "rascal/math/spherical_harmonics.hh"
+#include "rascal/math/utils.hh"
+#include "rascal/utils/json_io.hh"
+#include "rascal/utils/timer.hh"
+
+#include <Eigen/Dense>
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace rascal {
+  namespace internal {
+
+    /**
+     * Methods to evaluate the reciprocal space sum of the long-range
+     * expansion
+     */
+    enum class LongRangeMethod {
+      //! direct sum over the wave vectors, O(N^2)
+      Ewald,
+      //! smooth particle mesh Ewald with FFTs, O(N log N)
+      PME,
+      End_
+    };
+
+    /**
+     * Long-range (LODE) expansion of the atom density potential.
+     *
+     * The Gaussian atom density of the species a in a periodic cell of
+     * volume \f$\Omega\f$ generates the potential
+     *
+     * \f[
+     *    V_a(\mathbf{r}) = \frac{4\pi}{\Omega} \sum_{\mathbf{k}\neq 0}
+     *        \frac{e^{-\sigma^2 k^2/2}}{k^2} S_a(\mathbf{k})
+     *        e^{i\mathbf{k}\cdot\mathbf{r}}, \qquad
+     *    S_a(\mathbf{k}) = \sum_{j \in a} e^{-i\mathbf{k}\cdot\mathbf{r}_j},
+     * \f]
+     *
+     * i.e. the electrostatic potential of smeared unit charges with a
+     * neutralizing background. It is projected around each center i on the
+     * same orthonormalized GTO radial basis \f$R_n\f$ and real spherical
+     * harmonics as the local spherical expansion. With the plane wave
+     * expansion the projection is
+     *
+     * \f[
+     *    c^{i}_{anlm} = \int d\mathbf{x} R_n(x) Y_l^m(\hat{\mathbf{x}})
+     *        V_a(\mathbf{r}_i + \mathbf{x})
+     *    = \frac{(4\pi)^2}{\Omega} \sum_{\mathbf{k}\neq 0}
+     *        \frac{e^{-\sigma^2 k^2/2}}{k^2} i^l Y_l^m(\hat{\mathbf{k}})
+     *        I_{nl}(k) S_a(\mathbf{k}) e^{i\mathbf{k}\cdot\mathbf{r}_i},
+     * \f]
+     *
+     * where \f$I_{nl}(k) = \int_0^\infty dx x^2 R_n(x) j_l(kx)\f$ is
+     * tabulated once with a Gauss-Legendre quadrature and a cubic spline.
+     * The sum runs over the wave vectors with \f$k < k_c\f$, where
+     * \f$e^{-\sigma^2 k_c^2/2}\f$ is the requested accuracy.
+     *
+     * The Ewald method computes the structure factors and the sum directly
+     * which costs \f$O(N_k N)\f$, i.e. \f$O(N^2)\f$ at fixed density. The PME
+     * method spreads the atoms on a mesh with cardinal B-splines, so that
+     * \f$S_a(\mathbf{k})\f$ comes from one FFT per species, and evaluates each
+     * (a, n, l, m) channel as a field on the mesh with an inverse FFT that is
+     * interpolated back to the centers with the same B-splines (Essmann et
+     * al., J. Chem. Phys. 103, 8577 (1995)), which costs
+     * \f$O(N \log N)\f$. Two real channels are packed in each complex FFT.
+     *
+     * The hypers are of the form
+     *
+     *     {"method": "PME", "accuracy": 1e-8,
+     *      "spline_order": 6, "mesh_oversampling": 2}
+     *
+     * where method is "PME" (default) or "Ewald" and the last two options
+     * are only used by PME: the mesh has at least mesh_oversampling times the
+     * number of wave vectors along each direction and the B-splines are of
+     * even order spline_order.
+     */
+    class SphericalExpansionLongRange {
+     public:
+      using Hypers_t = json;
+      using Matrix_t = math::Matrix_t;
+      using Vector_t = math::Vector_t;
+      using Complex_t = std::complex<double>;
+      using Interpolator_t = math::InterpolatorMatrixUniformCubicSpline<
+          math::RefinementMethod_t::Exponential>;
+
+      /**
+       * @param hypers options of the long-range expansion, see above
+       * @param gaussian_sigma width of the Gaussian atom density
+       * @param max_radial number of radial basis functions
+       * @param max_angular largest angular channel
+       * @param radial_sigmas widths \f$\sigma_n\f$ of the GTO
+       *        \f$x^n e^{-x^2/2\sigma_n^2}\f$
+       * @param radial_ortho_matrix \f$S^{-1/2}\f$ orthonormalizing the
+       *        normalized GTOs
+       *
+       * @throw std::logic_error if the options are not valid
+       */
+      SphericalExpansionLongRange(const Hypers_t & hypers,
+                                  const double gaussian_sigma,
+                                  const size_t max_radial,
+                                  const size_t max_angular,
+                                  const Vector_t & radial_sigmas,
+                                  const Matrix_t & radial_ortho_matrix)
+          : hypers{hypers}, gaussian_sigma{gaussian_sigma},
+            max_radial{max_radial}, max_angular{max_angular} {
+        auto method_name = hypers.value("method", std::string("PME"));
+        if (method_name == "PME") {
+          this->method = LongRangeMethod::PME;
+        } else if (method_name == "Ewald") {
+          this->method = LongRangeMethod::Ewald;
+        } else {
+          throw std::logic_error("Requested long range method \'" +
+                                 method_name +
+                                 "\' is unknown.  Must be one of" +
+                                 ": \'PME\' or \'Ewald\'.");
+        }
+        const double accuracy{hypers.value("accuracy", 1e-8)};
+        this->spline_order = hypers.value("spline_order", 6);
+        this->mesh_oversampling = hypers.value("mesh_oversampling", 2.);
+        if (accuracy <= 0. or accuracy >= 1.) {
+          throw std::logic_error(
+              "The accuracy of the long range expansion should be in ]0, 1[");
+        }
+        if (this->spline_order < 2 or this->spline_order % 2 != 0) {
+          throw std::logic_error(
+              "The spline_order of the long range expansion should be even");
+        }
+        if (this->mesh_oversampling < 1.) {
+          throw std::logic_error("The mesh_oversampling of the long range "
+                                 "expansion should be at least 1");
+        }
+        if (gaussian_sigma <= 0.) {
+          throw std::logic_error(
+              "The long range expansion needs a positive gaussian_sigma");
+        }
+        this->k_cutoff = std::sqrt(-2. * std::log(accuracy)) / gaussian_sigma;
+        this->spherical_harmonics.precompute(this->max_angular);
+        this->precompute_radial_transform(radial_sigmas, radial_ortho_matrix);
+      }
+
+      //! largest wave vector of the reciprocal space sum
+      double get_k_cutoff() const { return this->k_cutoff; }
+
+      LongRangeMethod get_method() const { return this->method; }
+
+      /**
+       * Compute the long-range expansion of a periodic structure
+       *
+       * @param cell lattice vectors in the columns
+       * @param positions positions of the atoms of the cell [3, N_atoms]
+       * @param atom_types species of the atoms
+       * @param centers positions of the centers [3, N_centers]
+       * @param species sorted species of the expansion, should contain all
+       *        the atom_types
+       * @return the coefficients [N_centers * N_species, max_radial *
+       *        (max_angular+1)^2] where the row i_center * N_species +
+       *        i_species holds the (n, lm) coefficients in row-major order
+       */
+      Matrix_t compute(const Eigen::Matrix3d & cell,
+                       const Eigen::Ref<const Eigen::Matrix3Xd> & positions,
+                       const std::vector<int> & atom_types,
+                       const Eigen::Ref<const Eigen::Matrix3Xd> & centers,
+                       const std::vector<int> & species) {
+        std::map<int, size_t> species_ids{};
+        for (size_t i_species{0}; i_species < species.size(); ++i_species) {
+          species_ids[species[i_species]] = i_species;
+        }
+        std::vector<size_t> atom_species{};
+        for (const int & atom_type : atom_types) {
+          auto species_id = species_ids.find(atom_type);
+          if (species_id == species_ids.end()) {
+            std::stringstream err_str{};
+            err_str << "The species '" << atom_type
+                    << "' is not part of the long range expansion.";
+            throw std::runtime_error(err_str.str());
+          }
+          atom_species.push_back(species_id->second);
+        }
+        this->set_reciprocal_modes(cell);
+        const size_t n_lm{(this->max_angular + 1) * (this->max_angular + 1)};
+        Matrix_t coefficients{Matrix_t::Zero(centers.cols() * species.size(),
+                                             this->max_radial * n_lm)};
+        if (this->method == LongRangeMethod::Ewald) {
+          this->compute_ewald(positions, atom_species, centers, species.size(),
+                              coefficients);
+        } else {
+          this->compute_pme(cell, positions, atom_species, centers,
+                            species.size(), coefficients);
+        }
+        return coefficients;
+      }
+
+      //! options of the long-range expansion
+      Hypers_t hypers{};
+
+     protected:
+      /**
+       * Tabulate the radial transforms \f$I_{nl}(k)\f$ of the orthonormal
+       * GTO basis on [0, k_cutoff].
+       */
+      void precompute_radial_transform(const Vector_t & radial_sigmas,
+                                       const Matrix_t & radial_ortho_matrix) {
+        using math::pow;
+        // the GTOs are negligible beyond x_max
+        double x_max{0.};
+        for (size_t radial_n{0}; radial_n < this->max_radial; ++radial_n) {
+          x_max = std::max(x_max, radial_sigmas(radial_n) *
+                                      (std::sqrt(radial_n + 2.) + 10.));
+        }
+        // j_l(k x) oscillates up to k_cutoff * x_max / pi times on [0, x_max]
+        const int n_quad{
+            100 + 2 * static_cast<int>(std::ceil(this->k_cutoff * x_max))};
+        const auto points_weights{
+            math::compute_gauss_legendre_points_weights(0., x_max, n_quad)};
+        // x^2 R_n(x) w_x of the normalized GTOs
+        Matrix_t basis(n_quad, this->max_radial);
+        for (size_t radial_n{0}; radial_n < this->max_radial; ++radial_n) {
+          const double sigma{radial_sigmas(radial_n)};
+          const double norm{std::sqrt(
+              2. / (std::tgamma(1.5 + radial_n) * pow(sigma, 3 + 2 * radial_n)))};
+          for (int i_quad{0}; i_quad < n_quad; ++i_quad) {
+            const double x{points_weights(i_quad, 0)};
+            basis(i_quad, radial_n) =
+                norm * pow(x, radial_n + 2) *
+                std::exp(-0.5 * x * x / (sigma * sigma)) *
+                points_weights(i_quad, 1);
+          }
+        }
+        // orthonormalize with S^{-1/2}
+        basis = basis * radial_ortho_matrix.transpose();
+
+        // I_{nl}(k) is smooth on the scale of 1/x_max
+        const int n_k{std::max(
+            50, 4 * static_cast<int>(std::ceil(this->k_cutoff * x_max)) + 1)};
+        Vector_t grid{Vector_t::LinSpaced(n_k, 0., this->k_cutoff)};
+        const int n_l{static_cast<int>(this->max_angular) + 1};
+        Matrix_t evaluated_grid(n_k, this->max_radial * n_l);
+        Matrix_t bessels(n_quad, n_l);
+        Eigen::ArrayXd bessel_values(n_l);
+        for (int i_k{0}; i_k < n_k; ++i_k) {
+          for (int i_quad{0}; i_quad < n_quad; ++i_quad) {
+            math::compute_spherical_bessel(
+                grid(i_k) * points_weights(i_quad, 0), bessel_values);
+            bessels.row(i_quad) = bessel_values.transpose();
+          }
+          Matrix_t transform{basis.transpose() * bessels};
+          evaluated_grid.row(i_k) =
+              Eigen::Map<Vector_t>(transform.data(), transform.size());
+        }
+        this->radial_transform = std::make_unique<Interpolator_t>(
+            grid, evaluated_grid, n_l, this->max_radial);
+      }
+
+      /**
+       * Find the wave vectors of the half space with k < k_cutoff and the
+       * k dependent factors of their contributions.
+       */
+      void set_reciprocal_modes(const Eigen::Matrix3d & cell) {
+        using math::PI;
+        const double volume{std::abs(cell.determinant())};
+        // k = 2 pi cell^{-T} m
+        const Eigen::Matrix3d reciprocal{2. * PI *
+                                         cell.inverse().transpose()};
+        for (int i_dim{0}; i_dim < 3; ++i_dim) {
+          // |m_a| = |k . a| / 2 pi
+          this->max_modes[i_dim] = static_cast<int>(std::floor(
+              this->k_cutoff * cell.col(i_dim).norm() / (2. * PI)));
+        }
+        this->modes.clear();
+        std::vector<Eigen::Vector3d> wave_vectors{};
+        for (int m_0{0}; m_0 <= this->max_modes[0]; ++m_0) {
+          for (int m_1{-this->max_modes[1]}; m_1 <= this->max_modes[1];
+               ++m_1) {
+            for (int m_2{-this->max_modes[2]}; m_2 <= this->max_modes[2];
+                 ++m_2) {
+              // only one of k and -k
+              if (m_0 == 0 and (m_1 < 0 or (m_1 == 0 and m_2 <= 0))) {
+                continue;
+              }
+              Eigen::Vector3d k_vec{reciprocal *
+                                    Eigen::Vector3d(m_0, m_1, m_2)};
+              if (k_vec.norm() < this->k_cutoff) {
+                this->modes.push_back({{m_0, m_1, m_2}});
+                wave_vectors.push_back(k_vec);
+              }
+            }
+          }
+        }
+
+        const size_t n_modes{this->modes.size()};
+        const size_t n_l{this->max_angular + 1};
+        this->wave_vectors.resize(3, n_modes);
+        this->harmonics.resize(n_modes, n_l * n_l);
+        this->radial.resize(n_modes, this->max_radial * n_l);
+        const double sigma2{this->gaussian_sigma * this->gaussian_sigma};
+        for (size_t i_mode{0}; i_mode < n_modes; ++i_mode) {
+          const Eigen::Vector3d & k_vec{wave_vectors[i_mode]};
+          const double k_norm{k_vec.norm()};
+          this->wave_vectors.col(i_mode) = k_vec;
+          this->spherical_harmonics.calc(k_vec / k_norm);
+          this->harmonics.row(i_mode) =
+              this->spherical_harmonics.get_harmonics();
+          const double prefactor{16. * PI * PI / volume *
+                                 std::exp(-0.5 * sigma2 * k_norm * k_norm) /
+                                 (k_norm * k_norm)};
+          Matrix_t transform{prefactor *
+                             this->radial_transform->interpolate(k_norm)};
+          this->radial.row(i_mode) =
+              Eigen::Map<Vector_t>(transform.data(), transform.size());
+        }
+      }
+
+      //! Re(i^l z)
+      static double real_part_i_l(const Complex_t & z, const size_t l) {
+        switch (l % 4) {
+        case 0:
+          return z.real();
+        case 1:
+          return -z.imag();
+        case 2:
+          return -z.real();
+        default:
+          return z.imag();
+        }
+      }
+
+      //! i^l
+      static Complex_t i_l(const size_t l) {
+        const std::array<Complex_t, 4> powers{
+            {{1., 0.}, {0., 1.}, {-1., 0.}, {0., -1.}}};
+        return powers[l % 4];
+      }
+
+      //! direct sum over the wave vectors, k and -k give complex conjugates
+      void compute_ewald(const Eigen::Ref<const Eigen::Matrix3Xd> & positions,
+                         const std::vector<size_t> & atom_species,
+                         const Eigen::Ref<const Eigen::Matrix3Xd> & centers,
+                         const size_t n_species, Matrix_t & coefficients) {
+        RASCAL_TIMER("SphericalExpansionLongRange::compute_ewald");
+        const size_t n_l{this->max_angular + 1};
+        const size_t n_lm{n_l * n_l};
+        std::vector<Complex_t> structure_factors(n_species);
+        for (size_t i_mode{0}; i_mode < this->modes.size(); ++i_mode) {
+          const Eigen::Vector3d k_vec{this->wave_vectors.col(i_mode)};
+          std::fill(structure_factors.begin(), structure_factors.end(),
+                    Complex_t{0., 0.});
+          for (int i_atom{0}; i_atom < positions.cols(); ++i_atom) {
+            structure_factors[atom_species[i_atom]] +=
+                std::polar(1., -k_vec.dot(positions.col(i_atom)));
+          }
+          Eigen::Map<const Matrix_t> radial_mode(
+              this->radial.row(i_mode).data(), this->max_radial, n_l);
+          for (int i_center{0}; i_center < centers.cols(); ++i_center) {
+            const Complex_t phase{
+                std::polar(1., k_vec.dot(centers.col(i_center)))};
+            for (size_t i_species{0}; i_species < n_species; ++i_species) {
+              const Complex_t z{structure_factors[i_species] * phase};
+              Eigen::Map<Matrix_t> coefficients_center(
+                  coefficients.row(i_center * n_species + i_species).data(),
+                  this->max_radial, n_lm);
+              for (size_t l{0}; l < n_l; ++l) {
+                coefficients_center.middleCols(l * l, 2 * l + 1).noalias() +=
+                    (2. * real_part_i_l(z, l) * radial_mode.col(l)) *
+                    this->harmonics.block(i_mode, l * l, 1, 2 * l + 1);
+              }
+            }
+          }
+        }
+      }
+
+      /**
+       * Mesh points and B-spline weights of a point for the spreading and
+       * the interpolation
+       */
+      struct Stencil {
+        std::vector<size_t> indices{};
+        std::vector<double> weights{};
+      };
+
+      /**
+       * Values \f$M_p(w + j)\f$, j = 0, ..., p-1, of the cardinal B-spline of
+       * order p with w in [0, 1[
+       */
+      static std::vector<double> compute_bspline(const double w,
+                                                 const int order) {
+        std::vector<double> values(order, 0.);
+        values[0] = w;
+        values[1] = 1. - w;
+        for (int p{3}; p <= order; ++p) {
+          for (int j{p - 1}; j >= 0; --j) {
+            const double left{j > 0 ? values[j - 1] : 0.};
+            values[j] = ((w + j) * values[j] + (p - w - j) * left) / (p - 1);
+          }
+        }
+        return values;
+      }
+
+      Stencil make_stencil(const Eigen::Matrix3d & inverse_cell,
+                           const Eigen::Vector3d & position,
+                           const math::FFT3D & fft) const {
+        const auto & shape = fft.get_shape();
+        const int order{this->spline_order};
+        std::array<std::vector<double>, 3> weights{};
+        std::array<std::vector<size_t>, 3> indices{};
+        const Eigen::Vector3d scaled{inverse_cell * position};
+        for (int i_dim{0}; i_dim < 3; ++i_dim) {
+          const int n_mesh{static_cast<int>(shape[i_dim])};
+          double u{n_mesh * (scaled(i_dim) - std::floor(scaled(i_dim)))};
+          int base{static_cast<int>(std::floor(u))};
+          weights[i_dim] = compute_bspline(u - base, order);
+          for (int j{0}; j < order; ++j) {
+            indices[i_dim].push_back(
+                static_cast<size_t>(((base - j) % n_mesh + n_mesh) % n_mesh));
+          }
+        }
+        Stencil stencil{};
+        for (int j_0{0}; j_0 < order; ++j_0) {
+          for (int j_1{0}; j_1 < order; ++j_1) {
+            for (int j_2{0}; j_2 < order; ++j_2) {
+              stencil.indices.push_back(fft.get_index(
+                  indices[0][j_0], indices[1][j_1], indices[2][j_2]));
+              stencil.weights.push_back(weights[0][j_0] * weights[1][j_1] *
+                                        weights[2][j_2]);
+            }
+          }
+        }
+        return stencil;
+      }
+
+      //! smooth particle mesh Ewald
+      void compute_pme(const Eigen::Matrix3d & cell,
+                       const Eigen::Ref<const Eigen::Matrix3Xd> & positions,
+                       const std::vector<size_t> & atom_species,
+                       const Eigen::Ref<const Eigen::Matrix3Xd> & centers,
+                       const size_t n_species, Matrix_t & coefficients) {
+        RASCAL_TIMER("SphericalExpansionLongRange::compute_pme");
+        const int order{this->spline_order};
+        math::FFT3D::Shape_t shape{};
+        for (int i_dim{0}; i_dim < 3; ++i_dim) {
+          const auto n_mesh{static_cast<size_t>(std::ceil(
+              this->mesh_oversampling * (2 * this->max_modes[i_dim] + 1)))};
+          shape[i_dim] =
+              math::next_fft_size(std::max(n_mesh, size_t(2 * order)));
+        }
+        math::FFT3D fft{shape};
+        const size_t n_mesh{fft.size()};
+        const Eigen::Matrix3d inverse_cell{cell.inverse()};
+
+        // |b(m)|^2 of the exponential splines along each direction
+        std::vector<double> bspline_knots{compute_bspline(0., order)};
+        std::array<std::vector<double>, 3> bspline_moduli{};
+        for (int i_dim{0}; i_dim < 3; ++i_dim) {
+          const int n_points{static_cast<int>(shape[i_dim])};
+          for (int m{0}; m < n_points; ++m) {
+            Complex_t denominator{0., 0.};
+            for (int q{0}; q < order - 1; ++q) {
+              denominator += bspline_knots[q + 1] *
+                             std::polar(1., 2. * math::PI * m * q / n_points);
+            }
+            bspline_moduli[i_dim].push_back(1. / std::norm(denominator));
+          }
+        }
+        // mesh index of m and -m and |b(m)|^2 of each wave vector
+        const size_t n_modes{this->modes.size()};
+        std::vector<size_t> indices_plus(n_modes), indices_minus(n_modes);
+        std::vector<double> moduli(n_modes);
+        for (size_t i_mode{0}; i_mode < n_modes; ++i_mode) {
+          std::array<size_t, 3> plus{}, minus{};
+          moduli[i_mode] = 1.;
+          for (int i_dim{0}; i_dim < 3; ++i_dim) {
+            const int n_points{static_cast<int>(shape[i_dim])};
+            const int m{this->modes[i_mode][i_dim]};
+            plus[i_dim] = static_cast<size_t>((m + n_points) % n_points);
+            minus[i_dim] = static_cast<size_t>((n_points - m) % n_points);
+            moduli[i_mode] *= bspline_moduli[i_dim][plus[i_dim]];
+          }
+          indices_plus[i_mode] = fft.get_index(plus[0], plus[1], plus[2]);
+          indices_minus[i_mode] = fft.get_index(minus[0], minus[1], minus[2]);
+        }
+
+        // structure factors of each species from the spread atoms
+        std::vector<std::vector<Complex_t>> structure_factors(
+            n_species, std::vector<Complex_t>(n_mesh, Complex_t{0., 0.}));
+        for (int i_atom{0}; i_atom < positions.cols(); ++i_atom) {
+          auto stencil =
+              this->make_stencil(inverse_cell, positions.col(i_atom), fft);
+          auto & charges = structure_factors[atom_species[i_atom]];
+          for (size_t i_point{0}; i_point < stencil.indices.size();
+               ++i_point) {
+            charges[stencil.indices[i_point]] += stencil.weights[i_point];
+          }
+        }
+        for (auto & charges : structure_factors) {
+          fft.forward(charges);
+        }
+        std::vector<Stencil> center_stencils{};
+        for (int i_center{0}; i_center < centers.cols(); ++i_center) {
+          center_stencils.push_back(
+              this->make_stencil(inverse_cell, centers.col(i_center), fft));
+        }
+
+        // each (a, n, l, m) channel is a real field, two of them are
+        // computed with one complex inverse FFT
+        const size_t n_l{this->max_angular + 1};
+        const size_t n_lm{n_l * n_l};
+        const size_t n_channels{n_species * this->max_radial * n_lm};
+        std::vector<size_t> angular_l(n_lm);
+        for (size_t l{0}; l < n_l; ++l) {
+          for (size_t lm{l * l}; lm < (l + 1) * (l + 1); ++lm) {
+            angular_l[lm] = l;
+          }
+        }
+        std::vector<Complex_t> field(n_mesh);
+        for (size_t i_channel{0}; i_channel < n_channels; i_channel += 2) {
+          std::fill(field.begin(), field.end(), Complex_t{0., 0.});
+          const size_t n_packed{std::min(size_t(2), n_channels - i_channel)};
+          for (size_t i_packed{0}; i_packed < n_packed; ++i_packed) {
+            const size_t channel{i_channel + i_packed};
+            const size_t i_species{channel / (this->max_radial * n_lm)};
+            const size_t radial_n{(channel / n_lm) % this->max_radial};
+            const size_t lm{channel % n_lm};
+            const size_t l{angular_l[lm]};
+            const Complex_t factor{
+                (i_packed == 0 ? Complex_t{1., 0.} : Complex_t{0., 1.})};
+            const Complex_t phase{i_l(l)};
+            const auto & charges = structure_factors[i_species];
+            for (size_t i_mode{0}; i_mode < n_modes; ++i_mode) {
+              const Complex_t value{
+                  phase * moduli[i_mode] *
+                  this->radial(i_mode, radial_n * n_l + l) *
+                  this->harmonics(i_mode, lm) * charges[indices_plus[i_mode]]};
+              field[indices_plus[i_mode]] += factor * value;
+              field[indices_minus[i_mode]] += factor * std::conj(value);
+            }
+          }
+          fft.inverse(field);
+          for (size_t i_center{0}; i_center < center_stencils.size();
+               ++i_center) {
+            const auto & stencil = center_stencils[i_center];
+            Complex_t value{0., 0.};
+            for (size_t i_point{0}; i_point < stencil.indices.size();
+                 ++i_point) {
+              value += stencil.weights[i_point] * field[stencil.indices[i_point]];
+            }
+            for (size_t i_packed{0}; i_packed < n_packed; ++i_packed) {
+              const size_t channel{i_channel + i_packed};
+              const size_t i_species{channel / (this->max_radial * n_lm)};
+              coefficients(i_center * n_species + i_species,
+                           channel % (this->max_radial * n_lm)) =
+                  i_packed == 0 ? value.real() : value.imag();
+            }
+          }
+        }
+      }
+
+      LongRangeMethod method{LongRangeMethod::PME};
+      double gaussian_sigma{};
+      size_t max_radial{};
+      size_t max_angular{};
+      int spline_order{6};
+      double mesh_oversampling{2.};
+      double k_cutoff{};
+
+      //! I_{nl}(k) of the orthonormal GTO basis
+      std::unique_ptr<Interpolator_t> radial_transform{};
+      math::SphericalHarmonics spherical_harmonics{};
+
+      //! largest |m| along each reciprocal direction
+      std::array<int, 3> max_modes{};
+      //! integer coordinates m of the wave vectors of the half space
+      std::vector<std::array<int, 3>> modes{};
+      //! wave vectors [3, N_modes]
+      Eigen::Matrix3Xd wave_vectors{};
+      //! Y_l^m(k) [N_modes, (l_max+1)^2]
+      Matrix_t harmonics{};
+      //! (4 pi)^2/V e^{-sigma^2 k^2/2} / k^2 I_{nl}(k) [N_modes, n_max*(l_max+1)]
+      Matrix_t radial{};
+    };
+
+  }  // namespace internal
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_REPRESENTATIONS_SPHERICAL_EXPANSION_LONG_RANGE_HH_
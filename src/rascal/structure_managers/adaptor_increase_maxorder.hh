@@ -76,6 +76,11 @@ namespace rascal {
    * means, if the manager does not have a neighbourlist, there is nothing this
    * adaptor can do (hint: use adaptor_neighbour_list before and stack this on
    * top), if it exists, triplets, quadruplets, etc. lists are created.
+   *
+   * The clusters of the new order are stored explicitly, i.e. O(N k^2)
+   * triplets for N centers with k neighbours. For large dense structures
+   * use ImplicitTripletList (implicit_triplet_list.hh) that only stores the
+   * pairs and generates the triplets on the fly.
    */
   template <class ManagerImplementation>
   class AdaptorMaxOrder
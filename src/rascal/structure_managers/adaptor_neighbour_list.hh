@@ -381,20 +381,17 @@ namespace rascal {
     class IndexContainer {
      public:
       //! Default constructor
-      IndexContainer() = delete;
+      IndexContainer() = default;
 
       //! Constructor with size
-      explicit IndexContainer(const std::array<int, Dim> & nboxes)
-          : nboxes{nboxes} {
-        auto ntot = std::accumulate(nboxes.begin(), nboxes.end(), 1,
-                                    std::multiplies<int>());
-        data.resize(ntot);
+      explicit IndexContainer(const std::array<int, Dim> & nboxes) {
+        this->reset(nboxes);
       }
 
       //! Copy constructor
       IndexContainer(const IndexContainer & other) = delete;
       //! Move constructor
-      IndexContainer(IndexContainer && other) = delete;
+      IndexContainer(IndexContainer && other) = default;
       //! Destructor
       ~IndexContainer() {}
       //! Copy assignment operator
@@ -427,6 +424,21 @@ namespace rascal {
         return this->data[index];
       }
 
+      /**
+       * Empty all the boxes and change their number. The memory of the boxes
+       * is kept so that binning atoms again does not allocate once the boxes
+       * are large enough.
+       */
+      void reset(const std::array<int, Dim> & nboxes) {
+        this->nboxes = nboxes;
+        auto ntot = std::accumulate(nboxes.begin(), nboxes.end(), 1,
+                                    std::multiplies<int>());
+        for (auto & box : this->data) {
+          box.clear();
+        }
+        this->data.resize(ntot);
+      }
+
      protected:
       //! a vector of atom tags for every box
       std::vector<std::vector<int>> data{};
@@ -791,6 +803,16 @@ namespace rascal {
     //! ghost atom type
     std::vector<int> ghost_types{};
 
+    /**
+     * atom tags in the boxes of the linked cells, kept from one update to the
+     * next so that updating the structures of a trajectory reuses the memory
+     * of the boxes
+     */
+    internal::IndexContainer<traits::Dim> atom_id_cell{};
+
+    //! neighbours of the current center, reused for every center
+    std::vector<int> current_j_atoms{};
+
    private:
   };
 
@@ -842,6 +864,7 @@ namespace rascal {
   template <class ManagerImplementation>
   void AdaptorNeighbourList<ManagerImplementation>::update_self() {
     if (this->need_update) {
+      RASCAL_TIMER("AdaptorNeighbourList::update");
       // set the number of centers
       this->n_centers = this->manager->get_size();
       // this->n_atoms = this->manager->get_n_atoms();
@@ -872,6 +895,9 @@ namespace rascal {
       atom_cluster_indices.fill_sequence();
       pair_cluster_indices.fill_sequence();
       ++this->n_update;
+      RASCAL_COUNTER_ADD("AdaptorNeighbourList::pairs",
+                         this->neighbours_atom_tag.size());
+      RASCAL_COUNTER_ADD("AdaptorNeighbourList::ghosts", this->n_ghosts);
     }
   }
 
@@ -1020,12 +1046,17 @@ namespace rascal {
     // existing center atoms are added to the list of current atoms to start the
     // full list of current i-atoms to have them all contiguously at the
     // beginning of the list.
+    // The atom index of an atom is its tag in the underlying manager, the
+    // one of the original atom for a ghost, so get_atom_index() identifies
+    // ghost and masked atoms with the atom they stand for. When some atoms
+    // are masked it differs from the column of the position since the
+    // centers are listed first, the column is given by get_atom_index() of
+    // the root manager.
     for (size_t atom_tag{0}; atom_tag < this->manager->get_size(); ++atom_tag) {
       auto atom_type = this->manager->get_atom_type(atom_tag);
-      auto atom_index = this->manager->get_atom_index(atom_tag);
       this->atom_tag_list.push_back(atom_tag);
       this->atom_types.push_back(atom_type);
-      this->atom_index_from_atom_tag_list.push_back(atom_index);
+      this->atom_index_from_atom_tag_list.push_back(atom_tag);
     }
 
     // And before generating periodic replicas (termed ghost atoms), previous
@@ -1037,8 +1068,7 @@ namespace rascal {
       auto atom_type = this->manager->get_atom_type(atom_tag);
       auto new_atom_tag{this->n_centers + this->n_ghosts};
       this->add_ghost_atom(new_atom_tag, pos, atom_type);
-      size_t atom_index = this->manager->get_atom_index(atom_tag);
-      this->atom_index_from_atom_tag_list.push_back(atom_index);
+      this->atom_index_from_atom_tag_list.push_back(atom_tag);
     }
 
     // generate ghost atom tags and positions
@@ -1060,17 +1090,15 @@ namespace rascal {
             // next atom tag is size, since start is at index = 0
             auto new_atom_tag{this->n_centers + this->n_ghosts};
             this->add_ghost_atom(new_atom_tag, pos_ghost, atom_type);
-            // adds origin atom cluster_index if true
-            // adds ghost atom cluster index if false
-            size_t atom_index = this->manager->get_atom_index(atom_tag);
-            this->atom_index_from_atom_tag_list.push_back(atom_index);
+            // adds origin atom cluster_index
+            this->atom_index_from_atom_tag_list.push_back(atom_tag);
           }
         }
       }
     }
 
-    // neighbour boxes
-    internal::IndexContainer<dim> atom_id_cell{nboxes_per_dim};
+    // empty the neighbour boxes while keeping their memory
+    this->atom_id_cell.reset(nboxes_per_dim);
 
     // sorting the atoms and ghosts inside the cell into boxes
     auto n_potential_neighbours{this->n_centers + this->n_ghosts};
@@ -1078,12 +1106,11 @@ namespace rascal {
       auto pos = this->get_position(atom_tag);
       Vector_t dpos = pos - mesh_min;
       auto idx = internal::get_box_index(dpos, cutoff);
-      atom_id_cell[idx].push_back(atom_tag);
+      this->atom_id_cell[idx].push_back(atom_tag);
     }
 
     // go through all atoms and/or ghosts to build neighbour list, depending on
     // the runtime decision flag
-    std::vector<int> current_j_atoms{};
     for (auto center : this->get_manager()) {
       int atom_tag = center.get_atom_tag();
       int nneigh{0};
@@ -1091,11 +1118,12 @@ namespace rascal {
       Vector_t pos = center.get_position();
       Vector_t dpos = pos - mesh_min;
       auto box_index = internal::get_box_index(dpos, cutoff);
-      internal::fill_neighbours_atom_tag(atom_tag, box_index, atom_id_cell,
-                                         current_j_atoms);
+      internal::fill_neighbours_atom_tag(atom_tag, box_index,
+                                         this->atom_id_cell,
+                                         this->current_j_atoms);
 
-      nneigh += current_j_atoms.size();
-      for (auto & j_atom_tag : current_j_atoms) {
+      nneigh += this->current_j_atoms.size();
+      for (auto & j_atom_tag : this->current_j_atoms) {
         this->neighbours_atom_tag.push_back(j_atom_tag);
       }
 
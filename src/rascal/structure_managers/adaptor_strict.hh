@@ -36,6 +36,9 @@
 #include "rascal/structure_managers/updateable_base.hh"
 #include "rascal/utils/utils.hh"
 
+#include <algorithm>
+#include <vector>
+
 namespace rascal {
   /*
    * forward declaration for traits
@@ -73,6 +76,20 @@ namespace rascal {
    *
    * This interface should be implemented by all managers with the trait
    * AdaptorTraits::Strict::yes
+   *
+   * With the option `sort_neighbours` the neighbours of each center are
+   * sorted by species and then by distance (the center pair stays first),
+   * and the runs of neighbours of the same species are recorded so that
+   * the species dependent data can be looked up once per run, e.g.
+   *
+   * ```
+   * for (size_t i_run{0}; i_run < manager->get_nb_species_runs(center);
+   *      ++i_run) {
+   *   auto && run{manager->get_species_run(center, i_run)};
+   *   // the neighbours run.begin to run.end of center.pairs() have the
+   *   // species run.atom_type
+   * }
+   * ```
    */
   template <class ManagerImplementation>
   class AdaptorStrict
@@ -102,19 +119,33 @@ namespace rascal {
     constexpr static auto PairLayer{
         Manager_t::template cluster_layer_from_order<2>()};
 
+    /**
+     * Neighbours of a center with the same species when the neighbours are
+     * sorted, begin and end are positions in the iteration over
+     * center.pairs()
+     */
+    struct SpeciesRun {
+      int atom_type;
+      size_t begin;
+      size_t end;
+    };
+
     //! Default constructor
     AdaptorStrict() = delete;
 
     /**
      * construct a strict neighbourhood list from a given manager. `cut-off`
      * specifies the strict cutoff radius. all clusters with distances above
-     * this parameter will be skipped
+     * this parameter will be skipped. If `sort_neighbours` is true the
+     * neighbours of each center are sorted by species and distance.
      */
-    AdaptorStrict(ImplementationPtr_t manager, double cutoff);
+    AdaptorStrict(ImplementationPtr_t manager, double cutoff,
+                  bool sort_neighbours = false);
 
     AdaptorStrict(ImplementationPtr_t manager, const Hypers_t & adaptor_hypers)
         : AdaptorStrict(manager,
-                        adaptor_hypers.at("cutoff").template get<double>()) {}
+                        adaptor_hypers.at("cutoff").template get<double>(),
+                        adaptor_hypers.value("sort_neighbours", false)) {}
 
     //! Copy constructor
     AdaptorStrict(const AdaptorStrict & other) = delete;
@@ -141,6 +172,28 @@ namespace rascal {
     //! returns the (strict) cutoff for the adaptor
     double get_cutoff() const { return this->cutoff; }
 
+    //! whether the neighbours are sorted by species and distance
+    bool are_neighbours_sorted() const { return this->sort_neighbours; }
+
+    //! number of runs of neighbours of the same species of a center
+    template <size_t Layer>
+    size_t get_nb_species_runs(const ClusterRefKey<1, Layer> & center) const {
+      auto && i_center{center.get_cluster_index(AtomLayer)};
+      return this->species_runs_offsets[i_center + 1] -
+             this->species_runs_offsets[i_center];
+    }
+
+    /**
+     * i_run-th run of neighbours of the same species of a center, only
+     * available if the neighbours are sorted
+     */
+    template <size_t Layer>
+    const SpeciesRun & get_species_run(const ClusterRefKey<1, Layer> & center,
+                                       const size_t i_run) const {
+      auto && i_center{center.get_cluster_index(AtomLayer)};
+      return this->species_runs[this->species_runs_offsets[i_center] + i_run];
+    }
+
     size_t get_nb_clusters(int order) const {
       assert(order == 2);
       return this->atom_tag_list[order - 1].size();
@@ -291,6 +344,12 @@ namespace rascal {
     std::shared_ptr<Distance_t> distance;
     std::shared_ptr<DirectionVector_t> dir_vec;
     const double cutoff;
+    //! sort the neighbours of each center by species and distance
+    bool sort_neighbours;
+
+    //! runs of neighbours of the same species of each center, in CSR form
+    std::vector<SpeciesRun> species_runs{};
+    std::vector<size_t> species_runs_offsets{};
 
     /**
      * store atom tags per order,i.e.
@@ -348,11 +407,13 @@ namespace rascal {
   /*--------------------------------------------------------------------------*/
   template <class ManagerImplementation>
   AdaptorStrict<ManagerImplementation>::AdaptorStrict(
-      std::shared_ptr<ManagerImplementation> manager, double cutoff)
+      std::shared_ptr<ManagerImplementation> manager, double cutoff,
+      bool sort_neighbours)
       : manager{std::move(manager)}, distance{std::make_shared<Distance_t>(
                                          *this)},
         dir_vec{std::make_shared<DirectionVector_t>(*this)}, cutoff{cutoff},
-        atom_tag_list{}, neighbours_cluster_index{}, nb_neigh{}, offsets{}
+        sort_neighbours{sort_neighbours}, atom_tag_list{},
+        neighbours_cluster_index{}, nb_neigh{}, offsets{}
 
   {
     if (not internal::check_cutoff(this->manager, cutoff)) {
@@ -403,6 +464,44 @@ namespace rascal {
 
     double rc2{this->cutoff * this->cutoff};
 
+    this->species_runs.clear();
+    this->species_runs_offsets.assign(1, 0);
+
+    auto add_pair = [&](const int atom_tag, const double distance2,
+                        const Eigen::Vector3d & vec_ij,
+                        const Eigen::Matrix<size_t, PairLayer, 1> &
+                            cluster_indices) {
+      this->template add_atom<1>(atom_tag);
+      double distance{std::sqrt(distance2)};
+      if (distance2 > 0.) {
+        this->dir_vec->push_back((vec_ij.array() / distance).matrix());
+      } else {
+        this->dir_vec->push_back((vec_ij.array()).matrix());
+      }
+
+      this->distance->push_back(distance);
+
+      Eigen::Matrix<size_t, PairLayer + 1, 1> indices_pair;
+      indices_pair.template head<PairLayer>() = cluster_indices;
+      indices_pair(PairLayer) = pair_counter;
+      pair_cluster_indices.push_back(indices_pair);
+      pair_counter++;
+    };
+
+    // pairs of the current center within the cutoff, only buffered when
+    // they have to be sorted
+    struct StrictPair {
+      int atom_tag;
+      int atom_type;
+      double distance2;
+      Eigen::Vector3d vector;
+      Eigen::Matrix<size_t, PairLayer, 1> cluster_indices;
+    };
+    std::vector<StrictPair, Eigen::aligned_allocator<StrictPair>>
+        strict_pairs{};
+    // the center pair, if any, is the first pair and stays first
+    constexpr size_t NbCenterPairs{traits::HasCenterPair ? 1 : 0};
+
     for (auto && atom : this->manager) {
       this->add_atom(atom);
       /**
@@ -413,27 +512,55 @@ namespace rascal {
       indices.template head<AtomLayer>() = atom.get_cluster_indices();
       indices(AtomLayer) = indices(AtomLayer - 1);
       atom_cluster_indices.push_back(indices);
+
+      if (not this->sort_neighbours) {
+        for (auto pair : atom.pairs_with_self_pair()) {
+          auto vec_ij{pair.get_position() - atom.get_position()};
+          double distance2{(vec_ij).squaredNorm()};
+          if (distance2 <= rc2) {
+            add_pair(pair.get_atom_tag(), distance2, vec_ij,
+                     pair.get_cluster_indices());
+          }
+        }
+        this->species_runs_offsets.push_back(this->species_runs.size());
+        continue;
+      }
+
+      strict_pairs.clear();
       for (auto pair : atom.pairs_with_self_pair()) {
         auto vec_ij{pair.get_position() - atom.get_position()};
         double distance2{(vec_ij).squaredNorm()};
         if (distance2 <= rc2) {
-          this->add_atom(pair);
-          double distance{std::sqrt(distance2)};
-          if (distance2 > 0.) {
-            this->dir_vec->push_back((vec_ij.array() / distance).matrix());
-          } else {
-            this->dir_vec->push_back((vec_ij.array()).matrix());
+          strict_pairs.push_back({pair.get_atom_tag(), pair.get_atom_type(),
+                                  distance2, vec_ij,
+                                  pair.get_cluster_indices()});
+        }
+      }
+      if (strict_pairs.size() > NbCenterPairs) {
+        std::stable_sort(strict_pairs.begin() + NbCenterPairs,
+                         strict_pairs.end(),
+                         [](const StrictPair & a, const StrictPair & b) {
+                           return (a.atom_type < b.atom_type) or
+                                  (a.atom_type == b.atom_type and
+                                   a.distance2 < b.distance2);
+                         });
+        for (size_t i_pair{NbCenterPairs}; i_pair < strict_pairs.size();
+             ++i_pair) {
+          const int atom_type{strict_pairs[i_pair].atom_type};
+          const size_t position{i_pair - NbCenterPairs};
+          if (this->species_runs.size() == this->species_runs_offsets.back() or
+              this->species_runs.back().atom_type != atom_type) {
+            this->species_runs.push_back({atom_type, position, position});
           }
-
-          this->distance->push_back(distance);
-
-          Eigen::Matrix<size_t, PairLayer + 1, 1> indices_pair;
-          indices_pair.template head<PairLayer>() = pair.get_cluster_indices();
-          indices_pair(PairLayer) = pair_counter;
-          pair_cluster_indices.push_back(indices_pair);
-          pair_counter++;
+          this->species_runs.back().end = position + 1;
         }
       }
+      this->species_runs_offsets.push_back(this->species_runs.size());
+
+      for (auto && pair : strict_pairs) {
+        add_pair(pair.atom_tag, pair.distance2, pair.vector,
+                 pair.cluster_indices);
+      }
     }
 
     for (auto && atom : this->manager->only_ghosts()) {
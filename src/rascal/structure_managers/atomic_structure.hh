@@ -178,20 +178,41 @@ namespace rascal {
      * fold the atoms inside the box if it has periodic boundary conditions
      */
     void wrap() {
-      auto scaled_positions = this->get_scaled_positions();
-
-      for (int i_dim{0}; i_dim < Dim; ++i_dim) {
-        if (this->pbc[i_dim]) {
-          scaled_positions.row(i_dim) =
-              scaled_positions.row(i_dim).unaryExpr([](double d) {
-                // Modulo that follows python standard, i.e. (-3) % 5 == 2
-                // (python) and not (-3) % 5 == -3 (C++).
-                auto m = std::fmod(d, 1.0);
-                return m + (m < 0 ? 1.0 : 0);
-              });
+      // the atoms are folded one at a time to avoid allocating a copy of the
+      // positions, e.g. when wrapping every frame of a trajectory
+      const Cell_t inverse_cell{this->cell.inverse()};
+      Vec_t scaled_position{};
+      for (int i_atom{0}; i_atom < this->positions.cols(); ++i_atom) {
+        scaled_position = inverse_cell * this->positions.col(i_atom);
+        for (int i_dim{0}; i_dim < Dim; ++i_dim) {
+          if (this->pbc[i_dim]) {
+            // Modulo that follows python standard, i.e. (-3) % 5 == 2
+            // (python) and not (-3) % 5 == -3 (C++).
+            auto m = std::fmod(scaled_position(i_dim), 1.0);
+            scaled_position(i_dim) = m + (m < 0 ? 1.0 : 0);
+          }
         }
+        this->positions.col(i_atom) = this->cell * scaled_position;
       }
-      this->positions = this->cell * scaled_positions;
+    }
+
+    /**
+     * Replace the cell by an orthorhombic box 5% larger than the extent of
+     * the atoms and center the atoms in it, i.e. a cell that contains all
+     * the atoms of a non periodic structure. A direction in which the atoms
+     * have no extent gets a box length of 1.
+     */
+    void set_bounding_box_cell() {
+      if (this->get_number_of_atoms() == 0) {
+        this->cell = Cell_t::Identity();
+        return;
+      }
+      const Vec_t lower{this->positions.rowwise().minCoeff()};
+      const Vec_t upper{this->positions.rowwise().maxCoeff()};
+      Vec_t lengths{1.05 * (upper - lower)};
+      lengths = (lengths.array() > 0).select(lengths, Vec_t::Ones());
+      this->positions.colwise() += 0.5 * (lengths - lower - upper);
+      this->cell = lengths.asDiagonal();
     }
 
     /**
@@ -0,0 +1,467 @@
+/**
+ * @file   rascal/structure_managers/domain_decomposition.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 October 2026
+ *
+ * @brief  spatial decomposition of large structures into domains with halos
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_RASCAL_STRUCTURE_MANAGERS_DOMAIN_DECOMPOSITION_HH_
+#define SRC_RASCAL_STRUCTURE_MANAGERS_DOMAIN_DECOMPOSITION_HH_
+
+#include "rascal/math/utils.hh"
+#include "rascal/structure_managers/adaptor_center_contribution.hh"
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/atomic_structure.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+#include "rascal/utils/json_io.hh"
+#include "rascal/utils/parallel.hh"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace rascal {
+
+  /**
+   * Spatial decomposition of a (large) atomic structure into domains so that
+   * representations and predictions can be computed domain by domain with a
+   * bounded memory footprint.
+   *
+   * The structure is cut into n_domains[0] x n_domains[1] x n_domains[2]
+   * boxes in the fractional coordinates of its cell (along the non periodic
+   * directions the boxes span the extent of the atoms). Each domain holds a
+   * non periodic AtomicStructure made of the centers that fall in its box
+   * followed by a halo made of the atoms, or periodic images of atoms,
+   * within one cutoff of the box. The halo atoms are masked with
+   * center_atoms_mask so the environments of the centers of the domain are
+   * complete but only these centers are computed.
+   *
+   * The manager stack of a domain is built only when the domain is processed
+   * and released once its results have been extracted, so the memory used
+   * by the neighbour lists, the representations and their gradients scales
+   * with the size of the domains times the number of threads rather than
+   * with the size of the structure. The results are stitched back in the
+   * order of the centers of the original structure using
+   * Domain::atom_indices.
+   */
+  class DomainDecomposition {
+   public:
+    using Structure_t = AtomicStructure<3>;
+    using ManagerTypeHolder_t =
+        StructureManagerTypeHolder<StructureManagerCenters,
+                                   AdaptorNeighbourList,
+                                   AdaptorCenterContribution, AdaptorStrict>;
+    using Manager_t = typename ManagerTypeHolder_t::type;
+    using ManagerPtr_t = std::shared_ptr<Manager_t>;
+
+    //! a domain of the decomposition
+    struct Domain {
+      //! centers of the domain followed by the (masked) halo atoms
+      Structure_t structure{};
+      //! index in the original structure of each atom of structure
+      std::vector<size_t> atom_indices{};
+      //! number of centers, i.e. the n_centers first atoms of structure
+      size_t n_centers{0};
+    };
+
+    /**
+     * @param structure the structure to decompose. Its center_atoms_mask is
+     *        honoured, i.e. masked atoms only appear in the halos.
+     * @param cutoff interaction cutoff of the representation
+     * @param n_domains number of domains along each cell vector
+     *
+     * @throw std::runtime_error if the cutoff is not positive, the number of
+     *        domains is smaller than 1 along some direction or the cell is
+     *        singular.
+     */
+    DomainDecomposition(const Structure_t & structure, const double cutoff,
+                        const std::array<int, 3> & n_domains)
+        : cutoff{cutoff}, n_atoms{structure.get_number_of_atoms()},
+          periodic{(structure.pbc.array() != 0).any()} {
+      if (cutoff <= 0.) {
+        std::stringstream err_str{};
+        err_str << "The cutoff of the domain decomposition should be "
+                << "positive: '" << cutoff << "'.";
+        throw std::runtime_error(err_str.str());
+      }
+      for (int i_dim{0}; i_dim < ThreeD; ++i_dim) {
+        if (n_domains[i_dim] < 1) {
+          std::stringstream err_str{};
+          err_str << "The number of domains along dimension " << i_dim
+                  << " should be at least 1: '" << n_domains[i_dim] << "'.";
+          throw std::runtime_error(err_str.str());
+        }
+      }
+      if (std::abs(structure.cell.determinant()) < math::DBL_FTOL) {
+        throw std::runtime_error(
+            "The domain decomposition requires a non singular cell.");
+      }
+      this->volume = std::abs(structure.cell.determinant());
+      this->decompose(structure, n_domains);
+    }
+
+    //! number of (non empty) domains
+    size_t size() const { return this->domains.size(); }
+
+    const Domain & operator[](const size_t i_domain) const {
+      return this->domains[i_domain];
+    }
+
+    //! number of atoms of the original structure
+    size_t get_number_of_atoms() const { return this->n_atoms; }
+
+    //! number of centers of the original structure
+    size_t get_number_of_centers() const { return this->n_centers; }
+
+    /**
+     * Row of each atom of the original structure in the stitched per center
+     * results, i.e. its position among the centers, or -1 if it is not a
+     * center.
+     */
+    const std::vector<int> & get_center_rows() const {
+      return this->center_rows;
+    }
+
+    double get_cutoff() const { return this->cutoff; }
+
+    //! volume of the cell of the original structure
+    double get_volume() const { return this->volume; }
+
+    //! is the original structure periodic along some direction
+    bool is_periodic() const { return this->periodic; }
+
+    //! parameters of the adaptors of the manager stack of the domains
+    json get_adaptor_inputs() const {
+      json adaptors{
+          {{"name", "AdaptorNeighbourList"},
+           {"initialization_arguments",
+            {{"cutoff", this->cutoff}, {"skin", 0.}}}},
+          {{"name", "AdaptorCenterContribution"},
+           {"initialization_arguments", {}}},
+          {{"name", "AdaptorStrict"},
+           {"initialization_arguments", {{"cutoff", this->cutoff}}}}};
+      return adaptors;
+    }
+
+    /**
+     * Build the manager stack of each domain and call
+     * func(manager, i_domain, i_thread) with it using n_threads threads.
+     * The manager is released when func returns so func has to extract the
+     * results it needs. func is called concurrently so it should only write
+     * to buffers owned by i_domain or i_thread.
+     */
+    template <typename Func>
+    void for_each_domain(Func && func, const size_t n_threads) const {
+      const json adaptor_inputs = this->get_adaptor_inputs();
+      internal::parallel_for(
+          this->domains.size(), n_threads,
+          [&](const size_t i_domain, const size_t i_thread) {
+            ManagerPtr_t manager{
+                make_structure_manager_stack<StructureManagerCenters,
+                                             AdaptorNeighbourList,
+                                             AdaptorCenterContribution,
+                                             AdaptorStrict>(json{},
+                                                            adaptor_inputs)};
+            manager->update(this->domains[i_domain].structure);
+            func(manager, i_domain, i_thread);
+          });
+    }
+
+    /**
+     * Compute the representation defined by hypers domain by domain and
+     * return the dense feature matrix of the centers of the original
+     * structure (in their original order). Only block sparse
+     * representations, e.g. SphericalExpansion and SphericalInvariants, are
+     * supported.
+     *
+     * Each thread uses its own calculator since the calculators hold
+     * internal buffers.
+     */
+    template <class Calculator>
+    math::Matrix_t compute_features(const json & hypers,
+                                    size_t n_threads) const {
+      using Property_t = typename Calculator::template Property_t<Manager_t>;
+      using Keys_t = typename Property_t::Keys_t;
+      using Key_t = typename Property_t::Key_t;
+
+      n_threads = std::max(std::min(n_threads, this->size()), size_t(1));
+      std::vector<Calculator> calculators{};
+      calculators.reserve(n_threads);
+      for (size_t i_thread{0}; i_thread < n_threads; ++i_thread) {
+        calculators.emplace_back(hypers);
+      }
+
+      std::vector<Keys_t> keys_by_domain(this->size());
+      std::vector<math::Matrix_t> features_by_domain(this->size());
+      this->for_each_domain(
+          [&](ManagerPtr_t & manager, const size_t i_domain,
+              const size_t i_thread) {
+            auto & calculator = calculators[i_thread];
+            calculator.compute(manager);
+            auto && prop{*manager->template get_property<Property_t>(
+                calculator.get_name(), true)};
+            keys_by_domain[i_domain] = prop.get_keys();
+            features_by_domain[i_domain] = prop.get_features();
+          },
+          n_threads);
+
+      // the domains do not necessarily have the same keys so the features
+      // are aligned on the keys of the whole structure
+      Keys_t all_keys{};
+      int inner_size{0};
+      for (size_t i_domain{0}; i_domain < this->size(); ++i_domain) {
+        const auto & keys = keys_by_domain[i_domain];
+        all_keys.insert(keys.begin(), keys.end());
+        if (keys.size() > 0) {
+          inner_size = static_cast<int>(features_by_domain[i_domain].cols() /
+                                        keys.size());
+        }
+      }
+      std::map<Key_t, int> col_by_key{};
+      int i_col{0};
+      for (const auto & key : all_keys) {
+        col_by_key[key] = i_col;
+        i_col += inner_size;
+      }
+
+      math::Matrix_t features =
+          math::Matrix_t::Zero(this->n_centers, i_col);
+      for (size_t i_domain{0}; i_domain < this->size(); ++i_domain) {
+        const auto & domain = this->domains[i_domain];
+        const auto & domain_features = features_by_domain[i_domain];
+        for (size_t i_center{0}; i_center < domain.n_centers; ++i_center) {
+          const int i_row{this->center_rows[domain.atom_indices[i_center]]};
+          int i_col_domain{0};
+          for (const auto & key : keys_by_domain[i_domain]) {
+            features.block(i_row, col_by_key[key], 1, inner_size) =
+                domain_features.block(i_center, i_col_domain, 1, inner_size);
+            i_col_domain += inner_size;
+          }
+        }
+        features_by_domain[i_domain].resize(0, 0);
+      }
+      return features;
+    }
+
+   protected:
+    /**
+     * Assign the centers to the domains and collect the halos. Along the
+     * periodic directions the fractional coordinates are wrapped and the
+     * periodic images within one cutoff of a domain are added to its halo.
+     */
+    void decompose(const Structure_t & structure,
+                   const std::array<int, 3> & n_domains) {
+      using Vector_t = Eigen::Vector3d;
+      const Eigen::Matrix3d cell_inv{structure.cell.inverse()};
+      Eigen::Matrix<double, ThreeD, Eigen::Dynamic> scaled{
+          cell_inv * structure.positions};
+
+      // by default all atoms are centers
+      std::vector<bool> is_center(this->n_atoms, true);
+      if (static_cast<size_t>(structure.center_atoms_mask.size()) ==
+          this->n_atoms) {
+        for (size_t i_atom{0}; i_atom < this->n_atoms; ++i_atom) {
+          is_center[i_atom] = structure.center_atoms_mask(i_atom);
+        }
+      }
+
+      std::array<double, ThreeD> s_min{}, width{}, halo{};
+      std::array<int, ThreeD> n_shifts{};
+      for (int i_dim{0}; i_dim < ThreeD; ++i_dim) {
+        // one cutoff in fractional coordinates along the i_dim cell vector,
+        // i.e. the cutoff over the distance between the lattice planes
+        halo[i_dim] = this->cutoff * cell_inv.row(i_dim).norm();
+        double s_max{1.};
+        if (structure.pbc(i_dim)) {
+          scaled.row(i_dim) = scaled.row(i_dim).unaryExpr(
+              [](double s) { return s - std::floor(s); });
+          s_min[i_dim] = 0.;
+          n_shifts[i_dim] = static_cast<int>(std::ceil(halo[i_dim]));
+        } else if (this->n_atoms > 0) {
+          s_min[i_dim] = scaled.row(i_dim).minCoeff();
+          s_max = scaled.row(i_dim).maxCoeff();
+          n_shifts[i_dim] = 0;
+        }
+        width[i_dim] = (s_max - s_min[i_dim]) / n_domains[i_dim];
+        if (width[i_dim] <= 0.) {
+          // all the atoms are on the same plane
+          width[i_dim] = 1.;
+        }
+      }
+
+      // index of the domain containing s along i_dim, possibly out of range
+      auto get_domain_index = [&s_min, &width](const double s,
+                                               const int i_dim) {
+        return static_cast<int>(std::floor((s - s_min[i_dim]) / width[i_dim]));
+      };
+      auto get_flat_index = [&n_domains](const std::array<int, ThreeD> & idx) {
+        return (idx[0] * n_domains[1] + idx[1]) * n_domains[2] + idx[2];
+      };
+
+      const int n_domains_tot{n_domains[0] * n_domains[1] * n_domains[2]};
+      std::vector<std::vector<size_t>> centers(n_domains_tot);
+      std::vector<std::vector<size_t>> halo_indices(n_domains_tot);
+      std::vector<std::vector<Vector_t>> halo_positions(n_domains_tot);
+
+      // home domain of the centers
+      std::vector<int> home_domain(this->n_atoms, -1);
+      for (size_t i_atom{0}; i_atom < this->n_atoms; ++i_atom) {
+        if (not is_center[i_atom]) {
+          continue;
+        }
+        std::array<int, ThreeD> idx{};
+        for (int i_dim{0}; i_dim < ThreeD; ++i_dim) {
+          idx[i_dim] = std::min(
+              std::max(get_domain_index(scaled(i_dim, i_atom), i_dim), 0),
+              n_domains[i_dim] - 1);
+        }
+        home_domain[i_atom] = get_flat_index(idx);
+        centers[home_domain[i_atom]].push_back(i_atom);
+      }
+
+      // halos: every image within one cutoff of a domain and that is not one
+      // of its centers
+      for (size_t i_atom{0}; i_atom < this->n_atoms; ++i_atom) {
+        for (int sx{-n_shifts[0]}; sx <= n_shifts[0]; ++sx) {
+          for (int sy{-n_shifts[1]}; sy <= n_shifts[1]; ++sy) {
+            for (int sz{-n_shifts[2]}; sz <= n_shifts[2]; ++sz) {
+              const Vector_t shift{static_cast<double>(sx),
+                                   static_cast<double>(sy),
+                                   static_cast<double>(sz)};
+              const Vector_t s{scaled.col(i_atom) + shift};
+              const bool is_image{sx != 0 or sy != 0 or sz != 0};
+              std::array<int, ThreeD> lo{}, hi{};
+              bool in_range{true};
+              for (int i_dim{0}; i_dim < ThreeD; ++i_dim) {
+                lo[i_dim] = std::max(
+                    get_domain_index(s(i_dim) - halo[i_dim], i_dim), 0);
+                hi[i_dim] =
+                    std::min(get_domain_index(s(i_dim) + halo[i_dim], i_dim),
+                             n_domains[i_dim] - 1);
+                in_range = in_range and (lo[i_dim] <= hi[i_dim]);
+              }
+              if (not in_range) {
+                continue;
+              }
+              const Vector_t position{structure.cell * s};
+              std::array<int, ThreeD> idx{};
+              for (idx[0] = lo[0]; idx[0] <= hi[0]; ++idx[0]) {
+                for (idx[1] = lo[1]; idx[1] <= hi[1]; ++idx[1]) {
+                  for (idx[2] = lo[2]; idx[2] <= hi[2]; ++idx[2]) {
+                    const int i_domain{get_flat_index(idx)};
+                    if (not is_image and home_domain[i_atom] == i_domain) {
+                      continue;
+                    }
+                    halo_indices[i_domain].push_back(i_atom);
+                    halo_positions[i_domain].push_back(position);
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+
+      this->n_centers = 0;
+      this->center_rows.assign(this->n_atoms, -1);
+      for (size_t i_atom{0}; i_atom < this->n_atoms; ++i_atom) {
+        if (is_center[i_atom]) {
+          this->center_rows[i_atom] = static_cast<int>(this->n_centers);
+          this->n_centers++;
+        }
+      }
+
+      for (int i_domain{0}; i_domain < n_domains_tot; ++i_domain) {
+        if (centers[i_domain].empty()) {
+          continue;
+        }
+        this->domains.emplace_back();
+        auto & domain = this->domains.back();
+        const size_t n_domain_centers{centers[i_domain].size()};
+        const size_t n_domain_atoms{n_domain_centers +
+                                    halo_indices[i_domain].size()};
+        domain.n_centers = n_domain_centers;
+        domain.atom_indices = centers[i_domain];
+        domain.atom_indices.insert(domain.atom_indices.end(),
+                                   halo_indices[i_domain].begin(),
+                                   halo_indices[i_domain].end());
+
+        auto & domain_structure = domain.structure;
+        domain_structure.positions.resize(ThreeD, n_domain_atoms);
+        domain_structure.atom_types.resize(n_domain_atoms);
+        domain_structure.center_atoms_mask =
+            Structure_t::ArrayB_t::Constant(n_domain_atoms, false);
+        for (size_t i_atom{0}; i_atom < n_domain_atoms; ++i_atom) {
+          const size_t i_original{domain.atom_indices[i_atom]};
+          if (i_atom < n_domain_centers) {
+            domain_structure.positions.col(i_atom) =
+                structure.cell * scaled.col(i_original);
+            domain_structure.center_atoms_mask(i_atom) = true;
+          } else {
+            domain_structure.positions.col(i_atom) =
+                halo_positions[i_domain][i_atom - n_domain_centers];
+          }
+          domain_structure.atom_types(i_atom) =
+              structure.atom_types(i_original);
+        }
+
+        // the domain is an isolated cluster: shift it into an orthorhombic
+        // box that contains all its atoms as the neighbour list requires
+        Vector_t pos_min{domain_structure.positions.rowwise().minCoeff()};
+        Vector_t extent{domain_structure.positions.rowwise().maxCoeff() -
+                        pos_min};
+        domain_structure.positions.colwise() -= pos_min;
+        domain_structure.cell =
+            extent.array().max(this->cutoff).matrix().asDiagonal();
+        domain_structure.pbc.setZero();
+      }
+    }
+
+    //! interaction cutoff, i.e. width of the halos
+    double cutoff;
+    //! number of atoms in the original structure
+    size_t n_atoms;
+    //! number of centers in the original structure
+    size_t n_centers{0};
+    //! is the original structure periodic along some direction
+    bool periodic;
+    //! volume of the cell of the original structure
+    double volume{0.};
+    //! see get_center_rows
+    std::vector<int> center_rows{};
+    //! non empty domains
+    std::vector<Domain> domains{};
+  };
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_STRUCTURE_MANAGERS_DOMAIN_DECOMPOSITION_HH_
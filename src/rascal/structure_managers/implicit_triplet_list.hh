@@ -0,0 +1,340 @@
+/**
+ * @file   rascal/structure_managers/implicit_triplet_list.hh
+ *
+ * @date   18 October 2026
+ *
+ * @brief  triplets generated on the fly from a compressed pair list
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_RASCAL_STRUCTURE_MANAGERS_IMPLICIT_TRIPLET_LIST_HH_
+#define SRC_RASCAL_STRUCTURE_MANAGERS_IMPLICIT_TRIPLET_LIST_HH_
+
+#include "rascal/utils/utils.hh"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace rascal {
+
+  /**
+   * Triplets (i, j, k) of a pair list that are generated on the fly instead
+   * of being stored like in AdaptorMaxOrder.
+   *
+   * Only the pairs are stored, in compressed sparse row (CSR) form: the
+   * neighbours of the i-th center are the entries offsets[i] to
+   * offsets[i+1] of the neighbour arrays, which hold the atom tag, the
+   * distance and the unit direction vector of each neighbour. The memory is
+   * O(N k) instead of the O(N k^2) of the explicit triplets, for N centers
+   * with k neighbours.
+   *
+   * The triplets of a center are the unordered pairs {j, k}, j != k, of its
+   * neighbours that are within the angular cutoff (by default all the
+   * neighbours). The neighbours of a center are stored with the ones within
+   * the angular cutoff first, in the order of the pair list, so that the
+   * triplets only span a contiguous block of the CSR. With a full neighbour
+   * list the triplets are the ones of AdaptorMaxOrder without the
+   * permutations of j and k, i.e. AdaptorMaxOrder has twice as many.
+   *
+   * The triplets of a center are visited either one by one with
+   * for_each_triplet or in contiguous batches with their cosines computed
+   * at once with for_each_triplet_batch. Both are const so several threads
+   * can visit the triplets of different centers, each with its own batch.
+   *
+   * @tparam Manager structure manager with (at least) a pair list
+   */
+  template <class Manager>
+  class ImplicitTripletList {
+   public:
+    using ManagerPtr_t = std::shared_ptr<Manager>;
+    using Directions_t = Eigen::Matrix<double, ThreeD, Eigen::Dynamic>;
+
+    static_assert(Manager::traits::MaxOrder >= 2,
+                  "The manager needs at least a pair list to build triplets.");
+
+    /**
+     * A contiguous batch of triplets of one center. The arrays are reusable
+     * buffers that are only grown, the first size entries are valid.
+     */
+    struct TripletBatch {
+      //! index of the center in the list
+      size_t center{0};
+      //! number of valid triplets in the batch
+      size_t size{0};
+      //! indices in the pair CSR of the j and k neighbours
+      std::vector<size_t> neighbours_j{};
+      std::vector<size_t> neighbours_k{};
+      //! cosine of the angle between r_ij and r_ik
+      Eigen::ArrayXd cosines{};
+      //! |r_ij| and |r_ik|
+      Eigen::ArrayXd distances_j{};
+      Eigen::ArrayXd distances_k{};
+      //! cosines between all the angular neighbours of the center
+      Eigen::MatrixXd gram{};
+
+      void reserve(const size_t n_triplets) {
+        if (static_cast<size_t>(this->cosines.size()) < n_triplets) {
+          this->neighbours_j.resize(n_triplets);
+          this->neighbours_k.resize(n_triplets);
+          this->cosines.resize(n_triplets);
+          this->distances_j.resize(n_triplets);
+          this->distances_k.resize(n_triplets);
+        }
+      }
+    };
+
+    /**
+     * @param angular_cutoff only the neighbours closer than angular_cutoff
+     *        from the center form triplets, by default all the neighbours
+     *        of the pair list.
+     *
+     * @throw std::runtime_error if the angular cutoff is not positive
+     */
+    explicit ImplicitTripletList(
+        const double angular_cutoff = std::numeric_limits<double>::infinity())
+        : angular_cutoff{angular_cutoff} {
+      if (not(angular_cutoff > 0.)) {
+        std::stringstream err_str{};
+        err_str << "The angular cutoff of the triplets should be positive: '"
+                << angular_cutoff << "'.";
+        throw std::runtime_error(err_str.str());
+      }
+    }
+
+    //! (re)builds the pair CSR from the current state of manager
+    void update(const ManagerPtr_t & manager);
+
+    //! number of centers
+    size_t size() const { return this->center_atom_tags.size(); }
+
+    //! number of pairs of the CSR
+    size_t get_nb_pairs() const { return this->neighbour_atom_tags.size(); }
+
+    //! number of triplets of all the centers
+    size_t get_nb_triplets() const {
+      size_t n_triplets{0};
+      for (size_t i_center{0}; i_center < this->size(); ++i_center) {
+        n_triplets += this->get_nb_triplets(i_center);
+      }
+      return n_triplets;
+    }
+
+    //! number of triplets of a center
+    size_t get_nb_triplets(const size_t i_center) const {
+      const size_t n_angular{this->n_angular_neighbours[i_center]};
+      return n_angular * (n_angular - (n_angular > 0)) / 2;
+    }
+
+    //! angular cutoff of the triplets
+    double get_angular_cutoff() const { return this->angular_cutoff; }
+
+    int get_center_atom_tag(const size_t i_center) const {
+      return this->center_atom_tags[i_center];
+    }
+
+    //! index in the CSR of the first neighbour of a center
+    size_t get_offset(const size_t i_center) const {
+      return this->offsets[i_center];
+    }
+
+    //! number of neighbours of a center
+    size_t get_nb_neighbours(const size_t i_center) const {
+      return this->offsets[i_center + 1] - this->offsets[i_center];
+    }
+
+    //! number of neighbours of a center within the angular cutoff
+    size_t get_nb_angular_neighbours(const size_t i_center) const {
+      return this->n_angular_neighbours[i_center];
+    }
+
+    int get_neighbour_atom_tag(const size_t i_pair) const {
+      return this->neighbour_atom_tags[i_pair];
+    }
+
+    //! position of the pair in the iteration over center.pairs()
+    size_t get_pair_index(const size_t i_pair) const {
+      return this->pair_indices[i_pair];
+    }
+
+    double get_distance(const size_t i_pair) const {
+      return this->distances(i_pair);
+    }
+
+    //! unit vector from the center to the neighbour
+    Eigen::Ref<const Eigen::Vector3d> get_direction(const size_t i_pair) const {
+      return this->directions.col(i_pair);
+    }
+
+    /**
+     * Calls function(i_pair_j, i_pair_k, cosine) for each triplet of the
+     * center with j before k in the CSR.
+     */
+    template <class Function>
+    void for_each_triplet(const size_t i_center, Function && function) const {
+      const size_t begin{this->offsets[i_center]};
+      const size_t end{begin + this->n_angular_neighbours[i_center]};
+      for (size_t i_pair_j{begin}; i_pair_j < end; ++i_pair_j) {
+        for (size_t i_pair_k{i_pair_j + 1}; i_pair_k < end; ++i_pair_k) {
+          function(i_pair_j, i_pair_k,
+                   this->directions.col(i_pair_j).dot(
+                       this->directions.col(i_pair_k)));
+        }
+      }
+    }
+
+    /**
+     * Calls function(batch) with the triplets of the center, in the order
+     * of for_each_triplet, by batches of at most batch_size triplets. The
+     * cosines of all the triplets of the center are computed at once as the
+     * Gram matrix of the directions of its angular neighbours.
+     */
+    template <class Function>
+    void for_each_triplet_batch(const size_t i_center, const size_t batch_size,
+                                TripletBatch & batch,
+                                Function && function) const;
+
+   protected:
+    double angular_cutoff;
+    //! atom tag of each center
+    std::vector<int> center_atom_tags{};
+    //! offsets of the neighbours of each center, size() + 1 entries
+    std::vector<size_t> offsets{};
+    //! number of neighbours of each center within the angular cutoff
+    std::vector<size_t> n_angular_neighbours{};
+    //! per pair of the CSR
+    std::vector<int> neighbour_atom_tags{};
+    std::vector<size_t> pair_indices{};
+    Eigen::ArrayXd distances{};
+    Directions_t directions{};
+  };
+
+  /* ---------------------------------------------------------------------- */
+  template <class Manager>
+  void ImplicitTripletList<Manager>::update(const ManagerPtr_t & manager) {
+    const size_t n_centers{manager->size()};
+    // upper bound, e.g. it also counts the center pairs
+    const size_t max_pairs{manager->get_nb_clusters(2)};
+    this->center_atom_tags.clear();
+    this->center_atom_tags.reserve(n_centers);
+    this->offsets.clear();
+    this->offsets.reserve(n_centers + 1);
+    this->offsets.push_back(0);
+    this->n_angular_neighbours.clear();
+    this->n_angular_neighbours.reserve(n_centers);
+    this->neighbour_atom_tags.resize(max_pairs);
+    this->pair_indices.resize(max_pairs);
+    this->distances.resize(max_pairs);
+    this->directions.resize(ThreeD, max_pairs);
+
+    size_t i_pair{0};
+    // neighbours beyond the angular cutoff of the current center, they are
+    // stored after the ones within
+    struct OuterNeighbour {
+      int atom_tag;
+      size_t pair_index;
+      Eigen::Vector3d vector;
+    };
+    std::vector<OuterNeighbour> outer_neighbours{};
+    auto add_pair = [this, &i_pair](const int atom_tag, const size_t pair_index,
+                                    const Eigen::Vector3d & vector) {
+      const double distance{vector.norm()};
+      this->neighbour_atom_tags[i_pair] = atom_tag;
+      this->pair_indices[i_pair] = pair_index;
+      this->distances(i_pair) = distance;
+      this->directions.col(i_pair) = vector / distance;
+      i_pair++;
+    };
+    for (auto center : manager) {
+      this->center_atom_tags.push_back(center.get_atom_tag());
+      const Eigen::Vector3d center_position{center.get_position()};
+      outer_neighbours.clear();
+      size_t n_angular{0};
+      size_t pair_index{0};
+      for (auto neigh : center.pairs()) {
+        const Eigen::Vector3d vector{neigh.get_position() - center_position};
+        if (vector.norm() < this->angular_cutoff) {
+          add_pair(neigh.get_atom_tag(), pair_index, vector);
+          n_angular++;
+        } else {
+          outer_neighbours.push_back({neigh.get_atom_tag(), pair_index, vector});
+        }
+        pair_index++;
+      }
+      for (auto && outer : outer_neighbours) {
+        add_pair(outer.atom_tag, outer.pair_index, outer.vector);
+      }
+      this->n_angular_neighbours.push_back(n_angular);
+      this->offsets.push_back(i_pair);
+    }
+    this->neighbour_atom_tags.resize(i_pair);
+    this->pair_indices.resize(i_pair);
+    this->distances.conservativeResize(i_pair);
+    this->directions.conservativeResize(ThreeD, i_pair);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <class Manager>
+  template <class Function>
+  void ImplicitTripletList<Manager>::for_each_triplet_batch(
+      const size_t i_center, const size_t batch_size, TripletBatch & batch,
+      Function && function) const {
+    if (batch_size == 0) {
+      throw std::runtime_error("The size of the triplet batches should be "
+                               "positive.");
+    }
+    const size_t begin{this->offsets[i_center]};
+    const size_t n_angular{this->n_angular_neighbours[i_center]};
+    if (n_angular < 2) {
+      return;
+    }
+    auto && angular_directions{this->directions.middleCols(begin, n_angular)};
+    batch.gram.resize(n_angular, n_angular);
+    batch.gram.noalias() = angular_directions.transpose() * angular_directions;
+    batch.reserve(std::min(batch_size, this->get_nb_triplets(i_center)));
+    batch.center = i_center;
+    batch.size = 0;
+    for (size_t j_neigh{0}; j_neigh < n_angular; ++j_neigh) {
+      for (size_t k_neigh{j_neigh + 1}; k_neigh < n_angular; ++k_neigh) {
+        const size_t i_triplet{batch.size};
+        batch.neighbours_j[i_triplet] = begin + j_neigh;
+        batch.neighbours_k[i_triplet] = begin + k_neigh;
+        batch.cosines(i_triplet) = batch.gram(j_neigh, k_neigh);
+        batch.distances_j(i_triplet) = this->distances(begin + j_neigh);
+        batch.distances_k(i_triplet) = this->distances(begin + k_neigh);
+        batch.size++;
+        if (batch.size == batch_size) {
+          function(static_cast<const TripletBatch &>(batch));
+          batch.size = 0;
+        }
+      }
+    }
+    if (batch.size > 0) {
+      function(static_cast<const TripletBatch &>(batch));
+    }
+  }
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_STRUCTURE_MANAGERS_IMPLICIT_TRIPLET_LIST_HH_
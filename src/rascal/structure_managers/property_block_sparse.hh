@@ -33,6 +33,7 @@
 #include "rascal/math/utils.hh"
 #include "rascal/structure_managers/cluster_ref_key.hh"
 #include "rascal/structure_managers/property_base.hh"
+#include "rascal/utils/timer.hh"
 #include "rascal/utils/utils.hh"
 
 #include <algorithm>
@@ -734,6 +735,10 @@ namespace rascal {
                                       global_offset);
         global_offset += this->maps[i_map].size();
       }
+      // Eigen reallocates the values whenever their size changes
+      if (static_cast<Eigen::Index>(global_offset) != this->values.size()) {
+        RASCAL_COUNTER_ADD("BlockSparseProperty::allocations", 1);
+      }
       this->values.resize(global_offset);
 
       // check if the keys are the same across cluster entries
@@ -762,6 +767,10 @@ namespace rascal {
         this->maps[i_map].resize_view(keys, n_row, n_col, global_offset);
         global_offset += this->maps[i_map].size();
       }
+      // Eigen reallocates the values whenever their size changes
+      if (static_cast<Eigen::Index>(global_offset) != this->values.size()) {
+        RASCAL_COUNTER_ADD("BlockSparseProperty::allocations", 1);
+      }
       this->values.resize(global_offset);
 
       // check if the keys are the same across cluster entries
@@ -945,6 +954,20 @@ namespace rascal {
       return features;
     }
 
+    /**
+     * @return the column of the first feature of each key in the dense
+     * feature matrix of get_features()
+     */
+    std::map<Key_t, int> get_feature_offsets() const {
+      std::map<Key_t, int> offsets{};
+      int i_feat{0};
+      for (const auto & key : this->get_keys()) {
+        offsets[key] = i_feat;
+        i_feat += this->get_nb_comp();
+      }
+      return offsets;
+    }
+
     /**
      * Fill a dense feature matrix with layout Nneighbor x Nfeatures
      * when Order == 2
@@ -79,6 +79,9 @@ namespace rascal {
    * std::array<int, 3> species_indices{a, b, a};
    * fun(species_manager[species_indices])
    * ```
+   *
+   * SpeciesPartition gives the centers and the neighbours of each species
+   * without copying the clusters in filters.
    */
   template <class ManagerImplementation, size_t MaxOrder>
   class SpeciesManager : public Updateable,
@@ -0,0 +1,290 @@
+/**
+ * @file   rascal/structure_managers/species_partition.hh
+ *
+ * @date   18 October 2026
+ *
+ * @brief  centers and neighbours of a manager sorted by species in CSR form
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_RASCAL_STRUCTURE_MANAGERS_SPECIES_PARTITION_HH_
+#define SRC_RASCAL_STRUCTURE_MANAGERS_SPECIES_PARTITION_HH_
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace rascal {
+
+  /**
+   * Species views of the centers and of the neighbours of a structure
+   * manager, an alternative to SpeciesManager that does not build an
+   * AdaptorFilter per species combination.
+   *
+   * update() sorts once, with a counting sort, the centers by species and
+   * the neighbours of each center by species into compressed sparse row
+   * (CSR) arrays:
+   *
+   *  - the centers of the s-th species are the entries center_offsets[s]
+   *    to center_offsets[s+1] of the centers,
+   *  - the neighbours of species s of the i-th center are the entries
+   *    neighbour_offsets[i * n_species + s] to
+   *    neighbour_offsets[i * n_species + s + 1] of the neighbours, so all
+   *    the neighbours of a center are contiguous and sorted by species.
+   *
+   * The views are ranges over these arrays, the clusters of the manager are
+   * not copied. A neighbour records its position in the iteration over
+   * center.pairs() and the index of its pair in the properties of the
+   * manager so that the properties can be accessed directly from the
+   * views. The species are indexed in increasing order of atomic number.
+   *
+   * @tparam Manager structure manager with (at least) a pair list
+   */
+  template <class Manager>
+  class SpeciesPartition {
+   public:
+    using ManagerPtr_t = std::shared_ptr<Manager>;
+
+    static_assert(Manager::traits::MaxOrder >= 2,
+                  "The manager needs at least a pair list to be partitioned.");
+
+    struct Center {
+      //! position of the center in the iteration over the manager
+      size_t index;
+      int atom_tag;
+    };
+
+    struct Neighbour {
+      //! position of the pair in the iteration over center.pairs()
+      size_t pair_index;
+      //! index of the pair in the properties of order 2 of the manager
+      size_t cluster_index;
+      int atom_tag;
+    };
+
+    //! contiguous range of the entries of a view
+    template <typename T>
+    class Range {
+     public:
+      Range(const T * begin, const T * end) : first{begin}, last{end} {}
+
+      const T * begin() const { return this->first; }
+      const T * end() const { return this->last; }
+      size_t size() const {
+        return static_cast<size_t>(this->last - this->first);
+      }
+      bool empty() const { return this->first == this->last; }
+      const T & operator[](const size_t index) const {
+        return this->first[index];
+      }
+
+     protected:
+      const T * first;
+      const T * last;
+    };
+
+    //! (re)builds the views from the current state of manager
+    void update(const ManagerPtr_t & manager);
+
+    //! number of centers
+    size_t size() const { return this->center_species.size(); }
+
+    //! number of pairs of all the centers
+    size_t get_nb_pairs() const { return this->neighbours.size(); }
+
+    size_t get_nb_species() const { return this->species.size(); }
+
+    //! atomic numbers of the centers and neighbours, in increasing order
+    const std::vector<int> & get_species() const { return this->species; }
+
+    /**
+     * @return the index of an atomic number in get_species()
+     *
+     * @throw std::runtime_error if the species is not in the manager
+     */
+    size_t get_species_index(const int atom_type) const {
+      auto it{std::lower_bound(this->species.begin(), this->species.end(),
+                               atom_type)};
+      if (it == this->species.end() or *it != atom_type) {
+        std::stringstream err_str{};
+        err_str << "The species '" << atom_type << "' is not in the "
+                << "partitioned manager.";
+        throw std::runtime_error(err_str.str());
+      }
+      return static_cast<size_t>(it - this->species.begin());
+    }
+
+    //! species index of the i_center-th center
+    size_t get_center_species_index(const size_t i_center) const {
+      return this->center_species[i_center];
+    }
+
+    //! centers of a species, in the order of the manager
+    Range<Center> get_centers(const size_t species_index) const {
+      return this->make_range(this->centers,
+                              this->center_offsets[species_index],
+                              this->center_offsets[species_index + 1]);
+    }
+
+    //! neighbours of the i_center-th center sorted by species
+    Range<Neighbour> get_neighbours(const size_t i_center) const {
+      const size_t n_species{this->get_nb_species()};
+      return this->make_range(
+          this->neighbours, this->neighbour_offsets[i_center * n_species],
+          this->neighbour_offsets[(i_center + 1) * n_species]);
+    }
+
+    //! neighbours of a species of the i_center-th center
+    Range<Neighbour> get_neighbours(const size_t i_center,
+                                    const size_t species_index) const {
+      const size_t block{i_center * this->get_nb_species() + species_index};
+      return this->make_range(this->neighbours,
+                              this->neighbour_offsets[block],
+                              this->neighbour_offsets[block + 1]);
+    }
+
+    /**
+     * Calls function(species_index, neighbours) for each species that has
+     * neighbours around the i_center-th center, in increasing order of
+     * species.
+     */
+    template <class Function>
+    void for_each_species_block(const size_t i_center,
+                                Function && function) const {
+      for (size_t i_species{0}; i_species < this->get_nb_species();
+           ++i_species) {
+        auto && block{this->get_neighbours(i_center, i_species)};
+        if (not block.empty()) {
+          function(i_species, block);
+        }
+      }
+    }
+
+   protected:
+    template <typename T>
+    static Range<T> make_range(const std::vector<T> & values,
+                               const size_t begin, const size_t end) {
+      return Range<T>{values.data() + begin, values.data() + end};
+    }
+
+    //! atomic numbers present, in increasing order
+    std::vector<int> species{};
+    //! centers sorted by species and their CSR offsets
+    std::vector<Center> centers{};
+    std::vector<size_t> center_offsets{};
+    //! species index of each center in the order of the manager
+    std::vector<size_t> center_species{};
+    //! neighbours sorted by center then species and their CSR offsets
+    std::vector<Neighbour> neighbours{};
+    std::vector<size_t> neighbour_offsets{};
+
+    //! neighbours in the order of the manager before the sort
+    std::vector<Neighbour> unsorted_neighbours{};
+    std::vector<size_t> unsorted_offsets{};
+    std::vector<int> neighbour_types{};
+    std::vector<int> center_tags{};
+    std::vector<int> center_types{};
+  };
+
+  /* ---------------------------------------------------------------------- */
+  template <class Manager>
+  void SpeciesPartition<Manager>::update(const ManagerPtr_t & manager) {
+    // gather the clusters in the order of the manager
+    const size_t n_centers{manager->size()};
+    this->center_species.resize(n_centers);
+    this->center_tags.resize(n_centers);
+    this->center_types.resize(n_centers);
+    this->unsorted_neighbours.clear();
+    this->neighbour_types.clear();
+    this->unsorted_offsets.resize(n_centers + 1);
+    this->unsorted_offsets[0] = 0;
+    size_t i_center{0};
+    for (auto center : manager) {
+      this->center_tags[i_center] = center.get_atom_tag();
+      this->center_types[i_center] = center.get_atom_type();
+      size_t pair_index{0};
+      for (auto neigh : center.pairs()) {
+        this->unsorted_neighbours.push_back(
+            {pair_index, neigh.get_cluster_index(), neigh.get_atom_tag()});
+        this->neighbour_types.push_back(neigh.get_atom_type());
+        pair_index++;
+      }
+      this->unsorted_offsets[i_center + 1] = this->unsorted_neighbours.size();
+      i_center++;
+    }
+    this->species.assign(this->center_types.begin(), this->center_types.end());
+    this->species.insert(this->species.end(), this->neighbour_types.begin(),
+                         this->neighbour_types.end());
+    std::sort(this->species.begin(), this->species.end());
+    this->species.erase(std::unique(this->species.begin(), this->species.end()),
+                        this->species.end());
+    const size_t n_species{this->species.size()};
+
+    // counting sort of the centers
+    this->center_offsets.assign(n_species + 1, 0);
+    for (i_center = 0; i_center < n_centers; ++i_center) {
+      this->center_species[i_center] =
+          this->get_species_index(this->center_types[i_center]);
+      this->center_offsets[this->center_species[i_center] + 1]++;
+    }
+    for (size_t i_species{0}; i_species < n_species; ++i_species) {
+      this->center_offsets[i_species + 1] += this->center_offsets[i_species];
+    }
+    this->centers.resize(n_centers);
+    std::vector<size_t> cursors(this->center_offsets.begin(),
+                                this->center_offsets.end() - 1);
+    for (i_center = 0; i_center < n_centers; ++i_center) {
+      this->centers[cursors[this->center_species[i_center]]++] =
+          Center{i_center, this->center_tags[i_center]};
+    }
+
+    // counting sort of the neighbours of each center, the blocks of a
+    // center are contiguous in the offsets
+    for (auto && atom_type : this->neighbour_types) {
+      atom_type = static_cast<int>(this->get_species_index(atom_type));
+    }
+    this->neighbour_offsets.assign(n_centers * n_species + 1, 0);
+    for (i_center = 0; i_center < n_centers; ++i_center) {
+      for (size_t i_pair{this->unsorted_offsets[i_center]};
+           i_pair < this->unsorted_offsets[i_center + 1]; ++i_pair) {
+        this->neighbour_offsets[i_center * n_species +
+                                this->neighbour_types[i_pair] + 1]++;
+      }
+    }
+    for (size_t i_block{0}; i_block < n_centers * n_species; ++i_block) {
+      this->neighbour_offsets[i_block + 1] += this->neighbour_offsets[i_block];
+    }
+    this->neighbours.resize(this->unsorted_neighbours.size());
+    cursors.assign(this->neighbour_offsets.begin(),
+                   this->neighbour_offsets.end() - 1);
+    for (i_center = 0; i_center < n_centers; ++i_center) {
+      for (size_t i_pair{this->unsorted_offsets[i_center]};
+           i_pair < this->unsorted_offsets[i_center + 1]; ++i_pair) {
+        const size_t block{i_center * n_species +
+                           this->neighbour_types[i_pair]};
+        this->neighbours[cursors[block]++] = this->unsorted_neighbours[i_pair];
+      }
+    }
+  }
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_STRUCTURE_MANAGERS_SPECIES_PARTITION_HH_
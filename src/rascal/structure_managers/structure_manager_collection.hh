@@ -35,6 +35,7 @@
 #include "rascal/structure_managers/structure_manager.hh"
 #include "rascal/structure_managers/updateable_base.hh"
 #include "rascal/utils/json_io.hh"
+#include "rascal/utils/parallel.hh"
 #include "rascal/utils/utils.hh"
 
 namespace rascal {
@@ -76,6 +77,8 @@ namespace rascal {
    protected:
     Data_t managers{};
     Hypers_t adaptor_parameters{};
+    //! work structures of the threads of update_structures
+    std::vector<AtomicStructure<3>> structure_buffers{};
 
    public:
     ManagerCollection() = default;
@@ -101,24 +104,45 @@ namespace rascal {
 
     /**
      * Build a new collection containing a subset of the structure managers
-     * selected by selected_ids.
+     * selected by selected_ids. The managers are shared with this collection,
+     * not copied, so the subset is cheap to build and the representations
+     * that are already computed can be used from it, e.g. for the folds of
+     * a cross-validation.
      *
      * @return a new manager collection
      */
     template <typename Int>
     Self_t get_subset(const std::vector<Int> & selected_ids) {
-      Int idx_max{*std::max_element(selected_ids.begin(), selected_ids.end())};
-      if (idx_max >= static_cast<Int>(this->size())) {
-        std::stringstream error{};
-        error << "selected_ids has at least one out of bound index: '"
-              << idx_max
-              << "' for the number of managers in the collection is '"
-              << this->size() << "'.";
-        throw std::runtime_error(error.str());
-      }
       Self_t new_collection{this->adaptor_parameters};
+      new_collection.managers.reserve(selected_ids.size());
       for (const auto & idx : selected_ids) {
-        new_collection.add_structure(this->managers[idx]);
+        this->check_index(idx);
+        new_collection.managers.push_back(this->managers[idx]);
+      }
+      return new_collection;
+    }
+
+    /**
+     * Build a new collection containing the structure managers that are not
+     * selected by selected_ids, in their order in this collection, e.g. the
+     * training set of a cross-validation fold. As for get_subset the managers
+     * are shared with this collection.
+     *
+     * @return a new manager collection
+     */
+    template <typename Int>
+    Self_t get_complement(const std::vector<Int> & selected_ids) {
+      std::vector<bool> is_selected(this->size(), false);
+      for (const auto & idx : selected_ids) {
+        this->check_index(idx);
+        is_selected[idx] = true;
+      }
+      Self_t new_collection{this->adaptor_parameters};
+      new_collection.managers.reserve(this->size());
+      for (size_t idx{0}; idx < this->size(); ++idx) {
+        if (not is_selected[idx]) {
+          new_collection.managers.push_back(this->managers[idx]);
+        }
       }
       return new_collection;
     }
@@ -183,6 +207,207 @@ namespace rascal {
       }
     }
 
+    /**
+     * Add the structures given as flat arrays, e.g. the numpy buffers of a
+     * whole dataset, without going through one AtomicStructure or json
+     * object per structure on the caller side. The atoms of structure i are
+     * the columns offsets[i] to offsets[i+1] of the per atom arrays.
+     *
+     * As in the python interface, a non periodic structure with a cell
+     * filled with zeros gets a cell that is a bounding box of its atoms and
+     * the atoms are shifted inside of it.
+     *
+     * @param positions positions of all the atoms [3, N_{atoms}]
+     * @param atom_types atomic numbers of all the atoms [N_{atoms}]
+     * @param cells the cells of the structures, the 3 columns of structure
+     * i start at column 3 i and are its lattice vectors
+     * [3, 3 N_{structures}]
+     * @param pbcs the periodicity of the structures [3, N_{structures}]
+     * @param center_atoms_mask which atoms are centers [N_{atoms}]
+     * @param offsets index of the first atom of each structure followed by
+     * the total number of atoms [N_{structures} + 1]
+     * @param wrap_positions fold the atoms inside the cell along the periodic
+     * directions
+     * @param n_threads number of threads used to build the managers
+     *
+     * @throw std::runtime_error if the sizes of the arrays are inconsistent,
+     * in which case the collection is left unchanged. If the construction of
+     * a manager fails the exception is forwarded and no structure is added
+     * either.
+     */
+    void add_structures(
+        const Eigen::Ref<const Eigen::Matrix<double, 3, Eigen::Dynamic>> &
+            positions,
+        const Eigen::Ref<const Eigen::VectorXi> & atom_types,
+        const Eigen::Ref<const Eigen::Matrix<double, 3, Eigen::Dynamic>> &
+            cells,
+        const Eigen::Ref<const Eigen::Matrix<int, 3, Eigen::Dynamic>> & pbcs,
+        const Eigen::Ref<const Eigen::Array<bool, Eigen::Dynamic, 1>> &
+            center_atoms_mask,
+        const Eigen::Ref<const Eigen::VectorXi> & offsets,
+        const bool wrap_positions = true, const size_t n_threads = 1) {
+      using AtomicStructure_t = AtomicStructure<3>;
+      const auto n_structures{static_cast<size_t>(pbcs.cols())};
+      const auto n_atoms{static_cast<int>(positions.cols())};
+      if (static_cast<size_t>(offsets.size()) != n_structures + 1 or
+          static_cast<size_t>(cells.cols()) != 3 * n_structures) {
+        std::stringstream err_str{};
+        err_str << "There should be " << n_structures + 1
+                << " offsets and " << 3 * n_structures
+                << " cell vectors for " << n_structures
+                << " structures but got '" << offsets.size() << "' and '"
+                << cells.cols() << "'.";
+        throw std::runtime_error(err_str.str());
+      }
+      if (atom_types.size() != n_atoms or
+          center_atoms_mask.size() != n_atoms or offsets(0) != 0 or
+          offsets(n_structures) != n_atoms) {
+        std::stringstream err_str{};
+        err_str << "The number of atom positions '" << n_atoms
+                << "', atom types '" << atom_types.size()
+                << "' and center flags '" << center_atoms_mask.size()
+                << "' should match the offsets from '" << offsets(0)
+                << "' to '" << offsets(n_structures) << "'.";
+        throw std::runtime_error(err_str.str());
+      }
+      for (size_t i_structure{0}; i_structure < n_structures; ++i_structure) {
+        if (offsets(i_structure + 1) < offsets(i_structure)) {
+          std::stringstream err_str{};
+          err_str << "The offsets should be increasing but offset '"
+                  << i_structure + 1 << "' is '" << offsets(i_structure + 1)
+                  << "' and the previous one is '" << offsets(i_structure)
+                  << "'.";
+          throw std::runtime_error(err_str.str());
+        }
+      }
+
+      // the manager stacks are built in the calling thread and only filled
+      // in parallel since each one only touches its own data
+      const size_t n_managers{this->managers.size()};
+      Hypers_t empty_structure = Hypers_t::object();
+      for (size_t i_structure{0}; i_structure < n_structures; ++i_structure) {
+        this->add_structure(empty_structure);
+      }
+
+      try {
+        internal::parallel_for(
+            n_structures, n_threads, [&](const size_t i_structure, size_t) {
+              const int start{offsets(i_structure)};
+              const int n_structure_atoms{offsets(i_structure + 1) - start};
+              AtomicStructure_t atomic_structure{};
+              atomic_structure.positions =
+                  positions.middleCols(start, n_structure_atoms);
+              atomic_structure.atom_types =
+                  atom_types.segment(start, n_structure_atoms);
+              atomic_structure.center_atoms_mask =
+                  center_atoms_mask.segment(start, n_structure_atoms);
+              atomic_structure.cell = cells.middleCols<3>(3 * i_structure);
+              atomic_structure.pbc = pbcs.col(i_structure);
+              if ((atomic_structure.cell.array().abs() < 1e-10).all()) {
+                if (atomic_structure.pbc.any()) {
+                  std::stringstream err_str{};
+                  err_str << "The cell of the periodic structure '"
+                          << i_structure << "' is filled with zeros.";
+                  throw std::runtime_error(err_str.str());
+                }
+                atomic_structure.set_bounding_box_cell();
+              } else if (wrap_positions) {
+                atomic_structure.wrap();
+              }
+              this->managers[n_managers + i_structure]->update(
+                  atomic_structure);
+            });
+      } catch (...) {
+        this->managers.resize(n_managers);
+        throw;
+      }
+    }
+
+    /**
+     * Update in place the structures of the collection with new positions
+     * and cells, e.g. the frames of a trajectory with a fixed composition.
+     * The atom types, periodicity and center masks of the structures are
+     * kept and the existing manager stacks are updated, so the memory of
+     * their neighbour lists and properties is reused. A trajectory can then
+     * be processed as a sliding window of managers that are built once.
+     *
+     * @param positions the new positions of the atoms of each structure
+     * [N_{structures}, 3 N_{atoms}], i.e. a C ordered array
+     * [N_{structures}, N_{atoms}, 3]
+     * @param cells the new cells [N_{structures}, 9] with the lattice vectors
+     * one after the other, i.e. a C ordered array [N_{structures}, 3, 3]
+     * with the lattice vectors as rows. A single cell [1, 9] is used for all
+     * the structures.
+     * @param wrap_positions fold the atoms inside the cell along the periodic
+     * directions
+     * @param n_threads number of threads used to update the managers
+     *
+     * @throw std::runtime_error if the number of structures or the number of
+     * atoms of a structure do not match the inputs
+     */
+    void update_structures(
+        const Eigen::Ref<const Eigen::Matrix<double, Eigen::Dynamic,
+                                             Eigen::Dynamic, Eigen::RowMajor>> &
+            positions,
+        const Eigen::Ref<const Eigen::Matrix<double, Eigen::Dynamic,
+                                             Eigen::Dynamic, Eigen::RowMajor>> &
+            cells,
+        const bool wrap_positions = true, const size_t n_threads = 1) {
+      const size_t n_structures{this->size()};
+      if (static_cast<size_t>(positions.rows()) != n_structures or
+          (cells.rows() != 1 and
+           static_cast<size_t>(cells.rows()) != n_structures) or
+          cells.cols() != 9) {
+        std::stringstream err_str{};
+        err_str << "The collection has " << n_structures
+                << " structures but got positions for '" << positions.rows()
+                << "' structures and cells of shape (" << cells.rows() << ", "
+                << cells.cols() << ").";
+        throw std::runtime_error(err_str.str());
+      }
+      for (size_t i_structure{0}; i_structure < n_structures; ++i_structure) {
+        auto manager_root =
+            extract_underlying_manager<0>(this->managers[i_structure]);
+        const auto n_atoms{static_cast<Eigen::Index>(
+            manager_root->get_atomic_structure().get_number_of_atoms())};
+        if (positions.cols() != 3 * n_atoms) {
+          std::stringstream err_str{};
+          err_str << "Structure '" << i_structure << "' has " << n_atoms
+                  << " atoms but got " << positions.cols() / 3.
+                  << " positions.";
+          throw std::runtime_error(err_str.str());
+        }
+      }
+
+      const size_t n_used_threads{std::max(size_t(1), n_threads)};
+      if (this->structure_buffers.size() < n_used_threads) {
+        this->structure_buffers.resize(n_used_threads);
+      }
+      internal::parallel_for(
+          n_structures, n_used_threads,
+          [&](const size_t i_structure, const size_t i_thread) {
+            auto & atomic_structure = this->structure_buffers[i_thread];
+            auto manager_root =
+                extract_underlying_manager<0>(this->managers[i_structure]);
+            // the sizes match so the copies do not allocate memory
+            atomic_structure.set_structure(
+                manager_root->get_atomic_structure());
+            const Eigen::Index n_atoms{atomic_structure.positions.cols()};
+            atomic_structure.positions =
+                Eigen::Map<const Eigen::Matrix<double, 3, Eigen::Dynamic>>(
+                    positions.data() + i_structure * positions.outerStride(),
+                    3, n_atoms);
+            const Eigen::Index i_cell{
+                cells.rows() == 1 ? 0 : static_cast<Eigen::Index>(i_structure)};
+            atomic_structure.cell = Eigen::Map<const Eigen::Matrix3d>(
+                cells.data() + i_cell * cells.outerStride());
+            if (wrap_positions) {
+              atomic_structure.wrap();
+            }
+            this->managers[i_structure]->update(atomic_structure);
+          });
+    }
+
     void add_structures(const Hypers_t & structures,
                         const Hypers_t & adaptors_inputs) {
       if (not structures.is_array()) {
@@ -362,6 +587,19 @@ namespace rascal {
     }
 
    protected:
+    //! throw if idx is not the index of a manager of the collection
+    template <typename Int>
+    void check_index(const Int & idx) const {
+      if (static_cast<long long>(idx) < 0 or  // NOLINT
+          static_cast<size_t>(idx) >= this->size()) {
+        std::stringstream error{};
+        error << "selected_ids has at least one out of bound index: '" << idx
+              << "' for the number of managers in the collection is '"
+              << this->size() << "'.";
+        throw std::runtime_error(error.str());
+      }
+    }
+
     /**
      * Helper classes to deal with the differentiation between Property and
      * BlockSparseProperty when filling the feature matrix.
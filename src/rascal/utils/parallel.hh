@@ -0,0 +1,109 @@
+/**
+ * @file   rascal/utils/parallel.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 October 2026
+ *
+ * @brief  minimal thread based parallel loop over independent tasks
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_RASCAL_UTILS_PARALLEL_HH_
+#define SRC_RASCAL_UTILS_PARALLEL_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rascal {
+  namespace internal {
+
+    //! number of threads used when the user does not specify it
+    inline size_t get_default_number_of_threads() {
+      size_t n_threads{std::thread::hardware_concurrency()};
+      return std::max(n_threads, size_t(1));
+    }
+
+    /**
+     * Calls func(i_task, i_thread) for every i_task in [0, n_tasks) using
+     * n_threads threads. The tasks are distributed dynamically, i.e. a thread
+     * takes the next task as soon as it is done with the previous one, so
+     * tasks of uneven cost are balanced. i_thread in [0, n_threads) can be
+     * used to address buffers owned by each thread.
+     *
+     * With n_threads <= 1 the tasks are executed in order in the calling
+     * thread. When func throws, no new task is started and the first
+     * exception is rethrown in the calling thread once all threads are done.
+     */
+    template <typename Func>
+    void parallel_for(const size_t n_tasks, size_t n_threads, Func && func) {
+      n_threads = std::min(n_threads, n_tasks);
+      if (n_threads <= 1) {
+        for (size_t i_task{0}; i_task < n_tasks; ++i_task) {
+          func(i_task, size_t(0));
+        }
+        return;
+      }
+
+      std::atomic<size_t> next_task{0};
+      std::atomic<bool> failed{false};
+      std::exception_ptr error{nullptr};
+      std::mutex error_mutex{};
+
+      auto worker = [&](const size_t i_thread) {
+        while (not failed) {
+          size_t i_task{next_task++};
+          if (i_task >= n_tasks) {
+            break;
+          }
+          try {
+            func(i_task, i_thread);
+          } catch (...) {
+            std::lock_guard<std::mutex> lock{error_mutex};
+            if (not failed) {
+              error = std::current_exception();
+              failed = true;
+            }
+          }
+        }
+      };
+
+      std::vector<std::thread> threads{};
+      threads.reserve(n_threads - 1);
+      for (size_t i_thread{1}; i_thread < n_threads; ++i_thread) {
+        threads.emplace_back(worker, i_thread);
+      }
+      // the calling thread does its share of the work
+      worker(0);
+      for (auto & thread : threads) {
+        thread.join();
+      }
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+
+  }  // namespace internal
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_UTILS_PARALLEL_HH_
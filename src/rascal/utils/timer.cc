@@ -0,0 +1,136 @@
+/**
+ * @file   rascal/utils/timer.cc
+ *
+ * @date   18 October 2026
+ *
+ * @brief  registry of the timers and counters of all the threads
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "rascal/utils/timer.hh"
+
+#include <algorithm>
+#include <mutex>
+#include <set>
+
+namespace rascal {
+  namespace internal {
+    namespace {
+      //! timings of the live threads and of the terminated ones
+      struct TimingsRegistry {
+        std::mutex mutex{};
+        std::set<ThreadTimings *> threads{};
+        std::map<std::string, TimerRecord> finished_timers{};
+        std::map<std::string, double> finished_counters{};
+
+        void merge_thread(const ThreadTimings & thread,
+                          std::map<std::string, TimerRecord> & timers,
+                          std::map<std::string, double> & counters) {
+          for (const auto & timer : thread.timers) {
+            timers[timer.first].merge_thread(timer.second);
+          }
+          for (const auto & counter : thread.counters) {
+            counters[counter.first] += counter.second;
+          }
+        }
+      };
+
+      TimingsRegistry & get_registry() {
+        // never destroyed so that threads terminating during the static
+        // destruction can still unregister
+        static auto * registry = new TimingsRegistry{};
+        return *registry;
+      }
+    }  // namespace
+
+    void TimerRecord::merge_thread(const TimerRecord & other) {
+      this->count += other.count;
+      this->time += other.time;
+      this->max_thread_time = std::max(this->max_thread_time, other.time);
+      this->n_threads++;
+    }
+
+    void TimerRecord::merge(const TimerRecord & other) {
+      this->count += other.count;
+      this->time += other.time;
+      this->max_thread_time =
+          std::max(this->max_thread_time, other.max_thread_time);
+      this->n_threads += other.n_threads;
+    }
+
+    ThreadTimings::ThreadTimings() {
+      auto & registry = get_registry();
+      std::lock_guard<std::mutex> lock{registry.mutex};
+      registry.threads.insert(this);
+    }
+
+    ThreadTimings::~ThreadTimings() {
+      auto & registry = get_registry();
+      std::lock_guard<std::mutex> lock{registry.mutex};
+      registry.merge_thread(*this, registry.finished_timers,
+                            registry.finished_counters);
+      registry.threads.erase(this);
+    }
+
+    void ThreadTimings::clear() {
+      this->timers.clear();
+      this->counters.clear();
+    }
+
+    ThreadTimings & Timings::local() {
+      thread_local ThreadTimings timings{};
+      return timings;
+    }
+
+    json Timings::report() {
+      auto & registry = get_registry();
+      std::lock_guard<std::mutex> lock{registry.mutex};
+      auto timers = registry.finished_timers;
+      auto counters = registry.finished_counters;
+      for (const auto * thread : registry.threads) {
+        registry.merge_thread(*thread, timers, counters);
+      }
+      json report{{"timers", json::object()},
+                  {"counters", json::object()},
+                  {"level", RASCAL_TIMERS_LEVEL}};
+      for (const auto & timer : timers) {
+        report["timers"][timer.first] = {
+            {"count", timer.second.count},
+            {"time", timer.second.time},
+            {"max_thread_time", timer.second.max_thread_time},
+            {"n_threads", timer.second.n_threads}};
+      }
+      for (const auto & counter : counters) {
+        report["counters"][counter.first] = counter.second;
+      }
+      return report;
+    }
+
+    void Timings::reset() {
+      auto & registry = get_registry();
+      std::lock_guard<std::mutex> lock{registry.mutex};
+      registry.finished_timers.clear();
+      registry.finished_counters.clear();
+      for (auto * thread : registry.threads) {
+        thread->clear();
+      }
+    }
+
+  }  // namespace internal
+}  // namespace rascal
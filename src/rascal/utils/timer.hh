@@ -0,0 +1,259 @@
+/**
+ * @file   rascal/utils/timer.hh
+ *
+ * @date   18 October 2026
+ *
+ * @brief  lightweight hierarchical timers and counters
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef SRC_RASCAL_UTILS_TIMER_HH_
+#define SRC_RASCAL_UTILS_TIMER_HH_
+
+#include "rascal/utils/json_io.hh"
+
+#include <chrono>  // NOLINT
+#include <map>
+#include <string>
+
+/**
+ * Level of detail of the timers, set at configuration time with the
+ * RASCAL_TIMERS_LEVEL cmake variable:
+ *  - 0 (default): the timers and counters are removed at compile time
+ *  - 1: timers around the main phases of the computations and counters
+ *  - 2: additionally accumulates the time spent in the steps of the inner
+ *       loops (e.g. radial integral, spherical harmonics), which costs a few
+ *       clock reads per pair
+ */
+#ifndef RASCAL_TIMERS_LEVEL
+#define RASCAL_TIMERS_LEVEL 0
+#endif
+
+namespace rascal {
+  namespace internal {
+
+    //! aggregated measurements of one timer
+    struct TimerRecord {
+      //! number of times the timer was started
+      size_t count{0};
+      //! total time in seconds
+      double time{0.};
+      //! largest time accumulated by a single thread
+      double max_thread_time{0.};
+      //! number of threads that used the timer
+      size_t n_threads{0};
+
+      //! add the measurements of one thread
+      void merge_thread(const TimerRecord & other);
+      //! add measurements that were already aggregated over threads
+      void merge(const TimerRecord & other);
+    };
+
+    /**
+     * Timers and counters of one thread. The timers are identified by the
+     * names of the nested timers separated with '/', e.g.
+     * "SphericalInvariants::compute/SphericalExpansion::compute".
+     * Each thread fills its own instance without locking.
+     */
+    struct ThreadTimings {
+      std::map<std::string, TimerRecord> timers{};
+      std::map<std::string, double> counters{};
+      //! path of the timers currently running in this thread
+      std::string path{};
+
+      ThreadTimings();
+      ~ThreadTimings();
+      ThreadTimings(const ThreadTimings & other) = delete;
+      ThreadTimings & operator=(const ThreadTimings & other) = delete;
+
+      void clear();
+    };
+
+    /**
+     * Registry of the timings of all the threads.
+     *
+     * The measurements of a thread are merged in the report when the thread
+     * terminates so the timings of the worker threads of parallel_for are
+     * kept. report() and reset() read/write the measurements of the running
+     * threads so they should not be called while a computation is running in
+     * another thread.
+     */
+    class Timings {
+     public:
+      //! timings of the calling thread
+      static ThreadTimings & local();
+
+      //! add value to the counter name of the calling thread
+      static void add_counter(const std::string & name, double value) {
+        local().counters[name] += value;
+      }
+
+      /**
+       * Returns the timers and counters aggregated over the threads:
+       *   {"timers": {path: {"count", "time", "max_thread_time",
+       *                      "n_threads"}},
+       *    "counters": {name: value},
+       *    "level": RASCAL_TIMERS_LEVEL}
+       * The times are in seconds.
+       */
+      static json report();
+
+      //! discard all the measurements
+      static void reset();
+    };
+
+    /**
+     * Measures the time between its construction and its destruction and
+     * records it under the current path of the thread extended with name.
+     */
+    class ScopedTimer {
+     public:
+      using Clock_t = std::chrono::steady_clock;
+
+      explicit ScopedTimer(const char * name)
+          : timings{Timings::local()}, path_size{timings.path.size()},
+            start{} {
+        if (this->path_size > 0) {
+          this->timings.path += '/';
+        }
+        this->timings.path += name;
+        this->start = Clock_t::now();
+      }
+
+      ~ScopedTimer() {
+        std::chrono::duration<double> elapsed{Clock_t::now() - this->start};
+        auto & record = this->timings.timers[this->timings.path];
+        record.count++;
+        record.time += elapsed.count();
+        this->timings.path.resize(this->path_size);
+      }
+
+      ScopedTimer(const ScopedTimer & other) = delete;
+      ScopedTimer & operator=(const ScopedTimer & other) = delete;
+
+     protected:
+      ThreadTimings & timings;
+      size_t path_size;
+      Clock_t::time_point start;
+    };
+
+    /**
+     * Accumulates the time spent in a step of a loop between start() and
+     * stop() without touching the registry. The total is recorded with
+     * flush(), e.g. once per structure.
+     */
+    class TimeAccumulator {
+     public:
+      using Clock_t = std::chrono::steady_clock;
+
+      void start() { this->start_time = Clock_t::now(); }
+
+      void stop() {
+        this->elapsed += Clock_t::now() - this->start_time;
+        this->count++;
+      }
+
+      //! record the accumulated time under the current path + name
+      void flush(const char * name) {
+        if (this->count == 0) {
+          return;
+        }
+        auto & timings = Timings::local();
+        std::string path{timings.path};
+        if (path.size() > 0) {
+          path += '/';
+        }
+        path += name;
+        auto & record = timings.timers[path];
+        record.count += this->count;
+        record.time += std::chrono::duration<double>(this->elapsed).count();
+        this->elapsed = Clock_t::duration::zero();
+        this->count = 0;
+      }
+
+     protected:
+      Clock_t::time_point start_time{};
+      Clock_t::duration elapsed{Clock_t::duration::zero()};
+      size_t count{0};
+    };
+
+    /**
+     * Counts events of a loop in a local variable, the total is added to the
+     * counters of the thread with flush().
+     */
+    class LocalCounter {
+     public:
+      void add(const double value) { this->value += value; }
+
+      void flush(const std::string & name) {
+        Timings::add_counter(name, this->value);
+        this->value = 0.;
+      }
+
+     protected:
+      double value{0.};
+    };
+
+  }  // namespace internal
+}  // namespace rascal
+
+#define RASCAL_TIMER_CONCAT_IMPL(a, b) a##b
+#define RASCAL_TIMER_CONCAT(a, b) RASCAL_TIMER_CONCAT_IMPL(a, b)
+
+#if RASCAL_TIMERS_LEVEL >= 1
+//! time the rest of the enclosing scope under name
+#define RASCAL_TIMER(name)                                                     \
+  ::rascal::internal::ScopedTimer RASCAL_TIMER_CONCAT(rascal_timer_,           \
+                                                      __LINE__) {              \
+    name                                                                       \
+  }
+//! add value to the counter name
+#define RASCAL_COUNTER_ADD(name, value)                                        \
+  ::rascal::internal::Timings::add_counter(name, static_cast<double>(value))
+//! declare a counter for the events of a loop
+#define RASCAL_LOCAL_COUNTER_DECLARE(counter)                                  \
+  ::rascal::internal::LocalCounter counter {}
+#define RASCAL_LOCAL_COUNTER_ADD(counter, value)                               \
+  counter.add(static_cast<double>(value))
+//! add the events of counter to the counter name
+#define RASCAL_LOCAL_COUNTER_FLUSH(counter, name) counter.flush(name)
+#else
+#define RASCAL_TIMER(name)
+#define RASCAL_COUNTER_ADD(name, value)
+#define RASCAL_LOCAL_COUNTER_DECLARE(counter)
+#define RASCAL_LOCAL_COUNTER_ADD(counter, value)
+#define RASCAL_LOCAL_COUNTER_FLUSH(counter, name)
+#endif
+
+#if RASCAL_TIMERS_LEVEL >= 2
+//! declare an accumulator for the steps of a loop
+#define RASCAL_FINE_TIMER_DECLARE(accumulator)                                 \
+  ::rascal::internal::TimeAccumulator accumulator {}
+#define RASCAL_FINE_TIMER_START(accumulator) accumulator.start()
+#define RASCAL_FINE_TIMER_STOP(accumulator) accumulator.stop()
+//! record the time of accumulator under name
+#define RASCAL_FINE_TIMER_FLUSH(accumulator, name) accumulator.flush(name)
+#else
+#define RASCAL_FINE_TIMER_DECLARE(accumulator)
+#define RASCAL_FINE_TIMER_START(accumulator)
+#define RASCAL_FINE_TIMER_STOP(accumulator)
+#define RASCAL_FINE_TIMER_FLUSH(accumulator, name)
+#endif
+
+#endif  // SRC_RASCAL_UTILS_TIMER_HH_
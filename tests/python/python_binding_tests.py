@@ -8,13 +8,22 @@ from python_structure_manager_test import (
     TestNL,
     TestNLStrict,
     CenterSelectTest,
+    TestAtomsListFromArrays,
 )
 from python_representation_calculator_test import (
     TestSortedCoulombRepresentation,
     TestSphericalExpansionRepresentation,
     TestSphericalInvariantsRepresentation,
 )
-from python_models_test import TestNumericalKernelGradient, TestCosineKernel
+from python_models_test import (
+    TestNumericalKernelGradient,
+    TestCosineKernel,
+    TestKRRPredictions,
+    TestPairPotential,
+    TestGAPHyperparameterScan,
+    TestIncrementalGAPTrainer,
+    TestThreeBodyModels,
+)
 from python_math_test import TestMath
 from python_test_sparsify_fps import TestFPS
 from md_calculator_test import TestGenericMD
@@ -1,6 +1,13 @@
-from rascal.representations import SphericalInvariants
-from rascal.models import Kernel
+from rascal.representations import SphericalInvariants, ThreeBody
+from rascal.models import (
+    Kernel,
+    GAPHyperparameterScan,
+    IncrementalGAPTrainer,
+    PairPotential,
+    train_gap_model,
+)
 from rascal.models.sparse_points import SparsePoints
+from rascal.models.asemd import ASEMLCalculator
 from rascal.models.kernels import compute_numerical_kernel_gradients
 from rascal.utils import from_dict, to_dict
 from test_utils import load_json_frame, BoxList, Box, compute_relative_error
@@ -281,3 +288,537 @@ class TestCosineKernel(unittest.TestCase):
             cosine_kernel_copy_dict = to_dict(cosine_kernel_copy)
 
             self.assertTrue(cosine_kernel_dict == cosine_kernel_copy_dict)
+
+
+def load_gap_training_set(test_case, n_frames=12):
+    """
+    builds a small GAP training set of methane dimers with Lennard-Jones
+    energies and forces, and their features
+    """
+    test_case.frames = ase.io.read(
+        "reference_data/inputs/methane_dimer_sample.xyz", ":{}".format(n_frames)
+    )
+    calc = LennardJones()
+    test_case.energies, test_case.gradients = [], []
+    for frame in test_case.frames:
+        frame.calc = calc
+        test_case.energies.append(frame.get_potential_energy())
+        test_case.gradients.append(-frame.get_forces())
+    test_case.energies = np.array(test_case.energies)
+    test_case.self_contributions = {1: 0.0, 6: 0.0}
+    test_case.rep = SphericalInvariants(
+        soap_type="PowerSpectrum",
+        interaction_cutoff=3.5,
+        max_radial=4,
+        max_angular=3,
+        gaussian_sigma_constant=0.4,
+        gaussian_sigma_type="Constant",
+        cutoff_smooth_width=0.5,
+        compute_gradients=True,
+    )
+    test_case.managers = test_case.rep.transform(test_case.frames)
+
+
+class TestKRRPredictions(unittest.TestCase):
+    def setUp(self):
+        load_gap_training_set(self, n_frames=6)
+        self.X_sparse = SparsePoints(self.rep)
+        self.X_sparse.extend(self.managers, [[0, 1, 5, 6]] * len(self.frames))
+        self.kernel = Kernel(
+            self.rep, name="GAP", zeta=2, target_type="Structure", kernel_type="Sparse"
+        )
+        KNM = np.vstack(
+            [
+                self.kernel(self.managers, self.X_sparse),
+                self.kernel(self.managers, self.X_sparse, grad=(True, False)),
+            ]
+        )
+        self.model = train_gap_model(
+            self.kernel,
+            self.frames,
+            KNM,
+            self.X_sparse,
+            self.energies,
+            self.self_contributions,
+            grad_train=np.vstack(self.gradients),
+            lambdas=[1e-2, 5e-2],
+        )
+
+    def test_predict_all(self):
+        """Tests that the fused predictions are the ones of predict,
+        predict_forces and predict_stress"""
+        energies, forces, stress = self.model.predict_all(self.managers)
+        self.assertTrue(np.allclose(energies, self.model.predict(self.managers)))
+        self.assertTrue(
+            np.allclose(forces, self.model.predict_forces(self.managers))
+        )
+        self.assertTrue(
+            np.allclose(stress, self.model.predict_stress(self.managers))
+        )
+        _, forces_only, no_stress = self.model.predict_all(
+            self.managers, compute_stress=False
+        )
+        self.assertTrue(np.allclose(forces_only, forces))
+        self.assertTrue(np.allclose(no_stress, 0.0))
+
+    def test_ase_calculator(self):
+        """Tests that the ASE calculator only uses the fused predictions for
+        the gradients and gives the results of the separate predictions"""
+        calculator = ASEMLCalculator(self.model, self.rep)
+        self.assertFalse(calculator._use_fused_prediction(["energy"]))
+        self.assertTrue(calculator._use_fused_prediction(["energy", "forces"]))
+        frame = self.frames[0].copy()
+        frame.calc = calculator
+        managers = self.rep.transform([self.frames[0]])
+        energy = frame.get_potential_energy()
+        self.assertTrue(np.allclose(energy, self.model.predict(managers)))
+        self.assertTrue(
+            np.allclose(frame.get_forces(), self.model.predict_forces(managers))
+        )
+        self.assertTrue(
+            np.allclose(
+                frame.get_stress(voigt=True),
+                self.model.predict_stress(managers).flatten(),
+            )
+        )
+
+
+
+def pair_repulsion(r, cutoff=3.0):
+    """smooth repulsion vanishing with its two first derivatives at cutoff"""
+    return 0.1 * (cutoff - r) ** 3 / r
+
+
+def pair_repulsion_derivative(r, cutoff=3.0):
+    return -0.1 * (3 * (cutoff - r) ** 2 / r + (cutoff - r) ** 3 / r ** 2)
+
+
+def compute_pair_reference(frame, cutoff=3.0):
+    """energy, forces and stress (Voigt order) of pair_repulsion between all
+    the atoms of a frame, without periodic images"""
+    positions = frame.get_positions()
+    energy = 0.0
+    forces = np.zeros(positions.shape)
+    stress = np.zeros((3, 3))
+    for i_atom in range(len(frame)):
+        for j_atom in range(i_atom + 1, len(frame)):
+            r_ij = positions[j_atom] - positions[i_atom]
+            distance = np.linalg.norm(r_ij)
+            if distance >= cutoff:
+                continue
+            energy += pair_repulsion(distance, cutoff)
+            # dE/dr_j
+            derivative = pair_repulsion_derivative(distance, cutoff) * r_ij / distance
+            forces[j_atom] -= derivative
+            forces[i_atom] += derivative
+            stress += np.outer(derivative, r_ij)
+    stress /= frame.get_volume()
+    voigt = [(0, 0), (1, 1), (2, 2), (1, 2), (0, 2), (0, 1)]
+    return energy, forces, np.array([stress[ab] for ab in voigt])
+
+
+class TestPairPotential(unittest.TestCase):
+    def setUp(self):
+        load_gap_training_set(self, n_frames=6)
+        self.cutoff = 3.0
+        self.baseline = PairPotential.from_functions(
+            {
+                species: lambda r: pair_repulsion(r, self.cutoff)
+                for species in [(1, 1), (1, 6), (6, 6)]
+            },
+            r_min=0.5,
+            cutoff=self.cutoff,
+        )
+        references = [
+            compute_pair_reference(frame, self.cutoff) for frame in self.frames
+        ]
+        self.pair_energies = np.array([ref[0] for ref in references])
+        self.pair_forces = np.vstack([ref[1] for ref in references])
+        self.pair_stress = np.vstack([ref[2] for ref in references])
+
+    def test_compute(self):
+        """Tests the energies, forces and stress of the tabulated potential
+        against the analytical ones"""
+        self.assertEqual(self.baseline.get_cutoff(), self.cutoff)
+        energies, forces, stress = self.baseline.compute(self.managers)
+        self.assertTrue(np.allclose(energies, self.pair_energies, rtol=1e-5))
+        scale = np.abs(self.pair_forces).max()
+        self.assertTrue(
+            np.allclose(forces, self.pair_forces, rtol=1e-5, atol=1e-6 * scale)
+        )
+        scale = np.abs(self.pair_stress).max()
+        self.assertTrue(
+            np.allclose(stress, self.pair_stress, rtol=1e-5, atol=1e-6 * scale)
+        )
+        _, forces_only, no_stress = self.baseline.compute(
+            self.managers, compute_stress=False
+        )
+        self.assertTrue(np.allclose(forces_only, forces))
+        self.assertTrue(np.allclose(no_stress, 0.0))
+
+        # the cutoff of the neighbour lists is too small for the potential
+        rep = SphericalInvariants(
+            soap_type="PowerSpectrum",
+            interaction_cutoff=2.0,
+            max_radial=4,
+            max_angular=3,
+            gaussian_sigma_constant=0.4,
+            gaussian_sigma_type="Constant",
+            cutoff_smooth_width=0.5,
+        )
+        with self.assertRaises(RuntimeError):
+            self.baseline.compute(rep.transform(self.frames))
+
+    def test_baseline(self):
+        """Tests that a model trained with a baseline is the model trained on
+        the difference with the baseline, with the baseline added to its
+        energies, forces and stress"""
+        X_sparse = SparsePoints(self.rep)
+        X_sparse.extend(self.managers, [[0, 1, 5, 6]] * len(self.frames))
+        kernel = Kernel(
+            self.rep, name="GAP", zeta=2, target_type="Structure", kernel_type="Sparse"
+        )
+        KNM = np.vstack(
+            [
+                kernel(self.managers, X_sparse),
+                kernel(self.managers, X_sparse, grad=(True, False)),
+            ]
+        )
+        lambdas = [1e-2, 5e-2]
+        gradients = np.vstack(self.gradients)
+        model = train_gap_model(
+            kernel,
+            self.frames,
+            KNM,
+            X_sparse,
+            self.energies,
+            self.self_contributions,
+            grad_train=gradients,
+            lambdas=lambdas,
+            baseline=self.baseline,
+            managers=self.managers,
+        )
+        model_delta = train_gap_model(
+            kernel,
+            self.frames,
+            KNM,
+            X_sparse,
+            self.energies - self.pair_energies,
+            self.self_contributions,
+            grad_train=gradients + self.pair_forces,
+            lambdas=lambdas,
+        )
+        self.assertTrue(
+            np.allclose(model.weights, model_delta.weights, rtol=1e-4, atol=1e-8)
+        )
+
+        energies = model.predict(self.managers)
+        forces = model.predict_forces(self.managers)
+        stress = model.predict_stress(self.managers)
+        energies_delta = model_delta.predict(self.managers)
+        forces_delta = model_delta.predict_forces(self.managers)
+        stress_delta = model_delta.predict_stress(self.managers)
+        self.assertTrue(
+            np.allclose(energies, energies_delta + self.pair_energies, rtol=1e-5)
+        )
+        scale = np.abs(forces).max()
+        self.assertTrue(
+            np.allclose(
+                forces, forces_delta + self.pair_forces, rtol=1e-5, atol=1e-6 * scale
+            )
+        )
+        scale = np.abs(stress).max()
+        self.assertTrue(
+            np.allclose(
+                stress, stress_delta + self.pair_stress, rtol=1e-5, atol=1e-6 * scale
+            )
+        )
+
+        # the fused predictions include the baseline as well
+        energies_all, forces_all, stress_all = model.predict_all(self.managers)
+        self.assertTrue(np.allclose(energies_all, energies))
+        self.assertTrue(np.allclose(forces_all, forces))
+        self.assertTrue(np.allclose(stress_all, stress))
+
+        # the baseline is kept by the serialization
+        model_copy = from_dict(to_dict(model))
+        self.assertTrue(np.allclose(model_copy.predict(self.managers), energies))
+
+        with self.assertRaises(ValueError):
+            train_gap_model(
+                kernel,
+                self.frames,
+                KNM,
+                X_sparse,
+                self.energies,
+                self.self_contributions,
+                grad_train=gradients,
+                lambdas=lambdas,
+                baseline=self.baseline,
+            )
+
+
+class TestGAPHyperparameterScan(unittest.TestCase):
+    def setUp(self):
+        load_gap_training_set(self)
+        self.X_sparse = SparsePoints(self.rep)
+        self.X_sparse.extend(self.managers, [[0, 1, 5, 6]] * len(self.frames))
+        self.zetas = [1, 2]
+        self.scan = GAPHyperparameterScan(
+            self.get_kernel(self.zetas[-1]),
+            self.frames,
+            self.managers,
+            self.X_sparse,
+            self.energies,
+            self.self_contributions,
+            grad_train=np.vstack(self.gradients),
+            zetas=self.zetas,
+        )
+
+    def get_kernel(self, zeta):
+        return Kernel(
+            self.rep, name="GAP", zeta=zeta, target_type="Structure", kernel_type="Sparse"
+        )
+
+    def get_KNM(self, kernel, managers):
+        return np.vstack(
+            [
+                kernel(managers, self.X_sparse),
+                kernel(managers, self.X_sparse, grad=(True, False)),
+            ]
+        )
+
+    def test_get_model(self):
+        """Tests that the models of the scan are the ones of train_gap_model"""
+        for zeta in self.zetas:
+            kernel = self.get_kernel(zeta)
+            KNM = self.get_KNM(kernel, self.managers)
+            for lambdas in [[1e-2, 5e-2], [1e-1, 5e-2], [1e-1, 1e-2]]:
+                model_ref = train_gap_model(
+                    kernel,
+                    self.frames,
+                    KNM,
+                    self.X_sparse,
+                    self.energies,
+                    self.self_contributions,
+                    grad_train=np.vstack(self.gradients),
+                    lambdas=lambdas,
+                )
+                model = self.scan.get_model(lambdas, zeta)
+                self.assertEqual(model.kernel._kwargs["zeta"], zeta)
+                predictions_ref = np.dot(KNM, model_ref.weights)
+                predictions = np.dot(KNM, model.weights)
+                self.assertTrue(
+                    np.linalg.norm(predictions - predictions_ref)
+                    < 1e-5 * np.linalg.norm(predictions_ref)
+                )
+        with self.assertRaises(ValueError):
+            self.scan.get_model([1e-2, 5e-2], 3)
+
+    def test_cross_validation(self):
+        """Tests the cross-validation errors against models trained with
+        train_gap_model on the folds of AtomsList.get_folds"""
+        lambdas = np.array([[1e-2, 5e-2], [1e-1, 5e-2], [3e-2, 1e-1]])
+        n_folds, seed = 3, 10
+        errors = self.scan.cross_validation(lambdas, n_folds=n_folds, seed=seed)
+        self.assertEqual(errors["energy_rmse"].shape, (len(self.zetas), len(lambdas)))
+        self.assertEqual(errors["forces_rmse"].shape, (len(self.zetas), len(lambdas)))
+
+        for i_zeta, zeta in enumerate(self.zetas):
+            kernel = self.get_kernel(zeta)
+            energy_se = np.zeros(len(lambdas))
+            forces_se = np.zeros(len(lambdas))
+            for train, validation, validation_ids in self.managers.get_folds(
+                n_folds, seed=seed
+            ):
+                train_ids = np.setdiff1d(np.arange(len(self.frames)), validation_ids)
+                KNM = self.get_KNM(kernel, train)
+                KNM_val = self.get_KNM(kernel, validation)
+                n_val = len(validation_ids)
+                for i_lambda, lambdas_ in enumerate(lambdas):
+                    model = train_gap_model(
+                        kernel,
+                        [self.frames[idx] for idx in train_ids],
+                        KNM,
+                        self.X_sparse,
+                        self.energies[train_ids],
+                        self.self_contributions,
+                        grad_train=np.vstack([self.gradients[i] for i in train_ids]),
+                        lambdas=lambdas_,
+                    )
+                    predictions = np.dot(KNM_val, model.weights).reshape((-1))
+                    references = np.concatenate(
+                        [self.energies[validation_ids]]
+                        + [self.gradients[i].flatten() for i in validation_ids]
+                    )
+                    residuals = predictions - references
+                    energy_se[i_lambda] += np.sum(residuals[:n_val] ** 2)
+                    forces_se[i_lambda] += np.sum(residuals[n_val:] ** 2)
+            n_grads = 3 * sum(len(frame) for frame in self.frames)
+            self.assertTrue(
+                np.allclose(
+                    errors["energy_rmse"][i_zeta],
+                    np.sqrt(energy_se / len(self.frames)),
+                    rtol=1e-5,
+                )
+            )
+            self.assertTrue(
+                np.allclose(
+                    errors["forces_rmse"][i_zeta],
+                    np.sqrt(forces_se / n_grads),
+                    rtol=1e-5,
+                )
+            )
+
+
+class TestIncrementalGAPTrainer(unittest.TestCase):
+    def setUp(self):
+        load_gap_training_set(self)
+        self.kernel = Kernel(
+            self.rep, name="GAP", zeta=2, target_type="Structure", kernel_type="Sparse"
+        )
+        self.lambdas = [1e-2, 5e-2]
+
+    def test_updates(self):
+        """Tests that adding structures and sparse points in several steps
+        gives the model of train_gap_model on all of them"""
+        n_frames = len(self.frames)
+        half = n_frames // 2
+        # start with the sparse points of the carbons
+        X_sparse = SparsePoints(self.rep)
+        X_sparse.extend(self.managers, [[0, 5]] * n_frames)
+        trainer = IncrementalGAPTrainer(
+            self.kernel,
+            X_sparse,
+            self.self_contributions,
+            self.lambdas,
+            delta=np.std(self.energies),
+        )
+        for ids in [np.arange(half), np.arange(half, n_frames)]:
+            trainer.add_structures(
+                [self.frames[idx] for idx in ids],
+                self.managers.get_subset(ids.tolist()),
+                self.energies[ids],
+                np.vstack([self.gradients[idx] for idx in ids]),
+            )
+        model_carbons = trainer.get_model()
+        self.assertEqual(model_carbons.X_train.size(), X_sparse.size())
+        # then add hydrogens and carbons which interleaves them in X_sparse
+        # in two steps, the sparse points are only copied when a model shares
+        # them
+        new_ids = [[1, 6]] * half + [[2, 5]] + [[]] * (n_frames - half - 1)
+        trainer.add_sparse_points(
+            self.managers, new_ids[:half] + [[]] * (n_frames - half)
+        )
+        X_sparse_trainer = trainer.X_sparse
+        self.assertIsNot(X_sparse_trainer, model_carbons.X_train)
+        trainer.add_sparse_points(self.managers, [[]] * half + new_ids[half:])
+        self.assertIs(trainer.X_sparse, X_sparse_trainer)
+        model = trainer.get_model()
+        self.assertIs(model.X_train, X_sparse_trainer)
+        # the previous model keeps its sparse points
+        self.assertEqual(model_carbons.X_train.size(), X_sparse.size())
+
+        X_sparse.extend(self.managers, new_ids)
+        KNM = np.vstack(
+            [
+                self.kernel(self.managers, X_sparse),
+                self.kernel(self.managers, X_sparse, grad=(True, False)),
+            ]
+        )
+        model_ref = train_gap_model(
+            self.kernel,
+            self.frames,
+            KNM,
+            X_sparse,
+            self.energies,
+            self.self_contributions,
+            grad_train=np.vstack(self.gradients),
+            lambdas=self.lambdas,
+        )
+        self.assertEqual(model.X_train.size(), X_sparse.size())
+        predictions_ref = np.dot(KNM, model_ref.weights)
+        predictions = np.dot(KNM, model.weights)
+        self.assertTrue(
+            np.linalg.norm(predictions - predictions_ref)
+            < 1e-5 * np.linalg.norm(predictions_ref)
+        )
+
+
+class TestThreeBodyModels(unittest.TestCase):
+    def setUp(self):
+        load_gap_training_set(self, n_frames=6)
+        self.rep = ThreeBody(
+            interaction_cutoff=3.5,
+            cutoff_smooth_width=0.5,
+            max_radial=3,
+            max_angular=2,
+            compute_gradients=True,
+        )
+        self.managers = self.rep.transform(self.frames)
+        self.X_sparse = SparsePoints(self.rep)
+        self.X_sparse.extend(self.managers, [[0, 1, 5, 6]] * len(self.frames))
+        self.kernel = Kernel(
+            self.rep, name="GAP", zeta=2, target_type="Structure", kernel_type="Sparse"
+        )
+
+    def test_sparse_points(self):
+        self.assertEqual(self.X_sparse.size(), 4 * len(self.frames))
+        self.assertEqual(
+            sorted(np.unique(self.X_sparse.get_species()).tolist()), [1, 6]
+        )
+        X_sparse = from_dict(to_dict(self.X_sparse))
+        self.assertTrue(
+            np.allclose(X_sparse.get_features(), self.X_sparse.get_features())
+        )
+
+    def test_kernel_gradients(self):
+        """Tests the analytical derivatives of the sparse kernel of the
+        three-body features against finite differences"""
+        KNM_grad = self.kernel(self.managers, self.X_sparse, grad=(True, False))
+        KNM_num = compute_numerical_kernel_gradients(
+            self.kernel, self.rep, self.managers, self.X_sparse, 1e-5, False
+        )
+        self.assertEqual(KNM_grad.shape, KNM_num.shape)
+        self.assertTrue(
+            np.allclose(KNM_grad, KNM_num, atol=1e-6 * np.abs(KNM_num).max())
+        )
+
+    def test_predictions(self):
+        """Tests that a GAP model on the three-body features predicts the
+        same forces and stress with the fused and the separate predictions"""
+        KNM = np.vstack(
+            [
+                self.kernel(self.managers, self.X_sparse),
+                self.kernel(self.managers, self.X_sparse, grad=(True, False)),
+            ]
+        )
+        model = train_gap_model(
+            self.kernel,
+            self.frames,
+            KNM,
+            self.X_sparse,
+            self.energies,
+            self.self_contributions,
+            grad_train=np.vstack(self.gradients),
+            lambdas=[1e-2, 5e-2],
+        )
+        n_structures = len(self.frames)
+        energies, forces, stress = model.predict_all(self.managers)
+        self.assertTrue(np.allclose(energies, model.predict(self.managers)))
+        self.assertTrue(
+            np.allclose(
+                energies, np.dot(KNM[:n_structures], model.weights).flatten()
+            )
+        )
+        self.assertTrue(np.allclose(forces, model.predict_forces(self.managers)))
+        self.assertTrue(
+            np.allclose(
+                forces, -np.dot(KNM[n_structures:], model.weights).reshape((-1, 3))
+            )
+        )
+        self.assertTrue(np.allclose(stress, model.predict_stress(self.managers)))
+
+        cosine_kernel = Kernel(self.rep, name="Cosine", target_type="Atom", zeta=2)
+        K = cosine_kernel(self.managers)
+        self.assertTrue(np.allclose(np.diag(K), 1.0))
@@ -3,7 +3,7 @@ from rascal.representations import (
     SphericalExpansion,
     SphericalInvariants,
 )
-from rascal.utils import from_dict, to_dict, FPSFilter
+from rascal.utils import from_dict, to_dict, FPSFilter, reset_timings
 from rascal.models import Kernel
 from rascal.models.sparse_points import SparsePoints
 from test_utils import load_json_frame, BoxList, Box, dot
@@ -20,6 +20,98 @@ inputs_path = os.path.join(rascal_reference_path, "inputs")
 dump_path = os.path.join(rascal_reference_path, "tests_only")
 
 
+def check_derivative_products(test_case, rep, frame, h_disp=1e-5):
+    """
+    Check the vector-Jacobian (backward) and Jacobian-vector (jvp) products
+    of the representation of frame against centered finite differences of
+    its features, and the change of backward (backward_jvp) against the
+    finite differences of backward.
+    """
+    np.random.seed(10)
+    positions = frame["positions"]
+    n_atoms = positions.shape[1]
+
+    def get_features(displaced_positions):
+        displaced = copy(frame)
+        displaced["positions"] = np.array(displaced_positions, order="F")
+        return rep.transform([displaced]).get_features(rep)
+
+    managers = rep.transform([frame])
+    X = managers.get_features(rep)
+    features_gradient = np.random.uniform(-1, 1, X.shape)
+
+    # L = sum(features_gradient * X)
+    dLdr, virial = rep.backward(managers[0], features_gradient)
+    test_case.assertEqual(dLdr.shape, (n_atoms, 3))
+    test_case.assertEqual(virial.shape, (1, 6))
+    dLdr_num = np.zeros((n_atoms, 3))
+    for i_atom in range(n_atoms):
+        for i_der in range(3):
+            L = []
+            for sign in [1.0, -1.0]:
+                displaced_positions = positions.copy()
+                displaced_positions[i_der, i_atom] += sign * h_disp
+                L.append(np.sum(features_gradient * get_features(displaced_positions)))
+            dLdr_num[i_atom, i_der] = (L[0] - L[1]) / (2 * h_disp)
+    test_case.assertTrue(
+        np.allclose(dLdr, dLdr_num, rtol=1e-5, atol=1e-6 * np.abs(dLdr_num).max())
+    )
+
+    displacements = np.random.uniform(-1, 1, (n_atoms, 3))
+    dX = rep.jvp(managers[0], displacements)
+    dX_num = (
+        get_features(positions + h_disp * displacements.T)
+        - get_features(positions - h_disp * displacements.T)
+    ) / (2 * h_disp)
+    test_case.assertEqual(dX.shape, X.shape)
+    test_case.assertTrue(
+        np.allclose(dX, dX_num, rtol=1e-5, atol=1e-6 * np.abs(dX_num).max())
+    )
+
+    # change of dL/dr for the displacements against the finite differences
+    # of backward, it is linear in the change of dL/dX
+    def get_backward(displaced_positions):
+        displaced = copy(frame)
+        displaced["positions"] = np.array(displaced_positions, order="F")
+        return rep.backward(rep.transform([displaced])[0], features_gradient)[0]
+
+    zero_change = np.zeros(X.shape)
+    ddLdr = rep.backward_jvp(
+        managers[0], features_gradient, zero_change, displacements
+    )
+    ddLdr_num = (
+        get_backward(positions + h_disp * displacements.T)
+        - get_backward(positions - h_disp * displacements.T)
+    ) / (2 * h_disp)
+    test_case.assertEqual(ddLdr.shape, (n_atoms, 3))
+    test_case.assertTrue(
+        np.allclose(
+            ddLdr, ddLdr_num, rtol=1e-5, atol=1e-6 * np.abs(ddLdr_num).max()
+        )
+    )
+    features_gradient_change = np.random.uniform(-1, 1, X.shape)
+    ddLdr_change = rep.backward_jvp(
+        managers[0],
+        features_gradient,
+        features_gradient_change,
+        displacements,
+        fd_step=1e-4,
+    )
+    dLdr_change = rep.backward(managers[0], features_gradient_change)[0]
+    test_case.assertTrue(
+        np.allclose(
+            ddLdr_change - ddLdr,
+            dLdr_change,
+            rtol=1e-6,
+            atol=1e-7 * np.abs(ddLdr).max(),
+        )
+    )
+    with test_case.assertRaises(RuntimeError):
+        rep.backward_jvp(
+            managers[0], features_gradient, zero_change, displacements, fd_step=0.0
+        )
+
+
 class TestSortedCoulombRepresentation(unittest.TestCase):
     def setUp(self):
         """
@@ -96,6 +188,15 @@ class TestSphericalExpansionRepresentation(unittest.TestCase):
 
         test = features.get_features(rep)
 
+    def test_derivative_products(self):
+        """
+        Test the backward and jvp functions against finite differences.
+        """
+        hypers = deepcopy(self.hypers)
+        hypers.update(interaction_cutoff=3.5, max_radial=4, max_angular=3)
+        rep = SphericalExpansion(**hypers)
+        check_derivative_products(self, rep, self.frames[2])
+
     def test_serialization(self):
         rep = SphericalExpansion(**self.hypers)
 
@@ -172,6 +273,75 @@ class TestSphericalInvariantsRepresentation(unittest.TestCase):
         kk = dot(X_t, X_t)
         self.assertTrue(np.allclose(kk, kk_ref))
 
+    def test_compute_by_batch(self):
+        """
+        Test that the features computed by batches of centers match the ones
+        computed on the whole structure, whatever the size of the batches.
+        """
+        rep = SphericalInvariants(**self.hypers)
+
+        for frame in self.frames:
+            n_atoms = len(frame["atom_types"])
+            X_ref = rep.transform([frame]).get_features(rep, self.global_species)
+            for batch_size in [1, 7, 1000]:
+                X_t = np.zeros_like(X_ref)
+                n_calls = np.zeros(n_atoms, dtype=int)
+
+                def callback(features, atom_indices):
+                    self.assertLessEqual(len(atom_indices), batch_size)
+                    X_t[atom_indices] = features
+                    n_calls[atom_indices] += 1
+
+                rep.compute_by_batch(
+                    frame, callback, batch_size, species=self.global_species
+                )
+                # every center is computed exactly once
+                self.assertTrue(np.all(n_calls == 1))
+                self.assertTrue(np.allclose(X_t, X_ref))
+
+    def test_derivative_products(self):
+        """
+        Test the backward and jvp functions against finite differences.
+        """
+        rep = SphericalInvariants(**self.hypers)
+        check_derivative_products(self, rep, self.frames[2])
+
+    def test_get_timings(self):
+        """
+        Test that get_timings reports the computation of the invariants and of
+        the expansion when the timers are compiled in, and nothing otherwise.
+        """
+        rep = SphericalInvariants(**self.hypers)
+        reset_timings()
+        rep.transform(self.frames)
+        timings = rep.get_timings()
+        self.assertEqual(set(timings.keys()), {"timers", "counters", "level"})
+
+        if timings["level"] == 0:
+            self.assertEqual(len(timings["timers"]), 0)
+            self.assertEqual(len(timings["counters"]), 0)
+            return
+
+        timers = timings["timers"]
+        self.assertIn("SphericalInvariants::compute", timers)
+        self.assertIn(
+            "SphericalInvariants::compute/SphericalExpansion::compute", timers
+        )
+        # the timers of the neighbour list are filtered out
+        self.assertFalse(any("AdaptorNeighbourList" in path for path in timers))
+        n_centers = sum(len(frame["atom_types"]) for frame in self.frames)
+        self.assertEqual(
+            timings["counters"]["SphericalInvariants::centers"], n_centers
+        )
+        self.assertEqual(
+            timings["counters"]["SphericalExpansion::centers"], n_centers
+        )
+
+        reset_timings()
+        timings = rep.get_timings()
+        self.assertEqual(len(timings["timers"]), 0)
+        self.assertEqual(len(timings["counters"]), 0)
+
     def test_representation_gradient(self):
         """
         Test the get_features and get_features_gradient functions by computing
@@ -413,3 +413,78 @@ class CenterSelectTest(unittest.TestCase):
         test_mask = np.zeros((self.natoms,), dtype="bool")
         test_mask[3] = True
         self.check_mask(test_mask)
+
+
+class TestAtomsListFromArrays(unittest.TestCase):
+    def setUp(self):
+        """Build the same structures from ase.Atoms and from flat arrays."""
+        self.frames = ase.io.read(
+            os.path.join(inputs_path, "small_molecules-20.json"), ":5"
+        )
+        self.frames += ase.io.read(
+            os.path.join(inputs_path, "CaCrP2O7_mvc-11955_symmetrized.json"), ":"
+        )
+        interaction_cutoff = 3.0
+        self.nl_options = [
+            dict(name="centers", args=dict()),
+            dict(name="neighbourlist", args=dict(cutoff=interaction_cutoff)),
+            dict(name="centercontribution", args=dict()),
+            dict(name="strict", args=dict(cutoff=interaction_cutoff)),
+        ]
+
+    def test_from_arrays(self):
+        offsets = np.cumsum([0] + [len(frame) for frame in self.frames])
+        managers = AtomsList.from_arrays(
+            positions=np.concatenate(
+                [frame.get_positions() for frame in self.frames]
+            ),
+            numbers=np.concatenate(
+                [frame.get_atomic_numbers() for frame in self.frames]
+            ),
+            cells=np.array([frame.get_cell().array for frame in self.frames]),
+            pbcs=np.array([frame.get_pbc() for frame in self.frames]),
+            offsets=offsets,
+            nl_options=self.nl_options,
+            n_threads=2,
+        )
+        ref_managers = AtomsList(self.frames, self.nl_options)
+        self.assertEqual(len(managers), len(self.frames))
+        self.assertTrue(
+            np.allclose(managers.get_distances(), ref_managers.get_distances())
+        )
+        self.assertTrue(
+            np.array_equal(
+                managers.get_gradients_info(), ref_managers.get_gradients_info()
+            )
+        )
+        subset = managers.get_subset([1, 3])
+        self.assertEqual(len(subset), 2)
+
+    def test_update_structures(self):
+        frames = [self.frames[-1].copy() for _ in range(3)]
+        managers = AtomsList(frames, self.nl_options)
+        np.random.seed(10)
+        for frame in frames:
+            frame.positions += np.random.uniform(-0.3, 0.3, frame.positions.shape)
+            frame.wrap(eps=1e-11)
+        managers.update_structures(
+            np.array([frame.get_positions() for frame in frames]),
+            frames[0].get_cell().array,
+        )
+        ref_managers = AtomsList(frames, self.nl_options)
+        self.assertTrue(
+            np.allclose(managers.get_distances(), ref_managers.get_distances())
+        )
+
+    def test_folds(self):
+        managers = AtomsList(self.frames, self.nl_options)
+        n_folds = 3
+        validation_ids = []
+        for train, validation, ids in managers.get_folds(n_folds, seed=10):
+            self.assertEqual(len(train) + len(validation), len(self.frames))
+            validation_ids.extend(ids)
+            ref_distances = np.concatenate(
+                [managers.get_subset([idx]).get_distances() for idx in ids]
+            )
+            self.assertTrue(np.allclose(validation.get_distances(), ref_distances))
+        self.assertEqual(sorted(validation_ids), list(range(len(self.frames))))
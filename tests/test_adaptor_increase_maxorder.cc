@@ -29,6 +29,7 @@
 #include "test_structure.hh"
 
 #include "rascal/structure_managers/adaptor_half_neighbour_list.hh"
+#include "rascal/structure_managers/implicit_triplet_list.hh"
 
 #include <boost/test/unit_test.hpp>
 
@@ -211,6 +212,145 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /*
+   * Test that the implicit triplets of a full neighbour list are the
+   * triplets of AdaptorMaxOrder without the permutations of j and k.
+   */
+  BOOST_FIXTURE_TEST_CASE(implicit_triplets_test,
+                          ManagerFixture<StructureManagerCenters>) {
+    const double cutoff{3.5};
+    auto pair_manager{
+        make_adapted_manager<AdaptorNeighbourList>(this->manager, cutoff)};
+    auto strict_manager{
+        make_adapted_manager<AdaptorStrict>(pair_manager, cutoff)};
+    auto triplet_manager{make_adapted_manager<AdaptorMaxOrder>(strict_manager)};
+    triplet_manager->update();
+
+    ImplicitTripletList<AdaptorStrict<AdaptorNeighbourList<Manager_t>>>
+        implicit_triplets{};
+    implicit_triplets.update(strict_manager);
+    BOOST_CHECK_EQUAL(implicit_triplets.size(), strict_manager->size());
+    BOOST_CHECK_EQUAL(implicit_triplets.get_nb_pairs(),
+                      strict_manager->get_nb_clusters(2));
+    BOOST_CHECK_EQUAL(2 * implicit_triplets.get_nb_triplets(),
+                      triplet_manager->get_nb_clusters(3));
+
+    size_t i_center{0};
+    for (auto center : triplet_manager) {
+      BOOST_CHECK_EQUAL(implicit_triplets.get_center_atom_tag(i_center),
+                        center.get_atom_tag());
+      std::vector<std::array<int, 2>> explicit_tags{};
+      for (auto triplet : center.triplets()) {
+        auto && tags{triplet.get_atom_tag_list()};
+        explicit_tags.push_back({{std::min(tags[1], tags[2]),
+                                  std::max(tags[1], tags[2])}});
+      }
+      std::vector<std::array<int, 2>> implicit_tags{};
+      implicit_triplets.for_each_triplet(
+          i_center, [&implicit_triplets, &implicit_tags](
+                        size_t i_pair_j, size_t i_pair_k, double) {
+            const int tag_j{implicit_triplets.get_neighbour_atom_tag(i_pair_j)};
+            const int tag_k{implicit_triplets.get_neighbour_atom_tag(i_pair_k)};
+            // each triplet appears twice in AdaptorMaxOrder
+            implicit_tags.push_back(
+                {{std::min(tag_j, tag_k), std::max(tag_j, tag_k)}});
+            implicit_tags.push_back(implicit_tags.back());
+          });
+      std::sort(explicit_tags.begin(), explicit_tags.end());
+      std::sort(implicit_tags.begin(), implicit_tags.end());
+      BOOST_CHECK(explicit_tags == implicit_tags);
+      i_center++;
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /*
+   * Test the angular cutoff of the implicit triplets and that the batches
+   * give the triplets of for_each_triplet with the same cosines.
+   */
+  BOOST_FIXTURE_TEST_CASE(implicit_triplets_batch_test,
+                          ManagerFixture<StructureManagerCenters>) {
+    const double cutoff{3.5};
+    const double angular_cutoff{2.5};
+    const size_t batch_size{7};
+    auto pair_manager{
+        make_adapted_manager<AdaptorNeighbourList>(this->manager, cutoff)};
+    auto strict_manager{
+        make_adapted_manager<AdaptorStrict>(pair_manager, cutoff)};
+    using StrictManager_t = AdaptorStrict<AdaptorNeighbourList<Manager_t>>;
+
+    BOOST_CHECK_THROW(ImplicitTripletList<StrictManager_t>{0.},
+                      std::runtime_error);
+    ImplicitTripletList<StrictManager_t> implicit_triplets{angular_cutoff};
+    implicit_triplets.update(strict_manager);
+    typename ImplicitTripletList<StrictManager_t>::TripletBatch batch{};
+
+    size_t i_center{0};
+    for (auto center : strict_manager) {
+      // reference: all the pairs of neighbours within the angular cutoff
+      std::vector<Eigen::Vector3d> vectors{};
+      for (auto neigh : center.pairs()) {
+        Eigen::Vector3d vector{neigh.get_position() - center.get_position()};
+        if (vector.norm() < angular_cutoff) {
+          vectors.push_back(vector);
+        }
+      }
+      BOOST_CHECK_EQUAL(implicit_triplets.get_nb_angular_neighbours(i_center),
+                        vectors.size());
+      BOOST_CHECK_EQUAL(implicit_triplets.get_nb_neighbours(i_center),
+                        center.pairs().size());
+      std::vector<double> reference_cosines{};
+      for (size_t j_neigh{0}; j_neigh < vectors.size(); ++j_neigh) {
+        for (size_t k_neigh{j_neigh + 1}; k_neigh < vectors.size();
+             ++k_neigh) {
+          reference_cosines.push_back(
+              vectors[j_neigh].dot(vectors[k_neigh]) /
+              (vectors[j_neigh].norm() * vectors[k_neigh].norm()));
+        }
+      }
+      BOOST_CHECK_EQUAL(implicit_triplets.get_nb_triplets(i_center),
+                        reference_cosines.size());
+
+      std::vector<std::array<size_t, 2>> triplets{};
+      std::vector<double> cosines{};
+      implicit_triplets.for_each_triplet(
+          i_center, [&triplets, &cosines](size_t i_pair_j, size_t i_pair_k,
+                                          double cosine) {
+            triplets.push_back({{i_pair_j, i_pair_k}});
+            cosines.push_back(cosine);
+          });
+      BOOST_REQUIRE_EQUAL(cosines.size(), reference_cosines.size());
+      for (size_t i_triplet{0}; i_triplet < cosines.size(); ++i_triplet) {
+        BOOST_CHECK_CLOSE(cosines[i_triplet] + 2.,
+                          reference_cosines[i_triplet] + 2., TOLERANCE);
+      }
+
+      size_t i_triplet{0};
+      implicit_triplets.for_each_triplet_batch(
+          i_center, batch_size, batch,
+          [&](const typename ImplicitTripletList<
+              StrictManager_t>::TripletBatch & triplet_batch) {
+            BOOST_CHECK_EQUAL(triplet_batch.center, i_center);
+            BOOST_CHECK_LE(triplet_batch.size, batch_size);
+            for (size_t i_batch{0}; i_batch < triplet_batch.size; ++i_batch) {
+              BOOST_REQUIRE_LT(i_triplet, triplets.size());
+              const size_t i_pair_j{triplet_batch.neighbours_j[i_batch]};
+              BOOST_CHECK_EQUAL(i_pair_j, triplets[i_triplet][0]);
+              BOOST_CHECK_EQUAL(triplet_batch.neighbours_k[i_batch],
+                                triplets[i_triplet][1]);
+              BOOST_CHECK_CLOSE(triplet_batch.cosines(i_batch) + 2.,
+                                cosines[i_triplet] + 2., TOLERANCE);
+              BOOST_CHECK_EQUAL(triplet_batch.distances_j(i_batch),
+                                implicit_triplets.get_distance(i_pair_j));
+              i_triplet++;
+            }
+          });
+      BOOST_CHECK_EQUAL(i_triplet, triplets.size());
+      i_center++;
+    }
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace rascal
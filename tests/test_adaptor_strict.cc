@@ -33,6 +33,9 @@
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace rascal {
@@ -76,6 +79,98 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that the sorted neighbours are the neighbours of the unsorted
+   * adaptor sorted by species and distance, with the center pair first, that
+   * the distances and directions follow the pairs and that the species runs
+   * cover the neighbours.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(sorted_neighbours_test, Fix,
+                                   multiple_fixtures, Fix) {
+    using Pair_t = std::tuple<int, double, int>;
+    auto && managers = Fix::managers;
+    for (auto & manager : managers) {
+      double cutoff{manager->get_cutoff()};
+      auto adaptor{make_adapted_manager<AdaptorStrict>(manager, cutoff)};
+      json hypers{{"cutoff", cutoff}, {"sort_neighbours", true}};
+      auto adaptor_sorted{
+          make_adapted_manager_hypers<AdaptorStrict>(manager, hypers)};
+      adaptor->update();
+      adaptor_sorted->update();
+      BOOST_CHECK(not adaptor->are_neighbours_sorted());
+      BOOST_CHECK(adaptor_sorted->are_neighbours_sorted());
+      BOOST_REQUIRE_EQUAL(adaptor->size(), adaptor_sorted->size());
+
+      auto center_it{adaptor->begin()};
+      for (auto center : adaptor_sorted) {
+        auto && center_ref{*center_it};
+        BOOST_CHECK_EQUAL(adaptor->get_nb_species_runs(center_ref), 0);
+        std::vector<Pair_t> pairs{};
+        for (auto pair : center_ref.pairs()) {
+          pairs.emplace_back(pair.get_atom_type(),
+                             adaptor->get_distance(pair), pair.get_atom_tag());
+        }
+        if (Fix::Manager_t::traits::HasCenterPair) {
+          auto && self_pair{*center.pairs_with_self_pair().begin()};
+          BOOST_CHECK_EQUAL(self_pair.get_atom_tag(), center.get_atom_tag());
+          BOOST_CHECK_EQUAL(adaptor_sorted->get_distance(self_pair), 0.);
+        }
+
+        std::vector<Pair_t> sorted_pairs{};
+        for (auto pair : center.pairs()) {
+          const Eigen::Vector3d vector{pair.get_position() -
+                                       center.get_position()};
+          BOOST_CHECK_CLOSE(adaptor_sorted->get_distance(pair), vector.norm(),
+                            1e-10);
+          BOOST_CHECK_LE((adaptor_sorted->get_direction_vector(pair) -
+                          vector / vector.norm())
+                             .norm(),
+                         1e-12);
+          sorted_pairs.emplace_back(pair.get_atom_type(),
+                                    adaptor_sorted->get_distance(pair),
+                                    pair.get_atom_tag());
+        }
+        // sorted by species then distance, up to the rounding of the
+        // distances
+        for (size_t i_pair{1}; i_pair < sorted_pairs.size(); ++i_pair) {
+          const auto & previous{sorted_pairs[i_pair - 1]};
+          const auto & current{sorted_pairs[i_pair]};
+          BOOST_CHECK_LE(std::get<0>(previous), std::get<0>(current));
+          if (std::get<0>(previous) == std::get<0>(current)) {
+            BOOST_CHECK_LE(std::get<1>(previous),
+                           std::get<1>(current) + 1e-12);
+          }
+        }
+        // and the same pairs as without sorting
+        std::vector<Pair_t> sorted_pairs_copy{sorted_pairs};
+        std::sort(pairs.begin(), pairs.end());
+        std::sort(sorted_pairs_copy.begin(), sorted_pairs_copy.end());
+        BOOST_CHECK(pairs == sorted_pairs_copy);
+
+        size_t n_run_pairs{0};
+        for (size_t i_run{0};
+             i_run < adaptor_sorted->get_nb_species_runs(center); ++i_run) {
+          auto && run{adaptor_sorted->get_species_run(center, i_run)};
+          BOOST_CHECK_EQUAL(run.begin, n_run_pairs);
+          BOOST_CHECK_LT(run.begin, run.end);
+          for (size_t i_pair{run.begin}; i_pair < run.end; ++i_pair) {
+            BOOST_CHECK_EQUAL(std::get<0>(sorted_pairs[i_pair]),
+                              run.atom_type);
+          }
+          if (i_run > 0) {
+            BOOST_CHECK_GT(
+                run.atom_type,
+                adaptor_sorted->get_species_run(center, i_run - 1).atom_type);
+          }
+          n_run_pairs = run.end;
+        }
+        BOOST_CHECK_EQUAL(n_run_pairs, sorted_pairs.size());
+        ++center_it;
+      }
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   /**
    * Iteration test for strict adaptor. It also checks if the types of the
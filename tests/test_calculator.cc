@@ -33,6 +33,10 @@
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <map>
+#include <random>
+
 namespace rascal {
   /* ---------------------------------------------------------------------- */
 
@@ -44,6 +48,8 @@ namespace rascal {
                        CalculatorFixture<MultipleStructureSphericalInvariants<
                            MultipleStructureManagerNLCCStrictFixture>>,
                        CalculatorFixture<MultipleStructureSphericalCovariants<
+                           MultipleStructureManagerNLCCStrictFixture>>,
+                       CalculatorFixture<MultipleStructureThreeBody<
                            MultipleStructureManagerNLCCStrictFixture>>>;
 
   using fixtures_ref_test =
@@ -126,6 +132,46 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that the features computed with several threads are the same as
+   * with one thread and registered under the same name
+   */
+  using threads_fixtures =
+      boost::mpl::list<CalculatorFixture<MultipleStructureSortedCoulomb<
+                           MultipleStructureManagerNLStrictFixture>>,
+                       CalculatorFixture<MultipleStructureSphericalExpansion<
+                           MultipleStructureManagerNLCCStrictFixture>>,
+                       CalculatorFixture<MultipleStructureSphericalInvariants<
+                           MultipleStructureManagerNLCCStrictFixture>>,
+                       CalculatorFixture<MultipleStructureThreeBody<
+                           MultipleStructureManagerNLCCStrictFixture>>>;
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(threads_test, Fix, threads_fixtures, Fix) {
+    using Representation_t = typename Fix::Representation_t;
+    using Property_t = typename Fix::Property_t;
+    auto & managers = Fix::managers;
+    auto & representation_hypers = Fix::representation_hypers;
+
+    for (auto hyper : representation_hypers) {
+      Representation_t representation{hyper};
+      hyper["n_threads"] = 3;
+      Representation_t representation_threads{hyper};
+      BOOST_CHECK_EQUAL(representation.get_name(),
+                        representation_threads.get_name());
+      for (auto & manager : managers) {
+        representation.compute(manager);
+        auto && property{*manager->template get_property<Property_t>(
+            representation.get_name(), true)};
+        math::Matrix_t features = property.get_features();
+        property.set_updated_status(false);
+        representation_threads.compute(manager);
+        math::Matrix_t features_threads = property.get_features();
+        BOOST_CHECK_EQUAL(features.rows(), features_threads.rows());
+        BOOST_CHECK_EQUAL((features - features_threads).norm(), 0.);
+      }
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   /**
    * Test if the constructor runs and that the name is properly set
@@ -285,6 +331,8 @@ namespace rascal {
       CalculatorFixture<MultipleStructureSphericalCovariants<
           MultipleStructureManagerNLCCStrictFixtureCenterMask>>,
       CalculatorFixture<MultipleStructureSphericalInvariants<
+          MultipleStructureManagerNLCCStrictFixtureCenterMask>>,
+      CalculatorFixture<MultipleStructureThreeBody<
           MultipleStructureManagerNLCCStrictFixtureCenterMask>>>;
 
   /**
@@ -356,6 +404,181 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that computing the representation by batches of centers gives the
+   * same features as computing it on the whole structure, also when some
+   * centers of the structure are masked.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(compute_by_batch_test, Fix,
+                                   multiple_center_mask_fixtures, Fix) {
+    auto & managers = Fix::managers;
+    auto & hypers = Fix::representation_hypers;
+    using Representation_t = typename Fix::Representation_t;
+    using Property_t = typename Fix::Property_t;
+
+    const std::vector<size_t> batch_sizes{{1, 5, 1000}};
+    for (auto & manager : managers) {
+      for (auto & hyper : hypers) {
+        double representation_cutoff{
+            extract_interaction_cutoff_from_representation_hyper(hyper)};
+        if (manager->get_cutoff() != representation_cutoff) {
+          continue;
+        }
+        const double cutoff{manager->get_cutoff()};
+        json adaptors{{{"name", "AdaptorNeighbourList"},
+                       {"initialization_arguments", {{"cutoff", cutoff}}}},
+                      {{"name", "AdaptorCenterContribution"},
+                       {"initialization_arguments", {}}},
+                      {{"name", "AdaptorStrict"},
+                       {"initialization_arguments", {{"cutoff", cutoff}}}}};
+        auto manager_root = extract_underlying_manager<0>(manager);
+        const auto & structure = manager_root->get_atomic_structure();
+
+        Representation_t representation{hyper};
+        representation.compute(manager);
+        auto & prop = *manager->template get_property<Property_t>(
+            representation.get_name(), true);
+        const auto keys = prop.get_keys();
+        math::Matrix_t rep_full = prop.get_features();
+        // row of each center of the structure in rep_full
+        std::map<size_t, int> rows{};
+        for (auto center : manager) {
+          rows[manager_root->get_atom_index(center.get_atom_tag())] =
+              static_cast<int>(rows.size());
+        }
+
+        for (auto & batch_size : batch_sizes) {
+          size_t n_rows{0};
+          compute_by_batch<StructureManagerCenters, AdaptorNeighbourList,
+                           AdaptorCenterContribution, AdaptorStrict>(
+              representation, structure, adaptors, keys, batch_size,
+              [&](const Eigen::Ref<const math::Matrix_t> & features,
+                  const std::vector<size_t> & atom_indices) {
+                BOOST_REQUIRE_EQUAL(features.rows(), atom_indices.size());
+                BOOST_REQUIRE_LE(atom_indices.size(), batch_size);
+                BOOST_REQUIRE_EQUAL(features.cols(), rep_full.cols());
+                for (size_t i_row{0}; i_row < atom_indices.size(); ++i_row) {
+                  BOOST_REQUIRE_EQUAL(rows.count(atom_indices[i_row]), 1);
+                  auto diff = (features.row(i_row) -
+                               rep_full.row(rows[atom_indices[i_row]]))
+                                  .norm();
+                  BOOST_CHECK_LE(diff, math::DBL_FTOL);
+                }
+                n_rows += atom_indices.size();
+              });
+          BOOST_CHECK_EQUAL(n_rows, manager->size());
+        }
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+
+  using multiple_center_mask_gradient_fixtures = boost::mpl::list<
+      CalculatorFixture<MultipleStructureSphericalExpansion<
+          MultipleStructureManagerNLCCStrictFixtureCenterMask>>,
+      CalculatorFixture<MultipleStructureSphericalInvariants<
+          MultipleStructureManagerNLCCStrictFixtureCenterMask>>>;
+
+  /**
+   * Test that selecting subsets of centers will give the same gradients for
+   * the remaining centers. Since the neighbours might be ordered differently,
+   * the gradients of a center are summed over the periodic images of each
+   * neighbour and compared by atom, i.e. column of the positions.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(multiple_center_mask_gradient_test, Fix,
+                                   multiple_center_mask_gradient_fixtures,
+                                   Fix) {
+    auto & managers = Fix::managers;
+    auto & hypers = Fix::representation_hypers;
+    using Representation_t = typename Fix::Representation_t;
+    using Manager_t = typename Fix::Manager_t;
+    using PropGrad_t =
+        typename Representation_t::template PropertyGradient_t<Manager_t>;
+    using Key_t = typename PropGrad_t::Key_t;
+    using AtomGradients_t = std::map<size_t, std::map<Key_t, math::Matrix_t>>;
+
+    // sum the gradients of a center by neighbour atom and key
+    auto sum_gradients_by_atom = [](auto & manager, auto & prop_grad,
+                                    auto & center) {
+      auto root = extract_underlying_manager<0>(manager);
+      AtomGradients_t grads{};
+      for (auto neigh : center.pairs_with_self_pair()) {
+        size_t atom_index{root->get_atom_index(
+            manager->get_atom_index(neigh.get_atom_tag()))};
+        auto & atom_grads = grads[atom_index];
+        for (auto & key : prop_grad.get_keys(neigh)) {
+          math::Matrix_t grad = prop_grad(neigh, key);
+          if (atom_grads.count(key) == 0) {
+            atom_grads[key] = grad;
+          } else {
+            atom_grads[key] += grad;
+          }
+        }
+      }
+      return grads;
+    };
+
+    int n_manager{static_cast<int>(managers.size())};
+    for (int i_manager{0}; i_manager < n_manager; i_manager += 2) {
+      for (auto hyper : hypers) {
+        auto & manager = managers[i_manager];
+        double representation_cutoff{
+            extract_interaction_cutoff_from_representation_hyper(hyper)};
+        // the BiSpectrum has no gradients
+        if (manager->get_cutoff() != representation_cutoff or
+            (hyper.count("soap_type") and hyper["soap_type"] == "BiSpectrum")) {
+          continue;
+        }
+        auto & manager_no_center = managers[i_manager + 1];
+        auto center_atoms_mask =
+            extract_underlying_manager<0>(manager_no_center)
+                ->get_center_atoms_mask();
+
+        hyper["compute_gradients"] = true;
+        Representation_t representation{hyper};
+        representation.compute(manager);
+        representation.compute(manager_no_center);
+
+        auto & prop_grad = *manager->template get_property<PropGrad_t>(
+            representation.get_gradient_name(), true);
+        auto & prop_grad_no_center =
+            *manager_no_center->template get_property<PropGrad_t>(
+                representation.get_gradient_name(), true);
+
+        BOOST_CHECK_EQUAL(center_atoms_mask.count(), manager_no_center->size());
+
+        auto center_no_center_it = manager_no_center->begin();
+        for (auto center : manager) {
+          if (not center_atoms_mask(center.get_atom_tag())) {
+            continue;
+          }
+          // the cluster refs keep a reference to their iterator so it is
+          // incremented only once center_no_center is not used anymore
+          auto center_no_center = *center_no_center_it;
+          BOOST_CHECK_EQUAL(center.get_atom_type(),
+                            center_no_center.get_atom_type());
+
+          auto grads = sum_gradients_by_atom(manager, prop_grad, center);
+          auto grads_no_center = sum_gradients_by_atom(
+              manager_no_center, prop_grad_no_center, center_no_center);
+          BOOST_CHECK_EQUAL(grads.size(), grads_no_center.size());
+          for (auto & atom_grad : grads_no_center) {
+            BOOST_REQUIRE_EQUAL(grads.count(atom_grad.first), 1);
+            auto & key_grads = grads[atom_grad.first];
+            BOOST_CHECK_EQUAL(key_grads.size(), atom_grad.second.size());
+            for (auto & key_grad : atom_grad.second) {
+              BOOST_REQUIRE_EQUAL(key_grads.count(key_grad.first), 1);
+              auto & grad = key_grads[key_grad.first];
+              BOOST_CHECK_LE((grad - key_grad.second).norm(), math::DBL_FTOL);
+            }
+          }
+          ++center_no_center_it;
+        }
+      }
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
 
   using grad_sparse_fixtures =
@@ -550,11 +773,13 @@ namespace rascal {
       CalculatorFixture<
           SingleHypersSphericalExpansion<SimplePeriodicNLCCStrictFixture>>,
       CalculatorFixture<
-          SingleHypersSphericalInvariants<SimplePeriodicNLCCStrictFixture>>>;
+          SingleHypersSphericalInvariants<SimplePeriodicNLCCStrictFixture>>,
+      CalculatorFixture<
+          SingleHypersThreeBody<SimplePeriodicNLCCStrictFixture>>>;
 
   /**
-   * Test the gradient of the SphericalExpansion and SphericalInvariants
-   * representation on a few simple crystal structures (single- and
+   * Test the gradient of the SphericalExpansion, SphericalInvariants and
+   * ThreeBody representation on a few simple crystal structures (single- and
    * multi-species, primitive and supercells)
    */
   BOOST_FIXTURE_TEST_CASE_TEMPLATE(spherical_representation_gradients, Fix,
@@ -1065,6 +1290,433 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test the power spectrum computed with several threads on a half neighbor
+   * list against the full neighbor list implementation computed with one
+   * thread. The gradients \grad_i p^{j} of the pairs ij between two centers
+   * of the half list are compared with the gradients of the pairs ji of the
+   * full list.
+   */
+  using HalfFullInvariantsFixture =
+      MergeHalfAndFull<SimpleFullFixture, SimpleHalfFixture,
+                       CalculatorSphericalInvariants>;
+  BOOST_FIXTURE_TEST_CASE(half_threads_reverse_gradient_test,
+                          HalfFullInvariantsFixture) {
+    using Fix = HalfFullInvariantsFixture;
+    using Prop_t = typename Fix::Prop_t;
+    using PropHalf_t = typename Fix::PropHalf_t;
+    using PropGrad_t = typename Fix::PropGrad_t;
+    using PropGradHalf_t = typename Fix::PropGradHalf_t;
+    using Representation_t = typename Fix::Representation_t;
+    auto & managers = Fix::ParentFull::managers;
+    auto & managers_half = Fix::ParentHalf::managers;
+    auto & representation_hypers = Fix::ParentFull::representation_hypers;
+
+    // relative error threshold
+    const double delta{4e-7};
+    // range of zero
+    const double epsilon{1e-15};
+
+    // compares the blocks of the keys of reference, the other keys of test
+    // should be zero
+    auto compare_blocks = [&](auto & reference, auto & test) {
+      auto keys_test = test.get_keys();
+      for (const auto & key : reference.get_keys()) {
+        math::Matrix_t block_reference = reference[key];
+        if (std::find(keys_test.begin(), keys_test.end(), key) ==
+            keys_test.end()) {
+          BOOST_TEST(block_reference.cwiseAbs().maxCoeff() < epsilon);
+          continue;
+        }
+        math::Matrix_t block_test = test[key];
+        auto diff_m{
+            math::relative_error(block_reference, block_test, delta, epsilon)};
+        BOOST_TEST(diff_m.maxCoeff() < delta);
+      }
+      auto keys_reference = reference.get_keys();
+      for (const auto & key : keys_test) {
+        if (std::find(keys_reference.begin(), keys_reference.end(), key) ==
+            keys_reference.end()) {
+          math::Matrix_t block_test = test[key];
+          BOOST_TEST(block_test.cwiseAbs().maxCoeff() < epsilon);
+        }
+      }
+    };
+
+    for (size_t i_manager{0}; i_manager < managers.size(); ++i_manager) {
+      for (auto rep_hypers : representation_hypers[i_manager]) {
+        if (rep_hypers.at("soap_type").get<std::string>() != "PowerSpectrum") {
+          continue;
+        }
+        auto & manager = managers[i_manager];
+        auto & manager_half = managers_half[i_manager];
+        Representation_t representation{rep_hypers};
+        rep_hypers["n_threads"] = 3;
+        Representation_t representation_threads{rep_hypers};
+        representation.compute(manager);
+        representation_threads.compute(manager_half);
+
+        auto && rep_vectors{
+            *manager->template get_property<Prop_t>(representation.get_name())};
+        auto && rep_vectors_half{
+            *manager_half->template get_property<PropHalf_t>(
+                representation_threads.get_name())};
+        auto && rep_vector_gradients{
+            *manager->template get_property<PropGrad_t>(
+                representation.get_gradient_name())};
+        auto && rep_vector_gradients_half{
+            *manager_half->template get_property<PropGradHalf_t>(
+                representation_threads.get_gradient_name())};
+        auto && rep_vector_reverse_gradients_half{
+            *manager_half->template get_property<PropGradHalf_t>(
+                representation_threads.get_reverse_gradient_name())};
+
+        size_t center_count{0};
+        for (auto center_half : manager_half) {
+          auto it = manager->get_iterator_at(center_count, 0);
+          auto center = *(it);
+          compare_blocks(rep_vectors[center], rep_vectors_half[center_half]);
+          for (auto half_neigh : center_half.pairs()) {
+            if (not manager_half->is_center_atom(half_neigh) or
+                half_neigh.get_atom_tag() == center_half.get_atom_tag()) {
+              continue;
+            }
+            // the pair ij of the full list
+            for (auto neigh : center.pairs()) {
+              if (neigh.get_atom_tag() == half_neigh.get_atom_tag()) {
+                compare_blocks(rep_vector_gradients[neigh],
+                               rep_vector_gradients_half[half_neigh]);
+              }
+            }
+            // the pair ji of the full list
+            auto it_j = manager->get_iterator_at(
+                manager->get_atom_index(half_neigh.get_atom_tag()), 0);
+            auto center_j = *(it_j);
+            for (auto neigh : center_j.pairs()) {
+              if (neigh.get_atom_tag() == center_half.get_atom_tag()) {
+                compare_blocks(rep_vector_gradients[neigh],
+                               rep_vector_reverse_gradients_half[half_neigh]);
+              }
+            }
+          }
+          center_count++;
+        }
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Contract the stored gradients \grad_j X^{i} of a representation with the
+   * upstream gradient dL/dX (vector-Jacobian product) and with the
+   * displacements of the atoms (Jacobian-vector product). The virial is
+   * accumulated like in compute_sparse_kernel_neg_stress.
+   */
+  template <class Representation, class Manager>
+  void contract_stored_gradients(Representation & representation,
+                                 std::shared_ptr<Manager> manager,
+                                 const math::Matrix_t & upstream,
+                                 const math::Matrix_t & displacements,
+                                 math::Matrix_t & gradients,
+                                 math::Matrix_t & virial,
+                                 math::Matrix_t & change) {
+    using Prop_t = typename Representation::template Property_t<Manager>;
+    using PropGrad_t =
+        typename Representation::template PropertyGradient_t<Manager>;
+    using ConstMapGrad_t = const Eigen::Map<
+        const Eigen::Matrix<double, ThreeD, Eigen::Dynamic, Eigen::RowMajor>>;
+    auto && rep_vectors{
+        *manager->template get_property<Prop_t>(representation.get_name())};
+    auto && rep_vector_gradients{*manager->template get_property<PropGrad_t>(
+        representation.get_gradient_name())};
+    const auto offsets{rep_vectors.get_feature_offsets()};
+    const int inner_size{rep_vectors.get_nb_comp()};
+    const size_t n_centers{manager->size()};
+    const std::array<std::array<int, 2>, ThreeD> voigt_id_to_spatial_dim = {
+        {{{4, 2}}, {{5, 0}}, {{3, 1}}}};
+    gradients = math::Matrix_t::Zero(n_centers, ThreeD);
+    virial = math::Matrix_t::Zero(1, 6);
+    change = math::Matrix_t::Zero(n_centers, upstream.cols());
+    size_t i_center{0};
+    for (auto center : manager) {
+      for (auto neigh : center.pairs_with_self_pair()) {
+        const size_t j_atom{manager->get_atom_index(neigh.get_atom_tag())};
+        auto & gradient{rep_vector_gradients[neigh]};
+        Eigen::Vector3d pair_derivative{Eigen::Vector3d::Zero()};
+        for (const auto & key : gradient.get_keys()) {
+          auto && block{gradient[key]};
+          ConstMapGrad_t gradient_by_key(block.data(), ThreeD, inner_size);
+          pair_derivative +=
+              gradient_by_key *
+              upstream.row(i_center)
+                  .segment(offsets.at(key), inner_size)
+                  .transpose();
+          if (j_atom < n_centers) {
+            change.row(i_center).segment(offsets.at(key), inner_size) +=
+                displacements.row(j_atom) * gradient_by_key;
+          }
+        }
+        if (j_atom < n_centers) {
+          gradients.row(j_atom) += pair_derivative.transpose();
+        }
+        const Eigen::Vector3d r_ji{center.get_position() -
+                                   neigh.get_position()};
+        for (int i_der{0}; i_der < ThreeD; ++i_der) {
+          const auto & voigt = voigt_id_to_spatial_dim[i_der];
+          virial(0, i_der) += r_ji(i_der) * pair_derivative(i_der);
+          virial(0, voigt[0]) += r_ji(voigt[1]) * pair_derivative(i_der);
+        }
+      }
+      ++i_center;
+    }
+  }
+
+  /**
+   * Test the vector-Jacobian and Jacobian-vector products of the spherical
+   * representations computed without storing the gradients, on full and
+   * half neighbour lists and with several threads, against the contraction
+   * of the stored gradients of the full neighbour list.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(jacobian_products_test, Fix,
+                                   gradient_half_fixtures, Fix) {
+    using Prop_t = typename Fix::Prop_t;
+    using Representation_t = typename Fix::Representation_t;
+    auto & managers = Fix::ParentFull::managers;
+    auto & managers_half = Fix::ParentHalf::managers;
+    auto & representation_hypers = Fix::ParentFull::representation_hypers;
+
+    // relative error threshold w.r.t. the largest reference value
+    const double delta{1e-12};
+    auto check = [&delta](const math::Matrix_t & reference,
+                          const math::Matrix_t & test) {
+      BOOST_REQUIRE_EQUAL(reference.rows(), test.rows());
+      BOOST_REQUIRE_EQUAL(reference.cols(), test.cols());
+      const double scale{std::max(reference.cwiseAbs().maxCoeff(), 1.)};
+      BOOST_TEST((reference - test).cwiseAbs().maxCoeff() < delta * scale);
+    };
+
+    std::mt19937 generator{1234};
+    std::uniform_real_distribution<double> uniform{-1., 1.};
+    auto random_matrix = [&](const size_t n_rows, const size_t n_cols) {
+      math::Matrix_t matrix{n_rows, n_cols};
+      for (int i_row{0}; i_row < matrix.rows(); ++i_row) {
+        for (int i_col{0}; i_col < matrix.cols(); ++i_col) {
+          matrix(i_row, i_col) = uniform(generator);
+        }
+      }
+      return matrix;
+    };
+
+    for (size_t i_manager{0}; i_manager < managers.size(); ++i_manager) {
+      for (auto rep_hypers : representation_hypers[i_manager]) {
+        auto soap_type{rep_hypers.at("soap_type").template get<std::string>()};
+        if (soap_type != "PowerSpectrum") {
+          continue;
+        }
+        auto & manager = managers[i_manager];
+        auto & manager_half = managers_half[i_manager];
+        Representation_t representation{rep_hypers};
+        representation.compute(manager);
+        rep_hypers["compute_gradients"] = false;
+        Representation_t representation_no_gradients{rep_hypers};
+        rep_hypers["n_threads"] = 3;
+        Representation_t representation_threads{rep_hypers};
+
+        auto && rep_vectors{
+            *manager->template get_property<Prop_t>(representation.get_name())};
+        const math::Matrix_t features{rep_vectors.get_features()};
+        const math::Matrix_t upstream{
+            random_matrix(features.rows(), features.cols())};
+        const math::Matrix_t displacements{
+            random_matrix(manager->size(), ThreeD)};
+        math::Matrix_t gradients{}, virial{}, change{};
+        contract_stored_gradients(representation, manager, upstream,
+                                  displacements, gradients, virial, change);
+
+        auto && backward{
+            representation_no_gradients.backward(manager, upstream)};
+        check(gradients, std::get<0>(backward));
+        check(virial, std::get<1>(backward));
+        check(change, representation_no_gradients.jvp(manager, displacements));
+        BOOST_CHECK_THROW(
+            representation_no_gradients.backward(manager, upstream.leftCols(1)),
+            std::runtime_error);
+
+        auto && backward_half{
+            representation_threads.backward(manager_half, upstream)};
+        check(gradients, std::get<0>(backward_half));
+        check(virial, std::get<1>(backward_half));
+        check(change,
+              representation_threads.jvp(manager_half, displacements));
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that the incremental update of the spherical expansion (and of the
+   * power spectrum built on top of it) gives the same features and
+   * gradients as a full recomputation when only a few atoms are displaced
+   * between two calls.
+   */
+  BOOST_AUTO_TEST_CASE(incremental_update_test) {
+    const bool verbose{false};
+    // relative error threshold
+    const double delta{1e-10};
+    // range of zero, removing and adding back the contribution of a neighbour
+    // leaves round-off errors on the coefficients that nearly cancel
+    const double epsilon{1e-6};
+    // the round-off errors of the coefficients give absolute errors of a few
+    // 1e-15 on the gradients of the power spectrum (at most about 0.2), i.e.
+    // a relative error above delta for the values below 1e-4
+    const double epsilon_gradients{1e-4};
+
+    json structure{
+        {"filename", "reference_data/inputs/SiC_moissanite_supercell.json"}};
+    json adaptors{{{"name", "AdaptorNeighbourList"},
+                   {"initialization_arguments", {{"cutoff", 3.0}}}},
+                  {{"name", "AdaptorCenterContribution"},
+                   {"initialization_arguments", {}}},
+                  {{"name", "AdaptorStrict"},
+                   {"initialization_arguments", {{"cutoff", 3.0}}}}};
+
+    json hypers{{"max_radial", 4},
+                {"max_angular", 3},
+                {"soap_type", "PowerSpectrum"},
+                {"normalize", true},
+                {"compute_gradients", false},
+                {"cutoff_function",
+                 {{"type", "ShiftedCosine"},
+                  {"cutoff", {{"value", 3.0}, {"unit", "AA"}}},
+                  {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}}},
+                {"gaussian_density",
+                 {{"type", "Constant"},
+                  {"gaussian_sigma", {{"value", 0.3}, {"unit", "AA"}}}}},
+                {"radial_contribution", {{"type", "GTO"}}}};
+    std::vector<std::string> expansion_by_species_methods{
+        "environment wise", "structure wise"};
+    for (const auto & method : expansion_by_species_methods) {
+      for (const bool compute_gradients : {false, true}) {
+        hypers["expansion_by_species_method"] = method;
+        hypers["compute_gradients"] = compute_gradients;
+        json hypers_incremental = hypers;
+        hypers_incremental["incremental_update"] = {
+            {"displacement_threshold", 1e-8},
+            {"max_moved_fraction", 0.25},
+            {"full_refresh_period", 10}};
+
+        auto manager_inc = make_structure_manager_stack<
+            StructureManagerCenters, AdaptorNeighbourList,
+            AdaptorCenterContribution, AdaptorStrict>(structure, adaptors);
+        auto manager_ref = make_structure_manager_stack<
+            StructureManagerCenters, AdaptorNeighbourList,
+            AdaptorCenterContribution, AdaptorStrict>(structure, adaptors);
+        using Manager_t = typename decltype(manager_inc)::element_type;
+        using PropExp_t = CalculatorSphericalExpansion::Property_t<Manager_t>;
+        using PropGradExp_t =
+            CalculatorSphericalExpansion::PropertyGradient_t<Manager_t>;
+        using PropInv_t = CalculatorSphericalInvariants::Property_t<Manager_t>;
+        using PropGradInv_t =
+            CalculatorSphericalInvariants::PropertyGradient_t<Manager_t>;
+
+        CalculatorSphericalExpansion expansion_inc{hypers_incremental};
+        CalculatorSphericalExpansion expansion_ref{hypers};
+        CalculatorSphericalInvariants invariants_inc{hypers_incremental};
+        CalculatorSphericalInvariants invariants_ref{hypers};
+        BOOST_CHECK(expansion_inc.does_incremental_update());
+        BOOST_CHECK(not expansion_ref.does_incremental_update());
+
+        auto atomic_structure{
+            extract_underlying_manager<0>(manager_inc)->get_atomic_structure()};
+        const size_t n_atoms{atomic_structure.get_number_of_atoms()};
+        std::mt19937 generator{1234};
+        std::uniform_real_distribution<double> uniform{-0.05, 0.05};
+
+        // n_moved == 0 is the first full computation, the last step moves more
+        // atoms than max_moved_fraction allows and falls back to the full path
+        std::vector<size_t> n_moved_per_step{0, 1, 2, 0, 3, n_atoms / 2};
+        for (auto & n_moved : n_moved_per_step) {
+          for (size_t i_moved{0}; i_moved < n_moved; ++i_moved) {
+            Eigen::Vector3d displacement{};
+            for (int i_dim{0}; i_dim < 3; ++i_dim) {
+              displacement(i_dim) = uniform(generator);
+            }
+            atomic_structure.displace_position(
+                (7 * i_moved + n_moved) % n_atoms, displacement);
+          }
+          atomic_structure.wrap();
+          manager_inc->update(atomic_structure);
+          manager_ref->update(atomic_structure);
+
+          expansion_inc.compute(manager_inc);
+          expansion_ref.compute(manager_ref);
+          invariants_inc.compute(manager_inc);
+          invariants_ref.compute(manager_ref);
+
+          auto state = expansion_inc.get_incremental_state(manager_inc);
+          BOOST_REQUIRE(state != nullptr);
+          if (verbose) {
+            std::cout << "n_moved: " << n_moved << " incremental: "
+                      << state->last_update_incremental << std::endl;
+          }
+          if (n_moved > 0 and n_moved < n_atoms / 4) {
+            BOOST_CHECK(state->last_update_incremental);
+          } else if (n_moved >= n_atoms / 4) {
+            BOOST_CHECK(not state->last_update_incremental);
+          }
+
+          auto && exp_inc{*manager_inc->template get_property<PropExp_t>(
+              expansion_inc.get_name())};
+          auto && exp_ref{*manager_ref->template get_property<PropExp_t>(
+              expansion_ref.get_name())};
+          math::Matrix_t features_inc{exp_inc.get_features()};
+          math::Matrix_t features_ref{exp_ref.get_features()};
+          auto diff = math::relative_error(features_inc, features_ref, delta,
+                                           epsilon);
+          BOOST_CHECK_LE(diff.maxCoeff(), delta);
+
+          auto && inv_inc{*manager_inc->template get_property<PropInv_t>(
+              invariants_inc.get_name())};
+          auto && inv_ref{*manager_ref->template get_property<PropInv_t>(
+              invariants_ref.get_name())};
+          math::Matrix_t soap_inc{inv_inc.get_features()};
+          math::Matrix_t soap_ref{inv_ref.get_features()};
+          diff = math::relative_error(soap_inc, soap_ref, delta, epsilon);
+          BOOST_CHECK_LE(diff.maxCoeff(), delta);
+
+          if (compute_gradients) {
+            // the managers are updated in the same way so their pairs match
+            auto && exp_grad_inc{
+                *manager_inc->template get_property<PropGradExp_t>(
+                    expansion_inc.get_gradient_name())};
+            auto && exp_grad_ref{
+                *manager_ref->template get_property<PropGradExp_t>(
+                    expansion_ref.get_gradient_name())};
+            math::Matrix_t gradients_inc{exp_grad_inc.get_features_gradient()};
+            math::Matrix_t gradients_ref{exp_grad_ref.get_features_gradient()};
+            BOOST_REQUIRE_EQUAL(gradients_inc.rows(), gradients_ref.rows());
+            diff = math::relative_error(gradients_inc, gradients_ref, delta,
+                                        epsilon);
+            BOOST_CHECK_LE(diff.maxCoeff(), delta);
+
+            auto && inv_grad_inc{
+                *manager_inc->template get_property<PropGradInv_t>(
+                    invariants_inc.get_gradient_name())};
+            auto && inv_grad_ref{
+                *manager_ref->template get_property<PropGradInv_t>(
+                    invariants_ref.get_gradient_name())};
+            gradients_inc = inv_grad_inc.get_features_gradient();
+            gradients_ref = inv_grad_ref.get_features_gradient();
+            diff = math::relative_error(gradients_inc, gradients_ref, delta,
+                                        epsilon_gradients);
+            BOOST_CHECK_LE(diff.maxCoeff(), delta);
+          }
+        }
+      }
+    }
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace rascal
@@ -38,6 +38,8 @@
 #include "rascal/representations/calculator_spherical_covariants.hh"
 #include "rascal/representations/calculator_spherical_expansion.hh"
 #include "rascal/representations/calculator_spherical_invariants.hh"
+#include "rascal/representations/calculator_three_body.hh"
+#include "rascal/representations/compute_by_batch.hh"
 #include "rascal/structure_managers/atomic_structure.hh"
 #include "rascal/structure_managers/cluster_ref_key.hh"
 #include "rascal/structure_managers/structure_manager_collection.hh"
@@ -1125,6 +1127,69 @@ namespace rascal {
     Provider_t & provider;
   };
 
+  template <class MultipleStructureFixture>
+  struct MultipleStructureThreeBody : MultipleStructureFixture {
+    using Parent = MultipleStructureFixture;
+    using ManagerTypeHolder_t = typename Parent::ManagerTypeHolder_t;
+    using Representation_t = CalculatorThreeBody;
+
+    MultipleStructureThreeBody() : Parent{} {
+      for (auto & fc_hyp : this->fc_hypers) {
+        for (auto & rep_hyp : this->rep_hypers) {
+          rep_hyp["cutoff_function"] = fc_hyp;
+          this->representation_hypers.push_back(rep_hyp);
+        }
+      }
+    };
+
+    ~MultipleStructureThreeBody() = default;
+
+    std::vector<json> representation_hypers{};
+
+    std::vector<json> fc_hypers{
+        {{"type", "ShiftedCosine"},
+         {"cutoff", {{"value", 3.0}, {"unit", "AA"}}},
+         {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}}};
+
+    std::vector<json> rep_hypers{
+        {{"max_radial", 3}, {"max_angular", 4}, {"normalize", true}},
+        {{"max_radial", 2}, {"max_angular", 0}, {"normalize", true}}};
+  };
+
+  template <typename DataFixture>
+  struct SingleHypersThreeBody : DataFixture {
+    using Parent = DataFixture;
+    using ManagerTypeHolder_t = typename Parent::ManagerTypeHolder_t;
+    using Representation_t = CalculatorThreeBody;
+
+    SingleHypersThreeBody() : Parent{} {
+      for (auto & fc_hyp : this->fc_hypers) {
+        for (auto & rep_hyp : this->rep_hypers) {
+          rep_hyp["cutoff_function"] = fc_hyp;
+          this->representation_hypers.push_back(rep_hyp);
+        }
+      }
+    };
+
+    ~SingleHypersThreeBody() = default;
+
+    std::vector<json> representation_hypers{};
+
+    std::vector<json> fc_hypers{
+        {{"type", "ShiftedCosine"},
+         {"cutoff", {{"value", 2.5}, {"unit", "AA"}}},
+         {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}}};
+
+    std::vector<json> rep_hypers{{{"max_radial", 3},
+                                  {"max_angular", 3},
+                                  {"normalize", true},
+                                  {"compute_gradients", true}},
+                                 {{"max_radial", 2},
+                                  {"max_angular", 2},
+                                  {"normalize", true},
+                                  {"compute_gradients", true}}};
+  };
+
   template <class MultipleStructureFixture>
   struct MultipleStructureSortedCoulomb : MultipleStructureFixture {
     using Parent = MultipleStructureFixture;
@@ -0,0 +1,353 @@
+/**
+ * @file   test_calculator_long_range.cc
+ *
+ * @date   18 October 2026
+ *
+ * @brief  test the long-range (LODE) spherical expansion
+ *
+ * @section LICENSE
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "rascal/math/gauss_legendre.hh"
+#include "rascal/representations/calculator_spherical_expansion.hh"
+#include "rascal/representations/calculator_spherical_invariants.hh"
+#include "rascal/structure_managers/adaptor_center_contribution.hh"
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <complex>
+#include <set>
+
+namespace rascal {
+
+  BOOST_AUTO_TEST_SUITE(long_range_expansion_test);
+
+  struct LongRangeExpansionFixture {
+    using Structure_t = AtomicStructure<ThreeD>;
+    using Calculator_t = CalculatorSphericalExpansion;
+    using Key_t = Calculator_t::Key_t;
+
+    LongRangeExpansionFixture() {
+      for (auto && filename : this->filenames) {
+        this->structures.emplace_back();
+        this->structures.back().set_structure(filename);
+      }
+    }
+
+    ~LongRangeExpansionFixture() = default;
+
+    auto make_manager(const Structure_t & structure) const {
+      json structure_input = structure;
+      json adaptors{{{"name", "AdaptorNeighbourList"},
+                     {"initialization_arguments",
+                      {{"cutoff", this->cutoff}, {"skin", 0.}}}},
+                    {{"name", "AdaptorCenterContribution"},
+                     {"initialization_arguments", {}}},
+                    {{"name", "AdaptorStrict"},
+                     {"initialization_arguments", {{"cutoff", this->cutoff}}}}};
+      return make_structure_manager_stack<
+          StructureManagerCenters, AdaptorNeighbourList,
+          AdaptorCenterContribution, AdaptorStrict>(structure_input, adaptors);
+    }
+
+    json make_hypers(const std::string & method) const {
+      json hypers{
+          {"max_radial", 4},
+          {"max_angular", 3},
+          {"cutoff_function",
+           {{"type", "ShiftedCosine"},
+            {"cutoff", {{"value", this->cutoff}, {"unit", "AA"}}},
+            {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}}},
+          {"gaussian_density",
+           {{"type", "Constant"},
+            {"gaussian_sigma", {{"value", 1.}, {"unit", "AA"}}}}},
+          {"radial_contribution", {{"type", "GTO"}}},
+          {"long_range", {{"method", method}, {"accuracy", 1e-8}}}};
+      return hypers;
+    }
+
+    //! coefficients of all the centers and species [N_centers, ...]
+    template <class Manager>
+    math::Matrix_t get_coefficients(Calculator_t & calculator,
+                                    Manager & manager) const {
+      using Property_t = Calculator_t::Property_t<
+          typename Manager::element_type>;
+      calculator.compute(manager);
+      auto && expansions{*manager->template get_property<Property_t>(
+          calculator.get_name(), true)};
+      return expansions.get_features();
+    }
+
+    const std::vector<std::string> filenames{
+        "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json",
+        "reference_data/inputs/diamond_cubic_distorted.json",
+        "reference_data/inputs/SiCGe_wurtzite_like.json"};
+    const double cutoff{3.};
+
+    std::vector<Structure_t> structures{};
+  };
+
+  /**
+   * Test the Ewald sum against the projection of the potential on the
+   * basis computed with a quadrature in real space.
+   */
+  BOOST_FIXTURE_TEST_CASE(real_space_test, LongRangeExpansionFixture) {
+    using math::PI;
+    using Complex_t = std::complex<double>;
+    json hypers = this->make_hypers("Ewald");
+    Calculator_t calculator{hypers};
+    internal::RadialContribution<internal::RadialBasisType::GTO> radial_basis{
+        hypers};
+    const size_t max_radial{hypers["max_radial"]};
+    const size_t max_angular{hypers["max_angular"]};
+    const size_t n_lm{(max_angular + 1) * (max_angular + 1)};
+    const double sigma{1.};
+    const double k_cutoff{std::sqrt(-2. * std::log(1e-8)) / sigma};
+
+    // quadrature on the support of the radial basis
+    double x_max{0.};
+    for (size_t radial_n{0}; radial_n < max_radial; ++radial_n) {
+      x_max = std::max(x_max, radial_basis.radial_sigmas(radial_n) *
+                                  (std::sqrt(radial_n + 2.) + 10.));
+    }
+    const auto radial_points{
+        math::compute_gauss_legendre_points_weights(0., x_max, 80)};
+    const auto polar_points{
+        math::compute_gauss_legendre_points_weights(-1., 1., 30)};
+    const int n_azimuthal{60};
+    math::Matrix_t basis(radial_points.rows(), max_radial);
+    for (int i_x{0}; i_x < radial_points.rows(); ++i_x) {
+      const double x{radial_points(i_x, 0)};
+      for (size_t radial_n{0}; radial_n < max_radial; ++radial_n) {
+        const double sigma_n{radial_basis.radial_sigmas(radial_n)};
+        basis(i_x, radial_n) =
+            std::sqrt(2. / (std::tgamma(1.5 + radial_n) *
+                            std::pow(sigma_n, 3 + 2 * radial_n))) *
+            std::pow(x, radial_n) * std::exp(-0.5 * x * x / (sigma_n * sigma_n));
+      }
+    }
+    basis = basis * radial_basis.radial_ortho_matrix.transpose();
+    math::SphericalHarmonics harmonics{};
+    harmonics.precompute(max_angular);
+
+    // the small cells have few wave vectors
+    for (size_t i_structure{1}; i_structure < this->structures.size();
+         ++i_structure) {
+      auto & structure = this->structures[i_structure];
+      auto manager = this->make_manager(structure);
+      using Property_t =
+          Calculator_t::Property_t<typename decltype(manager)::element_type>;
+      calculator.compute(manager);
+      auto && expansions{*manager->template get_property<Property_t>(
+          calculator.get_name(), true)};
+
+      const Eigen::Matrix3d cell{structure.cell};
+      const double volume{std::abs(cell.determinant())};
+      const Eigen::Matrix3d reciprocal{2. * PI * cell.inverse().transpose()};
+      std::set<int> species(structure.atom_types.data(),
+                            structure.atom_types.data() +
+                                structure.atom_types.size());
+      // V_a(r) = sum_k amplitudes_a(k) e^{ikr}
+      std::vector<Eigen::Vector3d> wave_vectors{};
+      std::map<int, std::vector<Complex_t>> amplitudes{};
+      const int max_mode{10};
+      for (int m_0{-max_mode}; m_0 <= max_mode; ++m_0) {
+        for (int m_1{-max_mode}; m_1 <= max_mode; ++m_1) {
+          for (int m_2{-max_mode}; m_2 <= max_mode; ++m_2) {
+            Eigen::Vector3d k_vec{reciprocal * Eigen::Vector3d(m_0, m_1, m_2)};
+            const double k2{k_vec.squaredNorm()};
+            if (k2 == 0. or k2 >= k_cutoff * k_cutoff) {
+              continue;
+            }
+            wave_vectors.push_back(k_vec);
+            for (const int & sp : species) {
+              Complex_t structure_factor{0., 0.};
+              for (int i_atom{0}; i_atom < structure.atom_types.size();
+                   ++i_atom) {
+                if (structure.atom_types(i_atom) == sp) {
+                  structure_factor += std::polar(
+                      1., -k_vec.dot(structure.positions.col(i_atom)));
+                }
+              }
+              amplitudes[sp].push_back(4. * PI / volume *
+                                       std::exp(-0.5 * sigma * sigma * k2) /
+                                       k2 * structure_factor);
+            }
+          }
+        }
+      }
+      // the largest wave vector fits in the box of modes
+      BOOST_REQUIRE(max_mode * 2. * PI / cell.colwise().norm().maxCoeff() >
+                    k_cutoff);
+
+      // check the first center of each structure
+      std::vector<Complex_t> phases(wave_vectors.size());
+      for (auto center : manager) {
+        const Eigen::Vector3d r_i{center.get_position()};
+        std::map<int, math::Matrix_t> reference{};
+        for (const int & sp : species) {
+          reference[sp] = math::Matrix_t::Zero(max_radial, n_lm);
+        }
+        for (int i_x{0}; i_x < radial_points.rows(); ++i_x) {
+          const double x{radial_points(i_x, 0)};
+          for (int i_polar{0}; i_polar < polar_points.rows(); ++i_polar) {
+            const double cos_theta{polar_points(i_polar, 0)};
+            const double sin_theta{std::sqrt(1. - cos_theta * cos_theta)};
+            for (int i_azimuthal{0}; i_azimuthal < n_azimuthal; ++i_azimuthal) {
+              const double phi{2. * PI * i_azimuthal / n_azimuthal};
+              const Eigen::Vector3d direction{sin_theta * std::cos(phi),
+                                              sin_theta * std::sin(phi),
+                                              cos_theta};
+              const double weight{radial_points(i_x, 1) * x * x *
+                                  polar_points(i_polar, 1) * 2. * PI /
+                                  n_azimuthal};
+              harmonics.calc(direction);
+              const Eigen::Vector3d r{r_i + x * direction};
+              for (size_t i_k{0}; i_k < wave_vectors.size(); ++i_k) {
+                phases[i_k] = std::polar(1., wave_vectors[i_k].dot(r));
+              }
+              for (const int & sp : species) {
+                double potential{0.};
+                for (size_t i_k{0}; i_k < wave_vectors.size(); ++i_k) {
+                  potential += (amplitudes[sp][i_k] * phases[i_k]).real();
+                }
+                reference[sp] += weight * potential *
+                                 basis.row(i_x).transpose() *
+                                 harmonics.get_harmonics();
+              }
+            }
+          }
+        }
+        auto coefficients_center = expansions[center];
+        for (const int & sp : species) {
+          Key_t key{sp};
+          math::Matrix_t coefficients = coefficients_center[key];
+          const double scale{reference[sp].lpNorm<Eigen::Infinity>()};
+          BOOST_TEST((coefficients - reference[sp]).lpNorm<Eigen::Infinity>() <=
+                     1e-6 * scale);
+        }
+        break;
+      }
+    }
+  }
+
+  /**
+   * Test the particle mesh evaluation against the Ewald sum.
+   */
+  BOOST_FIXTURE_TEST_CASE(pme_test, LongRangeExpansionFixture) {
+    Calculator_t calculator_ewald{this->make_hypers("Ewald")};
+    Calculator_t calculator_pme{this->make_hypers("PME")};
+    for (auto & structure : this->structures) {
+      auto manager = this->make_manager(structure);
+      math::Matrix_t ewald{this->get_coefficients(calculator_ewald, manager)};
+      math::Matrix_t pme{this->get_coefficients(calculator_pme, manager)};
+      BOOST_REQUIRE_EQUAL(ewald.rows(), pme.rows());
+      BOOST_REQUIRE_EQUAL(ewald.cols(), pme.cols());
+      const double scale{ewald.lpNorm<Eigen::Infinity>()};
+      BOOST_TEST(scale > 0.);
+      BOOST_TEST((ewald - pme).lpNorm<Eigen::Infinity>() <= 1e-4 * scale);
+    }
+  }
+
+  /**
+   * Test that the coefficients do not change when the structure is
+   * translated and that the power spectrum does not change when it is
+   * rotated.
+   */
+  BOOST_FIXTURE_TEST_CASE(invariance_test, LongRangeExpansionFixture) {
+    using Invariants_t = CalculatorSphericalInvariants;
+    Calculator_t calculator{this->make_hypers("Ewald")};
+    json hypers_invariants = this->make_hypers("Ewald");
+    hypers_invariants["soap_type"] = "PowerSpectrum";
+    hypers_invariants["normalize"] = false;
+    Invariants_t invariants{hypers_invariants};
+    // rotation around (1, 2, 3)
+    const Eigen::Matrix3d rotation{
+        Eigen::AngleAxisd(0.7, Eigen::Vector3d(1., 2., 3.).normalized())
+            .toRotationMatrix()};
+    for (auto & structure : this->structures) {
+      auto manager = this->make_manager(structure);
+      math::Matrix_t reference{this->get_coefficients(calculator, manager)};
+
+      Structure_t translated{structure};
+      translated.positions.colwise() += Eigen::Vector3d(0.3, -1.1, 2.5);
+      translated.wrap();
+      auto manager_translated = this->make_manager(translated);
+      math::Matrix_t coefficients{
+          this->get_coefficients(calculator, manager_translated)};
+      const double scale{reference.lpNorm<Eigen::Infinity>()};
+      BOOST_TEST((coefficients - reference).lpNorm<Eigen::Infinity>() <=
+                 1e-10 * scale);
+
+      using PropertyInvariants_t =
+          Invariants_t::Property_t<typename decltype(manager)::element_type>;
+      invariants.compute(manager);
+      math::Matrix_t power_spectrum{
+          manager
+              ->template get_property<PropertyInvariants_t>(
+                  invariants.get_name(), true)
+              ->get_features()};
+      Structure_t rotated{structure};
+      rotated.positions = rotation * structure.positions;
+      rotated.cell = rotation * structure.cell;
+      auto manager_rotated = this->make_manager(rotated);
+      invariants.compute(manager_rotated);
+      math::Matrix_t power_spectrum_rotated{
+          manager_rotated
+              ->template get_property<PropertyInvariants_t>(
+                  invariants.get_name(), true)
+              ->get_features()};
+      const double scale_power{power_spectrum.lpNorm<Eigen::Infinity>()};
+      BOOST_TEST(scale_power > 0.);
+      BOOST_TEST(
+          (power_spectrum - power_spectrum_rotated).lpNorm<Eigen::Infinity>() <=
+          1e-9 * scale_power);
+    }
+  }
+
+  /**
+   * Test that the unsupported options and structures are reported.
+   */
+  BOOST_FIXTURE_TEST_CASE(error_test, LongRangeExpansionFixture) {
+    json hypers = this->make_hypers("PME");
+    hypers["compute_gradients"] = true;
+    BOOST_CHECK_THROW(Calculator_t{hypers}, std::logic_error);
+
+    hypers = this->make_hypers("PME");
+    hypers["radial_contribution"]["type"] = "DVR";
+    BOOST_CHECK_THROW(Calculator_t{hypers}, std::logic_error);
+
+    hypers = this->make_hypers("FFT");
+    BOOST_CHECK_THROW(Calculator_t{hypers}, std::logic_error);
+
+    Calculator_t calculator{this->make_hypers("PME")};
+    Structure_t structure{this->structures.front()};
+    structure.pbc.setZero();
+    auto manager = this->make_manager(structure);
+    BOOST_CHECK_THROW(calculator.compute(manager), std::runtime_error);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace rascal
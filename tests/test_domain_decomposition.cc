@@ -0,0 +1,187 @@
+/**
+ * @file   test_domain_decomposition.cc
+ *
+ * @date   18 October 2026
+ *
+ * @brief  test the spatial decomposition of structures into domains
+ *
+ * @section LICENSE
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "rascal/representations/calculator_spherical_invariants.hh"
+#include "rascal/structure_managers/domain_decomposition.hh"
+
+#include <boost/test/unit_test.hpp>
+
+namespace rascal {
+
+  BOOST_AUTO_TEST_SUITE(domain_decomposition_test);
+
+  struct DomainDecompositionFixture {
+    DomainDecompositionFixture() {
+      for (auto && filename : this->filenames) {
+        this->structures.emplace_back();
+        this->structures.back().set_structure(filename);
+      }
+      // some atoms that are not centers
+      auto & structure = this->structures.back();
+      for (size_t i_atom{0}; i_atom < structure.get_number_of_atoms();
+           i_atom += 3) {
+        structure.center_atoms_mask(i_atom) = false;
+      }
+    }
+
+    ~DomainDecompositionFixture() = default;
+
+    using Structure_t = DomainDecomposition::Structure_t;
+
+    //! builds the manager stack used for the domains on the whole structure
+    DomainDecomposition::ManagerPtr_t
+    make_manager(const Structure_t & structure, const double cutoff) {
+      json structure_input = structure;
+      json adaptors{{{"name", "AdaptorNeighbourList"},
+                     {"initialization_arguments",
+                      {{"cutoff", cutoff}, {"skin", 0.}}}},
+                    {{"name", "AdaptorCenterContribution"},
+                     {"initialization_arguments", {}}},
+                    {{"name", "AdaptorStrict"},
+                     {"initialization_arguments", {{"cutoff", cutoff}}}}};
+      return make_structure_manager_stack<
+          StructureManagerCenters, AdaptorNeighbourList,
+          AdaptorCenterContribution, AdaptorStrict>(structure_input, adaptors);
+    }
+
+    const std::vector<std::string> filenames{
+        "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json",
+        "reference_data/inputs/small_molecule.json",
+        "reference_data/inputs/diamond_cubic_distorted.json"};
+    const std::vector<double> cutoffs{{2., 3.5, 5.}};
+    const std::vector<std::array<int, 3>> n_domains{
+        {{2, 1, 1}}, {{2, 2, 2}}, {{1, 3, 2}}};
+
+    std::vector<Structure_t> structures{};
+  };
+
+  /**
+   * Test that every center belongs to exactly one domain, that the halo
+   * atoms are masked and that the centers have the same neighbours in their
+   * domain as in the whole structure.
+   */
+  BOOST_FIXTURE_TEST_CASE(partition_test, DomainDecompositionFixture) {
+    for (auto & structure : structures) {
+      for (auto & cutoff : cutoffs) {
+        auto manager = this->make_manager(structure, cutoff);
+        // number of neighbours of each center of the whole structure
+        std::vector<size_t> n_neighbours{};
+        for (auto center : manager) {
+          n_neighbours.push_back(center.pairs().size());
+        }
+        for (auto & n_domain : n_domains) {
+          DomainDecomposition domains{structure, cutoff, n_domain};
+          const auto & center_rows = domains.get_center_rows();
+
+          std::vector<int> n_owners(structure.get_number_of_atoms(), 0);
+          for (size_t i_domain{0}; i_domain < domains.size(); ++i_domain) {
+            const auto & domain = domains[i_domain];
+            const auto & mask = domain.structure.center_atoms_mask;
+            BOOST_CHECK_EQUAL(mask.count(), domain.n_centers);
+            BOOST_CHECK_EQUAL(domain.atom_indices.size(),
+                              domain.structure.get_number_of_atoms());
+            for (size_t i_center{0}; i_center < domain.n_centers;
+                 ++i_center) {
+              BOOST_CHECK(mask(i_center));
+              n_owners[domain.atom_indices[i_center]]++;
+            }
+          }
+          for (size_t i_atom{0}; i_atom < n_owners.size(); ++i_atom) {
+            BOOST_CHECK_EQUAL(n_owners[i_atom],
+                              center_rows[i_atom] >= 0 ? 1 : 0);
+          }
+
+          domains.for_each_domain(
+              [&](DomainDecomposition::ManagerPtr_t & domain_manager,
+                  const size_t i_domain, const size_t /*i_thread*/) {
+                const auto & domain = domains[i_domain];
+                BOOST_CHECK_EQUAL(domain_manager->size(), domain.n_centers);
+                size_t i_center{0};
+                for (auto center : domain_manager) {
+                  const int i_row{
+                      center_rows[domain.atom_indices[i_center]]};
+                  BOOST_CHECK_EQUAL(center.pairs().size(),
+                                    n_neighbours[i_row]);
+                  i_center++;
+                }
+              },
+              1);
+        }
+      }
+    }
+  }
+
+  /**
+   * Test that the features computed domain by domain, possibly with several
+   * threads, match the features of the whole structure.
+   */
+  BOOST_FIXTURE_TEST_CASE(features_test, DomainDecompositionFixture) {
+    using Manager_t = DomainDecomposition::Manager_t;
+    using Property_t = CalculatorSphericalInvariants::Property_t<Manager_t>;
+    const std::vector<size_t> n_threads{{1, 3}};
+    for (auto & structure : structures) {
+      for (auto & cutoff : cutoffs) {
+        json hypers{{"max_radial", 3},
+                    {"max_angular", 2},
+                    {"soap_type", "PowerSpectrum"},
+                    {"normalize", true},
+                    {"compute_gradients", false}};
+        hypers["cutoff_function"] = {
+            {"type", "ShiftedCosine"},
+            {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+            {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
+        hypers["gaussian_density"] = {
+            {"type", "Constant"},
+            {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
+        hypers["radial_contribution"] = {{"type", "GTO"}};
+
+        auto manager = this->make_manager(structure, cutoff);
+        CalculatorSphericalInvariants representation{hypers};
+        representation.compute(manager);
+        auto && prop{*manager->get_property<Property_t>(
+            representation.get_name(), true)};
+        math::Matrix_t features_ref = prop.get_features();
+
+        for (auto & n_domain : n_domains) {
+          DomainDecomposition domains{structure, cutoff, n_domain};
+          for (auto & n_thread : n_threads) {
+            math::Matrix_t features =
+                domains.compute_features<CalculatorSphericalInvariants>(
+                    hypers, n_thread);
+            BOOST_REQUIRE_EQUAL(features.rows(), features_ref.rows());
+            BOOST_REQUIRE_EQUAL(features.cols(), features_ref.cols());
+            double diff{(features - features_ref).lpNorm<Eigen::Infinity>()};
+            BOOST_CHECK_LE(diff, 1e-12);
+          }
+        }
+      }
+    }
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace rascal
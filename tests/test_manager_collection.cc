@@ -32,6 +32,8 @@
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <random>
+
 namespace rascal {
 
   BOOST_AUTO_TEST_SUITE(manager_collection_test);
@@ -90,5 +92,223 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that adding the structures from flat arrays, in parallel, builds
+   * the same managers as adding them one by one, that the positions are
+   * wrapped and that non periodic structures without cell get a bounding box
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(add_structures_from_arrays_test, Fix,
+                                   fixtures_test, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Positions_t = Eigen::Matrix<double, 3, Eigen::Dynamic>;
+    using PBCs_t = Eigen::Matrix<int, 3, Eigen::Dynamic>;
+    using Mask_t = Eigen::Array<bool, Eigen::Dynamic, 1>;
+    auto & collections = Fix::collections;
+
+    std::vector<AtomicStructure<3>> atomic_structures{};
+    json molecules = json_io::load(Fix::filename);
+    for (int idx{1}; idx < 6; ++idx) {
+      atomic_structures.emplace_back(
+          molecules[std::to_string(idx)].template get<AtomicStructure<3>>());
+    }
+    atomic_structures.emplace_back();
+    atomic_structures.back().set_structure(std::string(
+        "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json"));
+    // an atom outside of the cell
+    auto & crystal = atomic_structures.back();
+    crystal.displace_position(0,
+                              2. * crystal.cell.col(0) - crystal.cell.col(2));
+    // a non periodic structure without cell
+    atomic_structures.emplace_back(atomic_structures[0]);
+    atomic_structures.back().cell.setZero();
+    atomic_structures.back().pbc.setZero();
+
+    const size_t n_structures{atomic_structures.size()};
+    Eigen::VectorXi offsets(n_structures + 1);
+    offsets(0) = 0;
+    for (size_t i_structure{0}; i_structure < n_structures; ++i_structure) {
+      offsets(i_structure + 1) =
+          offsets(i_structure) +
+          atomic_structures[i_structure].get_number_of_atoms();
+    }
+    const int n_atoms{offsets(n_structures)};
+    Positions_t positions(3, n_atoms);
+    Eigen::VectorXi atom_types(n_atoms);
+    Mask_t center_atoms_mask(n_atoms);
+    Positions_t cells(3, 3 * n_structures);
+    PBCs_t pbcs(3, n_structures);
+    for (size_t i_structure{0}; i_structure < n_structures; ++i_structure) {
+      const auto & structure = atomic_structures[i_structure];
+      const int start{offsets(i_structure)};
+      const int n_structure_atoms{offsets(i_structure + 1) - start};
+      positions.middleCols(start, n_structure_atoms) = structure.positions;
+      atom_types.segment(start, n_structure_atoms) = structure.atom_types;
+      center_atoms_mask.segment(start, n_structure_atoms) =
+          structure.center_atoms_mask;
+      cells.middleCols<3>(3 * i_structure) = structure.cell;
+      pbcs.col(i_structure) = structure.pbc;
+    }
+
+    // what the bulk construction should do to the structures
+    atomic_structures[n_structures - 2].wrap();
+    atomic_structures[n_structures - 1].set_bounding_box_cell();
+
+    for (auto & collection : collections) {
+      ManagerCollection_t bulk_collection{collection.get_adaptors_parameters()};
+      bulk_collection.add_structures(positions, atom_types, cells, pbcs,
+                                     center_atoms_mask, offsets, true, 3);
+      collection.add_structures(atomic_structures);
+      BOOST_CHECK_EQUAL(bulk_collection.size(), n_structures);
+
+      for (size_t i_structure{0}; i_structure < n_structures; ++i_structure) {
+        auto manager = collection[i_structure];
+        auto bulk_manager = bulk_collection[i_structure];
+        BOOST_CHECK_EQUAL(bulk_manager->size(), manager->size());
+        BOOST_CHECK_EQUAL(bulk_manager->get_nb_clusters(2),
+                          manager->get_nb_clusters(2));
+        std::vector<Eigen::Vector3d> ref_positions{};
+        for (auto center : manager) {
+          ref_positions.emplace_back(center.get_position());
+        }
+        size_t i_center{0};
+        for (auto center : bulk_manager) {
+          BOOST_CHECK_LE(
+              (center.get_position() - ref_positions[i_center]).norm(), 1e-10);
+          ++i_center;
+        }
+      }
+
+      // the atoms are in the bounding box
+      const auto & molecule = atomic_structures.back();
+      auto scaled_positions = molecule.cell.inverse() * molecule.positions;
+      BOOST_CHECK(scaled_positions.minCoeff() > 0.);
+      BOOST_CHECK(scaled_positions.maxCoeff() < 1.);
+
+      // inconsistent inputs throw and leave the collection unchanged
+      Eigen::VectorXi wrong_offsets{offsets};
+      wrong_offsets(1) = wrong_offsets(2) + 1;
+      BOOST_CHECK_THROW(
+          bulk_collection.add_structures(positions, atom_types, cells, pbcs,
+                                         center_atoms_mask, wrong_offsets),
+          std::runtime_error);
+      BOOST_CHECK_THROW(bulk_collection.add_structures(
+                            positions, atom_types, cells.leftCols(3), pbcs,
+                            center_atoms_mask, offsets),
+                        std::runtime_error);
+      BOOST_CHECK_EQUAL(bulk_collection.size(), n_structures);
+    }
+  }
+
+  /**
+   * Test that updating the structures of a collection in place with new
+   * positions and cells gives the same neighbour lists as building new
+   * managers
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(update_structures_test, Fix, fixtures_test,
+                                   Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using RowMatrix_t =
+        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    auto & collections = Fix::collections;
+
+    AtomicStructure<3> crystal{};
+    crystal.set_structure(std::string(
+        "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json"));
+    const size_t n_frames{4};
+    const int n_atoms{static_cast<int>(crystal.get_number_of_atoms())};
+    std::vector<AtomicStructure<3>> initial_frames(n_frames, crystal);
+
+    std::mt19937 generator{11};
+    std::uniform_real_distribution<double> distribution{-0.3, 0.3};
+    std::vector<AtomicStructure<3>> frames(n_frames, crystal);
+    RowMatrix_t positions(n_frames, 3 * n_atoms);
+    RowMatrix_t cells(n_frames, 9);
+    for (size_t i_frame{0}; i_frame < n_frames; ++i_frame) {
+      auto & frame = frames[i_frame];
+      frame.cell *= 1. + 0.02 * static_cast<double>(i_frame);
+      frame.positions *= 1. + 0.02 * static_cast<double>(i_frame);
+      frame.positions = frame.positions.unaryExpr(
+          [&](double x) { return x + distribution(generator); });
+      Eigen::Map<Eigen::Matrix<double, 3, Eigen::Dynamic>>(
+          positions.row(i_frame).data(), 3, n_atoms) = frame.positions;
+      Eigen::Map<Eigen::Matrix3d>(cells.row(i_frame).data()) = frame.cell;
+      frame.wrap();
+    }
+
+    for (auto & collection : collections) {
+      ManagerCollection_t ref_collection{collection.get_adaptors_parameters()};
+      ref_collection.add_structures(frames);
+      collection.add_structures(initial_frames);
+      std::vector<void *> manager_addresses{};
+      for (auto & manager : collection) {
+        manager_addresses.push_back(manager.get());
+      }
+
+      // update twice to check that the managers can be updated repeatedly
+      collection.update_structures(positions, cells.row(0), true, 2);
+      collection.update_structures(positions, cells, true, 2);
+
+      for (size_t i_frame{0}; i_frame < n_frames; ++i_frame) {
+        auto manager = collection[i_frame];
+        auto ref_manager = ref_collection[i_frame];
+        BOOST_CHECK_EQUAL(manager.get(), manager_addresses[i_frame]);
+        BOOST_CHECK_EQUAL(manager->get_nb_clusters(2),
+                          ref_manager->get_nb_clusters(2));
+        std::vector<double> ref_distances{};
+        for (auto center : ref_manager) {
+          for (auto pair : center.pairs()) {
+            ref_distances.push_back(ref_manager->get_distance(pair));
+          }
+        }
+        size_t i_pair{0};
+        for (auto center : manager) {
+          for (auto pair : center.pairs()) {
+            BOOST_CHECK_LE(std::abs(manager->get_distance(pair) -
+                                    ref_distances.at(i_pair)),
+                           1e-10);
+            ++i_pair;
+          }
+        }
+      }
+
+      BOOST_CHECK_THROW(
+          collection.update_structures(positions.topRows(2), cells),
+          std::runtime_error);
+      BOOST_CHECK_THROW(
+          collection.update_structures(positions.leftCols(3), cells.row(0)),
+          std::runtime_error);
+    }
+  }
+
+  /**
+   * Test that the subsets and their complements share the managers of the
+   * collection
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(subset_test, Fix, fixtures_test, Fix) {
+    auto & collections = Fix::collections;
+    for (auto & collection : collections) {
+      collection.add_structures(Fix::filename, Fix::start, Fix::length + 3);
+      const std::vector<int> selected_ids{{4, 1, 1}};
+      auto subset = collection.get_subset(selected_ids);
+      auto complement = collection.get_complement(selected_ids);
+      BOOST_CHECK_EQUAL(subset.size(), selected_ids.size());
+      BOOST_CHECK_EQUAL(complement.size(), collection.size() - 2);
+      for (size_t i_manager{0}; i_manager < subset.size(); ++i_manager) {
+        BOOST_CHECK_EQUAL(subset[i_manager].get(),
+                          collection[selected_ids[i_manager]].get());
+      }
+      const std::vector<int> complement_ids{{0, 2, 3, 5}};
+      for (size_t i_manager{0}; i_manager < complement.size(); ++i_manager) {
+        BOOST_CHECK_EQUAL(complement[i_manager].get(),
+                          collection[complement_ids[i_manager]].get());
+      }
+      BOOST_CHECK_EQUAL(collection.get_subset(std::vector<int>{}).size(), 0);
+      BOOST_CHECK_THROW(collection.get_subset(std::vector<int>{{1, -1}}),
+                        std::runtime_error);
+      BOOST_CHECK_THROW(collection.get_complement(std::vector<int>{{6}}),
+                        std::runtime_error);
+    }
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 }  // namespace rascal
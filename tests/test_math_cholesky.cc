@@ -0,0 +1,118 @@
+/**
+ * @file   test_math_cholesky.cc
+ *
+ * @date   18 October 2026
+ *
+ * @brief  test the updates of the Cholesky factorisation
+ *
+ * @section LICENSE
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "rascal/math/cholesky.hh"
+
+#include <boost/test/unit_test.hpp>
+
+namespace rascal {
+
+  BOOST_AUTO_TEST_SUITE(MathCholeskyTests);
+
+  struct CholeskyFixture {
+    CholeskyFixture() {
+      std::srand(10);
+      math::Matrix_t X{math::Matrix_t::Random(2 * n, n)};
+      A = X.transpose() * X + math::Matrix_t::Identity(n, n);
+    }
+    //! relative accuracy of the factorisations
+    const double delta{1e-10};
+    const int n{20};
+    math::Matrix_t A{};
+
+    //! relative error of L L^T w.r.t. the reference
+    double get_error(const math::UpdatableCholesky & cholesky,
+                     const math::Matrix_t & reference) {
+      const auto & L = cholesky.get_factor();
+      return (L * L.transpose() - reference).norm() / reference.norm();
+    }
+  };
+
+  /**
+   * Check that the factor is lower triangular and factorises the matrix
+   * after construction, rank k updates and extensions, and that solve
+   * inverts the matrix.
+   */
+  BOOST_FIXTURE_TEST_CASE(updates_test, CholeskyFixture) {
+    math::UpdatableCholesky cholesky{A};
+    BOOST_CHECK_EQUAL(cholesky.size(), n);
+    BOOST_CHECK_LE(this->get_error(cholesky, A), delta);
+    const auto & L = cholesky.get_factor();
+    BOOST_CHECK_EQUAL(L.triangularView<Eigen::StrictlyUpper>().toDenseMatrix()
+                          .norm(),
+                      0.);
+
+    // rank 3 update
+    math::Matrix_t U{math::Matrix_t::Random(3, n)};
+    cholesky.add_rows(U);
+    math::Matrix_t A_updated{A + U.transpose() * U};
+    BOOST_CHECK_LE(this->get_error(cholesky, A_updated), delta);
+
+    // border the matrix with 4 new variables
+    const int m{4};
+    math::Matrix_t X{math::Matrix_t::Random(2 * (n + m), n + m)};
+    math::Matrix_t A_extended{X.transpose() * X};
+    A_extended.topLeftCorner(n, n) = A_updated;
+    A_extended.bottomRightCorner(m, m) +=
+        100. * (n + m) * math::Matrix_t::Identity(m, m);
+    cholesky.extend(A_extended.topRightCorner(n, m),
+                    A_extended.bottomRightCorner(m, m));
+    BOOST_CHECK_EQUAL(cholesky.size(), n + m);
+    BOOST_CHECK_LE(this->get_error(cholesky, A_extended), delta);
+
+    // updates after the extension
+    U = math::Matrix_t::Random(2, n + m);
+    cholesky.add_rows(U);
+    A_extended += U.transpose() * U;
+    BOOST_CHECK_LE(this->get_error(cholesky, A_extended), delta);
+
+    math::Matrix_t B{math::Matrix_t::Random(n + m, 2)};
+    math::Matrix_t solution{cholesky.solve(B)};
+    BOOST_CHECK_LE((A_extended * solution - B).norm(), delta * B.norm());
+  }
+
+  /**
+   * Check that inconsistent shapes and indefinite extensions throw
+   */
+  BOOST_FIXTURE_TEST_CASE(errors_test, CholeskyFixture) {
+    math::UpdatableCholesky cholesky{A};
+    BOOST_CHECK_THROW(cholesky.add_rows(math::Matrix_t::Random(2, n + 1)),
+                      std::runtime_error);
+    BOOST_CHECK_THROW(cholesky.solve(math::Matrix_t::Random(n + 1, 1)),
+                      std::runtime_error);
+    BOOST_CHECK_THROW(cholesky.extend(math::Matrix_t::Zero(n, 2),
+                                      math::Matrix_t::Zero(3, 3)),
+                      std::runtime_error);
+    BOOST_CHECK_THROW(
+        cholesky.extend(math::Matrix_t::Zero(n, 1), -math::Matrix_t::Ones(1, 1)),
+        std::runtime_error);
+    BOOST_CHECK_EQUAL(cholesky.size(), n);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace rascal
@@ -119,6 +119,39 @@ namespace rascal {
     }
   }
 
+  /**
+   * Check the spherical bessel functions of the first kind against the
+   * closed forms of the first orders and the sum rule
+   * \sum_l (2l+1) j_l(x)^2 = 1
+   */
+  BOOST_AUTO_TEST_CASE(spherical_bessel_test) {
+    const double delta{1e-12};
+    for (const double x : {0., 1e-6, 0.3, 1., 2.5, 7., 31.4, 120.}) {
+      const size_t max_angular{20 + static_cast<size_t>(2 * x)};
+      Eigen::ArrayXd vals(max_angular + 1);
+      math::compute_spherical_bessel(x, vals);
+
+      std::array<double, 3> refs{{1., 0., 0.}};
+      if (x > 1e-3) {
+        const double s{std::sin(x)}, c{std::cos(x)};
+        refs[0] = s / x;
+        refs[1] = s / (x * x) - c / x;
+        refs[2] = (3. / (x * x) - 1.) * s / x - 3. * c / (x * x);
+      } else {
+        refs[1] = x / 3.;
+        refs[2] = x * x / 15.;
+      }
+      for (size_t order{0}; order < refs.size(); ++order) {
+        BOOST_TEST(std::abs(vals(order) - refs[order]) <= delta);
+      }
+      const double sum_rule{
+          (Eigen::ArrayXd::LinSpaced(max_angular + 1, 1, 2 * max_angular + 1) *
+           vals.square())
+              .sum()};
+      BOOST_TEST(std::abs(sum_rule - 1.) <= delta);
+    }
+  }
+
   /* ----------------------------------------------------------------------
    */
   BOOST_AUTO_TEST_SUITE_END();
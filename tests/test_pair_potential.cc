@@ -0,0 +1,296 @@
+/**
+ * @file   test_pair_potential.cc
+ *
+ * @date   18 October 2026
+ *
+ * @brief  test the tabulated pair potentials
+ *
+ * @section LICENSE
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "rascal/models/pair_potential.hh"
+#include "rascal/structure_managers/adaptor_center_contribution.hh"
+#include "rascal/structure_managers/adaptor_half_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+
+namespace rascal {
+
+  BOOST_AUTO_TEST_SUITE(pair_potential_test);
+
+  struct PairPotentialFixture {
+    using Structure_t = AtomicStructure<ThreeD>;
+
+    PairPotentialFixture() {
+      for (auto && filename : this->filenames) {
+        this->structures.emplace_back();
+        this->structures.back().set_structure(filename);
+      }
+    }
+
+    ~PairPotentialFixture() = default;
+
+    json make_adaptors(const bool half_list) const {
+      json adaptors{{{"name", "AdaptorNeighbourList"},
+                     {"initialization_arguments",
+                      {{"cutoff", this->cutoff}, {"skin", 0.}}}}};
+      if (half_list) {
+        adaptors.push_back(
+            {{"name", "AdaptorHalfList"}, {"initialization_arguments", {}}});
+      }
+      adaptors.push_back({{"name", "AdaptorCenterContribution"},
+                          {"initialization_arguments", {}}});
+      adaptors.push_back({{"name", "AdaptorStrict"},
+                          {"initialization_arguments",
+                           {{"cutoff", this->cutoff}}}});
+      return adaptors;
+    }
+
+    auto make_manager(const Structure_t & structure) const {
+      json structure_input = structure;
+      return make_structure_manager_stack<
+          StructureManagerCenters, AdaptorNeighbourList,
+          AdaptorCenterContribution, AdaptorStrict>(structure_input,
+                                                    this->make_adaptors(false));
+    }
+
+    auto make_half_manager(const Structure_t & structure) const {
+      json structure_input = structure;
+      return make_structure_manager_stack<
+          StructureManagerCenters, AdaptorNeighbourList, AdaptorHalfList,
+          AdaptorCenterContribution, AdaptorStrict>(structure_input,
+                                                    this->make_adaptors(true));
+    }
+
+    //! force shifted Morse potential, zero with a zero slope at the cutoff
+    double morse(const double depth, const double r) const {
+      auto morse_ = [this, depth](const double x) {
+        const double e{std::exp(-this->alpha * (x - this->r_0))};
+        return depth * ((1. - e) * (1. - e) - 1.);
+      };
+      auto dmorse_ = [this, depth](const double x) {
+        const double e{std::exp(-this->alpha * (x - this->r_0))};
+        return 2. * depth * this->alpha * (1. - e) * e;
+      };
+      return morse_(r) - morse_(this->cutoff) -
+             (r - this->cutoff) * dmorse_(this->cutoff);
+    }
+
+    //! a table for all the pairs of species of the structures but one
+    json make_hypers() const {
+      std::set<int> species{};
+      for (auto && structure : this->structures) {
+        for (int i_atom{0}; i_atom < structure.atom_types.size(); ++i_atom) {
+          species.insert(structure.atom_types(i_atom));
+        }
+      }
+      const double dr{(this->cutoff - this->r_min) / (this->n_grid - 1)};
+      json hypers{{"pairs", json::array()}};
+      for (int sp_a : species) {
+        for (int sp_b : species) {
+          if (sp_b < sp_a or (sp_a == this->skipped[0] and
+                              sp_b == this->skipped[1])) {
+            continue;
+          }
+          const double depth{this->get_depth(sp_a, sp_b)};
+          std::vector<double> grid{}, values{};
+          for (int i_grid{0}; i_grid < this->n_grid; ++i_grid) {
+            grid.push_back(this->r_min + i_grid * dr);
+            values.push_back(this->morse(depth, grid.back()));
+          }
+          hypers["pairs"].push_back(
+              {{"species", {sp_b, sp_a}}, {"grid", grid}, {"values", values}});
+        }
+      }
+      return hypers;
+    }
+
+    double get_depth(const int sp_a, const int sp_b) const {
+      return 0.1 + 0.01 * (sp_a + sp_b);
+    }
+
+    const std::vector<std::string> filenames{
+        "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json",
+        "reference_data/inputs/diamond_cubic_distorted.json",
+        "reference_data/inputs/SiCGe_wurtzite_like.json"};
+    const double cutoff{3.};
+    const double r_min{0.5};
+    const double alpha{1.5};
+    const double r_0{1.8};
+    const int n_grid{3001};
+    //! pair of species without a table
+    const std::array<int, 2> skipped{{8, 8}};
+
+    std::vector<Structure_t> structures{};
+  };
+
+  /**
+   * Test the energies against the sum of the Morse potential over the pairs
+   * and the results of the full and half neighbour lists against each other.
+   */
+  BOOST_FIXTURE_TEST_CASE(energy_test, PairPotentialFixture) {
+    PairPotential potential{this->make_hypers()};
+    BOOST_CHECK_CLOSE(potential.get_cutoff(), this->cutoff, 1e-10);
+    const double delta{1e-8};
+    for (auto & structure : this->structures) {
+      auto manager = this->make_manager(structure);
+      auto manager_half = this->make_half_manager(structure);
+      double reference{0.};
+      for (auto center : manager) {
+        for (auto neigh : center.pairs()) {
+          std::array<int, 2> species{
+              {center.get_atom_type(), neigh.get_atom_type()}};
+          std::sort(species.begin(), species.end());
+          if (species == this->skipped) {
+            continue;
+          }
+          reference +=
+              0.5 * this->morse(this->get_depth(species[0], species[1]),
+                                manager->get_distance(neigh));
+        }
+      }
+      std::vector<decltype(manager)> managers{manager};
+      std::vector<decltype(manager_half)> managers_half{manager_half};
+      auto result = potential.compute(managers);
+      auto result_half = potential.compute(managers_half);
+
+      const double energy{std::get<0>(result)(0, 0)};
+      BOOST_TEST(std::abs(energy - reference) <=
+                 delta * std::abs(reference));
+      BOOST_TEST(std::abs(std::get<0>(result_half)(0, 0) - energy) <=
+                 1e-12 * std::abs(energy));
+      for (int i_result : {1, 2}) {
+        const math::Matrix_t & full{i_result == 1 ? std::get<1>(result)
+                                                  : std::get<2>(result)};
+        const math::Matrix_t & half{i_result == 1 ? std::get<1>(result_half)
+                                                  : std::get<2>(result_half)};
+        BOOST_TEST((full - half).lpNorm<Eigen::Infinity>() <=
+                   1e-12 * full.lpNorm<Eigen::Infinity>());
+      }
+    }
+  }
+
+  /**
+   * Test the gradients and the negative stress against the finite
+   * differences of the energy w.r.t. the positions and the strain.
+   */
+  BOOST_FIXTURE_TEST_CASE(gradient_test, PairPotentialFixture) {
+    PairPotential potential{this->make_hypers()};
+    const double h_disp{1e-5};
+    const double delta{1e-6};
+    // see compute_sparse_kernel_neg_stress for the Voigt order
+    const std::array<std::array<int, 2>, 2 * ThreeD> voigt{
+        {{{0, 0}}, {{1, 1}}, {{2, 2}}, {{1, 2}}, {{0, 2}}, {{0, 1}}}};
+    for (auto & structure : this->structures) {
+      auto manager = this->make_manager(structure);
+      std::vector<decltype(manager)> managers{manager};
+      auto result = potential.compute(managers);
+      const math::Matrix_t & gradients{std::get<1>(result)};
+      const math::Matrix_t & neg_stress{std::get<2>(result)};
+      BOOST_REQUIRE_EQUAL(gradients.rows(), manager->size());
+      BOOST_REQUIRE_EQUAL(neg_stress.cols(), 2 * ThreeD);
+
+      auto compute_energy = [&](const Structure_t & displaced) {
+        manager->update(displaced);
+        return std::get<0>(potential.compute(managers))(0, 0);
+      };
+
+      math::Matrix_t gradients_num{gradients.rows(), ThreeD};
+      for (size_t i_atom{0}; i_atom < manager->size(); ++i_atom) {
+        for (int i_der{0}; i_der < ThreeD; ++i_der) {
+          Eigen::Vector3d disp{Eigen::Vector3d::Zero()};
+          disp(i_der) = h_disp;
+          Structure_t plus{structure}, minus{structure};
+          plus.displace_position(i_atom, disp);
+          minus.displace_position(i_atom, -disp);
+          plus.wrap();
+          minus.wrap();
+          gradients_num(i_atom, i_der) =
+              (compute_energy(plus) - compute_energy(minus)) / (2 * h_disp);
+        }
+      }
+      const double scale{gradients.lpNorm<Eigen::Infinity>()};
+      BOOST_TEST((gradients - gradients_num).lpNorm<Eigen::Infinity>() <=
+                 delta * scale);
+
+      math::Matrix_t neg_stress_num{1, 2 * ThreeD};
+      for (int i_voigt{0}; i_voigt < 2 * ThreeD; ++i_voigt) {
+        Structure_t plus{structure}, minus{structure};
+        plus.displace_strain_tensor(voigt[i_voigt][0], voigt[i_voigt][1],
+                                    h_disp);
+        minus.displace_strain_tensor(voigt[i_voigt][0], voigt[i_voigt][1],
+                                     -h_disp);
+        neg_stress_num(0, i_voigt) =
+            -(compute_energy(plus) - compute_energy(minus)) /
+            (2 * h_disp * structure.get_volume());
+      }
+      manager->update(structure);
+      const double scale_stress{neg_stress.lpNorm<Eigen::Infinity>()};
+      BOOST_TEST((neg_stress - neg_stress_num).lpNorm<Eigen::Infinity>() <=
+                 delta * scale_stress);
+    }
+  }
+
+  /**
+   * Test that the distances outside of the tables and the neighbour lists
+   * that are too short are reported.
+   */
+  BOOST_FIXTURE_TEST_CASE(error_test, PairPotentialFixture) {
+    auto manager = this->make_manager(this->structures.front());
+    std::vector<decltype(manager)> managers{manager};
+
+    json hypers = this->make_hypers();
+    for (auto & pair : hypers["pairs"]) {
+      auto grid = pair["grid"].get<std::vector<double>>();
+      for (auto & r : grid) {
+        r += 1.;
+      }
+      pair["grid"] = grid;
+    }
+    PairPotential too_long{hypers};
+    BOOST_CHECK_THROW(too_long.compute(managers), std::runtime_error);
+
+    // the shortest bonds of the structure are below 2 AA
+    hypers = this->make_hypers();
+    for (auto & pair : hypers["pairs"]) {
+      auto grid = pair["grid"].get<std::vector<double>>();
+      const double dr{(this->cutoff - 2.) / (grid.size() - 1)};
+      for (size_t i_grid{0}; i_grid < grid.size(); ++i_grid) {
+        grid[i_grid] = 2. + i_grid * dr;
+      }
+      pair["grid"] = grid;
+    }
+    PairPotential too_short{hypers};
+    BOOST_CHECK_THROW(too_short.compute(managers), std::runtime_error);
+
+    hypers = this->make_hypers();
+    hypers["pairs"].push_back(hypers["pairs"].at(0));
+    BOOST_CHECK_THROW(PairPotential{hypers}, std::runtime_error);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace rascal
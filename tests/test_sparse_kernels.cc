@@ -32,6 +32,8 @@
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <random>
+
 namespace rascal {
   BOOST_AUTO_TEST_SUITE(sparse_kernels_test);
 
@@ -99,6 +101,7 @@ namespace rascal {
    * Utility fixture used to compare representations with sparsification
    */
 
+  template <class Representation, bool UnnormalizedInputs = true>
   struct SparseKernelGradFixture {
     using ManagerTypeHolder_t =
         StructureManagerTypeHolder<StructureManagerCenters,
@@ -109,7 +112,7 @@ namespace rascal {
         typename TypeHolderInjector<ManagerCollection,
                                     ManagerTypeHolder_t::type_list>::type;
     using Structure_t = AtomicStructure<3>;
-    using Representation_t = CalculatorSphericalInvariants;
+    using Representation_t = Representation;
     using SparsePoints_t = SparsePointsBlockSparse<Representation_t>;
     using Kernel_t = SparseKernel;
     using Prop_t = typename Representation_t::template Property_t<Manager_t>;
@@ -119,9 +122,33 @@ namespace rascal {
     SparseKernelGradFixture() {}
 
     ~SparseKernelGradFixture() = default;
+
+    /**
+     * Inputs of the gradient tests, the ones with unnormalized features are
+     * skipped if UnnormalizedInputs is false
+     */
+    static json get_inputs() {
+      json inputs =
+          json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+      json selected_inputs = json::array();
+      for (const auto & input : inputs) {
+        if (UnnormalizedInputs or
+            input.at("calculator").at("normalize").template get<bool>()) {
+          selected_inputs.push_back(input);
+        }
+      }
+      return selected_inputs;
+    }
   };
 
-  using sparse_grad_fixtures = boost::mpl::list<SparseKernelGradFixture>;
+  /**
+   * The unnormalized three-body features grow with the square of the number
+   * of neighbours so the kernels of the dense inputs are too large for their
+   * numerical gradients to be accurate
+   */
+  using sparse_grad_fixtures =
+      boost::mpl::list<SparseKernelGradFixture<CalculatorSphericalInvariants>,
+                       SparseKernelGradFixture<CalculatorThreeBody, false>>;
 
   /**
    * Test the analytical kernel gradients against numerical kernel gradients.
@@ -132,9 +159,7 @@ namespace rascal {
     using Representation_t = typename Fix::Representation_t;
     using Kernel_t = typename Fix::Kernel_t;
     using SparsePoints_t = typename Fix::SparsePoints_t;
-    json inputs{};
-    inputs =
-        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+    json inputs = Fix::get_inputs();
 
     const bool verbose{true};
     // relative error threshold
@@ -228,9 +253,7 @@ namespace rascal {
     using Kernel_t = typename Fix::Kernel_t;
     using SparsePoints_t = typename Fix::SparsePoints_t;
 
-    json inputs{};
-    inputs =
-        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+    json inputs = Fix::get_inputs();
 
     const bool verbose{true};
     // relative error threshold
@@ -322,6 +345,472 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the kernels computed for several zetas at once match the
+   * kernels computed separately for each zeta, for both target types and
+   * for the kernel gradients with the negative stress.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(zetas_test, Fix, sparse_grad_fixtures,
+                                   Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Representation_t = typename Fix::Representation_t;
+    using Kernel_t = typename Fix::Kernel_t;
+    using SparsePoints_t = typename Fix::SparsePoints_t;
+
+    json inputs = Fix::get_inputs();
+    const std::vector<size_t> zetas{1, 2, 4};
+    const double delta{1e-12};
+
+    for (const auto & input : inputs) {
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      ManagerCollection_t managers{adaptors_input};
+      SparsePoints_t sparse_points{};
+      Representation_t representation{calculator_input};
+      managers.add_structures(
+          input.at("filename").template get<std::string>(), 0,
+          input.at("n_structures").template get<int>());
+      representation.compute(managers);
+      sparse_points.push_back(representation, managers, selected_ids);
+
+      for (const std::string target_type : {"Structure", "Atom"}) {
+        kernel_input["target_type"] = target_type;
+        Kernel_t kernel{kernel_input};
+        auto KNMs{kernel.compute_for_zetas(representation, managers,
+                                           sparse_points, zetas)};
+        auto KMMs{kernel.compute_for_zetas(sparse_points, zetas)};
+        auto KNM_ders{kernel.compute_derivative_for_zetas(
+            representation, managers, sparse_points, true, zetas)};
+        BOOST_REQUIRE_EQUAL(KNMs.size(), zetas.size());
+        BOOST_REQUIRE_EQUAL(KMMs.size(), zetas.size());
+        BOOST_REQUIRE_EQUAL(KNM_ders.size(), zetas.size());
+
+        for (size_t i_zeta{0}; i_zeta < zetas.size(); ++i_zeta) {
+          kernel_input["zeta"] = zetas[i_zeta];
+          Kernel_t kernel_zeta{kernel_input};
+          math::Matrix_t KNM{
+              kernel_zeta.compute(representation, managers, sparse_points)};
+          math::Matrix_t KMM{kernel_zeta.compute(sparse_points)};
+          math::Matrix_t KNM_der{kernel_zeta.compute_derivative(
+              representation, managers, sparse_points, true)};
+          BOOST_CHECK_LE((KNMs[i_zeta] - KNM).norm(), delta * KNM.norm());
+          BOOST_CHECK_LE((KMMs[i_zeta] - KMM).norm(), delta * KMM.norm());
+          BOOST_CHECK_LE((KNM_ders[i_zeta] - KNM_der).norm(),
+                         delta * KNM_der.norm());
+        }
+      }
+    }
+  }
+
+  /**
+   * Test that the fused prediction routine gives the same property, gradients
+   * and negative stress as the kernel matrices contracted with the weights.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(fused_predictions_test, Fix,
+                                   sparse_grad_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Manager_t = typename ManagerCollection_t::Manager_t;
+    using Representation_t = typename Fix::Representation_t;
+    using Kernel_t = typename Fix::Kernel_t;
+    using SparsePoints_t = typename Fix::SparsePoints_t;
+
+    json inputs = Fix::get_inputs();
+
+    // relative error threshold
+    const double delta{1e-10};
+    // range of zero
+    const double epsilon{1e-12};
+
+    const bool compute_stress{true};
+
+    for (const auto & input : inputs) {
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      Kernel_t kernel{kernel_input};
+      ManagerCollection_t managers{adaptors_input};
+      SparsePoints_t sparse_points{};
+      Representation_t representation{calculator_input};
+      managers.add_structures(input.at("filename").template get<std::string>(),
+                              0, input.at("n_structures").template get<int>());
+      representation.compute(managers);
+      sparse_points.push_back(representation, managers, selected_ids);
+
+      math::Vector_t weights{sparse_points.size()};
+      weights.setRandom();
+
+      auto KNM{kernel.compute(representation, managers, sparse_points)};
+      auto KNM_der{kernel.compute_derivative(representation, managers,
+                                             sparse_points, compute_stress)};
+      math::Matrix_t energies_k = KNM * weights.transpose();
+      math::Matrix_t derivatives_k = KNM_der * weights.transpose();
+
+      const bool compute_neg_stress{true}, compute_atomic_virials{true};
+      auto names = compute_sparse_kernel_predictions(
+          representation, kernel, managers, sparse_points, weights,
+          compute_neg_stress, compute_atomic_virials);
+
+      int row_max{0}, col_max{0};
+      size_t i_manager{0}, i_grad{0};
+      size_t i_stress{static_cast<size_t>(KNM_der.rows()) -
+                      managers.size() * 6};
+      for (auto manager : managers) {
+        auto && energy{
+            *manager->template get_property<Property<double, 0, Manager_t, 1>>(
+                names[0], true)};
+        auto && gradients{*manager->template get_property<
+            Property<double, 1, Manager_t, 1, ThreeD>>(names[1], true)};
+        auto && neg_stress{
+            *manager->template get_property<Property<double, 0, Manager_t, 6>>(
+                names[2], true)};
+
+        math::Matrix_t en = energy.view();
+        math::Matrix_t en_r = energies_k.block(i_manager, 0, 1, 1);
+        math::Matrix_t en_diff = math::relative_error(en, en_r, delta, epsilon);
+        BOOST_TEST(en_diff.maxCoeff(&row_max, &col_max) < delta);
+
+        math::Matrix_t ff = Eigen::Map<const math::Matrix_t>(
+            gradients.view().data(), manager->size() * ThreeD, 1);
+        math::Matrix_t ff_r =
+            derivatives_k.block(i_grad, 0, manager->size() * ThreeD, 1);
+        math::Matrix_t ff_diff = math::relative_error(ff, ff_r, delta, epsilon);
+        BOOST_TEST(ff_diff.maxCoeff(&row_max, &col_max) < delta);
+
+        math::Matrix_t ss =
+            Eigen::Map<const math::Matrix_t>(neg_stress.view().data(), 6, 1);
+        math::Matrix_t ss_r = derivatives_k.block(i_stress, 0, 6, 1);
+        math::Matrix_t ss_diff = math::relative_error(ss, ss_r, delta, epsilon);
+        BOOST_TEST(ss_diff.maxCoeff(&row_max, &col_max) < delta);
+
+        // the atomic virials sum up to the virial of the structure
+        auto && atomic_virials{
+            *manager->template get_property<Property<double, 1, Manager_t, 6>>(
+                names[3], true)};
+        math::Matrix_t vv = atomic_virials.view();
+        BOOST_REQUIRE_EQUAL(vv.rows(), manager->size());
+        BOOST_REQUIRE_EQUAL(vv.cols(), 6);
+        auto manager_root = extract_underlying_manager<0>(manager);
+        json structure_copy = manager_root->get_atomic_structure();
+        auto atomic_structure =
+            structure_copy.template get<AtomicStructure<ThreeD>>();
+        math::Matrix_t vv_sum = vv.colwise().sum().transpose() /
+                                atomic_structure.get_volume();
+        math::Matrix_t vv_diff =
+            math::relative_error(vv_sum, ss_r, delta, epsilon);
+        BOOST_TEST(vv_diff.maxCoeff(&row_max, &col_max) < delta);
+
+        i_manager++;
+        i_grad += manager->size() * ThreeD;
+        i_stress += 6;
+      }
+    }
+  }
+
+  /**
+   * Test that the predictions computed domain by domain match the
+   * predictions computed on the whole structures.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(predictions_by_domains_test, Fix,
+                                   sparse_grad_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Manager_t = typename ManagerCollection_t::Manager_t;
+    using Representation_t = typename Fix::Representation_t;
+    using Kernel_t = typename Fix::Kernel_t;
+    using SparsePoints_t = typename Fix::SparsePoints_t;
+
+    json inputs = Fix::get_inputs();
+
+    // relative error threshold
+    const double delta{1e-10};
+    // range of zero
+    const double epsilon{1e-12};
+
+    const std::vector<std::array<int, 3>> n_domains{{{2, 1, 1}},
+                                                    {{2, 2, 3}}};
+
+    for (const auto & input : inputs) {
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      const double cutoff{adaptors_input[0]
+                              .at("initialization_arguments")
+                              .at("cutoff")
+                              .template get<double>()};
+      Kernel_t kernel{kernel_input};
+      ManagerCollection_t managers{adaptors_input};
+      SparsePoints_t sparse_points{};
+      Representation_t representation{calculator_input};
+      managers.add_structures(input.at("filename").template get<std::string>(),
+                              0, input.at("n_structures").template get<int>());
+      representation.compute(managers);
+      sparse_points.push_back(representation, managers, selected_ids);
+
+      math::Vector_t weights{sparse_points.size()};
+      weights.setRandom();
+
+      const bool compute_neg_stress{true}, compute_atomic_virials{true};
+      auto names = compute_sparse_kernel_predictions(
+          representation, kernel, managers, sparse_points, weights,
+          compute_neg_stress, compute_atomic_virials);
+
+      for (auto manager : managers) {
+        auto && energy{
+            *manager->template get_property<Property<double, 0, Manager_t, 1>>(
+                names[0], true)};
+        auto && gradients{*manager->template get_property<
+            Property<double, 1, Manager_t, 1, ThreeD>>(names[1], true)};
+        auto && neg_stress{
+            *manager->template get_property<Property<double, 0, Manager_t, 6>>(
+                names[2], true)};
+        math::Matrix_t en_r = energy.view();
+        math::Matrix_t ff_r = gradients.view();
+        math::Matrix_t ss_r =
+            Eigen::Map<const math::Matrix_t>(neg_stress.view().data(), 1, 6);
+        auto && atomic_virials{
+            *manager->template get_property<Property<double, 1, Manager_t, 6>>(
+                names[3], true)};
+        math::Matrix_t vv_r = atomic_virials.view();
+
+        auto manager_root = extract_underlying_manager<0>(manager);
+        const auto & structure = manager_root->get_atomic_structure();
+        const bool is_periodic{(structure.pbc.array() != 0).any()};
+        for (const auto & n_domain : n_domains) {
+          DomainDecomposition domains{structure, cutoff, n_domain};
+          auto predictions =
+              compute_sparse_kernel_predictions_by_domains<Representation_t>(
+                  domains, calculator_input, kernel, sparse_points, weights,
+                  2, compute_neg_stress, compute_atomic_virials);
+          math::Matrix_t en = math::Matrix_t::Constant(
+              1, 1, std::get<0>(predictions));
+          math::Matrix_t en_diff =
+              math::relative_error(en, en_r, delta, epsilon);
+          BOOST_TEST(en_diff.maxCoeff() < delta);
+
+          math::Matrix_t ff = std::get<1>(predictions);
+          BOOST_REQUIRE_EQUAL(ff.rows(), ff_r.rows());
+          math::Matrix_t ff_diff =
+              math::relative_error(ff, ff_r, delta, epsilon);
+          BOOST_TEST(ff_diff.maxCoeff() < delta);
+
+          math::Matrix_t vv = std::get<3>(predictions);
+          BOOST_REQUIRE_EQUAL(vv.rows(), vv_r.rows());
+          math::Matrix_t vv_diff =
+              math::relative_error(vv, vv_r, delta, epsilon);
+          BOOST_TEST(vv_diff.maxCoeff() < delta);
+
+          if (is_periodic) {
+            math::Matrix_t ss = std::get<2>(predictions);
+            math::Matrix_t ss_diff =
+                math::relative_error(ss, ss_r, delta, epsilon);
+            BOOST_TEST(ss_diff.maxCoeff() < delta);
+          }
+        }
+      }
+    }
+  }
+
+  using HessianFixture_t =
+      SparseKernelGradFixture<CalculatorSphericalInvariants>;
+  /**
+   * Test the Hessian-vector products of the SOAP-GAP prediction against
+   * centered finite differences of its gradients, and the assembled Hessian
+   * against the Hessian-vector products for the small structures.
+   */
+  BOOST_FIXTURE_TEST_CASE(hessian_vector_product_test, HessianFixture_t) {
+    json inputs = get_inputs();
+    // relative error threshold w.r.t. the largest element
+    const double delta{1e-5};
+    // the finite differences of the gradients of the expansion along the
+    // displacement of each pair make the products linear in the
+    // displacements only up to about 1e-9
+    const double delta_hessian{1e-8};
+    const size_t max_hessian_size{20};
+    const double h_disp{1e-4};
+    std::mt19937 generator{1234};
+    std::uniform_real_distribution<double> distribution{-1., 1.};
+
+    for (const auto & input : inputs) {
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      Kernel_t kernel{kernel_input};
+      ManagerCollection_t managers{adaptors_input};
+      SparsePoints_t sparse_points{};
+      Representation_t representation{calculator_input};
+      managers.add_structures(input.at("filename").template get<std::string>(),
+                              0, input.at("n_structures").template get<int>());
+      representation.compute(managers);
+      sparse_points.push_back(representation, managers, selected_ids);
+      // the products do not need the gradients of the representation
+      calculator_input["compute_gradients"] = false;
+      Representation_t representation_{calculator_input};
+
+      math::Vector_t weights{sparse_points.size()};
+      for (int i_point{0}; i_point < weights.size(); ++i_point) {
+        weights(i_point) = distribution(generator);
+      }
+
+      const int n_structures{input.at("n_structures").template get<int>()};
+      for (int i_structure{0}; i_structure < n_structures; ++i_structure) {
+        // the kernel gradients of the finite differences are computed on
+        // the structure alone
+        ManagerCollection_t single_manager{adaptors_input};
+        single_manager.add_structures(
+            input.at("filename").template get<std::string>(), i_structure, 1);
+        auto manager = single_manager[0];
+        const size_t n_centers{manager->size()};
+        math::Matrix_t displacements{n_centers, ThreeD};
+        for (size_t i_atom{0}; i_atom < n_centers; ++i_atom) {
+          for (int i_der{0}; i_der < ThreeD; ++i_der) {
+            displacements(i_atom, i_der) = distribution(generator);
+          }
+        }
+        math::Matrix_t hvp{compute_sparse_kernel_hessian_vector_product(
+            representation_, kernel, manager, sparse_points, weights,
+            displacements)};
+        BOOST_REQUIRE_EQUAL(hvp.rows(), n_centers);
+        BOOST_REQUIRE_EQUAL(hvp.cols(), ThreeD);
+
+        // centered finite differences of the gradients
+        auto manager_root = extract_underlying_manager<0>(manager);
+        json structure_copy = manager_root->get_atomic_structure();
+        math::Matrix_t hvp_num{math::Matrix_t::Zero(n_centers * ThreeD, 1)};
+        for (const double sign : {1., -1.}) {
+          auto atomic_structure =
+              structure_copy.template get<AtomicStructure<ThreeD>>();
+          for (size_t i_atom{0}; i_atom < n_centers; ++i_atom) {
+            Eigen::Vector3d disp{sign * h_disp *
+                                 displacements.row(i_atom).transpose()};
+            atomic_structure.displace_position(i_atom, disp);
+          }
+          atomic_structure.wrap();
+          manager->update(atomic_structure);
+          representation.compute(manager);
+          math::Matrix_t KNM_der{kernel.compute_derivative(
+              representation, single_manager, sparse_points, false)};
+          hvp_num += sign * KNM_der * weights.transpose() / (2 * h_disp);
+        }
+        manager->update(structure_copy.template get<AtomicStructure<ThreeD>>());
+
+        Eigen::Map<const math::Matrix_t> hvp_flat(hvp.data(),
+                                                  n_centers * ThreeD, 1);
+        const double scale{hvp_num.lpNorm<Eigen::Infinity>()};
+        BOOST_TEST((hvp_flat - hvp_num).lpNorm<Eigen::Infinity>() <=
+                   delta * scale);
+        // another step of the finite differences of the gradients of the
+        // expansion only changes the products within their accuracy
+        math::Matrix_t hvp_step{compute_sparse_kernel_hessian_vector_product(
+            representation_, kernel, manager, sparse_points, weights,
+            displacements, 1e-4)};
+        BOOST_TEST((hvp_step - hvp).lpNorm<Eigen::Infinity>() <=
+                   delta_hessian * 1e2 * scale);
+        BOOST_CHECK_THROW(compute_sparse_kernel_hessian_vector_product(
+                              representation_, kernel, manager, sparse_points,
+                              weights, displacements, 0.),
+                          std::runtime_error);
+
+        if (n_centers > max_hessian_size) {
+          continue;
+        }
+        Eigen::SparseMatrix<double> hessian{compute_sparse_kernel_hessian(
+            representation_, kernel, manager, sparse_points, weights)};
+        BOOST_REQUIRE_EQUAL(hessian.rows(), n_centers * ThreeD);
+        BOOST_REQUIRE_EQUAL(hessian.cols(), n_centers * ThreeD);
+        Eigen::Map<const Eigen::VectorXd> displacements_flat(
+            displacements.data(), n_centers * ThreeD);
+        Eigen::VectorXd hessian_dot{hessian * displacements_flat};
+        BOOST_TEST((hessian_dot - hvp_flat).lpNorm<Eigen::Infinity>() <=
+                   delta_hessian * scale);
+        // the second derivatives are symmetric up to the finite differences
+        // of the gradients of the expansion
+        Eigen::MatrixXd hessian_dense{hessian};
+        Eigen::MatrixXd asymmetry{hessian_dense - hessian_dense.transpose()};
+        BOOST_TEST(asymmetry.lpNorm<Eigen::Infinity>() <=
+                   delta * hessian_dense.lpNorm<Eigen::Infinity>());
+      }
+    }
+  }
+
+  /**
+   * Test that the gradients of the sparse kernels are rejected with a half
+   * neighbour list, whose missing pairs they would ignore.
+   */
+  BOOST_AUTO_TEST_CASE(half_neighbour_list_gradients_test) {
+    using ManagerCollection_t =
+        ManagerCollection<StructureManagerCenters, AdaptorNeighbourList,
+                          AdaptorHalfList, AdaptorCenterContribution,
+                          AdaptorStrict>;
+    using SparsePoints_t =
+        SparsePointsBlockSparse<CalculatorSphericalInvariants>;
+    const double cutoff{3.};
+    json adaptors{{{"name", "AdaptorNeighbourList"},
+                   {"initialization_arguments", {{"cutoff", cutoff}}}},
+                  {{"name", "AdaptorHalfList"},
+                   {"initialization_arguments", {}}},
+                  {{"name", "AdaptorCenterContribution"},
+                   {"initialization_arguments", {}}},
+                  {{"name", "AdaptorStrict"},
+                   {"initialization_arguments", {{"cutoff", cutoff}}}}};
+    json hypers{{"max_radial", 3},
+                {"max_angular", 2},
+                {"soap_type", "PowerSpectrum"},
+                {"normalize", true},
+                {"compute_gradients", true}};
+    hypers["cutoff_function"] = {
+        {"type", "ShiftedCosine"},
+        {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+        {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
+    hypers["gaussian_density"] = {
+        {"type", "Constant"},
+        {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
+    hypers["radial_contribution"] = {{"type", "GTO"}};
+
+    ManagerCollection_t managers{adaptors};
+    managers.add_structures("reference_data/inputs/small_molecules-20.json",
+                            0, 2);
+    CalculatorSphericalInvariants representation{hypers};
+    representation.compute(managers);
+    SparsePoints_t sparse_points{};
+    sparse_points.push_back(representation, managers,
+                            std::vector<std::vector<int>>{{0, 1}, {2}});
+    SparseKernel kernel{
+        json{{"name", "GAP"}, {"zeta", 2}, {"target_type", "Structure"}}};
+    math::Vector_t weights{math::Vector_t::Ones(sparse_points.size())};
+
+    // the kernel itself does not depend on the type of neighbour list
+    BOOST_CHECK_NO_THROW(
+        kernel.compute(representation, managers, sparse_points));
+    BOOST_CHECK_THROW(
+        kernel.compute_derivative(representation, managers, sparse_points,
+                                  true),
+        std::logic_error);
+    BOOST_CHECK_THROW(kernel.compute_derivative_for_zetas(
+                          representation, managers, sparse_points, true,
+                          std::vector<size_t>{1, 2}),
+                      std::logic_error);
+    BOOST_CHECK_THROW(compute_sparse_kernel_gradients(
+                          representation, kernel, managers, sparse_points,
+                          weights),
+                      std::logic_error);
+    BOOST_CHECK_THROW(compute_sparse_kernel_neg_stress(
+                          representation, kernel, managers, sparse_points,
+                          weights),
+                      std::logic_error);
+    BOOST_CHECK_THROW(compute_sparse_kernel_predictions(
+                          representation, kernel, managers, sparse_points,
+                          weights),
+                      std::logic_error);
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace rascal
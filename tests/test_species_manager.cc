@@ -28,7 +28,10 @@
 
 #include "test_structure.hh"
 
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
 #include "rascal/structure_managers/species_manager.hh"
+#include "rascal/structure_managers/species_partition.hh"
 
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
@@ -100,6 +103,82 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /*
+   * Test that the species views of SpeciesPartition hold each center and
+   * each pair exactly once, in species-homogeneous ranges.
+   */
+  BOOST_FIXTURE_TEST_CASE(species_partition_test,
+                          ManagerFixture<StructureManagerCenters>) {
+    const double cutoff{3.5};
+    using StrictManager_t = AdaptorStrict<AdaptorNeighbourList<Manager_t>>;
+    for (auto & structure_manager : this->managers) {
+      auto pair_manager{make_adapted_manager<AdaptorNeighbourList>(
+          structure_manager, cutoff)};
+      auto manager{make_adapted_manager<AdaptorStrict>(pair_manager, cutoff)};
+      manager->update();
+
+      SpeciesPartition<StrictManager_t> partition{};
+      partition.update(manager);
+      const auto & species{partition.get_species()};
+      BOOST_CHECK(std::is_sorted(species.begin(), species.end()));
+      BOOST_CHECK_THROW(partition.get_species_index(-1), std::runtime_error);
+
+      // the centers of each species in the order of the manager
+      std::vector<size_t> center_indices{};
+      for (size_t i_species{0}; i_species < species.size(); ++i_species) {
+        for (auto && center : partition.get_centers(i_species)) {
+          auto center_it{manager->get_iterator_at(center.index)};
+          BOOST_CHECK_EQUAL((*center_it).get_atom_type(), species[i_species]);
+          BOOST_CHECK_EQUAL((*center_it).get_atom_tag(), center.atom_tag);
+          BOOST_CHECK_EQUAL(partition.get_center_species_index(center.index),
+                            i_species);
+          center_indices.push_back(center.index);
+        }
+      }
+      std::sort(center_indices.begin(), center_indices.end());
+      BOOST_CHECK_EQUAL(center_indices.size(), manager->size());
+      for (size_t i_center{0}; i_center < center_indices.size(); ++i_center) {
+        BOOST_CHECK_EQUAL(center_indices[i_center], i_center);
+      }
+
+      size_t i_center{0};
+      size_t n_pairs{0};
+      for (auto center : manager) {
+        std::vector<int> types{};
+        std::vector<size_t> cluster_indices{};
+        for (auto neigh : center.pairs()) {
+          types.push_back(neigh.get_atom_type());
+          cluster_indices.push_back(neigh.get_cluster_index());
+        }
+        n_pairs += types.size();
+        auto && neighbours{partition.get_neighbours(i_center)};
+        BOOST_REQUIRE_EQUAL(neighbours.size(), types.size());
+        std::vector<bool> is_found(types.size(), false);
+        size_t n_visited{0};
+        int previous_type{0};
+        partition.for_each_species_block(
+            i_center, [&](size_t i_species, const auto & block) {
+              for (auto && neighbour : block) {
+                BOOST_REQUIRE_LT(neighbour.pair_index, types.size());
+                BOOST_CHECK_EQUAL(types[neighbour.pair_index],
+                                  species[i_species]);
+                BOOST_CHECK_EQUAL(cluster_indices[neighbour.pair_index],
+                                  neighbour.cluster_index);
+                BOOST_CHECK(not is_found[neighbour.pair_index]);
+                is_found[neighbour.pair_index] = true;
+              }
+              BOOST_CHECK_GT(species[i_species], previous_type);
+              previous_type = species[i_species];
+              n_visited += block.size();
+            });
+        BOOST_CHECK_EQUAL(n_visited, types.size());
+        ++i_center;
+      }
+      BOOST_CHECK_EQUAL(partition.get_nb_pairs(), n_pairs);
+    }
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace rascal
@@ -0,0 +1,183 @@
+/**
+ * @file   test_utils_timer.cc
+ *
+ * @date   18 October 2026
+ *
+ * @brief  test the built-in timers and counters
+ *
+ * @section LICENSE
+ *
+ * Copyright  2026 COSMO (EPFL), LAMMM (EPFL)
+ *
+ * Rascal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3, or (at
+ * your option) any later version.
+ *
+ * Rascal is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software; see the file LICENSE. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "rascal/representations/calculator_spherical_invariants.hh"
+#include "rascal/structure_managers/adaptor_center_contribution.hh"
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+#include "rascal/utils/parallel.hh"
+#include "rascal/utils/timer.hh"
+
+#include <boost/test/unit_test.hpp>
+
+namespace rascal {
+
+  BOOST_AUTO_TEST_SUITE(timer_test);
+
+#if RASCAL_TIMERS_LEVEL >= 1
+  /**
+   * Test that the nested timers are recorded under their path and that the
+   * counters and timers of terminated threads are kept.
+   */
+  BOOST_AUTO_TEST_CASE(nested_timers_test) {
+    using internal::Timings;
+    Timings::reset();
+    for (int i_call{0}; i_call < 3; ++i_call) {
+      RASCAL_TIMER("outer");
+      RASCAL_COUNTER_ADD("test::events", 2);
+      {
+        RASCAL_TIMER("inner");
+      }
+    }
+    const size_t n_tasks{8};
+    internal::parallel_for(n_tasks, 4, [](size_t, size_t) {
+      RASCAL_TIMER("task");
+      RASCAL_LOCAL_COUNTER_DECLARE(n_tasks_done);
+      RASCAL_LOCAL_COUNTER_ADD(n_tasks_done, 1);
+      RASCAL_LOCAL_COUNTER_FLUSH(n_tasks_done, "test::tasks");
+    });
+
+    json report = Timings::report();
+    BOOST_CHECK_EQUAL(report["level"].get<int>(), RASCAL_TIMERS_LEVEL);
+    auto && timers = report["timers"];
+    BOOST_REQUIRE(timers.count("outer"));
+    BOOST_REQUIRE(timers.count("outer/inner"));
+    BOOST_REQUIRE(timers.count("task"));
+    BOOST_CHECK_EQUAL(timers["outer"]["count"].get<size_t>(), 3);
+    BOOST_CHECK_EQUAL(timers["outer/inner"]["count"].get<size_t>(), 3);
+    BOOST_CHECK_LE(timers["outer/inner"]["time"].get<double>(),
+                   timers["outer"]["time"].get<double>());
+    BOOST_CHECK_EQUAL(timers["task"]["count"].get<size_t>(), n_tasks);
+    BOOST_CHECK_GE(timers["task"]["n_threads"].get<size_t>(), 1);
+    BOOST_CHECK_LE(timers["task"]["max_thread_time"].get<double>(),
+                   timers["task"]["time"].get<double>());
+    BOOST_CHECK_EQUAL(report["counters"]["test::events"].get<double>(), 6.);
+    BOOST_CHECK_EQUAL(report["counters"]["test::tasks"].get<double>(),
+                      static_cast<double>(n_tasks));
+
+    Timings::reset();
+    report = Timings::report();
+    BOOST_CHECK_EQUAL(report["timers"].size(), 0);
+    BOOST_CHECK_EQUAL(report["counters"].size(), 0);
+  }
+
+  /**
+   * Test that the computation of the spherical invariants reports the
+   * expansion nested in the invariants and counts the pairs of the
+   * neighbour list.
+   */
+  BOOST_AUTO_TEST_CASE(calculator_timers_test) {
+    using internal::Timings;
+    const double cutoff{3.};
+    json structure{
+        {"filename", "reference_data/inputs/small_molecule.json"}};
+    json adaptors{{{"name", "AdaptorNeighbourList"},
+                   {"initialization_arguments",
+                    {{"cutoff", cutoff}, {"skin", 0.}}}},
+                  {{"name", "AdaptorCenterContribution"},
+                   {"initialization_arguments", {}}},
+                  {{"name", "AdaptorStrict"},
+                   {"initialization_arguments", {{"cutoff", cutoff}}}}};
+    json hypers{{"max_radial", 3},
+                {"max_angular", 2},
+                {"soap_type", "PowerSpectrum"},
+                {"normalize", true},
+                {"compute_gradients", true}};
+    hypers["cutoff_function"] = {
+        {"type", "ShiftedCosine"},
+        {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+        {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
+    hypers["gaussian_density"] = {
+        {"type", "Constant"},
+        {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
+    hypers["radial_contribution"] = {{"type", "GTO"}};
+
+    Timings::reset();
+    auto manager =
+        make_structure_manager_stack<StructureManagerCenters,
+                                     AdaptorNeighbourList,
+                                     AdaptorCenterContribution, AdaptorStrict>(
+            structure, adaptors);
+    CalculatorSphericalInvariants representation{hypers};
+    representation.compute(manager);
+
+    // pairs().size() also counts the center pair which is not iterated over
+    size_t n_pairs{0};
+    for (auto center : manager) {
+      for (auto neigh : center.pairs()) {
+        (void)neigh;
+        n_pairs++;
+      }
+    }
+
+    json report = Timings::report();
+    auto && timers = report["timers"];
+    auto && counters = report["counters"];
+    BOOST_CHECK(timers.count("AdaptorNeighbourList::update"));
+    BOOST_CHECK(timers.count("SphericalInvariants::compute"));
+    BOOST_CHECK(timers.count(
+        "SphericalInvariants::compute/SphericalExpansion::compute"));
+    BOOST_CHECK(timers.count("SphericalInvariants::compute/invariants"));
+    BOOST_CHECK_EQUAL(counters["SphericalExpansion::centers"].get<double>(),
+                      static_cast<double>(manager->size()));
+    BOOST_CHECK_EQUAL(counters["SphericalInvariants::centers"].get<double>(),
+                      static_cast<double>(manager->size()));
+    BOOST_CHECK_EQUAL(counters["SphericalExpansion::pairs"].get<double>(),
+                      static_cast<double>(n_pairs));
+    BOOST_CHECK_GT(counters["AdaptorNeighbourList::pairs"].get<double>(), 0.);
+    BOOST_CHECK_GT(counters["BlockSparseProperty::allocations"].get<double>(),
+                   0.);
+    if (RASCAL_TIMERS_LEVEL >= 2) {
+      BOOST_CHECK(timers.count("SphericalInvariants::compute/"
+                               "SphericalExpansion::compute/expansion/"
+                               "radial_integral"));
+    }
+    Timings::reset();
+  }
+#else
+  /**
+   * Test that the timers and counters are removed at compile time
+   */
+  BOOST_AUTO_TEST_CASE(disabled_timers_test) {
+    using internal::Timings;
+    Timings::reset();
+    {
+      RASCAL_TIMER("outer");
+      RASCAL_COUNTER_ADD("test::events", 2);
+    }
+    json report = Timings::report();
+    BOOST_CHECK_EQUAL(report["level"].get<int>(), 0);
+    BOOST_CHECK_EQUAL(report["timers"].size(), 0);
+    BOOST_CHECK_EQUAL(report["counters"].size(), 0);
+  }
+#endif
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace rascal